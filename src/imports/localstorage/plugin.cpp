@@ -60,6 +60,7 @@
 #include <private/qv4scopedvalue_p.h>
 #include <private/qv4jscall_p.h>
 #include <private/qv4objectiterator_p.h>
+#include <private/qv4jsonobject_p.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -267,6 +268,11 @@ static QVariant toSqlVariant(QV4::ExecutionEngine *engine, const QV4::ScopedValu
     // expects a null variant. (this is because of QTBUG-40880)
     if (value->isNull())
         return QVariant();
+    // Plain objects and arrays can't be bound, store their JSON text instead
+    if (const QV4::Object *o = value->as<QV4::Object>()) {
+        if (o->as<QV4::ArrayObject>() || o->d()->vtable() == QV4::Object::staticVTable())
+            return QV4::JsonObject::stringify(engine, value);
+    }
     return engine->toVariant(value, /*typehint*/-1);
 }
 
@@ -302,6 +308,7 @@ static ReturnedValue qmlsqldatabase_executeSql(const FunctionObject *b, const Va
                 QV4::ScopedValue v(scope);
                 for (quint32 ii = 0; ii < size; ++ii) {
                     query.bindValue(ii, toSqlVariant(scope.engine, (v = array->get(ii))));
+                    CHECK_EXCEPTION();
                 }
             } else if (values->as<Object>()) {
                 ScopedObject object(scope, values);
@@ -313,6 +320,7 @@ static ReturnedValue qmlsqldatabase_executeSql(const FunctionObject *b, const Va
                     if (key->isNull())
                         break;
                     QVariant v = toSqlVariant(scope.engine, val);
+                    CHECK_EXCEPTION();
                     if (key->isString()) {
                         query.bindValue(key->stringValue()->toQString(), v);
                     } else {
@@ -323,6 +331,8 @@ static ReturnedValue qmlsqldatabase_executeSql(const FunctionObject *b, const Va
             } else {
                 query.bindValue(0, toSqlVariant(scope.engine, values));
             }
+            // Don't run the statement with values that failed to convert, such as cyclic objects
+            CHECK_EXCEPTION();
         }
         if (query.exec()) {
             QV4::Scoped<QQmlSqlDatabaseWrapper> rows(scope, QQmlSqlDatabaseWrapper::create(scope.engine));
@@ -660,6 +670,9 @@ In that case, the data could be saved in the following way:
 
 \endcode
 
+Since Qt 5.12, plain objects and arrays in the list of \e values are bound as their JSON
+text, so passing \c obj instead of \c{JSON.stringify(obj)} stores the same data.
+
 \section3 db.readTransaction(callback(tx))
 
 This method creates a read-only transaction and passed to \e callback. In this function,
@@ -74,6 +74,8 @@ static const qreal epsilon = 0.00001;
 QQuickFrictionAffector::QQuickFrictionAffector(QQuickItem *parent) :
     QQuickParticleAffector(parent), m_factor(0.0), m_threshold(0.0)
 {
+    m_batched = true;
+    m_threadSafeBatches = true;
 }
 
 bool QQuickFrictionAffector::affectParticle(QQuickParticleData *d, qreal dt)
@@ -110,6 +112,45 @@ bool QQuickFrictionAffector::affectParticle(QQuickParticleData *d, qreal dt)
     d->setInstantaneousVY(newVY, m_system);
     return true;
 }
+
+void QQuickFrictionAffector::affectBatch(const QQuickParticleBatch &batch, float time, qreal dt)
+{
+    if (!m_factor)
+        return;
+    for (int i = 0; i < batch.count; ++i) {
+        if (!batch.selected[i])
+            continue;
+        qreal curVX = batch.curVX(i, time);
+        qreal curVY = batch.curVY(i, time);
+        if (!curVX && !curVY)
+            continue;
+        qreal newVX = curVX + (curVX * m_factor * -1 * dt);
+        qreal newVY = curVY + (curVY * m_factor * -1 * dt);
+
+        if (!m_threshold) {
+            if (sign(curVX) != sign(newVX))
+                newVX = 0;
+            if (sign(curVY) != sign(newVY))
+                newVY = 0;
+        } else {
+            qreal curMag = qSqrt(curVX*curVX + curVY*curVY);
+            if (curMag <= m_threshold + epsilon)
+                continue;
+            qreal newMag = qSqrt(newVX*newVX + newVY*newVY);
+            if (newMag <= m_threshold + epsilon ||
+                sign(curVX) != sign(newVX) ||
+                sign(curVY) != sign(newVY)) {
+                qreal theta = qAtan2(curVY, curVX);
+                newVX = m_threshold * qCos(theta);
+                newVY = m_threshold * qSin(theta);
+            }
+        }
+
+        batch.setInstantaneousVX(i, newVX, time);
+        batch.setInstantaneousVY(i, newVY, time);
+        batch.affected[i] = true;
+    }
+}
 QT_END_NAMESPACE
 
 #include "moc_qquickfriction_p.cpp"
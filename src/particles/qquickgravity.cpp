@@ -114,6 +114,8 @@ qreal QQuickGravityAffector::angle() const
 QQuickGravityAffector::QQuickGravityAffector(QQuickItem *parent) :
     QQuickParticleAffector(parent), m_magnitude(-10), m_angle(90), m_needRecalc(true)
 {
+    m_batched = true;
+    m_threadSafeBatches = true;
 }
 
 bool QQuickGravityAffector::affectParticle(QQuickParticleData *d, qreal dt)
@@ -131,6 +133,44 @@ bool QQuickGravityAffector::affectParticle(QQuickParticleData *d, qreal dt)
     return true;
 }
 
+void QQuickGravityAffector::affectBatch(const QQuickParticleBatch &batch, float time, qreal dt)
+{
+    if (!m_magnitude)
+        return;
+
+    //Not cached in m_dx, m_dy, as several batches may run at once
+    const float dvx = m_magnitude * std::cos(m_angle * CONV) * dt;
+    const float dvy = m_magnitude * std::sin(m_angle * CONV) * dt;
+    float *x = batch.x();
+    float *y = batch.y();
+    float *vx = batch.vx();
+    float *vy = batch.vy();
+    const float *ax = batch.ax();
+    const float *ay = batch.ay();
+    const float *t = batch.t();
+
+    // setInstantaneousVX/VY written out and computed for every particle, keeping the results
+    // only for the selected ones, so that the loop has no branches and vectorizes
+    for (int i = 0; i < batch.count; ++i) {
+        const float elapsed = time - t[i];
+        const float elapsedSq = elapsed * elapsed;
+        const bool selected = batch.selected[i];
+
+        const float evx = (vx[i] + elapsed * ax[i] + dvx) - elapsed * ax[i];
+        const float ex = x[i] + vx[i] * elapsed + 0.5f * ax[i] * elapsedSq;
+        const float newX = ex - elapsed * evx - 0.5f * elapsedSq * ax[i];
+        const float evy = (vy[i] + elapsed * ay[i] + dvy) - elapsed * ay[i];
+        const float ey = y[i] + vy[i] * elapsed + 0.5f * ay[i] * elapsedSq;
+        const float newY = ey - elapsed * evy - 0.5f * elapsedSq * ay[i];
+
+        x[i] = selected ? newX : x[i];
+        vx[i] = selected ? evx : vx[i];
+        y[i] = selected ? newY : y[i];
+        vy[i] = selected ? evy : vy[i];
+        batch.affected[i] |= batch.selected[i];
+    }
+}
+
 
 
 QT_END_NAMESPACE
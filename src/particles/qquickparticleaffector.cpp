@@ -40,6 +40,8 @@
 #include "qquickparticleaffector_p.h"
 #include <QDebug>
 #include <private/qqmlglobal_p.h>
+#include <QtCore/qvarlengtharray.h>
+#include <cstring>
 QT_BEGIN_NAMESPACE
 
 /*!
@@ -88,6 +90,10 @@ QT_BEGIN_NAMESPACE
     again to see if they intersect with a particles from one of the particle groups
     in whenCollidingWith.
 
+    The positions of the particles in these groups are sampled once per frame and
+    shared between all affectors, so particles moved or emitted by an affector are
+    only collided with from the next frame on.
+
     By default, no groups are specified.
 */
 /*!
@@ -131,7 +137,7 @@ QT_BEGIN_NAMESPACE
 */
 QQuickParticleAffector::QQuickParticleAffector(QQuickItem *parent) :
     QQuickItem(parent), m_needsReset(false), m_ignoresTime(false), m_onceOff(false), m_enabled(true)
-    , m_system(nullptr), m_updateIntSet(false), m_shape(new QQuickParticleExtruder(this))
+    , m_batched(false), m_threadSafeBatches(false), m_system(nullptr), m_updateIntSet(false), m_shape(new QQuickParticleExtruder(this))
 {
 }
 
@@ -201,6 +207,10 @@ void QQuickParticleAffector::affectSystem(qreal dt)
         dt = 1.0;
     foreach (QQuickParticleGroupData* gd, m_system->groupData) {
         if (activeGroup(gd->index)) {
+            if (m_batched && m_whenCollidingWith.isEmpty()) {
+                affectGroupBatched(gd, dt);
+                continue;
+            }
             foreach (QQuickParticleData* d, gd->data) {
                 if (shouldAffect(d)) {
                     bool affected = false;
@@ -231,6 +241,102 @@ bool QQuickParticleAffector::affectParticle(QQuickParticleData *, qreal )
     return true;
 }
 
+void QQuickParticleAffector::affectBatch(const QQuickParticleBatch &, float, qreal)
+{
+}
+
+/*
+    Does the same as the per particle loop in affectSystem(), but a kinematics block at a time,
+    so that affectors with a batched implementation run over contiguous arrays.
+
+    Blocks are independent of each other, so for affectors with thread safe batches they are
+    spread over the simulation threads of the system. Everything else, and postAffect() in
+    particular, stays on this thread and runs in particle order once all blocks are done.
+*/
+void QQuickParticleAffector::affectGroupBatched(QQuickParticleGroupData *gd, qreal dt)
+{
+    const int realTime = m_system->timeInt;
+    const float now = realTime / 1000.0f;
+
+    // The sub-steps are the same for every particle
+    QVarLengthArray<int, 64> steps;
+    qreal myDt = dt;
+    if (!m_ignoresTime && myDt < simulationCutoff) {
+        int time = realTime;
+        time -= myDt * 1000.0;
+        while (myDt > simulationDelta) {
+            time += simulationDelta * 1000.0;
+            steps.append(time);
+            myDt -= simulationDelta;
+        }
+    }
+
+    const bool bounded = width() != 0 && height() != 0;
+    const QRectF bounds(m_offset.x(), m_offset.y(), width(), height());
+    const float epsilon = QQuickParticleData::EPSILON();
+    if (bounded)
+        m_shape->contains(bounds, bounds.center()); // Initializes mask shapes, later calls only read
+
+    const int blockCount = qMin(gd->kinematics.size(),
+            (gd->size() + QQuickParticleKinematicsBlock::Size - 1) / QQuickParticleKinematicsBlock::Size);
+    QVarLengthArray<uchar, QQuickParticleKinematicsBlock::Size> affected(blockCount * QQuickParticleKinematicsBlock::Size);
+
+    auto affectBlocks = [&](int begin, int end) {
+        uchar selected[QQuickParticleKinematicsBlock::Size];
+        uchar alive[QQuickParticleKinematicsBlock::Size];
+
+        for (int b = begin; b < end; ++b) {
+            const int first = b * QQuickParticleKinematicsBlock::Size;
+            const int count = qMin<int>(QQuickParticleKinematicsBlock::Size, gd->size() - first);
+            uchar *blockAffected = affected.data() + first;
+            memset(blockAffected, 0, count);
+            QQuickParticleBatch batch = { gd->kinematics.at(b), count, selected, blockAffected };
+            const float *t = batch.t();
+            const float *lifeSpan = batch.lifeSpan();
+
+            bool any = false;
+            for (int i = 0; i < count; ++i) {
+                selected[i] = (t[i] + lifeSpan[i] - epsilon) > now;
+                any |= selected[i];
+            }
+            if (!any)
+                continue;
+            if (m_onceOff || bounded) {
+                for (int i = 0; i < count; ++i) {
+                    if (!selected[i])
+                        continue;
+                    if (m_onceOff && m_onceOffed.contains(qMakePair(gd->index, first + i)))
+                        selected[i] = false;
+                    else if (bounded && !m_shape->contains(bounds, QPointF(batch.curX(i, now), batch.curY(i, now))))
+                        selected[i] = false;
+                }
+            }
+
+            // Only affect the particles during the parts of the frame they were alive for
+            batch.selected = alive;
+            for (int step : qAsConst(steps)) {
+                const float stepTime = step / 1000.0f;
+                for (int i = 0; i < count; ++i)
+                    alive[i] = selected[i] && (t[i] + epsilon) < stepTime && (t[i] + lifeSpan[i] - epsilon) > stepTime;
+                affectBatch(batch, stepTime, simulationDelta);
+            }
+
+            batch.selected = selected;
+            if (myDt > 0.0)
+                affectBatch(batch, now, myDt);
+        }
+    };
+    if (m_threadSafeBatches)
+        m_system->forEachBlockRange(blockCount, affectBlocks);
+    else
+        affectBlocks(0, blockCount);
+
+    for (int i = 0; i < blockCount * QQuickParticleKinematicsBlock::Size && i < gd->size(); ++i) {
+        if (affected[i])
+            postAffect(gd->data.at(i));
+    }
+}
+
 void QQuickParticleAffector::reset(QQuickParticleData* pd)
 {//TODO: This, among other ones, should be restructured so they don't all need to remember to call the superclass
     if (m_onceOff)
@@ -246,24 +352,7 @@ void QQuickParticleAffector::updateOffsets()
 
 bool QQuickParticleAffector::isColliding(QQuickParticleData *d) const
 {
-    qreal myCurX = d->curX(m_system);
-    qreal myCurY = d->curY(m_system);
-    qreal myCurSize = d->curSize(m_system) / 2;
-    foreach (const QString &group, m_whenCollidingWith){
-        foreach (QQuickParticleData* other, m_system->groupData[m_system->groupIds[group]]->data){
-            if (!other->stillAlive(m_system))
-                continue;
-            qreal otherCurX = other->curX(m_system);
-            qreal otherCurY = other->curY(m_system);
-            qreal otherCurSize = other->curSize(m_system) / 2;
-            if ((myCurX + myCurSize > otherCurX - otherCurSize
-                 && myCurX - myCurSize < otherCurX + otherCurSize)
-                 && (myCurY + myCurSize > otherCurY - otherCurSize
-                     && myCurY - myCurSize < otherCurY + otherCurSize))
-                return true;
-        }
-    }
-    return false;
+    return m_system->isColliding(d, m_whenCollidingWith);
 }
 
 QT_END_NAMESPACE
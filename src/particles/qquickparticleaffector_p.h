@@ -72,6 +72,8 @@ public:
     explicit QQuickParticleAffector(QQuickItem *parent = 0);
     virtual void affectSystem(qreal dt);
     virtual void reset(QQuickParticleData*);//As some store their own data per particle?
+    bool isBatched() const { return m_batched; }
+    void disableBatching() { m_batched = false; }//Falls back to affectParticle(), to compare it with affectBatch()
     QQuickParticleSystem* system() const
     {
         return m_system;
@@ -175,10 +177,15 @@ public Q_SLOTS:
 protected:
     friend class QQuickParticleSystem;
     virtual bool affectParticle(QQuickParticleData *d, qreal dt);
+    //Only called if m_batched is set. Same as affectParticle, for all the selected particles of the batch at once
+    //If m_threadSafeBatches is also set, it may be called for several batches at once from the simulation threads
+    virtual void affectBatch(const QQuickParticleBatch &batch, float time, qreal dt);
     bool m_needsReset:1;//### What is this really saving?
     bool m_ignoresTime:1;
     bool m_onceOff:1;
     bool m_enabled:1;
+    bool m_batched:1;
+    bool m_threadSafeBatches:1;
 
     QQuickParticleSystem* m_system;
     QStringList m_groups;
@@ -201,6 +208,7 @@ private:
     QStringList m_whenCollidingWith;
 
     bool isColliding(QQuickParticleData* d) const;
+    void affectGroupBatched(QQuickParticleGroupData *gd, qreal dt);
 };
 
 QT_END_NAMESPACE
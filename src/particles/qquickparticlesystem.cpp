@@ -50,8 +50,15 @@
 #include "qquicktrailemitter_p.h"//###For auto-follow on states, perhaps should be in emitter?
 #include <private/qqmlengine_p.h>
 #include <private/qqmlglobal_p.h>
+#include <QtCore/qnumeric.h>
 #include <cmath>
+#include <new>
+#include <algorithm>
 #include <QDebug>
+#include <QRunnable>
+#include <QSemaphore>
+#include <QThread>
+#include <QThreadPool>
 
 QT_BEGIN_NAMESPACE
 //###Switch to define later, for now user-friendly (no compilation) debugging is worth it
@@ -92,6 +99,12 @@ DEFINE_BOOL_CONFIG_OPTION(qmlParticlesDebug, QML_PARTICLES_DEBUG)
    Particle group changes move the particle from one group to another by killing the old particle
    and then creating a new one with the same data in the new group.
 
+   The batched affectors which are safe to run concurrently split each group's kinematics blocks
+   over simulationThreads threads (QML_PARTICLES_THREADS, 0 meaning one per core). Only the math
+   runs there: selection results are merged back, and the structural changes (postAffect, group
+   moves and kills) are applied on the GUI thread in particle order, so the outcome does not
+   depend on the number of threads.
+
    Note that currently groups only grow. Given that data is stored in vectors, it is non-trivial
    to pluck out the unused indexes when the count goes down. Given the dynamic nature of the
    system, it is difficult to tell if those unused data instances will be used again. Still,
@@ -314,6 +327,106 @@ void QQuickParticleDataHeap::bubbleDown(int idx)//tends to be called log n times
     }
 }
 
+void QQuickParticleSpatialHash::build(const QQuickParticleGroupData *gd, QQuickParticleSystem *system)
+{
+    m_x.clear();
+    m_y.clear();
+    m_halfSize.clear();
+    m_maxHalfSize = 0;
+    for (QQuickParticleData *d : gd->data) {
+        if (!d->stillAlive(system))
+            continue;
+        float x = d->curX(system);
+        float y = d->curY(system);
+        float halfSize = d->curSize(system) / 2;
+        if (!qIsFinite(x) || !qIsFinite(y) || !qIsFinite(halfSize))
+            continue; //Can't overlap anything
+        m_x.append(x);
+        m_y.append(y);
+        m_halfSize.append(halfSize);
+        m_maxHalfSize = qMax(m_maxHalfSize, qreal(halfSize));
+    }
+    m_valid = true;
+
+    const int n = m_x.size();
+    uint buckets = 16;
+    while (buckets < uint(n) * 2)
+        buckets *= 2;
+    m_mask = buckets - 1;
+    //Cells as large as the largest particle, so that a query never spans more than a few of them
+    m_cellSize = qMax(m_maxHalfSize * 2, qreal(1));
+
+    //Counting sort of the particles by bucket
+    QVector<uint> bucket(n);
+    m_bucketStart.fill(0, buckets + 1);
+    for (int i = 0; i < n; ++i) {
+        bucket[i] = bucketOf(cellOf(m_x[i]), cellOf(m_y[i]));
+        ++m_bucketStart[bucket[i] + 1];
+    }
+    for (uint b = 0; b < buckets; ++b)
+        m_bucketStart[b + 1] += m_bucketStart[b];
+
+    QVector<int> next(m_bucketStart);
+    QVector<float> x(n), y(n), halfSize(n);
+    for (int i = 0; i < n; ++i) {
+        int to = next[bucket[i]]++;
+        x[to] = m_x[i];
+        y[to] = m_y[i];
+        halfSize[to] = m_halfSize[i];
+    }
+    m_x.swap(x);
+    m_y.swap(y);
+    m_halfSize.swap(halfSize);
+}
+
+int QQuickParticleSpatialHash::cellOf(qreal v) const
+{
+    return int(qBound(qreal(INT_MIN / 2), std::floor(v / m_cellSize), qreal(INT_MAX / 2)));
+}
+
+bool QQuickParticleSpatialHash::overlaps(int i, qreal x, qreal y, qreal halfSize) const
+{
+    qreal otherX = m_x[i];
+    qreal otherY = m_y[i];
+    qreal otherHalfSize = m_halfSize[i];
+    return (x + halfSize > otherX - otherHalfSize
+            && x - halfSize < otherX + otherHalfSize)
+            && (y + halfSize > otherY - otherHalfSize
+                && y - halfSize < otherY + otherHalfSize);
+}
+
+bool QQuickParticleSpatialHash::intersects(qreal x, qreal y, qreal halfSize, int *tested) const
+{
+    Q_ASSERT(m_valid);
+    const int n = m_x.size();
+    if (!n)
+        return false;
+
+    const qreal reach = halfSize + m_maxHalfSize;
+    const qint64 x0 = cellOf(x - reach), x1 = cellOf(x + reach);
+    const qint64 y0 = cellOf(y - reach), y1 = cellOf(y + reach);
+    if ((x1 - x0 + 1) * (y1 - y0 + 1) > qint64(m_mask) + 1) {
+        //A box this large covers more cells than there are buckets, just look at everything
+        *tested += n;
+        for (int i = 0; i < n; ++i)
+            if (overlaps(i, x, y, halfSize))
+                return true;
+        return false;
+    }
+
+    for (qint64 cy = y0; cy <= y1; ++cy) {
+        for (qint64 cx = x0; cx <= x1; ++cx) {
+            const uint b = bucketOf(int(cx), int(cy));
+            const int end = m_bucketStart[b + 1];
+            *tested += end - m_bucketStart[b];
+            for (int i = m_bucketStart[b]; i < end; ++i)
+                if (overlaps(i, x, y, halfSize))
+                    return true;
+        }
+    }
+    return false;
+}
+
 QQuickParticleGroupData::QQuickParticleGroupData(const QString &name, QQuickParticleSystem* sys)
     : index(sys->registerParticleGroupData(name, this))
     , m_size(0)
@@ -326,6 +439,8 @@ QQuickParticleGroupData::~QQuickParticleGroupData()
 {
     foreach (QQuickParticleData* d, data)
         delete d;
+    for (QQuickParticleKinematicsBlock *block : qAsConst(kinematics))
+        QQuickParticleKinematicsBlock::destroy(block);
 }
 
 QString QQuickParticleGroupData::name()//### Worth caching as well?
@@ -340,8 +455,11 @@ void QQuickParticleGroupData::setSize(int newSize)
     Q_ASSERT(newSize > m_size);//XXX allow shrinking
     data.resize(newSize);
     freeList.resize(newSize);
+    while (kinematics.size() * QQuickParticleKinematicsBlock::Size < newSize)
+        kinematics.append(QQuickParticleKinematicsBlock::create());
     for (int i=m_size; i<newSize; i++) {
-        data[i] = new QQuickParticleData;
+        data[i] = new QQuickParticleData(kinematics.at(i / QQuickParticleKinematicsBlock::Size),
+                                         i % QQuickParticleKinematicsBlock::Size);
         data[i]->groupId = index;
         data[i]->index = i;
     }
@@ -414,15 +532,49 @@ void QQuickParticleGroupData::prepareRecycler(QQuickParticleData* d)
     }
 }
 
+QQuickParticleKinematicsBlock *QQuickParticleKinematicsBlock::create()
+{
+    // Cache line aligned, so that the kernels working on the rows can use aligned vector loads
+    void *memory = qMallocAligned(sizeof(QQuickParticleKinematicsBlock), 64);
+    Q_CHECK_PTR(memory);
+    return new (memory) QQuickParticleKinematicsBlock;
+}
+
+void QQuickParticleKinematicsBlock::destroy(QQuickParticleKinematicsBlock *block)
+{
+    block->~QQuickParticleKinematicsBlock();
+    qFreeAligned(block);
+}
+
 QQuickParticleData::QQuickParticleData()
+    : QQuickParticleData(new float[QQuickParticleKinematicsBlock::FieldCount], 1)
+{
+    m_ownKinematics = &x;
+}
+
+QQuickParticleData::QQuickParticleData(QQuickParticleKinematicsBlock *block, int slot)
+    : QQuickParticleData(&block->values[0][slot], QQuickParticleKinematicsBlock::Size)
+{
+}
+
+QQuickParticleData::QQuickParticleData(float *kinematics, int stride)
     : index(0)
     , systemIndex(-1)
+    , x(kinematics[QQuickParticleKinematicsBlock::X * stride])
+    , y(kinematics[QQuickParticleKinematicsBlock::Y * stride])
+    , t(kinematics[QQuickParticleKinematicsBlock::T * stride])
+    , lifeSpan(kinematics[QQuickParticleKinematicsBlock::LifeSpan * stride])
+    , vx(kinematics[QQuickParticleKinematicsBlock::VX * stride])
+    , vy(kinematics[QQuickParticleKinematicsBlock::VY * stride])
+    , ax(kinematics[QQuickParticleKinematicsBlock::AX * stride])
+    , ay(kinematics[QQuickParticleKinematicsBlock::AY * stride])
     , groupId(0)
     , colorOwner(nullptr)
     , rotationOwner(nullptr)
     , deformationOwner(nullptr)
     , animationOwner(nullptr)
     , v8Datum(nullptr)
+    , m_ownKinematics(nullptr)
 {
     x = 0;
     y = 0;
@@ -462,9 +614,11 @@ QQuickParticleData::QQuickParticleData()
 QQuickParticleData::~QQuickParticleData()
 {
     delete v8Datum;
+    delete[] m_ownKinematics;
 }
 
 QQuickParticleData::QQuickParticleData(const QQuickParticleData &other)
+    : QQuickParticleData()
 {
     *this = other;
 }
@@ -576,6 +730,12 @@ QQuickParticleSystem::QQuickParticleSystem(QQuickItem *parent) :
     m_empty(true)
 {
     m_debugMode = qmlParticlesDebug();
+    bool ok = false;
+    simulationThreads = qEnvironmentVariableIntValue("QML_PARTICLES_THREADS", &ok);
+    if (!ok)
+        simulationThreads = 1;
+    else if (simulationThreads <= 0)
+        simulationThreads = QThread::idealThreadCount();
 }
 
 QQuickParticleSystem::~QQuickParticleSystem()
@@ -1062,8 +1222,11 @@ void QQuickParticleSystem::updateCurrentTime( int currentTime )
 
     bool oldClear = m_empty;
     m_empty = true;
-    foreach (QQuickParticleGroupData* gd, groupData)//Recycle all groups and see if they're out of live particles
+    m_frameCollisionStatistics = CollisionStatistics();
+    foreach (QQuickParticleGroupData* gd, groupData) {//Recycle all groups and see if they're out of live particles
         m_empty = gd->recycle() && m_empty;
+        gd->collisionHash.invalidate();
+    }
 
     if (stateEngine)
         stateEngine->updateSprites(timeInt);
@@ -1076,10 +1239,90 @@ void QQuickParticleSystem::updateCurrentTime( int currentTime )
         foreach (QQuickParticlePainter* p, groupData[d->groupId]->painters)
             p->reload(d);
 
+    collisionStatistics = m_frameCollisionStatistics;
+    if (m_debugMode && collisionStatistics.queries)
+        qDebug() << "Particle collisions at" << timeInt << "ms:" << collisionStatistics.queries << "queries,"
+                 << collisionStatistics.candidates << "candidates," << collisionStatistics.hashBuilds
+                 << "groups hashed in" << collisionStatistics.nsecs / 1000 << "us";
+
     if (oldClear != m_empty)
         emptyChanged(m_empty);
 }
 
+namespace {
+class QQuickParticleRangeRunner : public QRunnable
+{
+public:
+    QQuickParticleRangeRunner(const std::function<void(int, int)> &function, int begin, int end, QSemaphore *done)
+        : m_function(function), m_begin(begin), m_end(end), m_done(done)
+    {}
+
+    void run() override
+    {
+        m_function(m_begin, m_end);
+        m_done->release();
+    }
+
+private:
+    const std::function<void(int, int)> &m_function;
+    int m_begin;
+    int m_end;
+    QSemaphore *m_done;
+};
+}
+
+Q_GLOBAL_STATIC(QThreadPool, particleThreadPool)
+
+/*
+    Used by the affectors to run a pass over the kinematics blocks of a group in parallel. The
+    calling thread takes the first range itself and returns once all of them are done, so the
+    function only has to be safe against other ranges of the same pass.
+*/
+void QQuickParticleSystem::forEachBlockRange(int count, const std::function<void(int, int)> &function)
+{
+    const int threads = qMin(simulationThreads, count);
+    if (threads <= 1) {
+        function(0, count);
+        return;
+    }
+
+    QThreadPool *pool = particleThreadPool();
+    if (pool->maxThreadCount() < threads - 1)
+        pool->setMaxThreadCount(threads - 1);
+    QSemaphore done;
+    for (int i = 1; i < threads; ++i)
+        pool->start(new QQuickParticleRangeRunner(function, count * i / threads, count * (i + 1) / threads, &done));
+    function(0, count / threads);
+    done.acquire(threads - 1);
+}
+
+bool QQuickParticleSystem::isColliding(QQuickParticleData *d, const QStringList &groups)
+{
+    QElapsedTimer timer;
+    timer.start();
+    CollisionStatistics &stats = m_frameCollisionStatistics;
+    ++stats.queries;
+
+    qreal x = d->curX(this);
+    qreal y = d->curY(this);
+    qreal halfSize = d->curSize(this) / 2;
+    bool colliding = false;
+    for (const QString &group : groups) {
+        QQuickParticleGroupData *gd = groupData[groupIds[group]];
+        if (!gd->collisionHash.isValid()) {
+            gd->collisionHash.build(gd, this);
+            ++stats.hashBuilds;
+        }
+        if (gd->collisionHash.intersects(x, y, halfSize, &stats.candidates)) {
+            colliding = true;
+            break;
+        }
+    }
+
+    stats.nsecs += timer.nsecsElapsed();
+    return colliding;
+}
+
 int QQuickParticleSystem::systemSync(QQuickParticlePainter* p)
 {
     if (!m_running)
@@ -55,6 +55,8 @@
 #include <QElapsedTimer>
 #include <QVector>
 #include <QHash>
+#include <QStringList>
+#include <functional>
 #include <QPointer>
 #include <private/qquicksprite_p.h>
 #include <QAbstractAnimation>
@@ -99,6 +101,7 @@ class QQuickStochasticEngine;
 class QQuickSprite;
 class QQuickV4ParticleData;
 class QQuickParticleGroup;
+class QQuickParticleGroupData;
 class QQuickImageParticle;
 
 struct QQuickParticleDataHeapNode{
@@ -133,6 +136,87 @@ private:
     QHash<int,int> m_lookups;
 };
 
+// Structure-of-arrays storage for the part of the particle state that the affectors and the
+// recycler go through every frame. A group allocates these in fixed-size blocks which never
+// move, so that the QQuickParticleData objects can refer to their slot for their whole life.
+struct Q_QUICKPARTICLES_PRIVATE_EXPORT QQuickParticleKinematicsBlock
+{
+    enum Field { X, Y, T, LifeSpan, VX, VY, AX, AY, FieldCount };
+    enum { Size = 256 };
+
+    static QQuickParticleKinematicsBlock *create();
+    static void destroy(QQuickParticleKinematicsBlock *block);
+
+    float *field(Field f) { return values[f]; }
+
+    float values[FieldCount][Size];
+};
+
+// A run of particles from one kinematics block, as handed to QQuickParticleAffector::affectBatch().
+// Only the particles with a non-zero entry in selected are to be affected, and those which were
+// have to be flagged in affected.
+struct QQuickParticleBatch
+{
+    QQuickParticleKinematicsBlock *block;
+    int count;
+    const uchar *selected;
+    uchar *affected;
+
+    float *x() const { return block->field(QQuickParticleKinematicsBlock::X); }
+    float *y() const { return block->field(QQuickParticleKinematicsBlock::Y); }
+    float *t() const { return block->field(QQuickParticleKinematicsBlock::T); }
+    float *lifeSpan() const { return block->field(QQuickParticleKinematicsBlock::LifeSpan); }
+    float *vx() const { return block->field(QQuickParticleKinematicsBlock::VX); }
+    float *vy() const { return block->field(QQuickParticleKinematicsBlock::VY); }
+    float *ax() const { return block->field(QQuickParticleKinematicsBlock::AX); }
+    float *ay() const { return block->field(QQuickParticleKinematicsBlock::AY); }
+
+    //Same as the QQuickParticleData functions of the same name, with the system time passed in seconds
+    float curX(int i, float time) const;
+    float curY(int i, float time) const;
+    float curVX(int i, float time) const;
+    float curVY(int i, float time) const;
+    void setInstantaneousVX(int i, float vx, float time) const;
+    void setInstantaneousVY(int i, float vy, float time) const;
+    void setInstantaneousAX(int i, float ax, float time) const;
+    void setInstantaneousAY(int i, float ay, float time) const;
+};
+
+// Broad phase for the whenCollidingWith tests of the affectors. It is a snapshot of the live
+// particles of one group, bucketed by a uniform grid whose cells are at least as large as the
+// largest particle, so that a query only has to look at the cells its own box overlaps.
+// Each group builds it at most once per frame, on first use, and all affectors share it.
+// Particles moved or emitted by the affectors later in that frame are only seen the next one.
+class Q_QUICKPARTICLES_PRIVATE_EXPORT QQuickParticleSpatialHash
+{
+public:
+    QQuickParticleSpatialHash() {}
+
+    void build(const QQuickParticleGroupData *gd, QQuickParticleSystem *system);
+    void invalidate() { m_valid = false; }
+    bool isValid() const { return m_valid; }
+    int count() const { return m_x.size(); }
+
+    //True if the square of half size halfSize at x, y overlaps any particle in the snapshot.
+    //The number of particles compared exactly is added to tested.
+    bool intersects(qreal x, qreal y, qreal halfSize, int *tested) const;
+
+private:
+    int cellOf(qreal v) const;
+    uint bucketOf(int cx, int cy) const
+    { return (uint(cx) * 73856093u ^ uint(cy) * 19349663u) & m_mask; }
+    bool overlaps(int i, qreal x, qreal y, qreal halfSize) const;
+
+    bool m_valid = false;
+    qreal m_cellSize = 1;
+    qreal m_maxHalfSize = 0;
+    uint m_mask = 0;
+    QVector<int> m_bucketStart; //m_mask + 2 entries, the particles of bucket b are [start[b], start[b + 1])
+    QVector<float> m_x;
+    QVector<float> m_y;
+    QVector<float> m_halfSize;
+};
+
 class Q_QUICKPARTICLES_PRIVATE_EXPORT QQuickParticleGroupData {
     class FreeList
     {
@@ -210,8 +294,10 @@ public:
 
     //TODO: Refactor particle data list out into a separate class
     QVector<QQuickParticleData*> data;
+    QVector<QQuickParticleKinematicsBlock*> kinematics; // particle i lives in slot i % Size of block i / Size
     FreeList freeList;
     QQuickParticleDataHeap dataHeap;
+    QQuickParticleSpatialHash collisionHash;
     bool recycle(); //Force recycling round, returns true if all indexes are now reusable
 
     void initList();
@@ -239,6 +325,7 @@ class Q_QUICKPARTICLES_PRIVATE_EXPORT QQuickParticleData {
 public:
     //TODO: QObject like memory management (without the cost, just attached to system)
     QQuickParticleData();
+    QQuickParticleData(QQuickParticleKinematicsBlock *block, int slot);
     ~QQuickParticleData();
 
     QQuickParticleData(const QQuickParticleData &other);
@@ -274,16 +361,17 @@ public:
     int systemIndex;
 
     //General Position Stuff
-    float x;
-    float y;
-    float t;
-    float lifeSpan;
+    //x, y, t, lifeSpan, vx, vy, ax and ay refer to the slot in the kinematics block of the group
+    float &x;
+    float &y;
+    float &t;
+    float &lifeSpan;
     float size;
     float endSize;
-    float vx;
-    float vy;
-    float ax;
-    float ay;
+    float &vx;
+    float &vy;
+    float &ax;
+    float &ay;
 
     //Painter-specific stuff, now universally shared
     //Used by ImageParticle color mode
@@ -339,7 +427,10 @@ public:
     static inline Q_DECL_CONSTEXPR float EPSILON() Q_DECL_NOTHROW { return 0.001f; }
 
 private:
+    QQuickParticleData(float *kinematics, int stride);
+
     QQuickV4ParticleData* v8Datum;
+    float *m_ownKinematics; // Only for particles outside of a group
 };
 
 class Q_QUICKPARTICLES_PRIVATE_EXPORT QQuickParticleSystem : public QQuickItem
@@ -404,6 +495,19 @@ public:
     //This one only once per painter per frame
     int systemSync(QQuickParticlePainter* p);
 
+    //Calls function on consecutive ranges of [0, count), in parallel on up to simulationThreads threads
+    void forEachBlockRange(int count, const std::function<void(int, int)> &function);
+
+    //Used by the affectors for their whenCollidingWith tests, can be called many times per frame
+    bool isColliding(QQuickParticleData *d, const QStringList &groups);
+
+    struct CollisionStatistics {
+        int hashBuilds = 0; //groups whose spatial hash had to be built
+        int queries = 0; //particles tested for collision
+        int candidates = 0; //pairs compared exactly after the broad phase
+        qint64 nsecs = 0; //time spent building and querying
+    };
+
     //Data members here for ease of related class and auto-test usage. Not "public" API. TODO: d_ptrize
     QSet<QQuickParticleData*> needsReset;
     QVector<QQuickParticleData*> bySysIdx; //Another reference to the data (data owned by group), but by sysIdx
@@ -423,6 +527,8 @@ public:
     int timeInt;
     bool initialized;
     int particleCount;
+    CollisionStatistics collisionStatistics; //of the last complete frame
+    int simulationThreads; //1 runs the whole simulation on the GUI thread
 
     void registerParticlePainter(QQuickParticlePainter* p);
     void registerParticleEmitter(QQuickParticleEmitter* e);
@@ -460,6 +566,7 @@ private:
     bool m_paused;
     bool m_allDead;
     bool m_empty;
+    CollisionStatistics m_frameCollisionStatistics;
 };
 
 // Internally, this animation drives all the timing. Painters sync up in their updatePaintNode
@@ -549,6 +656,74 @@ inline void QQuickParticleData::setInstantaneousY(float y, QQuickParticleSystem
     this->y = y - t * this->vy - 0.5f * t_sq * this->ay;
 }
 
+inline float QQuickParticleBatch::curX(int i, float time) const
+{
+    float t = time - this->t()[i];
+    return x()[i] + vx()[i] * t + 0.5f * ax()[i] * t * t;
+}
+
+inline float QQuickParticleBatch::curY(int i, float time) const
+{
+    float t = time - this->t()[i];
+    return y()[i] + vy()[i] * t + 0.5f * ay()[i] * t * t;
+}
+
+inline float QQuickParticleBatch::curVX(int i, float time) const
+{
+    return vx()[i] + (time - t()[i]) * ax()[i];
+}
+
+inline float QQuickParticleBatch::curVY(int i, float time) const
+{
+    return vy()[i] + (time - t()[i]) * ay()[i];
+}
+
+inline void QQuickParticleBatch::setInstantaneousVX(int i, float vx, float time) const
+{
+    float t = time - this->t()[i];
+    float t_sq = t * t;
+    float ax = this->ax()[i];
+    float evx = vx - t * ax;
+    float ex = x()[i] + this->vx()[i] * t + 0.5f * ax * t_sq;
+    x()[i] = ex - t * evx - 0.5f * t_sq * ax;
+    this->vx()[i] = evx;
+}
+
+inline void QQuickParticleBatch::setInstantaneousVY(int i, float vy, float time) const
+{
+    float t = time - this->t()[i];
+    float t_sq = t * t;
+    float ay = this->ay()[i];
+    float evy = vy - t * ay;
+    float ey = y()[i] + this->vy()[i] * t + 0.5f * ay * t_sq;
+    y()[i] = ey - t * evy - 0.5f * t_sq * ay;
+    this->vy()[i] = evy;
+}
+
+inline void QQuickParticleBatch::setInstantaneousAX(int i, float ax, float time) const
+{
+    float t = time - this->t()[i];
+    float t_sq = t * t;
+    float oldAX = this->ax()[i];
+    float vx = (this->vx()[i] + t * oldAX) - t * ax;
+    float ex = x()[i] + this->vx()[i] * t + 0.5f * oldAX * t_sq;
+    x()[i] = ex - t * vx - 0.5f * t_sq * ax;
+    this->vx()[i] = vx;
+    this->ax()[i] = ax;
+}
+
+inline void QQuickParticleBatch::setInstantaneousAY(int i, float ay, float time) const
+{
+    float t = time - this->t()[i];
+    float t_sq = t * t;
+    float oldAY = this->ay()[i];
+    float vy = (this->vy()[i] + t * oldAY) - t * ay;
+    float ey = y()[i] + this->vy()[i] * t + 0.5f * oldAY * t_sq;
+    y()[i] = ey - t * vy - 0.5f * t_sq * ay;
+    this->vy()[i] = vy;
+    this->ay()[i] = ay;
+}
+
 inline float QQuickParticleData::curX(QQuickParticleSystem *particleSystem) const
 {
     float t = (particleSystem->timeInt / 1000.0f) - this->t;
@@ -85,6 +85,7 @@ QQuickWanderAffector::QQuickWanderAffector(QQuickItem *parent) :
     , m_affectedParameter(Velocity)
 {
     m_needsReset = true;
+    m_batched = true;
 }
 
 QQuickWanderAffector::~QQuickWanderAffector()
@@ -179,6 +180,50 @@ bool QQuickWanderAffector::affectParticle(QQuickParticleData* data, qreal dt)
     }
     return true;
 }
+
+void QQuickWanderAffector::affectBatch(const QQuickParticleBatch &batch, float time, qreal dt)
+{
+    float *x = batch.x();
+    float *y = batch.y();
+    const float *ax = batch.ax();
+    const float *ay = batch.ay();
+    QRandomGenerator *random = QRandomGenerator::global();
+    for (int i = 0; i < batch.count; ++i) {
+        if (!batch.selected[i])
+            continue;
+        qreal dx = dt * m_pace * (2 * random->generateDouble() - 1);
+        qreal dy = dt * m_pace * (2 * random->generateDouble() - 1);
+        qreal newX, newY;
+        switch (m_affectedParameter){
+        case Position:
+            newX = batch.curX(i, time) + dx;
+            if (m_xVariance > qAbs(newX) )
+                x[i] += dx;
+            newY = batch.curY(i, time) + dy;
+            if (m_yVariance > qAbs(newY) )
+                y[i] += dy;
+            break;
+        default:
+        case Velocity:
+            newX = batch.curVX(i, time) + dx;
+            if (m_xVariance > qAbs(newX))
+                batch.setInstantaneousVX(i, newX, time);
+            newY = batch.curVY(i, time) + dy;
+            if (m_yVariance > qAbs(newY))
+                batch.setInstantaneousVY(i, newY, time);
+            break;
+        case Acceleration:
+            newX = ax[i] + dx;
+            if (m_xVariance > qAbs(newX))
+                batch.setInstantaneousAX(i, newX, time);
+            newY = ay[i] + dy;
+            if (m_yVariance > qAbs(newY))
+                batch.setInstantaneousAY(i, newY, time);
+            break;
+        }
+        batch.affected[i] = true;
+    }
+}
 QT_END_NAMESPACE
 
 #include "moc_qquickwander_p.cpp"
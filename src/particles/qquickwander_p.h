@@ -106,6 +106,7 @@ public:
 
 protected:
     bool affectParticle(QQuickParticleData *d, qreal dt) override;
+    void affectBatch(const QQuickParticleBatch &batch, float time, qreal dt) override;
 
 Q_SIGNALS:
 
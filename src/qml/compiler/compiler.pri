@@ -4,6 +4,7 @@ INCLUDEPATH += $$OUT_PWD
 HEADERS += \
     $$PWD/qv4bytecodegenerator_p.h \
     $$PWD/qv4compileddata_p.h \
+    $$PWD/qv4compilationunitbundle_p.h \
     $$PWD/qv4compiler_p.h \
     $$PWD/qv4compilercontext_p.h \
     $$PWD/qv4compilercontrolflow_p.h \
@@ -17,6 +18,7 @@ HEADERS += \
 SOURCES += \
     $$PWD/qv4bytecodegenerator.cpp \
     $$PWD/qv4compileddata.cpp \
+    $$PWD/qv4compilationunitbundle.cpp \
     $$PWD/qv4compiler.cpp \
     $$PWD/qv4compilercontext.cpp \
     $$PWD/qv4compilerscanfunctions.cpp \
@@ -0,0 +1,331 @@
+/****************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtQml module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qv4compilationunitbundle_p.h"
+#include "qv4compileddata_p.h"
+
+#include <QtCore/qfile.h>
+#include <QtCore/qsavefile.h>
+
+#include <algorithm>
+#include <limits>
+
+QT_BEGIN_NAMESPACE
+
+using namespace QV4;
+
+namespace {
+const char bundleMagic[] = "qv4cbndl";
+const quint32 bundleVersion = 1;
+// Units are stored at this alignment, so that they can be used in place.
+const quint32 unitAlignment = 16;
+
+quint32 alignedOffset(quint32 offset)
+{
+    return (offset + unitAlignment - 1) & ~(unitAlignment - 1);
+}
+}
+
+struct CompilationUnitBundle::Header
+{
+    char magic[8];
+    quint32_le bundleVersion;
+    quint32_le structureVersion;
+    quint32_le qtVersion;
+    quint32_le entryCount;
+    quint32_le offsetToIndex;
+    quint32_le size;
+};
+static_assert(sizeof(CompilationUnitBundle::Header) == 32, "Bundle header must have the same layout on all platforms");
+
+// Paths are stored as little endian UTF-16.
+struct CompilationUnitBundle::IndexEntry
+{
+    quint64_le pathHash;
+    quint32_le offsetToPath;
+    quint32_le pathLength;
+    quint32_le offsetToUnit;
+    quint32_le unitSize;
+};
+static_assert(sizeof(CompilationUnitBundle::IndexEntry) == 24, "Bundle index entries must have the same layout on all platforms");
+
+CompilationUnitBundle::CompilationUnitBundle()
+{
+}
+
+CompilationUnitBundle::~CompilationUnitBundle()
+{
+#ifndef V4_BOOTSTRAP
+    delete m_file;
+#endif
+}
+
+// FNV-1a, so that the index does not depend on the seed or the implementation of qHash().
+quint64 CompilationUnitBundle::hashSourcePath(const QString &sourcePath)
+{
+    quint64 hash = Q_UINT64_C(14695981039346656037);
+    for (const QChar c : sourcePath) {
+        hash ^= c.unicode();
+        hash *= Q_UINT64_C(1099511628211);
+    }
+    return hash;
+}
+
+bool CompilationUnitBundle::write(const QString &fileName, const QVector<Entry> &entries, QString *errorString)
+{
+    struct SortedEntry
+    {
+        quint64 hash;
+        const Entry *entry;
+    };
+    QVector<SortedEntry> sorted;
+    sorted.reserve(entries.size());
+    for (const Entry &entry : entries) {
+        if (size_t(entry.unitData.size()) < sizeof(CompiledData::Unit)
+                || reinterpret_cast<const CompiledData::Unit *>(entry.unitData.constData())->unitSize != quint32(entry.unitData.size())) {
+            *errorString = QStringLiteral("Invalid compilation unit for %1").arg(entry.sourcePath);
+            return false;
+        }
+        sorted.append({hashSourcePath(entry.sourcePath), &entry});
+    }
+    std::sort(sorted.begin(), sorted.end(), [](const SortedEntry &lhs, const SortedEntry &rhs) {
+        if (lhs.hash != rhs.hash)
+            return lhs.hash < rhs.hash;
+        return lhs.entry->sourcePath < rhs.entry->sourcePath;
+    });
+    for (int i = 1; i < sorted.size(); ++i) {
+        if (sorted.at(i - 1).entry->sourcePath == sorted.at(i).entry->sourcePath) {
+            *errorString = QStringLiteral("Duplicate entry for %1").arg(sorted.at(i).entry->sourcePath);
+            return false;
+        }
+    }
+
+    // Header, index, paths and then the units.
+    quint32 offset = sizeof(Header) + quint32(sorted.size()) * sizeof(IndexEntry);
+    QVector<IndexEntry> index(sorted.size());
+    for (int i = 0; i < sorted.size(); ++i) {
+        IndexEntry &indexEntry = index[i];
+        indexEntry.pathHash = sorted.at(i).hash;
+        indexEntry.offsetToPath = offset;
+        indexEntry.pathLength = quint32(sorted.at(i).entry->sourcePath.size());
+        offset += indexEntry.pathLength * sizeof(quint16_le);
+    }
+    for (int i = 0; i < sorted.size(); ++i) {
+        IndexEntry &indexEntry = index[i];
+        offset = alignedOffset(offset);
+        indexEntry.offsetToUnit = offset;
+        indexEntry.unitSize = quint32(sorted.at(i).entry->unitData.size());
+        offset += indexEntry.unitSize;
+    }
+
+    QByteArray bundle(int(offset), Qt::Uninitialized);
+    memset(bundle.data(), 0, bundle.size());
+    char *data = bundle.data();
+
+    Header *header = reinterpret_cast<Header *>(data);
+    memcpy(header->magic, bundleMagic, sizeof(header->magic));
+    header->bundleVersion = bundleVersion;
+    header->structureVersion = QV4_DATA_STRUCTURE_VERSION;
+    header->qtVersion = QT_VERSION;
+    header->entryCount = quint32(sorted.size());
+    header->offsetToIndex = sizeof(Header);
+    header->size = offset;
+    memcpy(data + sizeof(Header), index.constData(), index.size() * sizeof(IndexEntry));
+
+    for (int i = 0; i < sorted.size(); ++i) {
+        const IndexEntry &indexEntry = index.at(i);
+        const Entry *entry = sorted.at(i).entry;
+
+        quint16_le *path = reinterpret_cast<quint16_le *>(data + indexEntry.offsetToPath);
+        for (const QChar c : entry->sourcePath)
+            *path++ = c.unicode();
+
+        memcpy(data + indexEntry.offsetToUnit, entry->unitData.constData(), indexEntry.unitSize);
+        CompiledData::Unit *unit = reinterpret_cast<CompiledData::Unit *>(data + indexEntry.offsetToUnit);
+        unit->flags |= CompiledData::Unit::StaticData;
+    }
+
+#if QT_CONFIG(temporaryfile)
+    QSaveFile file(fileName);
+#else
+    QFile file(fileName);
+#endif
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        *errorString = file.errorString();
+        return false;
+    }
+
+    if (file.write(bundle) != bundle.size()) {
+        *errorString = file.errorString();
+        return false;
+    }
+
+#if QT_CONFIG(temporaryfile)
+    if (!file.commit()) {
+        *errorString = file.errorString();
+        return false;
+    }
+#endif
+
+    return true;
+}
+
+#ifndef V4_BOOTSTRAP
+
+bool CompilationUnitBundle::open(const QString &fileName, QString *errorString)
+{
+    Q_ASSERT(!isOpen());
+
+    QScopedPointer<QFile> file(new QFile(fileName));
+    if (!file->open(QIODevice::ReadOnly)) {
+        *errorString = file->errorString();
+        return false;
+    }
+
+    const qint64 size = file->size();
+    if (size < qint64(sizeof(Header)) || size > std::numeric_limits<quint32>::max()) {
+        *errorString = QStringLiteral("File size does not match a cache bundle");
+        return false;
+    }
+
+    const uchar *data = file->map(0, size);
+    if (!data) {
+        *errorString = file->errorString();
+        return false;
+    }
+
+    const Header *header = reinterpret_cast<const Header *>(data);
+    if (memcmp(header->magic, bundleMagic, sizeof(header->magic)) != 0) {
+        *errorString = QStringLiteral("Magic bytes in the header do not match");
+        return false;
+    }
+
+    if (header->bundleVersion != bundleVersion) {
+        *errorString = QString::fromUtf8("Bundle version mismatch. Found %1 expected %2").arg(quint32(header->bundleVersion)).arg(bundleVersion);
+        return false;
+    }
+
+    if (header->structureVersion != quint32(QV4_DATA_STRUCTURE_VERSION)) {
+        *errorString = QString::fromUtf8("V4 data structure version mismatch. Found %1 expected %2").arg(quint32(header->structureVersion), 0, 16).arg(QV4_DATA_STRUCTURE_VERSION, 0, 16);
+        return false;
+    }
+
+    if (header->qtVersion != quint32(QT_VERSION)) {
+        *errorString = QString::fromUtf8("Qt version mismatch. Found %1 expected %2").arg(quint32(header->qtVersion), 0, 16).arg(QT_VERSION, 0, 16);
+        return false;
+    }
+
+    // Check the index once, so that lookups can trust it.
+    const quint64 indexEnd = quint64(header->offsetToIndex) + quint64(header->entryCount) * sizeof(IndexEntry);
+    if (header->size != quint32(size) || header->offsetToIndex % alignof(IndexEntry) || indexEnd > quint64(size)) {
+        *errorString = QStringLiteral("Bundle index is corrupt");
+        return false;
+    }
+
+    const IndexEntry *entries = reinterpret_cast<const IndexEntry *>(data + header->offsetToIndex);
+    for (quint32 i = 0; i < header->entryCount; ++i) {
+        const IndexEntry &entry = entries[i];
+        const bool valid = (i == 0 || entries[i - 1].pathHash <= entry.pathHash)
+                && quint64(entry.offsetToPath) + quint64(entry.pathLength) * sizeof(quint16_le) <= quint64(size)
+                && entry.offsetToUnit % unitAlignment == 0
+                && entry.unitSize >= sizeof(CompiledData::Unit)
+                && quint64(entry.offsetToUnit) + entry.unitSize <= quint64(size)
+                && reinterpret_cast<const CompiledData::Unit *>(data + entry.offsetToUnit)->unitSize == entry.unitSize;
+        if (!valid) {
+            *errorString = QStringLiteral("Bundle index is corrupt");
+            return false;
+        }
+    }
+
+    m_file = file.take();
+    m_data = data;
+    m_entries = entries;
+    m_entryCount = int(header->entryCount);
+    return true;
+}
+
+const CompiledData::Unit *CompilationUnitBundle::unit(const QString &sourcePath) const
+{
+    if (!m_entries)
+        return nullptr;
+
+    const quint64 hash = hashSourcePath(sourcePath);
+    const IndexEntry *end = m_entries + m_entryCount;
+    const IndexEntry *it = std::lower_bound(m_entries, end, hash, [](const IndexEntry &entry, quint64 hash) {
+        return entry.pathHash < hash;
+    });
+
+    for (; it != end && it->pathHash == hash; ++it) {
+        if (it->pathLength != quint32(sourcePath.size()))
+            continue;
+        const quint16_le *path = reinterpret_cast<const quint16_le *>(m_data + it->offsetToPath);
+        if (std::equal(sourcePath.cbegin(), sourcePath.cend(), path, [](QChar c, quint16 p) {
+                return c.unicode() == p;
+            })) {
+            return reinterpret_cast<const CompiledData::Unit *>(m_data + it->offsetToUnit);
+        }
+    }
+
+    return nullptr;
+}
+
+const CompilationUnitBundle *CompilationUnitBundle::global()
+{
+    // Intentionally leaked. Units from the bundle are used in place, and strings created
+    // from them may point into the mapping until the very end.
+    static const CompilationUnitBundle *bundle = []() -> const CompilationUnitBundle * {
+        const QString fileName = qEnvironmentVariable("QML_DISK_CACHE_BUNDLE");
+        if (fileName.isEmpty())
+            return nullptr;
+
+        CompilationUnitBundle *bundle = new CompilationUnitBundle;
+        QString error;
+        if (!bundle->open(fileName, &error)) {
+            qWarning("Could not open QML cache bundle %s: %s", qPrintable(fileName), qPrintable(error));
+            delete bundle;
+            return nullptr;
+        }
+        return bundle;
+    }();
+    return bundle;
+}
+
+#endif // V4_BOOTSTRAP
+
+QT_END_NAMESPACE
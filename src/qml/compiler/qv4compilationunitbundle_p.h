@@ -0,0 +1,120 @@
+/****************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtQml module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QV4COMPILATIONUNITBUNDLE_P_H
+#define QV4COMPILATIONUNITBUNDLE_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <private/qv4global_p.h>
+#include <QtCore/qstring.h>
+#include <QtCore/qvector.h>
+
+QT_BEGIN_NAMESPACE
+
+class QFile;
+
+namespace QV4 {
+
+namespace CompiledData {
+struct Unit;
+}
+
+// A single cache file holding the compilation units of many source files, so that an
+// application can map all of them with one open() and mmap() instead of one per file.
+// Units are looked up by the local path of their source file, as returned by
+// QQmlFile::urlToLocalFileOrQrc(), through an index sorted by the hash of that path.
+//
+// Each unit is still validated against its source with Unit::verifyHeader() before it
+// is used. If only some sources have been rebuilt, only their entries go stale and the
+// loader falls back to the individual cache files for them.
+class Q_QML_PRIVATE_EXPORT CompilationUnitBundle
+{
+public:
+    struct Entry
+    {
+        QString sourcePath;
+        QByteArray unitData;
+    };
+
+    CompilationUnitBundle();
+    ~CompilationUnitBundle();
+
+    static bool write(const QString &fileName, const QVector<Entry> &entries, QString *errorString);
+    static quint64 hashSourcePath(const QString &sourcePath);
+
+#ifndef V4_BOOTSTRAP
+    bool open(const QString &fileName, QString *errorString);
+    bool isOpen() const { return m_entries != nullptr; }
+    int count() const { return m_entryCount; }
+
+    const CompiledData::Unit *unit(const QString &sourcePath) const;
+
+    // The bundle named by the QML_DISK_CACHE_BUNDLE environment variable, if any.
+    static const CompilationUnitBundle *global();
+#endif
+
+    struct Header;
+    struct IndexEntry;
+
+private:
+    Q_DISABLE_COPY(CompilationUnitBundle)
+
+#ifndef V4_BOOTSTRAP
+    QFile *m_file = nullptr;
+    const uchar *m_data = nullptr;
+    const IndexEntry *m_entries = nullptr;
+    int m_entryCount = 0;
+#endif
+};
+
+}
+
+QT_END_NAMESPACE
+
+#endif // QV4COMPILATIONUNITBUNDLE_P_H
@@ -51,7 +51,7 @@ QT_BEGIN_NAMESPACE
 
 using namespace QV4;
 
-CompiledData::Unit *CompilationUnitMapper::open(const QString &cacheFileName, const QDateTime &sourceTimeStamp, QString *errorString)
+CompiledData::Unit *CompilationUnitMapper::open(const QString &cacheFileName, const QDateTime &sourceTimeStamp, QString *errorString, quint64 sourceHash)
 {
     close();
 
@@ -73,7 +73,7 @@ CompiledData::Unit *CompilationUnitMapper::open(const QString &cacheFileName, co
         return nullptr;
     }
 
-    if (!header.verifyHeader(sourceTimeStamp, errorString))
+    if (!header.verifyHeader(sourceTimeStamp, errorString, sourceHash))
         return nullptr;
 
     // Data structure and qt version matched, so now we can access the rest of the file safely.
@@ -54,6 +54,7 @@
 #include <private/qv4qobjectwrapper_p.h>
 #include <private/qqmlvaluetypewrapper_p.h>
 #include "qv4compilationunitmapper_p.h"
+#include "qv4compilationunitbundle_p.h"
 #include <QQmlPropertyMap>
 #include <QDateTime>
 #include <QFile>
@@ -92,6 +93,43 @@ static_assert(sizeof(Unit::libraryVersionHash) >= QML_COMPILE_HASH_LENGTH + 1, "
 #  error "QML_COMPILE_HASH must be defined for the build of QtDeclarative to ensure version checking for cache files"
 #endif
 
+// MurmurHash64A. The result is stored in cache files, so it must not depend on the host's
+// endianness or on QHash seeding.
+quint64 computeSourceHash(const char *data, qsizetype size)
+{
+    const quint64 m = Q_UINT64_C(0xc6a4a7935bd1e995);
+    const int r = 47;
+    quint64 h = Q_UINT64_C(0x51ed270b27e1d3a5) ^ (quint64(size) * m);
+
+    const uchar *p = reinterpret_cast<const uchar *>(data);
+    const uchar *end = p + (size & ~qsizetype(7));
+    for (; p != end; p += 8) {
+        quint64 k = qFromLittleEndian<quint64>(p);
+        k *= m;
+        k ^= k >> r;
+        k *= m;
+        h ^= k;
+        h *= m;
+    }
+
+    switch (size & 7) {
+    case 7: h ^= quint64(p[6]) << 48; Q_FALLTHROUGH();
+    case 6: h ^= quint64(p[5]) << 40; Q_FALLTHROUGH();
+    case 5: h ^= quint64(p[4]) << 32; Q_FALLTHROUGH();
+    case 4: h ^= quint64(p[3]) << 24; Q_FALLTHROUGH();
+    case 3: h ^= quint64(p[2]) << 16; Q_FALLTHROUGH();
+    case 2: h ^= quint64(p[1]) << 8; Q_FALLTHROUGH();
+    case 1: h ^= quint64(p[0]);
+            h *= m;
+    }
+
+    h ^= h >> r;
+    h *= m;
+    h ^= h >> r;
+    // Zero means "no hash" in the unit header.
+    return h ? h : 1;
+}
+
 
 CompilationUnit::CompilationUnit(const Unit *unitData, const QString &fileName, const QString &finalUrlString)
 {
@@ -129,15 +167,37 @@ CompilationUnit::~CompilationUnit()
 }
 #ifndef V4_BOOTSTRAP
 
-QString CompilationUnit::localCacheFilePath(const QUrl &url)
+static QString cacheFileName(const QUrl &url, quint64 sourceHash)
 {
     const QString localSourcePath = QQmlFile::urlToLocalFileOrQrc(url);
     const QString cacheFileSuffix = QFileInfo(localSourcePath + QLatin1Char('c')).completeSuffix();
     QCryptographicHash fileNameHash(QCryptographicHash::Sha1);
     fileNameHash.addData(localSourcePath.toUtf8());
+    QString fileName = QString::fromUtf8(fileNameHash.result().toHex());
+    // Content addressed cache files can coexist for different revisions of the same source file.
+    if (sourceHash)
+        fileName += QLatin1Char('-') + QString::number(sourceHash, 16);
+    return fileName + QLatin1Char('.') + cacheFileSuffix;
+}
+
+QString CompilationUnit::localCacheFilePath(const QUrl &url, quint64 sourceHash)
+{
     QString directory = QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + QLatin1String("/qmlcache/");
     QDir::root().mkpath(directory);
-    return directory + QString::fromUtf8(fileNameHash.result().toHex()) + QLatin1Char('.') + cacheFileSuffix;
+    return directory + cacheFileName(url, sourceHash);
+}
+
+QString CompilationUnit::sharedCacheFilePath(const QUrl &url, quint64 sourceHash)
+{
+    // The shared directory is populated ahead of time (for example by copying the local cache of a
+    // build machine) and is never written to at run-time, so it can live on a read-only file system.
+    // Only content addressed cache files are looked up there, as time stamps do not survive copying.
+    if (!sourceHash)
+        return QString();
+    const QString directory = qEnvironmentVariable("QML_DISK_CACHE_SHARED_PATH");
+    if (directory.isEmpty())
+        return QString();
+    return QDir(directory).filePath(cacheFileName(url, sourceHash));
 }
 
 QV4::Function *CompilationUnit::linkToEngine(ExecutionEngine *engine)
@@ -285,10 +345,10 @@ void CompilationUnit::unlink()
     if (runtimeLookups) {
         for (uint i = 0; i < data->lookupTableSize; ++i) {
             QV4::Lookup &l = runtimeLookups[i];
-            if (l.getter == QV4::QObjectWrapper::lookupGetter) {
+            if (l.getter == QV4::QObjectWrapper::lookupGetter || l.setter == QV4::QObjectWrapper::lookupSetter) {
                 if (QQmlPropertyCache *pc = l.qobjectLookup.propertyCache)
                     pc->release();
-            } else if (l.getter == QQmlValueTypeWrapper::lookupGetter) {
+            } else if (l.getter == QQmlValueTypeWrapper::lookupGetter || l.setter == QQmlValueTypeWrapper::lookupSetter) {
                 if (QQmlPropertyCache *pc = l.qgadgetLookup.propertyCache)
                     pc->release();
             }
@@ -297,6 +357,8 @@ void CompilationUnit::unlink()
                 if (QQmlPropertyCache *pc = l.qobjectLookup.propertyCache)
                     pc->release();
             }
+
+            l.releasePolymorphicCache();
         }
     }
 
@@ -645,7 +707,8 @@ void CompilationUnit::evaluateModuleRequests()
     }
 }
 
-bool CompilationUnit::loadFromDisk(const QUrl &url, const QDateTime &sourceTimeStamp, QString *errorString)
+bool CompilationUnit::loadFromDisk(const QUrl &url, const QDateTime &sourceTimeStamp, QString *errorString,
+                                   quint64 sourceHash)
 {
     if (!QQmlFile::isLocalFile(url)) {
         *errorString = QStringLiteral("File has to be a local file.");
@@ -653,28 +716,50 @@ bool CompilationUnit::loadFromDisk(const QUrl &url, const QDateTime &sourceTimeS
     }
 
     const QString sourcePath = QQmlFile::urlToLocalFileOrQrc(url);
-    QScopedPointer<CompilationUnitMapper> cacheFile(new CompilationUnitMapper());
-
-    const QStringList cachePaths = { sourcePath + QLatin1Char('c'), localCacheFilePath(url) };
-    for (const QString &cachePath : cachePaths) {
-        CompiledData::Unit *mappedUnit = cacheFile->open(cachePath, sourceTimeStamp, errorString);
-        if (!mappedUnit)
-            continue;
 
+    auto adoptUnit = [this, &sourcePath, errorString](const Unit *unit) {
         const Unit * const oldDataPtr = (data && !(data->flags & QV4::CompiledData::Unit::StaticData)) ? data : nullptr;
         const Unit *oldData = data;
         auto dataPtrRevert = qScopeGuard([this, oldData](){
             setUnitData(oldData);
         });
-        setUnitData(mappedUnit);
+        setUnitData(unit);
 
         if (data->sourceFileIndex != 0 && sourcePath != QQmlFile::urlToLocalFileOrQrc(stringAt(data->sourceFileIndex))) {
             *errorString = QStringLiteral("QML source file has moved to a different location.");
-            continue;
+            return false;
         }
 
         dataPtrRevert.dismiss();
         free(const_cast<Unit*>(oldDataPtr));
+        return true;
+    };
+
+    // The bundle is mapped once for the whole process, so this does not touch the file system.
+    // Stale entries are skipped, and the individual cache files below are used instead.
+    if (const CompilationUnitBundle *bundle = CompilationUnitBundle::global()) {
+        const Unit *bundledUnit = bundle->unit(sourcePath);
+        if (bundledUnit && bundledUnit->verifyHeader(sourceTimeStamp, errorString, sourceHash) && adoptUnit(bundledUnit)) {
+            backingFile.reset();
+            return true;
+        }
+    }
+
+    QScopedPointer<CompilationUnitMapper> cacheFile(new CompilationUnitMapper());
+
+    QStringList cachePaths = { sourcePath + QLatin1Char('c') };
+    const QString sharedCachePath = sharedCacheFilePath(url, sourceHash);
+    if (!sharedCachePath.isEmpty())
+        cachePaths << sharedCachePath;
+    cachePaths << localCacheFilePath(url, sourceHash);
+    for (const QString &cachePath : cachePaths) {
+        CompiledData::Unit *mappedUnit = cacheFile->open(cachePath, sourceTimeStamp, errorString, sourceHash);
+        if (!mappedUnit)
+            continue;
+
+        if (!adoptUnit(mappedUnit))
+            continue;
+
         backingFile.reset(cacheFile.take());
         return true;
     }
@@ -693,7 +778,7 @@ bool CompilationUnit::saveToDisk(const QUrl &unitUrl, QString *errorString)
     errorString->clear();
 
 #if !defined(V4_BOOTSTRAP)
-    if (data->sourceTimeStamp == 0) {
+    if (data->sourceTimeStamp == 0 && data->sourceHash == 0) {
         *errorString = QStringLiteral("Missing time stamp for source file");
         return false;
     }
@@ -702,7 +787,7 @@ bool CompilationUnit::saveToDisk(const QUrl &unitUrl, QString *errorString)
         *errorString = QStringLiteral("File has to be a local file.");
         return false;
     }
-    const QString outputFileName = localCacheFilePath(unitUrl);
+    const QString outputFileName = localCacheFilePath(unitUrl, data->sourceHash);
 #endif
 
 #if QT_CONFIG(temporaryfile)
@@ -966,7 +1051,7 @@ void Unit::generateChecksum()
 #endif
 }
 
-bool Unit::verifyHeader(QDateTime expectedSourceTimeStamp, QString *errorString) const
+bool Unit::verifyHeader(QDateTime expectedSourceTimeStamp, QString *errorString, quint64 expectedSourceHash) const
 {
 #ifndef V4_BOOTSTRAP
     if (strncmp(magic, CompiledData::magic_str, sizeof(magic))) {
@@ -984,7 +1069,14 @@ bool Unit::verifyHeader(QDateTime expectedSourceTimeStamp, QString *errorString)
         return false;
     }
 
-    if (sourceTimeStamp) {
+    if (expectedSourceHash) {
+        // Content based validation is immune to time stamps changing through checkouts, copies
+        // or deployment, so it replaces the time stamp check entirely.
+        if (sourceHash != expectedSourceHash) {
+            *errorString = QStringLiteral("QML source file has a different content hash than cached file.");
+            return false;
+        }
+    } else if (sourceTimeStamp) {
         // Files from the resource system do not have any time stamps, so fall back to the application
         // executable.
         if (!expectedSourceTimeStamp.isValid())
@@ -1009,6 +1101,7 @@ bool Unit::verifyHeader(QDateTime expectedSourceTimeStamp, QString *errorString)
 #else
     Q_UNUSED(expectedSourceTimeStamp)
     Q_UNUSED(errorString)
+    Q_UNUSED(expectedSourceHash)
     return false;
 #endif
 }
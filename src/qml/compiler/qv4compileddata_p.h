@@ -73,7 +73,7 @@
 QT_BEGIN_NAMESPACE
 
 // Bump this whenever the compiler data structures change in an incompatible way.
-#define QV4_DATA_STRUCTURE_VERSION 0x20
+#define QV4_DATA_STRUCTURE_VERSION 0x21
 
 class QIODevice;
 class QQmlPropertyCache;
@@ -821,6 +821,10 @@ enum { QmlCompileHashSpace = 48 };
 static const char magic_str[] = "qv4cdata";
 extern const char qml_compile_hash[QmlCompileHashSpace + 1];
 
+// A fast hash of the raw bytes of a source file, used to validate cache files by content
+// instead of by time stamp. Never returns 0, which stands for an unknown hash.
+Q_QML_PRIVATE_EXPORT quint64 computeSourceHash(const char *data, qsizetype size);
+
 struct Unit
 {
     // DO NOT CHANGE THESE FIELDS EVER
@@ -883,7 +887,9 @@ struct Unit
 
     quint32_le offsetToQmlUnit;
 
-    bool verifyHeader(QDateTime expectedSourceTimeStamp, QString *errorString) const;
+    quint64_le sourceHash; // computeSourceHash() of the source code, or 0 if unknown.
+
+    bool verifyHeader(QDateTime expectedSourceTimeStamp, QString *errorString, quint64 expectedSourceHash = 0) const;
 
     /* QML specific fields */
 
@@ -978,7 +984,7 @@ struct Unit
     const quint32_le *moduleRequestTable() const { return reinterpret_cast<const quint32_le*>((reinterpret_cast<const char *>(this)) + offsetToModuleRequestTable); }
 };
 
-static_assert(sizeof(Unit) == 248, "Unit structure needs to have the expected size to be binary compatible on disk when generated by host compiler and loaded by target");
+static_assert(sizeof(Unit) == 256, "Unit structure needs to have the expected size to be binary compatible on disk when generated by host compiler and loaded by target");
 
 struct TypeReference
 {
@@ -1211,9 +1217,11 @@ public:
 
     void markObjects(MarkStack *markStack);
 
-    bool loadFromDisk(const QUrl &url, const QDateTime &sourceTimeStamp, QString *errorString);
+    bool loadFromDisk(const QUrl &url, const QDateTime &sourceTimeStamp, QString *errorString,
+                      quint64 sourceHash = 0);
 
-    static QString localCacheFilePath(const QUrl &url);
+    static QString localCacheFilePath(const QUrl &url, quint64 sourceHash = 0);
+    static QString sharedCacheFilePath(const QUrl &url, quint64 sourceHash = 0);
 
 protected:
     quint32 totalStringCount() const
@@ -686,6 +686,7 @@ QV4::CompiledData::Unit QV4::Compiler::JSUnitGenerator::generateHeader(QV4::Comp
     unit.sourceFileIndex = getStringId(module->fileName);
     unit.finalUrlIndex = getStringId(module->finalUrl);
     unit.sourceTimeStamp = module->sourceTimeStamp.isValid() ? module->sourceTimeStamp.toMSecsSinceEpoch() : 0;
+    unit.sourceHash = module->sourceHash;
     unit.offsetToQmlUnit = 0;
 
     unit.unitSize = nextOffset;
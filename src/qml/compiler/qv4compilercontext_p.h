@@ -146,6 +146,7 @@ struct Module {
     QString fileName;
     QString finalUrl;
     QDateTime sourceTimeStamp;
+    quint64 sourceHash = 0;
     uint unitFlags = 0; // flags merged into CompiledData::Unit::flags
     bool debugMode = false;
     QVector<ExportEntry> localExportEntries;
@@ -4,11 +4,13 @@ INCLUDEPATH += $$OUT_PWD
 SOURCES += \
     $$PWD/qv4jithelpers.cpp \
     $$PWD/qv4baselinejit.cpp \
+    $$PWD/qv4backgroundjit.cpp \
     $$PWD/qv4baselineassembler.cpp \
     $$PWD/qv4assemblercommon.cpp
 
 HEADERS += \
     $$PWD/qv4jithelpers_p.h \
     $$PWD/qv4baselinejit_p.h \
+    $$PWD/qv4backgroundjit_p.h \
     $$PWD/qv4baselineassembler_p.h \
     $$PWD/qv4assemblercommon_p.h
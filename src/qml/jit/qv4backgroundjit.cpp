@@ -0,0 +1,172 @@
+/****************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtQml module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qv4backgroundjit_p.h"
+#include "qv4baselinejit_p.h"
+#include <private/qv4function_p.h>
+#include <private/qqmlrefcount_p.h>
+
+#include <QtCore/qrunnable.h>
+#include <QtCore/qthread.h>
+#include <QtCore/qthreadpool.h>
+
+#ifdef V4_ENABLE_JIT
+
+QT_BEGIN_NAMESPACE
+
+using namespace QV4;
+using namespace QV4::JIT;
+
+namespace {
+// All engines share a single compiler thread.
+struct CompilerThreadPool : public QThreadPool
+{
+    CompilerThreadPool() { setMaxThreadCount(1); }
+};
+}
+
+Q_GLOBAL_STATIC(CompilerThreadPool, compilerThreadPool)
+
+class BackgroundJIT::Job : public QRunnable
+{
+public:
+    Job(BackgroundJIT *owner, Function *function)
+        : owner(owner)
+        , function(function)
+        , compilationUnit(function->compilationUnit)
+        , jit(new BaselineJIT(function))
+    {
+        setAutoDelete(false);
+    }
+
+    void run() override
+    {
+        jit->compile();
+        owner->jobFinished(this);
+    }
+
+    BackgroundJIT *owner;
+    Function *function;
+    // Keeps the function alive until the job has been published or discarded. The reference
+    // is only ever dropped on the engine thread.
+    QQmlRefPointer<CompiledData::CompilationUnit> compilationUnit;
+    QScopedPointer<BaselineJIT> jit;
+};
+
+BackgroundJIT::BackgroundJIT()
+{
+}
+
+BackgroundJIT::~BackgroundJIT()
+{
+    QMutexLocker locker(&mutex);
+    for (auto it = pendingJobs.begin(); it != pendingJobs.end();) {
+        if (compilerThreadPool()->tryTake(*it)) {
+            delete *it;
+            it = pendingJobs.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    while (!pendingJobs.isEmpty())
+        jobsDone.wait(&mutex);
+    qDeleteAll(finishedJobs);
+}
+
+bool BackgroundJIT::isEnabled()
+{
+    static const bool enabled = QThread::idealThreadCount() > 1
+            && !qEnvironmentVariableIsSet("QV4_JIT_SYNCHRONOUS");
+    return enabled;
+}
+
+void BackgroundJIT::enqueue(Function *function)
+{
+    if (function->jitQueued)
+        return;
+    function->jitQueued = true;
+
+    Job *job = new Job(this, function);
+    {
+        QMutexLocker locker(&mutex);
+        pendingJobs.append(job);
+    }
+    compilerThreadPool()->start(job);
+}
+
+void BackgroundJIT::finishPendingJobs()
+{
+    {
+        QMutexLocker locker(&mutex);
+        while (!pendingJobs.isEmpty())
+            jobsDone.wait(&mutex);
+    }
+    publishCompiledFunctions();
+}
+
+// Called on the compiler thread.
+void BackgroundJIT::jobFinished(Job *job)
+{
+    QMutexLocker locker(&mutex);
+    pendingJobs.removeOne(job);
+    finishedJobs.append(job);
+    hasFinishedJobs.storeRelease(1);
+    jobsDone.wakeAll();
+}
+
+void BackgroundJIT::publishFinishedJobs()
+{
+    QVector<Job *> jobs;
+    {
+        QMutexLocker locker(&mutex);
+        jobs.swap(finishedJobs);
+        hasFinishedJobs.storeRelease(0);
+    }
+
+    for (Job *job : qAsConst(jobs)) {
+        // The function may have been compiled synchronously in the meantime.
+        if (!job->function->jittedCode)
+            job->jit->link();
+        delete job;
+    }
+}
+
+QT_END_NAMESPACE
+
+#endif // V4_ENABLE_JIT
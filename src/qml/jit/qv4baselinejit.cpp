@@ -42,6 +42,7 @@
 #include "qv4baselineassembler_p.h"
 #include <private/qv4lookup_p.h>
 #include <private/qv4generatorobject_p.h>
+#include <private/qv4mm_p.h>
 
 #ifdef V4_ENABLE_JIT
 
@@ -53,12 +54,21 @@ using namespace QV4::Moth;
 BaselineJIT::BaselineJIT(Function *function)
     : function(function)
     , as(new BaselineAssembler(function->compilationUnit->constants))
+    , writeBarrierRequired(function->internalClass->engine->memoryManager->writeBarrierRequired())
 {}
 
 BaselineJIT::~BaselineJIT()
 {}
 
 void BaselineJIT::generate()
+{
+    compile();
+    link();
+}
+
+// Generates the machine code into the assembler buffer. This only reads the (immutable)
+// byte code and constants of the function, so it can run on a background thread.
+void BaselineJIT::compile()
 {
 //    qDebug()<<"jitting" << function->name()->toQString();
     const char *code = function->codeData;
@@ -68,9 +78,15 @@ void BaselineJIT::generate()
     as->generatePrologue();
     decode(code, len);
     as->generateEpilogue();
+//    qDebug()<<"done";
+}
 
+// Copies the generated code into executable memory and publishes it in the function. This
+// has to happen on the thread owning the engine, as changing the protection of the executable
+// pages would otherwise race with code running from those pages.
+void BaselineJIT::link()
+{
     as->link(function);
-//    qDebug()<<"done";
 }
 
 #define STORE_IP() as->storeInstructionPointer(nextInstructionOffset())
@@ -157,7 +173,10 @@ void BaselineJIT::generate_LoadLocal(int index)
 void BaselineJIT::generate_StoreLocal(int index)
 {
     as->checkException();
-    as->storeLocal(index);
+    if (needsWriteBarrier())
+        generateStoreLocalWithBarrier(0, index);
+    else
+        as->storeLocal(index);
 }
 
 void BaselineJIT::generate_LoadScopedLocal(int scope, int index)
@@ -168,7 +187,29 @@ void BaselineJIT::generate_LoadScopedLocal(int scope, int index)
 void BaselineJIT::generate_StoreScopedLocal(int scope, int index)
 {
     as->checkException();
-    as->storeLocal(index, scope);
+    if (needsWriteBarrier())
+        generateStoreLocalWithBarrier(scope, index);
+    else
+        as->storeLocal(index, scope);
+}
+
+bool BaselineJIT::needsWriteBarrier() const
+{
+    // With incremental or generational garbage collection, stores into the context need
+    // to go through the write barrier. Otherwise they can be written inline.
+    return writeBarrierRequired;
+}
+
+void BaselineJIT::generateStoreLocalWithBarrier(int scope, int index)
+{
+    STORE_ACC();
+    as->prepareCallWithArgCount(5);
+    as->passAccumulatorAsArg(4);
+    as->passInt32AsArg(index, 3);
+    as->passInt32AsArg(scope, 2);
+    as->passJSSlotAsArg(0, 1);
+    as->passEngineAsArg(0);
+    BASELINEJIT_GENERATE_RUNTIME_CALL(Helpers::storeLocal, CallResultDestination::InAccumulator);
 }
 
 void BaselineJIT::generate_LoadRuntimeString(int stringId)
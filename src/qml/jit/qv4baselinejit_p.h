@@ -73,6 +73,8 @@ public:
     virtual ~BaselineJIT() Q_DECL_OVERRIDE;
 
     void generate();
+    void compile();
+    void link();
 
     void generate_Ret() override;
     void generate_Debug() override;
@@ -217,9 +219,13 @@ protected:
     { return nextInstructionOffset() + relativeOffset; }
 
 private:
+    bool needsWriteBarrier() const;
+    void generateStoreLocalWithBarrier(int scope, int index);
+
     QV4::Function *function;
     QScopedPointer<BaselineAssembler> as;
     std::vector<int> labels;
+    bool writeBarrierRequired;
 };
 #endif // V4_ENABLE_JIT
 
@@ -166,6 +166,16 @@ void throwOnNullOrUndefined(ExecutionEngine *engine, const Value &v)
         engine->throwTypeError();
 }
 
+ReturnedValue storeLocal(ExecutionEngine *engine, Value *stack, int scope, int index, const Value &value)
+{
+    Heap::ExecutionContext *ctx = static_cast<Heap::ExecutionContext *>(stack[CallData::Context].m());
+    while (scope--)
+        ctx = ctx->outer;
+    Heap::CallContext *cc = static_cast<Heap::CallContext *>(ctx);
+    WriteBarrier::write(engine, cc, cc->locals.values[index].data_ptr(), value.asReturnedValue());
+    return value.asReturnedValue();
+}
+
 } // Helpers namespace
 } // JIT namespace
 } // QV4 namespace
@@ -79,6 +79,7 @@ void popScriptContext(Value *stack, ExecutionEngine *engine);
 ReturnedValue deleteProperty(QV4::Function *function, const QV4::Value &base, const QV4::Value &index);
 ReturnedValue deleteName(Function *function, int name);
 void throwOnNullOrUndefined(ExecutionEngine *engine, const Value &v);
+ReturnedValue storeLocal(ExecutionEngine *engine, Value *stack, int scope, int index, const Value &value);
 
 } // Helpers namespace
 } // JIT namespace
@@ -41,8 +41,43 @@
 #include "qv4atomics_p.h"
 #include "qv4symbol_p.h"
 
+#include <QtCore/qcoreapplication.h>
+#include <QtCore/qdeadlinetimer.h>
+#include <QtCore/qmutex.h>
+#include <QtCore/qnumeric.h>
+#include <QtCore/qset.h>
+#include <QtCore/qthread.h>
+#include <QtCore/qwaitcondition.h>
+
+#include <limits>
+
 using namespace QV4;
 
+namespace {
+
+// Agents blocked in Atomics.wait(). A SharedArrayBuffer can be referenced from
+// several engines living in different threads, so the list is process wide and
+// keyed by the address of the element waited on.
+struct AtomicsWaiter
+{
+    const char *address;
+    QThread *thread;
+    QWaitCondition condition;
+    bool notified = false;
+};
+
+struct AtomicsWaiterList
+{
+    QMutex mutex;
+    QList<AtomicsWaiter *> waiters;
+    // Threads that are being shut down, see Atomics::interruptWaiters()
+    QSet<QThread *> interruptedThreads;
+};
+
+}
+
+Q_GLOBAL_STATIC(AtomicsWaiterList, atomicsWaiters)
+
 DEFINE_OBJECT_VTABLE(Atomics);
 
 void Heap::Atomics::init()
@@ -57,6 +92,7 @@ void Heap::Atomics::init()
     m->defineDefaultProperty(QStringLiteral("exchange"), QV4::Atomics::method_exchange, 3);
     m->defineDefaultProperty(QStringLiteral("isLockFree"), QV4::Atomics::method_isLockFree, 1);
     m->defineDefaultProperty(QStringLiteral("load"), QV4::Atomics::method_load, 2);
+    m->defineDefaultProperty(QStringLiteral("notify"), QV4::Atomics::method_wake, 3);
     m->defineDefaultProperty(QStringLiteral("or"), QV4::Atomics::method_or, 3);
     m->defineDefaultProperty(QStringLiteral("store"), QV4::Atomics::method_store, 3);
     m->defineDefaultProperty(QStringLiteral("sub"), QV4::Atomics::method_sub, 3);
@@ -240,14 +276,143 @@ ReturnedValue Atomics::method_sub(const FunctionObject *f, const Value *, const
     return atomicReadModifyWrite(f, argv, argc, AtomicSub);
 }
 
-ReturnedValue Atomics::method_wait(const FunctionObject *f, const Value *, const Value *, int)
+ReturnedValue Atomics::method_wait(const FunctionObject *f, const Value *, const Value *argv, int argc)
 {
-    return f->engine()->throwTypeError();
+    Scope scope(f);
+    if (!argc)
+        return scope.engine->throwTypeError();
+
+    SharedArrayBuffer *buffer = validateSharedIntegerTypedArray(scope, argv[0], true);
+    if (!buffer)
+        return Encode::undefined();
+    const TypedArray &a = static_cast<const TypedArray &>(argv[0]);
+    int index = validateAtomicAccess(scope, a, argc > 1 ? argv[1] : Value::undefinedValue());
+    if (index < 0)
+        return Encode::undefined();
+
+    qint32 value = (argc > 2 ? argv[2] : Value::undefinedValue()).toInt32();
+    if (scope.hasException())
+        return Encode::undefined();
+
+    double timeout = argc > 3 && !argv[3].isUndefined() ? argv[3].toNumber() : qInf();
+    if (scope.hasException())
+        return Encode::undefined();
+    if (qIsNaN(timeout))
+        timeout = qInf();
+    timeout = qMax(timeout, 0.);
+
+    // Blocking the GUI thread would freeze the application
+    if (QCoreApplication::instance() && QThread::currentThread() == QCoreApplication::instance()->thread())
+        return scope.engine->throwTypeError(QStringLiteral("Atomics.wait() cannot be called in the main thread"));
+
+    const char *address = buffer->data() + a.d()->byteOffset + index * sizeof(qint32);
+    // Anything longer than QDeadlineTimer can represent is as good as forever
+    const double maximumTimeout = double(std::numeric_limits<qint64>::max() / (1000 * 1000));
+    QDeadlineTimer deadline(QDeadlineTimer::Forever);
+    if (timeout < maximumTimeout)
+        deadline.setRemainingTime(qint64(timeout));
+
+    AtomicsWaiterList *list = atomicsWaiters();
+    QMutexLocker locker(&list->mutex);
+
+    QThread *thread = QThread::currentThread();
+    if (list->interruptedThreads.contains(thread))
+        return scope.engine->throwError(QStringLiteral("Atomics.wait() was interrupted"));
+
+    // Compare under the lock, so that a store followed by notify() on another thread
+    // either makes us return "not-equal" or finds us in the list.
+    if (reinterpret_cast<const QAtomicInt *>(address)->loadAcquire() != value)
+        return Encode(scope.engine->newString(QStringLiteral("not-equal")));
+
+    AtomicsWaiter waiter;
+    waiter.address = address;
+    waiter.thread = thread;
+    list->waiters.append(&waiter);
+
+    while (!waiter.notified && !list->interruptedThreads.contains(thread)) {
+        if (!waiter.condition.wait(&list->mutex, deadline))
+            break;
+    }
+
+    if (!waiter.notified) {
+        list->waiters.removeOne(&waiter);
+        if (list->interruptedThreads.contains(thread))
+            return scope.engine->throwError(QStringLiteral("Atomics.wait() was interrupted"));
+        return Encode(scope.engine->newString(QStringLiteral("timed-out")));
+    }
+    return Encode(scope.engine->newString(QStringLiteral("ok")));
+}
+
+ReturnedValue Atomics::method_wake(const FunctionObject *f, const Value *, const Value *argv, int argc)
+{
+    Scope scope(f);
+    if (!argc)
+        return scope.engine->throwTypeError();
+
+    SharedArrayBuffer *buffer = validateSharedIntegerTypedArray(scope, argv[0], true);
+    if (!buffer)
+        return Encode::undefined();
+    const TypedArray &a = static_cast<const TypedArray &>(argv[0]);
+    int index = validateAtomicAccess(scope, a, argc > 1 ? argv[1] : Value::undefinedValue());
+    if (index < 0)
+        return Encode::undefined();
+
+    double count = argc > 2 && !argv[2].isUndefined() ? argv[2].toInteger() : qInf();
+    if (scope.hasException())
+        return Encode::undefined();
+    count = qMax(count, 0.);
+
+    const char *address = buffer->data() + a.d()->byteOffset + index * sizeof(qint32);
+
+    AtomicsWaiterList *list = atomicsWaiters();
+    QMutexLocker locker(&list->mutex);
+
+    // Waiters are woken in the order they started waiting
+    int woken = 0;
+    for (auto it = list->waiters.begin(); it != list->waiters.end() && woken < count;) {
+        AtomicsWaiter *waiter = *it;
+        if (waiter->address != address) {
+            ++it;
+            continue;
+        }
+        waiter->notified = true;
+        waiter->condition.wakeOne();
+        it = list->waiters.erase(it);
+        ++woken;
+    }
+
+    return Encode(woken);
 }
 
-ReturnedValue Atomics::method_wake(const FunctionObject *f, const Value *, const Value *, int)
+/*!
+    \internal
+
+    Wakes up the agents of \a thread that are blocked in Atomics.wait(), and
+    makes any further wait on that thread throw right away, until
+    resetInterrupt() is called. This allows stopping a thread whose script
+    waits for a notification that never comes.
+*/
+void Atomics::interruptWaiters(QThread *thread)
+{
+    AtomicsWaiterList *list = atomicsWaiters();
+    QMutexLocker locker(&list->mutex);
+    list->interruptedThreads.insert(thread);
+    for (AtomicsWaiter *waiter : qAsConst(list->waiters)) {
+        if (waiter->thread == thread)
+            waiter->condition.wakeOne();
+    }
+}
+
+/*!
+    \internal
+
+    Allows agents of \a thread to wait again after interruptWaiters().
+*/
+void Atomics::resetInterrupt(QThread *thread)
 {
-    return f->engine()->throwTypeError();
+    AtomicsWaiterList *list = atomicsWaiters();
+    QMutexLocker locker(&list->mutex);
+    list->interruptedThreads.remove(thread);
 }
 
 ReturnedValue Atomics::method_xor(const FunctionObject *f, const Value *, const Value *argv, int argc)
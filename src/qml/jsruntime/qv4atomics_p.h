@@ -55,6 +55,8 @@
 
 QT_BEGIN_NAMESPACE
 
+class QThread;
+
 namespace QV4 {
 
 namespace Heap {
@@ -81,6 +83,9 @@ struct Atomics : Object
     static ReturnedValue method_wait(const FunctionObject *, const Value *thisObject, const Value *argv, int argc);
     static ReturnedValue method_wake(const FunctionObject *, const Value *thisObject, const Value *argv, int argc);
     static ReturnedValue method_xor(const FunctionObject *, const Value *thisObject, const Value *argv, int argc);
+
+    static void interruptWaiters(QThread *thread);
+    static void resetInterrupt(QThread *thread);
 };
 
 
@@ -47,6 +47,7 @@
 #include <private/qv4codegen_p.h>
 
 #include <QtCore/QTextStream>
+#include <QtCore/qloggingcategory.h>
 #include <QDateTime>
 #include <QDir>
 #include <QFileInfo>
@@ -77,6 +78,8 @@
 #include <qv4variantobject_p.h>
 #include <qv4runtime_p.h>
 #include <private/qv4mm_p.h>
+#include <private/qv4backgroundjit_p.h>
+#include <private/qv4lookup_p.h>
 #include <qv4argumentsobject_p.h>
 #include <qv4dateobject_p.h>
 #include <qv4jsonobject_p.h>
@@ -138,6 +141,8 @@ using namespace QV4;
 
 #ifndef V4_BOOTSTRAP
 
+Q_LOGGING_CATEGORY(lcLookupStats, "qt.qml.lookup.statistics")
+
 static QBasicAtomicInt engineSerial = Q_BASIC_ATOMIC_INITIALIZER(1);
 
 ReturnedValue throwTypeError(const FunctionObject *b, const QV4::Value *, const QV4::Value *, int)
@@ -164,6 +169,7 @@ ExecutionEngine::ExecutionEngine(QJSEngine *jsEngine)
 #endif
 {
     memoryManager = new QV4::MemoryManager(this);
+    megamorphicLookupCache = new MegamorphicLookupCache;
 
     if (maxCallDepth == -1) {
         bool ok = false;
@@ -205,6 +211,12 @@ ExecutionEngine::ExecutionEngine(QJSEngine *jsEngine)
             jitCallCountThreshold = std::numeric_limits<int>::max();
     }
 
+#if defined(V4_ENABLE_JIT) && !defined(V4_BOOTSTRAP)
+    // A threshold of 0 asks for JIT code on the first call, which needs synchronous compilation.
+    if (m_canAllocateExecutableMemory && jitCallCountThreshold > 0 && JIT::BackgroundJIT::isEnabled())
+        backgroundJIT = new JIT::BackgroundJIT;
+#endif
+
     exceptionValue = jsAlloca(1);
     *exceptionValue = Encode::undefined();
     globalObject = static_cast<Object *>(jsAlloca(1));
@@ -652,6 +664,17 @@ ExecutionEngine::ExecutionEngine(QJSEngine *jsEngine)
 
 ExecutionEngine::~ExecutionEngine()
 {
+    if (lcLookupStats().isDebugEnabled()) {
+        qCDebug(lcLookupStats) << "Polymorphic lookups:" << lookupStatistics.polymorphicHits << "hits,"
+                               << lookupStatistics.polymorphicMisses << "misses";
+        qCDebug(lcLookupStats) << "Megamorphic lookups:" << lookupStatistics.megamorphicHits << "hits,"
+                               << lookupStatistics.megamorphicMisses << "misses";
+        qCDebug(lcLookupStats) << "Lookup transitions:" << lookupStatistics.transitions;
+    }
+
+#if defined(V4_ENABLE_JIT) && !defined(V4_BOOTSTRAP)
+    delete backgroundJIT;
+#endif
     modules.clear();
     delete m_multiplyWrappedQObjects;
     m_multiplyWrappedQObjects = nullptr;
@@ -663,6 +686,7 @@ ExecutionEngine::~ExecutionEngine()
 
     delete bumperPointerAllocator;
     delete regExpCache;
+    delete megamorphicLookupCache;
     delete regExpAllocator;
     delete executableAllocator;
     jsStack->deallocate();
@@ -1777,7 +1801,8 @@ QQmlRefPointer<CompiledData::CompilationUnit> ExecutionEngine::compileModule(con
 #endif // ifndef V4_BOOTSTRAP
 
 QQmlRefPointer<CompiledData::CompilationUnit> ExecutionEngine::compileModule(bool debugMode, const QString &url, const QString &sourceCode,
-                                                                             const QDateTime &sourceTimeStamp, QList<QQmlJS::DiagnosticMessage> *diagnostics)
+                                                                             const QDateTime &sourceTimeStamp, QList<QQmlJS::DiagnosticMessage> *diagnostics,
+                                                                             quint64 sourceHash)
 {
     QQmlJS::Engine ee;
     QQmlJS::Lexer lexer(&ee);
@@ -1805,6 +1830,7 @@ QQmlRefPointer<CompiledData::CompilationUnit> ExecutionEngine::compileModule(boo
     Compiler::Module compilerModule(debugMode);
     compilerModule.unitFlags |= CompiledData::Unit::IsESModule;
     compilerModule.sourceTimeStamp = sourceTimeStamp;
+    compilerModule.sourceHash = sourceHash;
     JSUnitGenerator jsGenerator(&compilerModule);
     Codegen cg(&jsGenerator, /*strictMode*/true);
     cg.generateFromModule(url, url, sourceCode, moduleNode, &compilerModule);
@@ -87,12 +87,16 @@ class Profiler;
 namespace CompiledData {
 struct CompilationUnit;
 }
+namespace JIT {
+class BackgroundJIT;
+}
 
 namespace Heap {
 struct Module;
 };
 
 struct Function;
+struct MegamorphicLookupCache;
 
 namespace Promise {
 class ReactionHandler;
@@ -109,6 +113,7 @@ private:
 public:
     ExecutableAllocator *executableAllocator;
     ExecutableAllocator *regExpAllocator;
+    JIT::BackgroundJIT *backgroundJIT = nullptr;
 
     WTF::BumpPointerAllocator *bumperPointerAllocator; // Used by Yarr Regex engine.
 
@@ -470,6 +475,15 @@ public:
 
     quintptr protoIdCount = 1;
 
+    MegamorphicLookupCache *megamorphicLookupCache;
+    struct LookupStatistics {
+        quint64 polymorphicHits = 0;
+        quint64 polymorphicMisses = 0;
+        quint64 megamorphicHits = 0;
+        quint64 megamorphicMisses = 0;
+        quint64 transitions = 0; // to the polymorphic and megamorphic states
+    } lookupStatistics;
+
     ExecutionEngine(QJSEngine *jsEngine = nullptr);
     ~ExecutionEngine();
 
@@ -608,7 +622,7 @@ public:
 
     double localTZA = 0.0; // local timezone, initialized at startup
 
-    static QQmlRefPointer<CompiledData::CompilationUnit> compileModule(bool debugMode, const QString &url, const QString &sourceCode, const QDateTime &sourceTimeStamp, QList<QQmlJS::DiagnosticMessage> *diagnostics);
+    static QQmlRefPointer<CompiledData::CompilationUnit> compileModule(bool debugMode, const QString &url, const QString &sourceCode, const QDateTime &sourceTimeStamp, QList<QQmlJS::DiagnosticMessage> *diagnostics, quint64 sourceHash = 0);
 #ifndef V4_BOOTSTRAP
     QQmlRefPointer<CompiledData::CompilationUnit> compileModule(const QUrl &url);
     QQmlRefPointer<CompiledData::CompilationUnit> compileModule(const QUrl &url, const QString &sourceCode, const QDateTime &sourceTimeStamp);
@@ -81,6 +81,7 @@ struct Q_QML_EXPORT Function {
     uint nFormals;
     int interpreterCallCount = 0;
     bool isEval = false;
+    bool jitQueued = false; // handed to the background JIT, see JIT::BackgroundJIT
 
     Function(ExecutionEngine *engine, CompiledData::CompilationUnit *unit, const CompiledData::Function *function);
     ~Function();
@@ -49,7 +49,11 @@
 #include "qv4jscall_p.h"
 #include <qv4symbol_p.h>
 
-#include <qstack.h>
+#include <private/qsimd_p.h>
+#include <private/qutfcodec_p.h>
+
+#include <qiodevice.h>
+#include <qset.h>
 #include <qstringlist.h>
 
 #include <wtf/MathExtras.h>
@@ -73,9 +77,20 @@ DEFINE_OBJECT_VTABLE(JsonObject);
 
 static const int nestingLimit = 1024;
 
+static inline uint unit(QChar c)
+{
+    return c.unicode();
+}
 
-JsonParser::JsonParser(ExecutionEngine *engine, const QChar *json, int length)
-    : engine(engine), head(json), json(json), nestingLevel(0), lastError(QJsonParseError::NoError)
+static inline uint unit(char c)
+{
+    return uchar(c);
+}
+
+template <typename CharType>
+BasicJsonParser<CharType>::BasicJsonParser(ExecutionEngine *engine, const CharType *json, int length)
+    : engine(engine), head(json), json(json), nestingLevel(0), lastError(QJsonParseError::NoError),
+      shapeRoots(nullptr)
 {
     end = json + length;
 }
@@ -122,27 +137,72 @@ enum {
     Quote = 0x22
 };
 
-bool JsonParser::eatSpace()
+static inline bool isSpace(uint c)
 {
-    while (json < end) {
-        if (*json > Space)
-            break;
-        if (*json != Space &&
-            *json != Tab &&
-            *json != LineFeed &&
-            *json != Return)
-            break;
-        ++json;
+    return c == Space || c == Tab || c == LineFeed || c == Return;
+}
+
+// Returns the first character at or after p that is not whitespace
+static inline const QChar *skipSpace(const QChar *p, const QChar *end)
+{
+#ifdef __SSE2__
+    const __m128i space = _mm_set1_epi16(Space);
+    const __m128i tab = _mm_set1_epi16(Tab);
+    const __m128i lineFeed = _mm_set1_epi16(LineFeed);
+    const __m128i ret = _mm_set1_epi16(Return);
+    while (end - p >= 8) {
+        const __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+        __m128i ws = _mm_or_si128(_mm_cmpeq_epi16(data, space), _mm_cmpeq_epi16(data, tab));
+        ws = _mm_or_si128(ws, _mm_or_si128(_mm_cmpeq_epi16(data, lineFeed), _mm_cmpeq_epi16(data, ret)));
+        const uint mask = ~uint(_mm_movemask_epi8(ws)) & 0xffff;
+        if (mask)
+            return p + qCountTrailingZeroBits(mask) / 2;
+        p += 8;
+    }
+#endif
+    while (p < end && isSpace(p->unicode()))
+        ++p;
+    return p;
+}
+
+static inline const char *skipSpace(const char *p, const char *end)
+{
+#ifdef __SSE2__
+    const __m128i space = _mm_set1_epi8(Space);
+    const __m128i tab = _mm_set1_epi8(Tab);
+    const __m128i lineFeed = _mm_set1_epi8(LineFeed);
+    const __m128i ret = _mm_set1_epi8(Return);
+    while (end - p >= 16) {
+        const __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+        __m128i ws = _mm_or_si128(_mm_cmpeq_epi8(data, space), _mm_cmpeq_epi8(data, tab));
+        ws = _mm_or_si128(ws, _mm_or_si128(_mm_cmpeq_epi8(data, lineFeed), _mm_cmpeq_epi8(data, ret)));
+        const uint mask = ~uint(_mm_movemask_epi8(ws)) & 0xffff;
+        if (mask)
+            return p + qCountTrailingZeroBits(mask);
+        p += 16;
     }
+#endif
+    while (p < end && isSpace(uchar(*p)))
+        ++p;
+    return p;
+}
+
+template <typename CharType>
+bool BasicJsonParser<CharType>::eatSpace()
+{
+    if (json < end && unit(*json) > Space)
+        return true;
+    json = skipSpace(json, end);
     return (json < end);
 }
 
-QChar JsonParser::nextToken()
+template <typename CharType>
+uint BasicJsonParser<CharType>::nextToken()
 {
     if (!eatSpace())
         return 0;
-    QChar token = *json++;
-    switch (token.unicode()) {
+    uint token = unit(*json++);
+    switch (token) {
     case BeginArray:
     case BeginObject:
     case NameSeparator:
@@ -162,7 +222,8 @@ QChar JsonParser::nextToken()
 /*
     JSON-text = object / array
 */
-ReturnedValue JsonParser::parse(QJsonParseError *error)
+template <typename CharType>
+ReturnedValue BasicJsonParser<CharType>::parse(QJsonParseError *error)
 {
 #ifdef PARSER_DEBUG
     indent = 0;
@@ -172,6 +233,8 @@ ReturnedValue JsonParser::parse(QJsonParseError *error)
     eatSpace();
 
     Scope scope(engine);
+    ScopedArrayObject roots(scope, engine->newArrayObject());
+    shapeRoots = roots.getPointer();
     ScopedValue v(scope);
     if (!parseValue(v)) {
 #ifdef PARSER_DEBUG
@@ -198,26 +261,42 @@ ReturnedValue JsonParser::parse(QJsonParseError *error)
     return v->asReturnedValue();
 }
 
+template <typename CharType>
+int BasicJsonParser<CharType>::shapeFor(Heap::InternalClass *ic)
+{
+    const auto it = shapeIndex.constFind(ic);
+    if (it != shapeIndex.constEnd())
+        return *it;
+
+    const int index = int(shapes.size());
+    shapes.push_back({ ic, QVector<CharType>(), -1 });
+    shapeIndex.insert(ic, index);
+    shapeRoots->arraySet(index, Value::fromHeapObject(ic));
+    return index;
+}
+
 /*
     object = begin-object [ member *( value-separator member ) ]
     end-object
 */
 
-ReturnedValue JsonParser::parseObject()
+template <typename CharType>
+ReturnedValue BasicJsonParser<CharType>::parseObject()
 {
     if (++nestingLevel > nestingLimit) {
         lastError = QJsonParseError::DeepNesting;
         return Encode::undefined();
     }
 
-    BEGIN << "parseObject pos=" << json;
+    BEGIN << "parseObject pos=" << (json - head);
     Scope scope(engine);
 
     ScopedObject o(scope, engine->newObject());
+    int shape = shapeFor(o->internalClass());
 
-    QChar token = nextToken();
+    uint token = nextToken();
     while (token == Quote) {
-        if (!parseMember(o))
+        if (!parseMember(o, &shape))
             return Encode::undefined();
         token = nextToken();
         if (token != ValueSeparator)
@@ -244,20 +323,46 @@ ReturnedValue JsonParser::parseObject()
 /*
     member = string name-separator value
 */
-bool JsonParser::parseMember(Object *o)
+template <typename CharType>
+bool BasicJsonParser<CharType>::parseMember(Object *o, int *shape)
 {
     BEGIN << "parseMember";
     Scope scope(engine);
+    ScopedValue val(scope);
 
+    const Shape &current = shapes[*shape];
+    const int next = current.next;
+    if (next >= 0) {
+        const int length = current.nextKey.size();
+        if (end - json > length && unit(json[length]) == Quote
+                && !memcmp(json, current.nextKey.constData(), length * sizeof(CharType))) {
+            // Same key as the last object in this state, take the cached transition.
+            const uint index = current.internalClass->size;
+            json += length + 1;
+            if (nextToken() != NameSeparator) {
+                lastError = QJsonParseError::MissingNameSeparator;
+                return false;
+            }
+            if (!parseValue(val))
+                return false;
+            o->setInternalClass(shapes[next].internalClass);
+            o->setProperty(index, val);
+            *shape = next;
+            END;
+            return true;
+        }
+    }
+
+    const CharType *keyStart = json;
     QString key;
     if (!parseString(&key))
         return false;
-    QChar token = nextToken();
+    const int keyLength = int(json - keyStart) - 1;
+    uint token = nextToken();
     if (token != NameSeparator) {
         lastError = QJsonParseError::MissingNameSeparator;
         return false;
     }
-    ScopedValue val(scope);
     if (!parseValue(val))
         return false;
 
@@ -267,7 +372,19 @@ bool JsonParser::parseMember(Object *o)
         o->put(skey.asArrayIndex(), val);
     } else {
         // avoid trouble with properties named __proto__
+        Heap::InternalClass *before = o->internalClass();
         o->insertMember(s, val);
+        Heap::InternalClass *after = o->internalClass();
+        if (after != before) {
+            const int from = *shape;
+            *shape = shapeFor(after);
+            if (after->size == before->size + 1) {
+                Shape &previous = shapes[from];
+                previous.nextKey.resize(keyLength);
+                memcpy(previous.nextKey.data(), keyStart, keyLength * sizeof(CharType));
+                previous.next = *shape;
+            }
+        }
     }
 
     END;
@@ -277,7 +394,8 @@ bool JsonParser::parseMember(Object *o)
 /*
     array = begin-array [ value *( value-separator value ) ] end-array
 */
-ReturnedValue JsonParser::parseArray()
+template <typename CharType>
+ReturnedValue BasicJsonParser<CharType>::parseArray()
 {
     Scope scope(engine);
     BEGIN << "parseArray";
@@ -292,7 +410,7 @@ ReturnedValue JsonParser::parseArray()
         lastError = QJsonParseError::UnterminatedArray;
         return Encode::undefined();
     }
-    if (*json == EndArray) {
+    if (unit(*json) == EndArray) {
         nextToken();
     } else {
         uint index = 0;
@@ -301,7 +419,7 @@ ReturnedValue JsonParser::parseArray()
             if (!parseValue(val))
                 return Encode::undefined();
             array->arraySet(index, val);
-            QChar token = nextToken();
+            uint token = nextToken();
             if (token == EndArray)
                 break;
             else if (token != ValueSeparator) {
@@ -327,11 +445,12 @@ value = false / null / true / object / array / number / string
 
 */
 
-bool JsonParser::parseValue(Value *val)
+template <typename CharType>
+bool BasicJsonParser<CharType>::parseValue(Value *val)
 {
     BEGIN << "parse Value" << *json;
 
-    switch ((json++)->unicode()) {
+    switch (unit(*json++)) {
     case 'n':
         if (end - json < 3) {
             lastError = QJsonParseError::IllegalValue;
@@ -435,24 +554,40 @@ bool JsonParser::parseValue(Value *val)
 
 */
 
-bool JsonParser::parseNumber(Value *val)
+static inline double toDouble(const QChar *number, int length, bool *ok)
+{
+    return QString::fromRawData(number, length).toDouble(ok);
+}
+
+static inline double toDouble(const char *number, int length, bool *ok)
+{
+    return QByteArray::fromRawData(number, length).toDouble(ok);
+}
+
+template <typename CharType>
+bool BasicJsonParser<CharType>::parseNumber(Value *val)
 {
     BEGIN << "parseNumber" << *json;
 
-    const QChar *start = json;
+    const CharType *start = json;
     bool isInt = true;
+    bool negative = false;
 
     // minus
-    if (json < end && *json == '-')
+    if (json < end && *json == '-') {
+        negative = true;
         ++json;
+    }
 
     // int = zero / ( digit1-9 *DIGIT )
+    const CharType *digits = json;
     if (json < end && *json == '0') {
         ++json;
     } else {
         while (json < end && *json >= '0' && *json <= '9')
             ++json;
     }
+    const int intDigits = int(json - digits);
 
     // frac = decimal-point 1*DIGIT
     if (json < end && *json == '.') {
@@ -472,14 +607,15 @@ bool JsonParser::parseNumber(Value *val)
             ++json;
     }
 
-    QString number(start, json - start);
-    DEBUG << "numberstring" << number;
+    DEBUG << "number length" << (json - start);
 
-    if (isInt) {
-        bool ok;
-        int n = number.toInt(&ok);
-        if (ok && n < (1<<25) && n > -(1<<25)) {
-            *val = Value::fromInt32(n);
+    // Up to 8 digits can't overflow, and most numbers in JSON are small integers
+    if (isInt && intDigits > 0 && intDigits <= 8) {
+        int n = 0;
+        for (const CharType *d = digits; d < json; ++d)
+            n = n * 10 + int(unit(*d) - '0');
+        if (n < (1<<25)) {
+            *val = Value::fromInt32(negative ? -n : n);
             END;
             return true;
         }
@@ -487,7 +623,7 @@ bool JsonParser::parseNumber(Value *val)
 
     bool ok;
     double d;
-    d = number.toDouble(&ok);
+    d = toDouble(start, int(json - start), &ok);
 
     if (!ok) {
         lastError = QJsonParseError::IllegalNumber;
@@ -522,9 +658,8 @@ bool JsonParser::parseNumber(Value *val)
 
         unescaped = %x20-21 / %x23-5B / %x5D-10FFFF
  */
-static inline bool addHexDigit(QChar digit, uint *result)
+static inline bool addHexDigit(uint d, uint *result)
 {
-    ushort d = digit.unicode();
     *result <<= 4;
     if (d >= '0' && d <= '9')
         *result |= (d - '0');
@@ -537,14 +672,15 @@ static inline bool addHexDigit(QChar digit, uint *result)
     return true;
 }
 
-static inline bool scanEscapeSequence(const QChar *&json, const QChar *end, uint *ch)
+template <typename CharType>
+static inline bool scanEscapeSequence(const CharType *&json, const CharType *end, uint *ch)
 {
     ++json;
     if (json >= end)
         return false;
 
     DEBUG << "scan escape";
-    uint escaped = (json++)->unicode();
+    uint escaped = unit(*json++);
     switch (escaped) {
     case '"':
         *ch = '"'; break;
@@ -567,7 +703,7 @@ static inline bool scanEscapeSequence(const QChar *&json, const QChar *end, uint
         if (json > end - 4)
             return false;
         for (int i = 0; i < 4; ++i) {
-            if (!addHexDigit(*json, ch))
+            if (!addHexDigit(unit(*json), ch))
                 return false;
             ++json;
         }
@@ -579,32 +715,128 @@ static inline bool scanEscapeSequence(const QChar *&json, const QChar *end, uint
     return true;
 }
 
+// Returns the first character at or after p that needs more than copying:
+// a quote, a backslash or a control character.
+static inline const QChar *skipPlainCharacters(const QChar *p, const QChar *end)
+{
+#ifdef __SSE2__
+    const __m128i quote = _mm_set1_epi16(Quote);
+    const __m128i backslash = _mm_set1_epi16('\\');
+    const __m128i control = _mm_set1_epi16(0x1f);
+    const __m128i zero = _mm_setzero_si128();
+    while (end - p >= 8) {
+        const __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+        __m128i special = _mm_or_si128(_mm_cmpeq_epi16(data, quote), _mm_cmpeq_epi16(data, backslash));
+        // data <= 0x1f iff the saturated difference is zero
+        special = _mm_or_si128(special, _mm_cmpeq_epi16(_mm_subs_epu16(data, control), zero));
+        const uint mask = uint(_mm_movemask_epi8(special));
+        if (mask)
+            return p + qCountTrailingZeroBits(mask) / 2;
+        p += 8;
+    }
+#endif
+    while (p < end) {
+        const ushort c = p->unicode();
+        if (c == Quote || c == '\\' || c <= 0x1f)
+            break;
+        ++p;
+    }
+    return p;
+}
+
+// Same as above, but also stops at the first byte of a multi-byte UTF-8 sequence
+static inline const char *skipPlainCharacters(const char *p, const char *end)
+{
+#ifdef __SSE2__
+    const __m128i quote = _mm_set1_epi8(Quote);
+    const __m128i backslash = _mm_set1_epi8('\\');
+    const __m128i control = _mm_set1_epi8(0x1f);
+    const __m128i zero = _mm_setzero_si128();
+    while (end - p >= 16) {
+        const __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+        __m128i special = _mm_or_si128(_mm_cmpeq_epi8(data, quote), _mm_cmpeq_epi8(data, backslash));
+        special = _mm_or_si128(special, _mm_cmpeq_epi8(_mm_subs_epu8(data, control), zero));
+        const uint mask = uint(_mm_movemask_epi8(special) | _mm_movemask_epi8(data));
+        if (mask)
+            return p + qCountTrailingZeroBits(mask);
+        p += 16;
+    }
+#endif
+    while (p < end) {
+        const uchar c = uchar(*p);
+        if (c == Quote || c == '\\' || c <= 0x1f || c >= 0x80)
+            break;
+        ++p;
+    }
+    return p;
+}
+
+static inline void appendPlainCharacters(QString *string, const QChar *chars, int length)
+{
+    string->append(chars, length);
+}
+
+static inline void appendPlainCharacters(QString *string, const char *chars, int length)
+{
+    string->append(QLatin1String(chars, length));
+}
+
+static inline bool appendEncodedCharacter(QString *string, const QChar *&json, const QChar *)
+{
+    *string += *json++;
+    return true;
+}
+
+static inline bool appendEncodedCharacter(QString *string, const char *&json, const char *end)
+{
+    const uchar *&src = reinterpret_cast<const uchar *&>(json);
+    const uchar *uend = reinterpret_cast<const uchar *>(end);
+    ushort buffer[2];
+    ushort *dst = buffer;
+    const uchar b = *src++;
+    const int length = QUtf8Functions::fromUtf8<QUtf8BaseTraits>(b, dst, src, uend);
+    if (length < 0) {
+        --src;
+        return false;
+    }
+    string->append(reinterpret_cast<const QChar *>(buffer), length);
+    return true;
+}
 
-bool JsonParser::parseString(QString *string)
+template <typename CharType>
+bool BasicJsonParser<CharType>::parseString(QString *string)
 {
-    BEGIN << "parse string stringPos=" << json;
+    BEGIN << "parse string stringPos=" << (json - head);
 
     while (json < end) {
-        if (*json == '"')
+        const CharType *run = json;
+        json = skipPlainCharacters(json, end);
+        if (json != run)
+            appendPlainCharacters(string, run, int(json - run));
+        if (json >= end)
             break;
-        else if (*json == '\\') {
+
+        const uint c = unit(*json);
+        if (c == '"') {
+            break;
+        } else if (c == '\\') {
             uint ch = 0;
             if (!scanEscapeSequence(json, end, &ch)) {
                 lastError = QJsonParseError::IllegalEscapeSequence;
                 return false;
             }
             if (QChar::requiresSurrogates(ch)) {
-                *string += QChar(QChar::highSurrogate(ch)) + QChar(QChar::lowSurrogate(ch));
+                *string += QChar(QChar::highSurrogate(ch));
+                *string += QChar(QChar::lowSurrogate(ch));
             } else {
                 *string += QChar(ch);
             }
-        } else {
-            if (json->unicode() <= 0x1f) {
-                lastError = QJsonParseError::IllegalEscapeSequence;
-                return false;
-            }
-            *string += *json;
-            ++json;
+        } else if (c <= 0x1f) {
+            lastError = QJsonParseError::IllegalEscapeSequence;
+            return false;
+        } else if (!appendEncodedCharacter(string, json, end)) {
+            lastError = QJsonParseError::IllegalUTF8String;
+            return false;
         }
     }
     ++json;
@@ -618,260 +850,543 @@ bool JsonParser::parseString(QString *string)
     return true;
 }
 
+namespace QV4 {
+template class BasicJsonParser<QChar>;
+template class BasicJsonParser<char>;
+}
+
+
+/*
+    JSON.stringify writes its result into a single growing buffer instead of
+    concatenating the strings of the members. The buffer is either a QString,
+    for the JS API, or UTF-8 in a QByteArray, which can be streamed out to a
+    QIODevice while the value is being serialized.
+*/
+
+static inline void appendAscii(QString *out, const char *text, int length)
+{
+    out->append(QLatin1String(text, length));
+}
+
+static inline void appendAscii(QByteArray *out, const char *text, int length)
+{
+    out->append(text, length);
+}
+
+static inline void appendChar(QString *out, char c)
+{
+    out->append(QLatin1Char(c));
+}
+
+static inline void appendChar(QByteArray *out, char c)
+{
+    out->append(c);
+}
 
+static inline void appendText(QString *out, const QString &text)
+{
+    out->append(text);
+}
+
+static inline void appendText(QByteArray *out, const QByteArray &text)
+{
+    out->append(text);
+}
+
+static inline void toText(QString *out, const QString &str)
+{
+    *out = str;
+}
+
+static inline void toText(QByteArray *out, const QString &str)
+{
+    *out = str.toUtf8();
+}
+
+static inline bool needsEscape(ushort c)
+{
+    return c == '"' || c == '\\' || c <= 0x1f;
+}
+
+template <typename Text>
+static void appendEscaped(Text *out, ushort c)
+{
+    switch (c) {
+    case '"':
+        appendAscii(out, "\\\"", 2);
+        break;
+    case '\\':
+        appendAscii(out, "\\\\", 2);
+        break;
+    case '\b':
+        appendAscii(out, "\\b", 2);
+        break;
+    case '\f':
+        appendAscii(out, "\\f", 2);
+        break;
+    case '\n':
+        appendAscii(out, "\\n", 2);
+        break;
+    case '\r':
+        appendAscii(out, "\\r", 2);
+        break;
+    case '\t':
+        appendAscii(out, "\\t", 2);
+        break;
+    default: {
+        static const char hexDigits[] = "0123456789abcdef";
+        const char escape[] = {
+            '\\', 'u',
+            hexDigits[(c >> 12) & 0xf], hexDigits[(c >> 8) & 0xf],
+            hexDigits[(c >> 4) & 0xf], hexDigits[c & 0xf]
+        };
+        appendAscii(out, escape, 6);
+        break;
+    }
+    }
+}
+
+static void quote(QString *out, const QString &str)
+{
+    const QChar *begin = str.constData();
+    const QChar *end = begin + str.length();
+    appendChar(out, '"');
+    const QChar *run = begin;
+    for (const QChar *c = begin; c < end; ++c) {
+        if (!needsEscape(c->unicode()))
+            continue;
+        out->append(run, int(c - run));
+        appendEscaped(out, c->unicode());
+        run = c + 1;
+    }
+    out->append(run, int(end - run));
+    appendChar(out, '"');
+}
+
+static void quote(QByteArray *out, const QString &str)
+{
+    const ushort *src = reinterpret_cast<const ushort *>(str.constData());
+    const ushort *end = src + str.length();
+    appendChar(out, '"');
+    while (src < end) {
+        // copy runs of ASCII in one go
+        const ushort *run = src;
+        while (src < end && *src < 0x80 && !needsEscape(*src))
+            ++src;
+        if (src != run) {
+            const int size = out->size();
+            out->resize(size + int(src - run));
+            char *dst = out->data() + size;
+            while (run < src)
+                *dst++ = char(*run++);
+        }
+        if (src == end)
+            break;
+
+        const ushort u = *src++;
+        if (u < 0x80) {
+            appendEscaped(out, u);
+            continue;
+        }
+        uchar buffer[4];
+        uchar *dst = buffer;
+        if (QUtf8Functions::toUtf8<QUtf8BaseTraits>(u, dst, src, end) < 0)
+            appendEscaped(out, u); // unpaired surrogate, can't be encoded as UTF-8
+        else
+            out->append(reinterpret_cast<const char *>(buffer), int(dst - buffer));
+    }
+    appendChar(out, '"');
+}
+
+static inline void appendNumber(QString *out, const Value &value)
+{
+    if (value.isInteger())
+        out->append(QString::number(value.integerValue()));
+    else
+        out->append(value.toQString());
+}
+
+static inline void appendNumber(QByteArray *out, const Value &value)
+{
+    if (value.isInteger())
+        out->append(QByteArray::number(value.integerValue()));
+    else
+        out->append(value.toQString().toLatin1());
+}
+
+static inline bool writeTo(QIODevice *device, const QString &text)
+{
+    return device->write(text.toUtf8()) >= 0;
+}
+
+static inline bool writeTo(QIODevice *device, const QByteArray &text)
+{
+    return device->write(text) == text.size();
+}
+
+template <typename Text>
 struct Stringify
 {
     ExecutionEngine *v4;
     FunctionObject *replacerFunction;
     QV4::String *propertyList;
     int propertyListSize;
-    QString gap;
-    QString indent;
-    QStack<Object *> stack;
+    Text gap;
+    Text indent;
+
+    Text *out;
+    QIODevice *device;
+    bool deviceError;
+
+    // The objects currently being serialized, for the cycle check. Scanning
+    // is fine for the usual nesting depths, deeper levels go into a set.
+    enum { StackScanLimit = 16, FlushSize = 64 * 1024 };
+    std::vector<Heap::Object *> stack;
+    QSet<Heap::Object *> deepStack;
+
+    // The members of plain objects, per internal class, with the key already
+    // quoted into the output encoding
+    struct Member {
+        uint index;
+        PropertyKey key;
+        Text quotedKey;
+    };
+    struct Shape {
+        bool plain;
+        std::vector<Member> members;
+    };
+    QHash<Heap::InternalClass *, Shape> shapes;
+    ArrayObject *shapeRoots; // keeps the internal classes in shapes alive
+
+    QV4::String *toJSON;
+
+    Stringify(Scope &scope, Text *out)
+        : v4(scope.engine), replacerFunction(nullptr), propertyList(nullptr), propertyListSize(0),
+          out(out), device(nullptr), deviceError(false)
+    {
+        Value *roots = scope.alloc(2);
+        roots[0] = v4->newArrayObject();
+        shapeRoots = static_cast<ArrayObject *>(&roots[0]);
+        roots[1] = v4->newIdentifier(QStringLiteral("toJSON"));
+        toJSON = static_cast<QV4::String *>(&roots[1]);
+    }
 
-    bool stackContains(Object *o) {
-        for (int i = 0; i < stack.size(); ++i)
-            if (stack.at(i)->d() == o->d())
+    bool stackContains(Heap::Object *o) const {
+        const size_t scanned = qMin(stack.size(), size_t(StackScanLimit));
+        for (size_t i = 0; i < scanned; ++i)
+            if (stack[i] == o)
                 return true;
-        return false;
+        return !deepStack.isEmpty() && deepStack.contains(o);
+    }
+    void push(Heap::Object *o) {
+        if (stack.size() >= size_t(StackScanLimit))
+            deepStack.insert(o);
+        stack.push_back(o);
+    }
+    void pop() {
+        if (stack.size() > size_t(StackScanLimit))
+            deepStack.remove(stack.back());
+        stack.pop_back();
     }
 
-    Stringify(ExecutionEngine *e) : v4(e), replacerFunction(nullptr), propertyList(nullptr), propertyListSize(0) {}
-
-    QString Str(const QString &key, const Value &v);
-    QString JA(Object *a);
-    QString JO(Object *o);
+    // Returns false once writing to the device failed, to stop the serialization
+    bool flush() {
+        if (deviceError)
+            return false;
+        if (!device || out->size() < FlushSize)
+            return true;
+        if (!writeTo(device, *out))
+            deviceError = true;
+        out->resize(0);
+        return !deviceError;
+    }
 
-    QString makeMember(const QString &key, const Value &v);
+    bool Str(const Value &value);
+    bool prepare(Value *value, const Value &key);
+    bool write(const Value &value);
+    bool writeMember(const Value &key, const Text *quotedKey, Value *value, bool *first);
+    void separator(bool *first);
+    const Shape *shapeFor(Object *o);
+    bool JA(Object *a);
+    bool JO(Object *o);
 };
 
-static QString quote(const QString &str)
-{
-    QString product;
-    const int length = str.length();
-    product.reserve(length + 2);
-    product += QLatin1Char('"');
-    for (int i = 0; i < length; ++i) {
-        QChar c = str.at(i);
-        switch (c.unicode()) {
-        case '"':
-            product += QLatin1String("\\\"");
-            break;
-        case '\\':
-            product += QLatin1String("\\\\");
-            break;
-        case '\b':
-            product += QLatin1String("\\b");
-            break;
-        case '\f':
-            product += QLatin1String("\\f");
-            break;
-        case '\n':
-            product += QLatin1String("\\n");
-            break;
-        case '\r':
-            product += QLatin1String("\\r");
-            break;
-        case '\t':
-            product += QLatin1String("\\t");
-            break;
-        default:
-            if (c.unicode() <= 0x1f) {
-                product += QLatin1String("\\u00");
-                product += (c.unicode() > 0xf ? QLatin1Char('1') : QLatin1Char('0')) +
-                        QLatin1Char("0123456789abcdef"[c.unicode() & 0xf]);
-            } else {
-                product += c;
-            }
-        }
-    }
-    product += QLatin1Char('"');
-    return product;
-}
-
-QString Stringify::Str(const QString &key, const Value &v)
+// Applies toJSON and the replacer function. Returns whether the resulting
+// value is serialized at all.
+template <typename Text>
+bool Stringify<Text>::prepare(Value *value, const Value &key)
 {
     Scope scope(v4);
 
-    ScopedValue value(scope, v);
-    ScopedObject o(scope, value);
+    ScopedObject o(scope, *value);
     if (o) {
-        ScopedString s(scope, v4->newString(QStringLiteral("toJSON")));
-        ScopedFunctionObject toJSON(scope, o->get(s));
-        if (!!toJSON) {
+        ScopedFunctionObject toJSONFunction(scope, o->get(toJSON));
+        if (!!toJSONFunction) {
             JSCallData jsCallData(scope, 1);
-            *jsCallData->thisObject = value;
-            jsCallData->args[0] = v4->newString(key);
-            value = toJSON->call(jsCallData);
+            *jsCallData->thisObject = *value;
+            jsCallData->args[0] = key.toString(v4);
+            *value = toJSONFunction->call(jsCallData);
+            if (v4->hasException)
+                return false;
         }
     }
 
     if (replacerFunction) {
         ScopedObject holder(scope, v4->newObject());
-        holder->put(scope.engine->id_empty(), value);
+        holder->put(scope.engine->id_empty(), *value);
         JSCallData jsCallData(scope, 2);
-        jsCallData->args[0] = v4->newString(key);
-        jsCallData->args[1] = value;
+        jsCallData->args[0] = key.toString(v4);
+        jsCallData->args[1] = *value;
         *jsCallData->thisObject = holder;
-        value = replacerFunction->call(jsCallData);
+        *value = replacerFunction->call(jsCallData);
+        if (v4->hasException)
+            return false;
     }
 
     o = value->asReturnedValue();
     if (o) {
         if (NumberObject *n = o->as<NumberObject>())
-            value = Encode(n->value());
+            *value = Encode(n->value());
         else if (StringObject *so = o->as<StringObject>())
-            value = so->d()->string;
+            *value = so->d()->string;
         else if (BooleanObject *b = o->as<BooleanObject>())
-            value = Encode(b->value());
+            *value = Encode(b->value());
     }
 
-    if (value->isNull())
-        return QStringLiteral("null");
-    if (value->isBoolean())
-        return value->booleanValue() ? QStringLiteral("true") : QStringLiteral("false");
-    if (value->isString())
-        return quote(value->stringValue()->toQString());
+    if (value->isNull() || value->isBoolean() || value->isString() || value->isNumber())
+        return true;
+    if (const Object *object = value->as<Object>())
+        return object->as<QV4::VariantObject>() || !object->as<FunctionObject>();
+    return false;
+}
 
-    if (value->isNumber()) {
-        double d = value->toNumber();
-        return std::isfinite(d) ? value->toQString() : QStringLiteral("null");
+template <typename Text>
+bool Stringify<Text>::write(const Value &value)
+{
+    if (value.isNull()) {
+        appendAscii(out, "null", 4);
+    } else if (value.isBoolean()) {
+        if (value.booleanValue())
+            appendAscii(out, "true", 4);
+        else
+            appendAscii(out, "false", 5);
+    } else if (value.isString()) {
+        quote(out, value.stringValue()->toQString());
+    } else if (value.isNumber()) {
+        if (value.isInteger() || std::isfinite(value.doubleValue()))
+            appendNumber(out, value);
+        else
+            appendAscii(out, "null", 4);
+    } else if (const QV4::VariantObject *v = value.as<QV4::VariantObject>()) {
+        quote(out, v->d()->data().toString());
+    } else {
+        Scope scope(v4);
+        ScopedObject o(scope, value);
+        if (o->isArrayLike())
+            return JA(o);
+        return JO(o);
     }
+    return true;
+}
 
-    if (const QV4::VariantObject *v = value->as<QV4::VariantObject>()) {
-        return quote(v->d()->data().toString());
-    }
+template <typename Text>
+bool Stringify<Text>::Str(const Value &v)
+{
+    Scope scope(v4);
+    ScopedValue value(scope, v);
+    ScopedValue key(scope, v4->id_empty());
+    if (!prepare(value, key))
+        return false;
+    if (!write(value))
+        return false;
+    if (device && !deviceError && !out->isEmpty() && !writeTo(device, *out))
+        deviceError = true;
+    return !deviceError;
+}
 
-    o = value->asReturnedValue();
-    if (o) {
-        if (!o->as<FunctionObject>()) {
-            if (o->isArrayLike()) {
-                return JA(o.getPointer());
-            } else {
-                return JO(o);
-            }
-        }
+template <typename Text>
+void Stringify<Text>::separator(bool *first)
+{
+    if (!*first)
+        appendChar(out, ',');
+    *first = false;
+    if (!gap.isEmpty()) {
+        appendChar(out, '\n');
+        appendText(out, indent);
     }
-
-    return QString();
 }
 
-QString Stringify::makeMember(const QString &key, const Value &v)
+template <typename Text>
+bool Stringify<Text>::writeMember(const Value &key, const Text *quotedKey, Value *value, bool *first)
 {
-    QString strP = Str(key, v);
-    if (!strP.isEmpty()) {
-        QString member = quote(key) + QLatin1Char(':');
+    if (!prepare(value, key))
+        return !v4->hasException;
+
+    separator(first);
+    if (quotedKey) {
+        appendText(out, *quotedKey);
+    } else {
+        quote(out, key.toQString());
+        appendChar(out, ':');
         if (!gap.isEmpty())
-            member += QLatin1Char(' ');
-        member += strP;
-        return member;
+            appendChar(out, ' ');
     }
-    return QString();
+    return write(*value);
 }
 
-QString Stringify::JO(Object *o)
+template <typename Text>
+const typename Stringify<Text>::Shape *Stringify<Text>::shapeFor(Object *o)
 {
-    if (stackContains(o)) {
+    if (o->d()->vtable() != QV4::Object::staticVTable() || o->arrayData())
+        return nullptr;
+
+    Heap::InternalClass *ic = o->internalClass();
+    typename QHash<Heap::InternalClass *, Shape>::const_iterator it = shapes.constFind(ic);
+    if (it == shapes.constEnd()) {
+        Shape shape;
+        shape.plain = true;
+        for (uint i = 0; i < ic->size; ++i) {
+            const PropertyKey key = ic->nameMap.at(i);
+            const PropertyAttributes attributes = ic->propertyData.at(i);
+            if (!key.isValid() || attributes.isEmpty())
+                continue;
+            if (attributes.isAccessor() || !attributes.isEnumerable()) {
+                shape.plain = false;
+                break;
+            }
+            if (key.isSymbol())
+                continue;
+            Member member = { i, key, Text() };
+            quote(&member.quotedKey, key.toQString());
+            appendChar(&member.quotedKey, ':');
+            if (!gap.isEmpty())
+                appendChar(&member.quotedKey, ' ');
+            shape.members.push_back(member);
+        }
+        shapeRoots->arraySet(uint(shapes.size()), Value::fromHeapObject(ic));
+        it = shapes.insert(ic, shape);
+    }
+    return it->plain ? &*it : nullptr;
+}
+
+template <typename Text>
+bool Stringify<Text>::JO(Object *o)
+{
+    if (stackContains(o->d())) {
         v4->throwTypeError();
-        return QString();
+        return false;
     }
 
     Scope scope(v4);
 
-    QString result;
-    stack.push(o);
-    QString stepback = indent;
+    push(o->d());
+    Text stepback = indent;
     indent += gap;
 
-    QStringList partial;
-    if (!propertyListSize) {
-        ObjectIterator it(scope, o, ObjectIterator::EnumerableOnly);
-        ScopedValue name(scope);
-
-        ScopedValue val(scope);
-        while (1) {
-            name = it.nextPropertyNameAsString(val);
-            if (name->isNull())
-                break;
-            QString key = name->toQString();
-            QString member = makeMember(key, val);
-            if (!member.isEmpty())
-                partial += member;
-        }
-    } else {
-        ScopedValue v(scope);
-        for (int i = 0; i < propertyListSize; ++i) {
+    appendChar(out, '{');
+    bool first = true;
+    bool ok = true;
+    ScopedValue key(scope);
+    ScopedValue val(scope);
+    if (propertyListSize) {
+        for (int i = 0; ok && i < propertyListSize; ++i) {
             bool exists;
             String *s = propertyList + i;
-            if (!s)
+            if (!s->d())
                 continue;
-            v = o->get(s, &exists);
+            val = o->get(s, &exists);
             if (!exists)
                 continue;
-            QString member = makeMember(s->toQString(), v);
-            if (!member.isEmpty())
-                partial += member;
+            ok = writeMember(*s, nullptr, val, &first) && flush();
+        }
+    } else if (const Shape *shape = shapeFor(o)) {
+        // Read the members directly, unless toJSON or the replacer changed the object
+        Heap::InternalClass *ic = o->internalClass();
+        for (const Member &member : shape->members) {
+            if (o->internalClass() == ic) {
+                val = *o->propertyData(member.index);
+            } else {
+                bool exists;
+                val = o->get(member.key, nullptr, &exists);
+                if (!exists)
+                    continue;
+            }
+            key = member.key.asStringOrSymbol();
+            ok = writeMember(key, &member.quotedKey, val, &first) && flush();
+            if (!ok)
+                break;
+        }
+    } else {
+        ObjectIterator it(scope, o, ObjectIterator::EnumerableOnly);
+        while (ok) {
+            key = it.nextPropertyNameAsString(val);
+            if (key->isNull())
+                break;
+            ok = writeMember(key, nullptr, val, &first) && flush();
         }
     }
 
-    if (partial.isEmpty()) {
-        result = QStringLiteral("{}");
-    } else if (gap.isEmpty()) {
-        result = QLatin1Char('{') + partial.join(QLatin1Char(',')) + QLatin1Char('}');
-    } else {
-        QString separator = QLatin1String(",\n") + indent;
-        result = QLatin1String("{\n") + indent + partial.join(separator) + QLatin1Char('\n')
-                 + stepback + QLatin1Char('}');
+    if (ok) {
+        if (!first && !gap.isEmpty()) {
+            appendChar(out, '\n');
+            appendText(out, stepback);
+        }
+        appendChar(out, '}');
     }
 
     indent = stepback;
-    stack.pop();
-    return result;
+    pop();
+    return ok;
 }
 
-QString Stringify::JA(Object *a)
+template <typename Text>
+bool Stringify<Text>::JA(Object *a)
 {
-    if (stackContains(a)) {
+    if (stackContains(a->d())) {
         v4->throwTypeError();
-        return QString();
+        return false;
     }
 
     Scope scope(a->engine());
 
-    QString result;
-    stack.push(a);
-    QString stepback = indent;
+    push(a->d());
+    Text stepback = indent;
     indent += gap;
 
-    QStringList partial;
+    appendChar(out, '[');
+    bool first = true;
+    bool ok = true;
     uint len = a->getLength();
     ScopedValue v(scope);
+    ScopedValue key(scope);
     for (uint i = 0; i < len; ++i) {
         bool exists;
         v = a->get(i, &exists);
-        if (!exists) {
-            partial += QStringLiteral("null");
-            continue;
+        key = Value::fromUInt32(i);
+        separator(&first);
+        if (exists && prepare(v, key)) {
+            ok = write(v);
+        } else if (v4->hasException) {
+            ok = false;
+        } else {
+            appendAscii(out, "null", 4);
         }
-        QString strP = Str(QString::number(i), v);
-        if (!strP.isEmpty())
-            partial += strP;
-        else
-            partial += QStringLiteral("null");
+        ok = ok && flush();
+        if (!ok)
+            break;
     }
 
-    if (partial.isEmpty()) {
-        result = QStringLiteral("[]");
-    } else if (gap.isEmpty()) {
-        result = QLatin1Char('[') + partial.join(QLatin1Char(',')) + QLatin1Char(']');
-    } else {
-        QString separator = QLatin1String(",\n") + indent;
-        result = QLatin1String("[\n") + indent + partial.join(separator) + QLatin1Char('\n') + stepback + QLatin1Char(']');
+    if (ok) {
+        if (!first && !gap.isEmpty()) {
+            appendChar(out, '\n');
+            appendText(out, stepback);
+        }
+        appendChar(out, ']');
     }
 
     indent = stepback;
-    stack.pop();
-    return result;
+    pop();
+    return ok;
 }
 
 
@@ -910,7 +1425,8 @@ ReturnedValue JsonObject::method_parse(const FunctionObject *b, const Value *, c
 ReturnedValue JsonObject::method_stringify(const FunctionObject *b, const Value *, const Value *argv, int argc)
 {
     Scope scope(b);
-    Stringify stringify(scope.engine);
+    QString result;
+    Stringify<QString> stringify(scope, &result);
 
     ScopedObject o(scope, argc > 1 ? argv[1] : Value::undefinedValue());
     if (o) {
@@ -951,12 +1467,47 @@ ReturnedValue JsonObject::method_stringify(const FunctionObject *b, const Value
 
 
     ScopedValue arg0(scope, argc ? argv[0] : Value::undefinedValue());
-    QString result = stringify.Str(QString(), arg0);
-    if (result.isEmpty() || scope.engine->hasException)
+    if (!stringify.Str(arg0) || scope.engine->hasException)
         RETURN_UNDEFINED();
     return Encode(scope.engine->newString(result));
 }
 
+// Serializes value like JSON.stringify() without a replacer or gap. Returns
+// a null string if the value has no JSON representation or an exception was
+// thrown.
+QString JsonObject::stringify(ExecutionEngine *engine, const Value &value)
+{
+    Scope scope(engine);
+    QString result;
+    Stringify<QString> stringify(scope, &result);
+    if (!stringify.Str(value) || engine->hasException)
+        return QString();
+    return result;
+}
+
+// Same as stringify(), but returns the result encoded as UTF-8
+QByteArray JsonObject::stringifyToUtf8(ExecutionEngine *engine, const Value &value)
+{
+    Scope scope(engine);
+    QByteArray result;
+    Stringify<QByteArray> stringify(scope, &result);
+    if (!stringify.Str(value) || engine->hasException)
+        return QByteArray();
+    return result;
+}
+
+// Writes the UTF-8 encoded JSON to device while it is being produced. On
+// failure, part of the text may already have been written.
+bool JsonObject::stringifyToUtf8(ExecutionEngine *engine, const Value &value, QIODevice *device)
+{
+    Scope scope(engine);
+    QByteArray buffer;
+    buffer.reserve(2 * Stringify<QByteArray>::FlushSize);
+    Stringify<QByteArray> stringify(scope, &buffer);
+    stringify.device = device;
+    return stringify.Str(value) && !engine->hasException;
+}
+
 
 
 ReturnedValue JsonObject::fromJsonValue(ExecutionEngine *engine, const QJsonValue &value)
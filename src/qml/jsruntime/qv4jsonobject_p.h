@@ -56,9 +56,14 @@
 #include <qjsonvalue.h>
 #include <qjsondocument.h>
 #include <qhash.h>
+#include <qvector.h>
+
+#include <vector>
 
 QT_BEGIN_NAMESPACE
 
+class QIODevice;
+
 namespace QV4 {
 
 namespace Heap {
@@ -91,6 +96,10 @@ public:
     static ReturnedValue method_parse(const FunctionObject *, const Value *thisObject, const Value *argv, int argc);
     static ReturnedValue method_stringify(const FunctionObject *, const Value *thisObject, const Value *argv, int argc);
 
+    Q_QML_PRIVATE_EXPORT static QString stringify(ExecutionEngine *engine, const Value &value);
+    Q_QML_PRIVATE_EXPORT static QByteArray stringifyToUtf8(ExecutionEngine *engine, const Value &value);
+    Q_QML_PRIVATE_EXPORT static bool stringifyToUtf8(ExecutionEngine *engine, const Value &value, QIODevice *device);
+
     static ReturnedValue fromJsonValue(ExecutionEngine *engine, const QJsonValue &value);
     static ReturnedValue fromJsonObject(ExecutionEngine *engine, const QJsonObject &object);
     static ReturnedValue fromJsonArray(ExecutionEngine *engine, const QJsonArray &array);
@@ -109,33 +118,52 @@ private:
 
 };
 
-class JsonParser
+template <typename CharType>
+class BasicJsonParser
 {
 public:
-    JsonParser(ExecutionEngine *engine, const QChar *json, int length);
+    BasicJsonParser(ExecutionEngine *engine, const CharType *json, int length);
 
     ReturnedValue parse(QJsonParseError *error);
 
 private:
     inline bool eatSpace();
-    inline QChar nextToken();
+    inline uint nextToken();
 
     ReturnedValue parseObject();
     ReturnedValue parseArray();
-    bool parseMember(Object *o);
+    bool parseMember(Object *o, int *shape);
     bool parseString(QString *string);
     bool parseValue(Value *val);
     bool parseNumber(Value *val);
 
+    int shapeFor(Heap::InternalClass *ic);
+
     ExecutionEngine *engine;
-    const QChar *head;
-    const QChar *json;
-    const QChar *end;
+    const CharType *head;
+    const CharType *json;
+    const CharType *end;
 
     int nestingLevel;
     QJsonParseError::ParseError lastError;
+
+    // Objects with the same keys in the same order end up with the same
+    // internal class. Remember the last key added to each class we have seen,
+    // so that the next object with that key can take the transition without
+    // creating an identifier or searching the transition table.
+    struct Shape {
+        Heap::InternalClass *internalClass;
+        QVector<CharType> nextKey; // raw, still escaped key text
+        int next;
+    };
+    std::vector<Shape> shapes;
+    QHash<Heap::InternalClass *, int> shapeIndex;
+    ArrayObject *shapeRoots; // keeps the internal classes in shapes alive
 };
 
+typedef BasicJsonParser<QChar> JsonParser;
+typedef BasicJsonParser<char> Utf8JsonParser;
+
 }
 
 QT_END_NAMESPACE
@@ -180,6 +180,13 @@ ReturnedValue Lookup::getterTwoClasses(Lookup *l, ExecutionEngine *engine, const
             return result;
         }
 
+        LookupCacheEntry entries[2];
+        uint count = 0;
+        if (first.toCacheEntries(entries, &count) && second.toCacheEntries(entries + count, &count)) {
+            ++engine->lookupStatistics.transitions;
+            l->becomePolymorphic(entries, count);
+            return result;
+        }
     }
 
     l->getter = getterFallback;
@@ -242,9 +249,7 @@ ReturnedValue Lookup::getter0Inlinegetter0Inline(Lookup *l, ExecutionEngine *eng
             return o->inlinePropertyDataWithOffset(l->objectLookupTwoClasses.offset)->asReturnedValue();
         if (l->objectLookupTwoClasses.ic2 == o->internalClass)
             return o->inlinePropertyDataWithOffset(l->objectLookupTwoClasses.offset2)->asReturnedValue();
-        Value obj = Value::fromHeapObject(o);
-        Value str = Value::fromHeapObject(engine->currentStackFrame->v4Function->compilationUnit->runtimeStrings[l->nameIndex]);
-        return static_cast<Object &>(obj).get(&static_cast<String &>(str));
+        return l->getterBecomePolymorphic(engine, object);
     }
     l->getter = getterFallback;
     return getterFallback(l, engine, object);
@@ -260,9 +265,7 @@ ReturnedValue Lookup::getter0Inlinegetter0MemberData(Lookup *l, ExecutionEngine
             return o->inlinePropertyDataWithOffset(l->objectLookupTwoClasses.offset)->asReturnedValue();
         if (l->objectLookupTwoClasses.ic2 == o->internalClass)
             return o->memberData->values.data()[l->objectLookupTwoClasses.offset2].asReturnedValue();
-        Value obj = Value::fromHeapObject(o);
-        Value str = Value::fromHeapObject(engine->currentStackFrame->v4Function->compilationUnit->runtimeStrings[l->nameIndex]);
-        return static_cast<Object &>(obj).get(&static_cast<String &>(str));
+        return l->getterBecomePolymorphic(engine, object);
     }
     l->getter = getterFallback;
     return getterFallback(l, engine, object);
@@ -278,9 +281,7 @@ ReturnedValue Lookup::getter0MemberDatagetter0MemberData(Lookup *l, ExecutionEng
             return o->memberData->values.data()[l->objectLookupTwoClasses.offset].asReturnedValue();
         if (l->objectLookupTwoClasses.ic2 == o->internalClass)
             return o->memberData->values.data()[l->objectLookupTwoClasses.offset2].asReturnedValue();
-        Value obj = Value::fromHeapObject(o);
-        Value str = Value::fromHeapObject(engine->currentStackFrame->v4Function->compilationUnit->runtimeStrings[l->nameIndex]);
-        return static_cast<Object &>(obj).get(&static_cast<String &>(str));
+        return l->getterBecomePolymorphic(engine, object);
     }
     l->getter = getterFallback;
     return getterFallback(l, engine, object);
@@ -296,9 +297,7 @@ ReturnedValue Lookup::getterProtoTwoClasses(Lookup *l, ExecutionEngine *engine,
             return l->protoLookupTwoClasses.data->asReturnedValue();
         if (l->protoLookupTwoClasses.protoId2 == o->internalClass->protoId)
             return l->protoLookupTwoClasses.data2->asReturnedValue();
-        Value obj = Value::fromHeapObject(o);
-        Value str = Value::fromHeapObject(engine->currentStackFrame->v4Function->compilationUnit->runtimeStrings[l->nameIndex]);
-        return static_cast<Object &>(obj).get(&static_cast<String &>(str));
+        return l->getterBecomePolymorphic(engine, object);
     }
     l->getter = getterFallback;
     return getterFallback(l, engine, object);
@@ -354,6 +353,7 @@ ReturnedValue Lookup::getterProtoAccessorTwoClasses(Lookup *l, ExecutionEngine *
 
             return static_cast<const FunctionObject *>(getter)->call(&object, nullptr, 0);
         }
+        return l->getterBecomePolymorphic(engine, object);
     }
     l->getter = getterFallback;
     return getterFallback(l, engine, object);
@@ -464,16 +464,17 @@ bool Lookup::setterGeneric(Lookup *l, ExecutionEngine *engine, Value &object, co
 
 bool Lookup::setterTwoClasses(Lookup *l, ExecutionEngine *engine, Value &object, const Value &value)
 {
-    Lookup first = *l;
-    Lookup second = *l;
-
     if (object.isObject()) {
-        if (!l->resolveSetter(engine, static_cast<Object *>(&object), value)) {
+        Lookup first = *l;
+        Lookup second = *l;
+
+        if (!second.resolveSetter(engine, static_cast<Object *>(&object), value)) {
             l->setter = setterFallback;
             return false;
         }
 
-        if (l->setter == Lookup::setter0 || l->setter == Lookup::setter0Inline) {
+        if ((first.setter == Lookup::setter0 || first.setter == Lookup::setter0Inline)
+                && (second.setter == Lookup::setter0 || second.setter == Lookup::setter0Inline)) {
             l->objectLookupTwoClasses.ic = first.objectLookup.ic;
             l->objectLookupTwoClasses.ic2 = second.objectLookup.ic;
             l->objectLookupTwoClasses.offset = first.objectLookup.offset;
@@ -481,6 +482,10 @@ bool Lookup::setterTwoClasses(Lookup *l, ExecutionEngine *engine, Value &object,
             l->setter = setter0setter0;
             return true;
         }
+
+        // The value has been stored by resolveSetter() already.
+        l->setter = setterFallback;
+        return true;
     }
 
     l->setter = setterFallback;
@@ -532,6 +537,7 @@ bool Lookup::setter0setter0(Lookup *l, ExecutionEngine *engine, Value &object, c
             o->setProperty(engine, l->objectLookupTwoClasses.offset2, value);
             return true;
         }
+        return l->setterBecomePolymorphic(engine, object, value);
     }
 
     l->setter = setterFallback;
@@ -566,4 +572,306 @@ bool Lookup::arrayLengthSetter(Lookup *, ExecutionEngine *engine, Value &object,
     return true;
 }
 
+// Polymorphic and megamorphic lookups
+//
+// Once a lookup has seen more than two classes, it switches to a small table of up to
+// PolymorphicLookupCache::Size entries. When that overflows, or a class shows up that the
+// table can't describe, the lookup goes through the engine wide MegamorphicLookupCache, which
+// is keyed on (class, property key).
+
+static inline bool hasDefaultLookupResolution(const Object *o)
+{
+    // Types like QObjectWrapper resolve lookups in their own way, and keep references in the
+    // Lookup. Those can't be described by a cache entry.
+    const VTable *vtable = o->vtable();
+    return vtable->resolveLookupGetter == Object::staticVTable()->resolveLookupGetter
+            && vtable->resolveLookupSetter == Object::staticVTable()->resolveLookupSetter;
+}
+
+static inline ReturnedValue getFromCacheEntry(const LookupCacheEntry &entry, Heap::Object *o, const Value &object)
+{
+    switch (entry.type) {
+    case LookupCacheEntry::GetterInline:
+        return o->inlinePropertyDataWithOffset(entry.offset)->asReturnedValue();
+    case LookupCacheEntry::GetterMemberData:
+        return o->memberData->values.data()[entry.offset].asReturnedValue();
+    case LookupCacheEntry::GetterProto:
+        return entry.data->asReturnedValue();
+    case LookupCacheEntry::GetterAccessor:
+    case LookupCacheEntry::GetterProtoAccessor: {
+        const Value *getter = entry.type == LookupCacheEntry::GetterAccessor ? o->propertyData(entry.offset) : entry.data;
+        if (!getter->isFunctionObject()) // ### catch at resolve time
+            return Encode::undefined();
+
+        return static_cast<const FunctionObject *>(getter)->call(&object, nullptr, 0);
+    }
+    default:
+        Q_UNREACHABLE();
+        return Encode::undefined();
+    }
+}
+
+static inline void setFromCacheEntry(const LookupCacheEntry &entry, ExecutionEngine *engine, Heap::Object *o, const Value &value)
+{
+    if (entry.type == LookupCacheEntry::SetterInline)
+        o->setInlineProperty(engine, entry.offset, value);
+    else
+        o->setProperty(engine, entry.offset, value);
+}
+
+// Describes the state of a monomorphic or two class lookup as cache entries. Writes the
+// entries, increments count accordingly and returns true if that's possible.
+bool Lookup::toCacheEntries(LookupCacheEntry *entries, uint *count) const
+{
+    uint n = *count;
+    auto add = [&](quintptr protoId, LookupCacheEntry::Type type, int offset, const Value *data) {
+        LookupCacheEntry &e = entries[n - *count];
+        e.protoId = protoId;
+        e.key = 0;
+        e.data = data;
+        e.offset = uint(offset);
+        e.type = type;
+        ++n;
+    };
+
+    if (getter == getter0Inline) {
+        add(objectLookup.ic->protoId, LookupCacheEntry::GetterInline, objectLookup.offset, nullptr);
+    } else if (getter == getter0MemberData) {
+        add(objectLookup.ic->protoId, LookupCacheEntry::GetterMemberData, objectLookup.offset, nullptr);
+    } else if (getter == getterAccessor) {
+        add(objectLookup.ic->protoId, LookupCacheEntry::GetterAccessor, objectLookup.offset, nullptr);
+    } else if (getter == getterProto) {
+        add(protoLookup.protoId, LookupCacheEntry::GetterProto, 0, protoLookup.data);
+    } else if (getter == getterProtoAccessor) {
+        add(protoLookup.protoId, LookupCacheEntry::GetterProtoAccessor, 0, protoLookup.data);
+    } else if (getter == getter0Inlinegetter0Inline) {
+        add(objectLookupTwoClasses.ic->protoId, LookupCacheEntry::GetterInline, objectLookupTwoClasses.offset, nullptr);
+        add(objectLookupTwoClasses.ic2->protoId, LookupCacheEntry::GetterInline, objectLookupTwoClasses.offset2, nullptr);
+    } else if (getter == getter0Inlinegetter0MemberData) {
+        add(objectLookupTwoClasses.ic->protoId, LookupCacheEntry::GetterInline, objectLookupTwoClasses.offset, nullptr);
+        add(objectLookupTwoClasses.ic2->protoId, LookupCacheEntry::GetterMemberData, objectLookupTwoClasses.offset2, nullptr);
+    } else if (getter == getter0MemberDatagetter0MemberData) {
+        add(objectLookupTwoClasses.ic->protoId, LookupCacheEntry::GetterMemberData, objectLookupTwoClasses.offset, nullptr);
+        add(objectLookupTwoClasses.ic2->protoId, LookupCacheEntry::GetterMemberData, objectLookupTwoClasses.offset2, nullptr);
+    } else if (getter == getterProtoTwoClasses) {
+        add(protoLookupTwoClasses.protoId, LookupCacheEntry::GetterProto, 0, protoLookupTwoClasses.data);
+        add(protoLookupTwoClasses.protoId2, LookupCacheEntry::GetterProto, 0, protoLookupTwoClasses.data2);
+    } else if (getter == getterProtoAccessorTwoClasses) {
+        add(protoLookupTwoClasses.protoId, LookupCacheEntry::GetterProtoAccessor, 0, protoLookupTwoClasses.data);
+        add(protoLookupTwoClasses.protoId2, LookupCacheEntry::GetterProtoAccessor, 0, protoLookupTwoClasses.data2);
+    } else if (setter == setter0) {
+        add(objectLookup.ic->protoId, LookupCacheEntry::Setter, objectLookup.offset, nullptr);
+    } else if (setter == setter0Inline) {
+        add(objectLookup.ic->protoId, LookupCacheEntry::SetterInline, objectLookup.offset, nullptr);
+    } else if (setter == setter0setter0) {
+        add(objectLookupTwoClasses.ic->protoId, LookupCacheEntry::Setter, objectLookupTwoClasses.offset, nullptr);
+        add(objectLookupTwoClasses.ic2->protoId, LookupCacheEntry::Setter, objectLookupTwoClasses.offset2, nullptr);
+    } else {
+        return false;
+    }
+
+    *count = n;
+    return true;
+}
+
+void Lookup::becomePolymorphic(const LookupCacheEntry *entries, uint count)
+{
+    Q_ASSERT(count > 0 && count <= PolymorphicLookupCache::Size);
+    PolymorphicLookupCache *cache = new PolymorphicLookupCache;
+    memcpy(cache->entries, entries, count * sizeof(LookupCacheEntry));
+    cache->size = count;
+
+    const bool isSetter = entries[0].isSetter();
+    clear();
+    polymorphicLookup.cache = cache;
+    if (isSetter)
+        setter = setterPolymorphic;
+    else
+        getter = getterPolymorphic;
+}
+
+void Lookup::becomeMegamorphic(ExecutionEngine *engine, bool isSetter)
+{
+    ++engine->lookupStatistics.transitions;
+    releasePolymorphicCache();
+    clear();
+    if (isSetter)
+        setter = setterMegamorphic;
+    else
+        getter = getterMegamorphic;
+}
+
+ReturnedValue Lookup::getterBecomePolymorphic(ExecutionEngine *engine, const Value &object)
+{
+    LookupCacheEntry entries[2];
+    uint count = 0;
+    if (!toCacheEntries(entries, &count)) {
+        getter = getterFallback;
+        return getterFallback(this, engine, object);
+    }
+    ++engine->lookupStatistics.transitions;
+    becomePolymorphic(entries, count);
+    return getterPolymorphicMiss(engine, object);
+}
+
+bool Lookup::setterBecomePolymorphic(ExecutionEngine *engine, Value &object, const Value &value)
+{
+    LookupCacheEntry entries[2];
+    uint count = 0;
+    if (!toCacheEntries(entries, &count)) {
+        setter = setterFallback;
+        return setterFallback(this, engine, object, value);
+    }
+    ++engine->lookupStatistics.transitions;
+    becomePolymorphic(entries, count);
+    return setterPolymorphicMiss(engine, object, value);
+}
+
+ReturnedValue Lookup::getterPolymorphic(Lookup *l, ExecutionEngine *engine, const Value &object)
+{
+    // we can safely cast to a QV4::Object here. If object is actually a string,
+    // the internal class won't match
+    Heap::Object *o = static_cast<Heap::Object *>(object.heapObject());
+    if (o) {
+        const quintptr protoId = o->internalClass->protoId;
+        const PolymorphicLookupCache *cache = l->polymorphicLookup.cache;
+        for (uint i = 0; i < cache->size; ++i) {
+            if (cache->entries[i].protoId == protoId) {
+                ++engine->lookupStatistics.polymorphicHits;
+                return getFromCacheEntry(cache->entries[i], o, object);
+            }
+        }
+    }
+    return l->getterPolymorphicMiss(engine, object);
+}
+
+ReturnedValue Lookup::getterPolymorphicMiss(ExecutionEngine *engine, const Value &object)
+{
+    ++engine->lookupStatistics.polymorphicMisses;
+    const Object *o = object.as<Object>();
+    if (!o)
+        return getterFallback(this, engine, object);
+
+    PolymorphicLookupCache *cache = polymorphicLookup.cache;
+    if (cache->size < PolymorphicLookupCache::Size && hasDefaultLookupResolution(o)) {
+        Lookup resolved;
+        resolved.clear();
+        resolved.nameIndex = nameIndex;
+        resolved.getter = getterGeneric;
+        ReturnedValue result = resolved.resolveGetter(engine, o);
+        if (!resolved.toCacheEntries(cache->entries + cache->size, &cache->size))
+            becomeMegamorphic(engine, false);
+        return result;
+    }
+
+    becomeMegamorphic(engine, false);
+    return getterMegamorphic(this, engine, object);
+}
+
+ReturnedValue Lookup::getterMegamorphic(Lookup *l, ExecutionEngine *engine, const Value &object)
+{
+    const Object *o = object.as<Object>();
+    if (!o)
+        return getterFallback(l, engine, object);
+
+    Heap::Object *ho = o->d();
+    PropertyKey key = engine->identifierTable->asPropertyKey(engine->currentStackFrame->v4Function->compilationUnit->runtimeStrings[l->nameIndex]);
+    LookupCacheEntry &entry = engine->megamorphicLookupCache->entry(ho->internalClass->protoId, key);
+    if (entry.protoId == ho->internalClass->protoId && entry.key == key.id() && entry.isGetter()) {
+        ++engine->lookupStatistics.megamorphicHits;
+        return getFromCacheEntry(entry, ho, object);
+    }
+
+    ++engine->lookupStatistics.megamorphicMisses;
+    if (!hasDefaultLookupResolution(o))
+        return getterFallback(l, engine, object);
+
+    Lookup resolved;
+    resolved.clear();
+    resolved.nameIndex = l->nameIndex;
+    resolved.getter = getterGeneric;
+    ReturnedValue result = resolved.resolveGetter(engine, o);
+    LookupCacheEntry resolvedEntry;
+    uint count = 0;
+    if (resolved.toCacheEntries(&resolvedEntry, &count)) {
+        resolvedEntry.key = key.id();
+        engine->megamorphicLookupCache->entry(resolvedEntry.protoId, key) = resolvedEntry;
+    }
+    return result;
+}
+
+bool Lookup::setterPolymorphic(Lookup *l, ExecutionEngine *engine, Value &object, const Value &value)
+{
+    // If object is actually a string, the internal class won't match
+    Heap::Object *o = static_cast<Heap::Object *>(object.heapObject());
+    if (o) {
+        const quintptr protoId = o->internalClass->protoId;
+        const PolymorphicLookupCache *cache = l->polymorphicLookup.cache;
+        for (uint i = 0; i < cache->size; ++i) {
+            if (cache->entries[i].protoId == protoId) {
+                ++engine->lookupStatistics.polymorphicHits;
+                setFromCacheEntry(cache->entries[i], engine, o, value);
+                return true;
+            }
+        }
+    }
+    return l->setterPolymorphicMiss(engine, object, value);
+}
+
+bool Lookup::setterPolymorphicMiss(ExecutionEngine *engine, Value &object, const Value &value)
+{
+    ++engine->lookupStatistics.polymorphicMisses;
+    if (!object.isObject())
+        return setterFallback(this, engine, object, value);
+
+    Object *o = static_cast<Object *>(&object);
+    PolymorphicLookupCache *cache = polymorphicLookup.cache;
+    if (cache->size < PolymorphicLookupCache::Size && hasDefaultLookupResolution(o)) {
+        Lookup resolved;
+        resolved.clear();
+        resolved.nameIndex = nameIndex;
+        resolved.setter = setterGeneric;
+        bool result = resolved.resolveSetter(engine, o, value);
+        if (!resolved.toCacheEntries(cache->entries + cache->size, &cache->size))
+            becomeMegamorphic(engine, true);
+        return result;
+    }
+
+    becomeMegamorphic(engine, true);
+    return setterMegamorphic(this, engine, object, value);
+}
+
+bool Lookup::setterMegamorphic(Lookup *l, ExecutionEngine *engine, Value &object, const Value &value)
+{
+    if (!object.isObject())
+        return setterFallback(l, engine, object, value);
+
+    Object *o = static_cast<Object *>(&object);
+    Heap::Object *ho = o->d();
+    PropertyKey key = engine->identifierTable->asPropertyKey(engine->currentStackFrame->v4Function->compilationUnit->runtimeStrings[l->nameIndex]);
+    LookupCacheEntry &entry = engine->megamorphicLookupCache->entry(ho->internalClass->protoId, key);
+    if (entry.protoId == ho->internalClass->protoId && entry.key == key.id() && entry.isSetter()) {
+        ++engine->lookupStatistics.megamorphicHits;
+        setFromCacheEntry(entry, engine, ho, value);
+        return true;
+    }
+
+    ++engine->lookupStatistics.megamorphicMisses;
+    if (!hasDefaultLookupResolution(o))
+        return setterFallback(l, engine, object, value);
+
+    Lookup resolved;
+    resolved.clear();
+    resolved.nameIndex = l->nameIndex;
+    resolved.setter = setterGeneric;
+    bool result = resolved.resolveSetter(engine, o, value);
+    LookupCacheEntry resolvedEntry;
+    uint count = 0;
+    if (resolved.toCacheEntries(&resolvedEntry, &count)) {
+        resolvedEntry.key = key.id();
+        engine->megamorphicLookupCache->entry(resolvedEntry.protoId, key) = resolvedEntry;
+    }
+    return result;
+}
+
 QT_END_NAMESPACE
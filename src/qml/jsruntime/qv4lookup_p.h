@@ -64,6 +64,55 @@ QT_BEGIN_NAMESPACE
 
 namespace QV4 {
 
+// One entry of a polymorphic inline cache or of the megamorphic stub cache. Entries are keyed
+// on the protoId of the object's internal class instead of the class itself. protoIds are unique
+// across the engine and never reused, so an entry can never match a different class, and the
+// caches don't need to keep internal classes alive.
+struct LookupCacheEntry
+{
+    enum Type : quint32 {
+        Empty,
+        GetterInline,
+        GetterMemberData,
+        GetterAccessor,
+        GetterProto,
+        GetterProtoAccessor,
+        Setter,
+        SetterInline
+    };
+
+    quintptr protoId;
+    quint64 key; // only used by the megamorphic cache
+    const Value *data;
+    uint offset;
+    Type type;
+
+    bool isGetter() const { return type >= GetterInline && type <= GetterProtoAccessor; }
+    bool isSetter() const { return type >= Setter; }
+};
+
+struct PolymorphicLookupCache
+{
+    enum { Size = 8 };
+    LookupCacheEntry entries[Size];
+    uint size = 0;
+};
+
+// Shared by all lookups of an engine that have seen too many different classes.
+struct MegamorphicLookupCache
+{
+    enum { Size = 1024 };
+    LookupCacheEntry entries[Size];
+
+    MegamorphicLookupCache() { memset(entries, 0, sizeof(entries)); }
+
+    LookupCacheEntry &entry(quintptr protoId, PropertyKey key)
+    {
+        const quint64 hash = (quint64(protoId) >> 1) ^ (key.id() >> 4) ^ (key.id() >> 12);
+        return entries[hash % Size];
+    }
+};
+
 struct Lookup {
     union {
         ReturnedValue (*getter)(Lookup *l, ExecutionEngine *engine, const Value &object);
@@ -113,6 +162,11 @@ struct Lookup {
             quintptr protoId;
             int offset;
         } insertionLookup;
+        struct {
+            quintptr _unused;
+            quintptr _unused2;
+            PolymorphicLookupCache *cache;
+        } polymorphicLookup;
         struct {
             quintptr _unused;
             quintptr _unused2;
@@ -174,6 +228,8 @@ struct Lookup {
     static ReturnedValue getterProtoAccessor(Lookup *l, ExecutionEngine *engine, const Value &object);
     static ReturnedValue getterProtoAccessorTwoClasses(Lookup *l, ExecutionEngine *engine, const Value &object);
     static ReturnedValue getterIndexed(Lookup *l, ExecutionEngine *engine, const Value &object);
+    static ReturnedValue getterPolymorphic(Lookup *l, ExecutionEngine *engine, const Value &object);
+    static ReturnedValue getterMegamorphic(Lookup *l, ExecutionEngine *engine, const Value &object);
 
     static ReturnedValue primitiveGetterProto(Lookup *l, ExecutionEngine *engine, const Value &object);
     static ReturnedValue primitiveGetterAccessor(Lookup *l, ExecutionEngine *engine, const Value &object);
@@ -192,6 +248,14 @@ struct Lookup {
     static bool setter0setter0(Lookup *l, ExecutionEngine *engine, Value &object, const Value &value);
     static bool setterInsert(Lookup *l, ExecutionEngine *engine, Value &object, const Value &value);
     static bool arrayLengthSetter(Lookup *l, ExecutionEngine *engine, Value &object, const Value &value);
+    static bool setterPolymorphic(Lookup *l, ExecutionEngine *engine, Value &object, const Value &value);
+    static bool setterMegamorphic(Lookup *l, ExecutionEngine *engine, Value &object, const Value &value);
+
+    bool isPolymorphic() const { return getter == getterPolymorphic || setter == setterPolymorphic; }
+    void releasePolymorphicCache() {
+        if (isPolymorphic())
+            delete polymorphicLookup.cache;
+    }
 
     void markObjects(MarkStack *stack) {
         if (markDef.h1 && !(reinterpret_cast<quintptr>(markDef.h1) & 1))
@@ -203,6 +267,15 @@ struct Lookup {
     void clear() {
         memset(&markDef, 0, sizeof(markDef));
     }
+
+private:
+    bool toCacheEntries(LookupCacheEntry *entries, uint *count) const;
+    void becomePolymorphic(const LookupCacheEntry *entries, uint count);
+    void becomeMegamorphic(ExecutionEngine *engine, bool isSetter);
+    ReturnedValue getterBecomePolymorphic(ExecutionEngine *engine, const Value &object);
+    bool setterBecomePolymorphic(ExecutionEngine *engine, Value &object, const Value &value);
+    ReturnedValue getterPolymorphicMiss(ExecutionEngine *engine, const Value &object);
+    bool setterPolymorphicMiss(ExecutionEngine *engine, Value &object, const Value &value);
 };
 
 Q_STATIC_ASSERT(std::is_standard_layout<Lookup>::value);
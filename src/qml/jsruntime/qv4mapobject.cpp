@@ -253,6 +253,7 @@ ReturnedValue WeakMapPrototype::method_set(const FunctionObject *b, const Value
         return scope.engine->throwTypeError();
 
     that->d()->esTable->set(argv[0], argc > 1 ? argv[1] : Value::undefinedValue());
+    WriteBarrier::markDirty(scope.engine, that->d());
     return that.asReturnedValue();
 }
 
@@ -356,6 +357,7 @@ ReturnedValue MapPrototype::method_set(const FunctionObject *b, const Value *thi
         return scope.engine->throwTypeError();
 
     that->d()->esTable->set(argc ? argv[0] : Value::undefinedValue(), argc > 1 ? argv[1] : Value::undefinedValue());
+    WriteBarrier::markDirty(scope.engine, that->d());
     return that.asReturnedValue();
 }
 
@@ -893,7 +893,76 @@ ReturnedValue QObjectWrapper::lookupGetter(Lookup *lookup, ExecutionEngine *engi
 bool QObjectWrapper::virtualResolveLookupSetter(Object *object, ExecutionEngine *engine, Lookup *lookup,
                                                 const Value &value)
 {
-    return Object::virtualResolveLookupSetter(object, engine, lookup, value);
+    // Keep this code in sync with ::virtualPut
+    PropertyKey id = engine->identifierTable->asPropertyKey(engine->currentStackFrame->v4Function->compilationUnit->
+                                                            runtimeStrings[lookup->nameIndex]);
+    if (!id.isString())
+        return Object::virtualResolveLookupSetter(object, engine, lookup, value);
+
+    QObjectWrapper *This = static_cast<QObjectWrapper *>(object);
+    QObject * const qobj = This->d()->object();
+
+    QQmlData *ddata = QQmlData::get(qobj, false);
+    if (engine->hasException || QQmlData::wasDeleted(qobj) || !ddata || !ddata->propertyCache) {
+        lookup->setter = Lookup::setterFallback;
+        return lookup->setter(lookup, engine, *object, value);
+    }
+
+    Scope scope(engine);
+    ScopedString name(scope, id.asStringOrSymbol());
+    QQmlPropertyData *property = ddata->propertyCache->property(name.getPointer(), qobj, engine->callingQmlContext());
+    if (!property) {
+        lookup->setter = Lookup::setterFallback;
+        return lookup->setter(lookup, engine, *object, value);
+    }
+
+    lookup->qobjectLookup.ic = This->internalClass();
+    lookup->qobjectLookup.staticQObject = nullptr;
+    lookup->qobjectLookup.propertyCache = ddata->propertyCache;
+    lookup->qobjectLookup.propertyCache->addref();
+    lookup->qobjectLookup.propertyData = property;
+    lookup->setter = QV4::QObjectWrapper::lookupSetter;
+    return lookup->setter(lookup, engine, *object, value);
+}
+
+bool QObjectWrapper::lookupSetter(Lookup *lookup, ExecutionEngine *engine, Value &object, const Value &value)
+{
+    const auto revertLookup = [lookup, engine, &object, &value]() {
+        lookup->qobjectLookup.propertyCache->release();
+        lookup->qobjectLookup.propertyCache = nullptr;
+        lookup->setter = Lookup::setterGeneric;
+        return Lookup::setterGeneric(lookup, engine, object, value);
+    };
+
+    // we can safely cast to a QV4::Object here. If object is something else,
+    // the internal class won't match
+    Heap::Object *o = static_cast<Heap::Object *>(object.heapObject());
+    if (!o || o->internalClass != lookup->qobjectLookup.ic)
+        return revertLookup();
+
+    QObject *qobj = static_cast<Heap::QObjectWrapper *>(o)->object();
+    if (engine->hasException || QQmlData::wasDeleted(qobj))
+        return false;
+
+    QQmlData *ddata = QQmlData::get(qobj, /*create*/false);
+    if (!ddata)
+        return revertLookup();
+
+    QQmlPropertyData *property = lookup->qobjectLookup.propertyData;
+    if (ddata->propertyCache != lookup->qobjectLookup.propertyCache) {
+        // The object may be of a derived type, as long as that doesn't override the property.
+        if (property->isOverridden())
+            return revertLookup();
+
+        QQmlPropertyCache *fromMo = ddata->propertyCache;
+        while (fromMo && fromMo != lookup->qobjectLookup.propertyCache)
+            fromMo = fromMo->parent();
+        if (!fromMo)
+            return revertLookup();
+    }
+
+    setProperty(engine, qobj, property, value);
+    return true;
 }
 
 namespace QV4 {
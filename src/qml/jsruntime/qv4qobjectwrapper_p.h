@@ -188,6 +188,7 @@ struct Q_QML_EXPORT QObjectWrapper : public Object
     static ReturnedValue lookupGetter(Lookup *l, ExecutionEngine *engine, const Value &object);
     template <typename ReversalFunctor> static ReturnedValue lookupGetterImpl(Lookup *l, ExecutionEngine *engine, const Value &object, bool useOriginalProperty, ReversalFunctor revert);
     static bool virtualResolveLookupSetter(Object *object, ExecutionEngine *engine, Lookup *lookup, const Value &value);
+    static bool lookupSetter(Lookup *l, ExecutionEngine *engine, Value &object, const Value &value);
 
 protected:
     static void setProperty(ExecutionEngine *engine, QObject *object, QQmlPropertyData *property, const Value &value);
@@ -48,6 +48,11 @@
 #include <private/qv4value_p.h>
 #include <private/qv4dateobject_p.h>
 #include <private/qv4regexpobject_p.h>
+#include <private/qv4arraybuffer_p.h>
+#include <private/qv4typedarray_p.h>
+#include <private/qv4mapobject_p.h>
+#include <private/qv4setobject_p.h>
+#include <private/qv4mm_p.h>
 #if QT_CONFIG(qml_sequence_object)
 #include <private/qv4sequenceobject_p.h>
 #endif
@@ -70,6 +75,10 @@ using namespace QV4;
 //    + Number
 //    + Date
 //    + RegExp
+//    + ArrayBuffer, optionally transferred instead of copied
+//    + SharedArrayBuffer, sharing its storage with the receiving engine
+//    + TypedArray
+//    + Map and Set
 // <quint8 type><quint24 size><data>
 
 enum Type {
@@ -86,6 +95,12 @@ enum Type {
     WorkerNumber,
     WorkerDate,
     WorkerRegexp,
+    WorkerArrayBuffer,
+    WorkerTransferredArrayBuffer,
+    WorkerSharedArrayBuffer,
+    WorkerTypedArray,
+    WorkerMap,
+    WorkerSet,
 #if QT_CONFIG(qml_list_model)
     WorkerListModel,
 #endif
@@ -154,7 +169,15 @@ static inline void *popPtr(const char *&data)
 // serialization/deserialization failures
 
 #define ALIGN(size) (((size) + 3) & ~3)
-void Serialize::serialize(QByteArray &data, const QV4::Value &v, ExecutionEngine *engine)
+struct Serialize::Context
+{
+    QVector<QByteArray> &buffers;
+    const Object *transfer;
+    // The buffers whose storage is in buffers, in the same order
+    Object *bufferObjects;
+};
+
+void Serialize::serialize(QByteArray &data, const QV4::Value &v, ExecutionEngine *engine, Context &context)
 {
     QV4::Scope scope(engine);
 
@@ -197,7 +220,7 @@ void Serialize::serialize(QByteArray &data, const QV4::Value &v, ExecutionEngine
         push(data, valueheader(WorkerArray, length));
         ScopedValue val(scope);
         for (uint ii = 0; ii < length; ++ii)
-            serialize(data, (val = array->get(ii)), engine);
+            serialize(data, (val = array->get(ii)), engine, context);
     } else if (v.isInteger()) {
         reserve(data, 2 * sizeof(quint32));
         push(data, valueheader(WorkerInt32));
@@ -233,6 +256,70 @@ void Serialize::serialize(QByteArray &data, const QV4::Value &v, ExecutionEngine
         char *buffer = data.data() + offset;
 
         memcpy(buffer, pattern.constData(), length*sizeof(QChar));
+    } else if (const ArrayBuffer *buffer = v.as<ArrayBuffer>()) {
+        if (context.transfer && !buffer->isDetachedBuffer() && isTransferred(buffer, context.transfer)) {
+            // Hand the storage itself over. The source buffer gets detached once we're done.
+            push(data, valueheader(WorkerTransferredArrayBuffer, addBuffer(context, buffer, buffer->asByteArray())));
+            return;
+        }
+
+        quint32 length = buffer->byteLength();
+        int size = ALIGN(length);
+        reserve(data, 2 * sizeof(quint32) + size);
+        push(data, valueheader(WorkerArrayBuffer));
+        push(data, length);
+
+        int offset = data.size();
+        data.resize(data.size() + size);
+        if (length)
+            memcpy(data.data() + offset, buffer->d()->data->data(), length);
+    } else if (const SharedArrayBuffer *sharedBuffer = v.as<SharedArrayBuffer>()) {
+        // Both engines reference the same storage; its reference count is atomic
+        push(data, valueheader(WorkerSharedArrayBuffer, addBuffer(context, sharedBuffer, sharedBuffer->asByteArray())));
+    } else if (const TypedArray *typedArray = v.as<TypedArray>()) {
+        reserve(data, 3 * sizeof(quint32));
+        push(data, valueheader(WorkerTypedArray, typedArray->arrayType()));
+        push(data, typedArray->d()->byteOffset);
+        push(data, typedArray->length());
+        ScopedValue buffer(scope, typedArray->d()->buffer);
+        serialize(data, buffer, engine, context);
+    } else if (const MapObject *map = v.as<MapObject>()) {
+        if (map->d()->isWeakMap) {
+            push(data, valueheader(WorkerUndefined));
+            return;
+        }
+        ESTable *table = map->d()->esTable;
+        uint size = table->size();
+        if (size > 0xFFFFFF) {
+            push(data, valueheader(WorkerUndefined));
+            return;
+        }
+        push(data, valueheader(WorkerMap, size));
+        ScopedValue key(scope);
+        ScopedValue val(scope);
+        for (uint ii = 0; ii < size; ++ii) {
+            table->iterate(ii, key, val);
+            serialize(data, key, engine, context);
+            serialize(data, val, engine, context);
+        }
+    } else if (const SetObject *set = v.as<SetObject>()) {
+        if (set->d()->isWeakSet) {
+            push(data, valueheader(WorkerUndefined));
+            return;
+        }
+        ESTable *table = set->d()->esTable;
+        uint size = table->size();
+        if (size > 0xFFFFFF) {
+            push(data, valueheader(WorkerUndefined));
+            return;
+        }
+        push(data, valueheader(WorkerSet, size));
+        ScopedValue key(scope);
+        ScopedValue val(scope);
+        for (uint ii = 0; ii < size; ++ii) {
+            table->iterate(ii, key, val);
+            serialize(data, key, engine, context);
+        }
     } else if (const QObjectWrapper *qobjectWrapper = v.as<QV4::QObjectWrapper>()) {
         // XXX TODO: Generalize passing objects between the main thread and worker scripts so
         // that others can trivially plug in their elements.
@@ -262,10 +349,10 @@ void Serialize::serialize(QByteArray &data, const QV4::Value &v, ExecutionEngine
             }
             reserve(data, sizeof(quint32) + length * sizeof(quint32));
             push(data, valueheader(WorkerSequence, length));
-            serialize(data, QV4::Value::fromInt32(QV4::SequencePrototype::metaTypeForSequence(o)), engine); // sequence type
+            serialize(data, QV4::Value::fromInt32(QV4::SequencePrototype::metaTypeForSequence(o)), engine, context); // sequence type
             ScopedValue val(scope);
             for (uint ii = 0; ii < seqLength; ++ii)
-                serialize(data, (val = o->get(ii)), engine); // sequence elements
+                serialize(data, (val = o->get(ii)), engine, context); // sequence elements
 
             return;
         }
@@ -284,14 +371,14 @@ void Serialize::serialize(QByteArray &data, const QV4::Value &v, ExecutionEngine
         QV4::ScopedValue s(scope);
         for (quint32 ii = 0; ii < length; ++ii) {
             s = properties->get(ii);
-            serialize(data, s, engine);
+            serialize(data, s, engine, context);
 
             QV4::String *str = s->as<String>();
             val = o->get(str);
             if (scope.hasException())
                 scope.engine->catchException();
 
-            serialize(data, val, engine);
+            serialize(data, val, engine, context);
         }
         return;
     } else {
@@ -299,7 +386,7 @@ void Serialize::serialize(QByteArray &data, const QV4::Value &v, ExecutionEngine
     }
 }
 
-ReturnedValue Serialize::deserialize(const char *&data, ExecutionEngine *engine)
+ReturnedValue Serialize::deserialize(const char *&data, ExecutionEngine *engine, const QVector<QByteArray> &buffers, Value *bufferObjects)
 {
     quint32 header = popUint32(data);
     Type type = headertype(header);
@@ -331,7 +418,7 @@ ReturnedValue Serialize::deserialize(const char *&data, ExecutionEngine *engine)
         ScopedArrayObject a(scope, engine->newArrayObject());
         ScopedValue v(scope);
         for (quint32 ii = 0; ii < size; ++ii) {
-            v = deserialize(data, engine);
+            v = deserialize(data, engine, buffers, bufferObjects);
             a->put(ii, v);
         }
         return a.asReturnedValue();
@@ -344,8 +431,8 @@ ReturnedValue Serialize::deserialize(const char *&data, ExecutionEngine *engine)
         ScopedString n(scope);
         ScopedValue value(scope);
         for (quint32 ii = 0; ii < size; ++ii) {
-            name = deserialize(data, engine);
-            value = deserialize(data, engine);
+            name = deserialize(data, engine, buffers, bufferObjects);
+            value = deserialize(data, engine, buffers, bufferObjects);
             n = name->asReturnedValue();
             o->put(n, value);
         }
@@ -367,6 +454,67 @@ ReturnedValue Serialize::deserialize(const char *&data, ExecutionEngine *engine)
         data += ALIGN(length * sizeof(quint16));
         return Encode(engine->newRegExpObject(pattern, flags));
     }
+    case WorkerArrayBuffer:
+    {
+        quint32 length = popUint32(data);
+        Scoped<ArrayBuffer> buffer(scope, engine->newArrayBuffer(length));
+        if (length && !scope.hasException())
+            memcpy(buffer->d()->data->data(), data, length);
+        data += ALIGN(length);
+        return buffer.asReturnedValue();
+    }
+    case WorkerTransferredArrayBuffer:
+    case WorkerSharedArrayBuffer:
+    {
+        // A buffer that is referenced more than once, e.g. by a view on it, is
+        // deserialized only once, to keep the identity of the sent objects
+        quint32 index = headersize(header);
+        Q_ASSERT(int(index) < buffers.size());
+        Value &buffer = bufferObjects[index];
+        if (buffer.isUndefined()) {
+            if (type == WorkerTransferredArrayBuffer)
+                buffer = engine->newArrayBuffer(buffers.at(index));
+            else
+                buffer = engine->memoryManager->allocate<SharedArrayBuffer>(buffers.at(index));
+        }
+        return buffer.asReturnedValue();
+    }
+    case WorkerTypedArray:
+    {
+        quint32 arrayType = headersize(header);
+        Value *arguments = scope.alloc(3);
+        arguments[1] = Encode(popUint32(data));
+        arguments[2] = Encode(popUint32(data));
+        arguments[0] = deserialize(data, engine, buffers, bufferObjects);
+        if (arrayType >= NTypedArrayTypes)
+            return QV4::Encode::undefined();
+        return engine->typedArrayCtors[arrayType].callAsConstructor(arguments, 3);
+    }
+    case WorkerMap:
+    {
+        quint32 size = headersize(header);
+        ScopedFunctionObject ctor(scope, engine->mapCtor());
+        ScopedObject map(scope, ctor->callAsConstructor(nullptr, 0));
+        Value *entry = scope.alloc(2);
+        for (quint32 ii = 0; ii < size; ++ii) {
+            entry[0] = deserialize(data, engine, buffers, bufferObjects);
+            entry[1] = deserialize(data, engine, buffers, bufferObjects);
+            MapPrototype::method_set(ctor, map, entry, 2);
+        }
+        return map.asReturnedValue();
+    }
+    case WorkerSet:
+    {
+        quint32 size = headersize(header);
+        ScopedFunctionObject ctor(scope, engine->setCtor());
+        ScopedObject set(scope, ctor->callAsConstructor(nullptr, 0));
+        ScopedValue key(scope);
+        for (quint32 ii = 0; ii < size; ++ii) {
+            key = deserialize(data, engine, buffers, bufferObjects);
+            SetPrototype::method_add(ctor, set, key, 1);
+        }
+        return set.asReturnedValue();
+    }
 #if QT_CONFIG(qml_list_model)
     case WorkerListModel:
     {
@@ -392,12 +540,12 @@ ReturnedValue Serialize::deserialize(const char *&data, ExecutionEngine *engine)
         bool succeeded = false;
         quint32 length = headersize(header);
         quint32 seqLength = length - 1;
-        value = deserialize(data, engine);
+        value = deserialize(data, engine, buffers, bufferObjects);
         int sequenceType = value->integerValue();
         ScopedArrayObject array(scope, engine->newArrayObject());
         array->arrayReserve(seqLength);
         for (quint32 ii = 0; ii < seqLength; ++ii) {
-            value = deserialize(data, engine);
+            value = deserialize(data, engine, buffers, bufferObjects);
             array->arrayPut(ii, value);
         }
         array->setArrayLengthUnchecked(seqLength);
@@ -410,17 +558,89 @@ ReturnedValue Serialize::deserialize(const char *&data, ExecutionEngine *engine)
     return QV4::Encode::undefined();
 }
 
-QByteArray Serialize::serialize(const QV4::Value &value, ExecutionEngine *engine)
+SerializedData Serialize::serialize(const QV4::Value &value, ExecutionEngine *engine)
 {
-    QByteArray rv;
-    serialize(rv, value, engine);
+    return serialize(value, engine, nullptr);
+}
+
+/*!
+    \internal
+
+    Serializes \a value like the structured clone algorithm would, moving the
+    storage of the ArrayBuffers listed in the \a transferList array instead of
+    copying it. The transferred buffers are detached afterwards, so that their
+    contents are only reachable from the engine deserializing the data.
+*/
+SerializedData Serialize::serialize(const QV4::Value &value, const QV4::Value &transferList, ExecutionEngine *engine)
+{
+    Scope scope(engine);
+    ScopedObject transfer(scope, transferList.as<ArrayObject>());
+
+    SerializedData rv = serialize(value, engine, transfer);
+
+    if (transfer) {
+        Scoped<ArrayBuffer> buffer(scope);
+        uint length = transfer->getLength();
+        for (uint ii = 0; ii < length; ++ii) {
+            buffer = transfer->get(ii);
+            if (buffer)
+                buffer->detachArrayBuffer();
+        }
+    }
     return rv;
 }
 
-ReturnedValue Serialize::deserialize(const QByteArray &data, ExecutionEngine *engine)
+SerializedData Serialize::serialize(const QV4::Value &value, ExecutionEngine *engine, const Object *transfer)
 {
-    const char *stream = data.constData();
-    return deserialize(stream, engine);
+    Scope scope(engine);
+    ScopedObject bufferObjects(scope, engine->newArrayObject());
+
+    SerializedData rv;
+    Context context = { rv.buffers, transfer, bufferObjects };
+    serialize(rv.data, value, engine, context);
+    return rv;
+}
+
+/*!
+    \internal
+
+    Returns the index of \a buffer in the buffers sent along with the data,
+    adding its \a storage if the buffer wasn't seen before.
+*/
+quint32 Serialize::addBuffer(Context &context, const Object *buffer, const QByteArray &storage)
+{
+    Scope scope(buffer->engine());
+    ScopedValue entry(scope);
+    const uint count = context.buffers.size();
+    for (uint ii = 0; ii < count; ++ii) {
+        entry = context.bufferObjects->get(ii);
+        if (entry->heapObject() == buffer->d())
+            return ii;
+    }
+    context.bufferObjects->put(count, *buffer);
+    context.buffers.append(storage);
+    return count;
+}
+
+bool Serialize::isTransferred(const ArrayBuffer *buffer, const Object *transferList)
+{
+    Scope scope(transferList->engine());
+    ScopedValue entry(scope);
+    uint length = transferList->getLength();
+    for (uint ii = 0; ii < length; ++ii) {
+        entry = transferList->get(ii);
+        if (entry->heapObject() == buffer->d())
+            return true;
+    }
+    return false;
+}
+
+ReturnedValue Serialize::deserialize(const SerializedData &data, ExecutionEngine *engine)
+{
+    Scope scope(engine);
+    Value *bufferObjects = scope.alloc(data.buffers.size());
+    const char *stream = data.data.constData();
+    return deserialize(stream, engine, data.buffers, bufferObjects);
 }
 
 QT_END_NAMESPACE
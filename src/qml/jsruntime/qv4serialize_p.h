@@ -52,21 +52,37 @@
 //
 
 #include <QtCore/qbytearray.h>
+#include <QtCore/qvector.h>
 #include <private/qv4value_p.h>
 
 QT_BEGIN_NAMESPACE
 
 namespace QV4 {
 
+// The storage of transferred and shared array buffers travels next to the
+// serialized data, so that it is released with the message even if the
+// message is never deserialized.
+struct SerializedData
+{
+    QByteArray data;
+    QVector<QByteArray> buffers;
+};
+
 class Serialize {
 public:
 
-    static QByteArray serialize(const Value &, ExecutionEngine *);
-    static ReturnedValue deserialize(const QByteArray &, ExecutionEngine *);
+    static SerializedData serialize(const Value &, ExecutionEngine *);
+    static SerializedData serialize(const Value &, const Value &transferList, ExecutionEngine *);
+    static ReturnedValue deserialize(const SerializedData &, ExecutionEngine *);
 
 private:
-    static void serialize(QByteArray &, const Value &, ExecutionEngine *);
-    static ReturnedValue deserialize(const char *&, ExecutionEngine *);
+    struct Context;
+
+    static void serialize(QByteArray &, const Value &, ExecutionEngine *, Context &);
+    static SerializedData serialize(const Value &, ExecutionEngine *, const Object *transfer);
+    static quint32 addBuffer(Context &, const Object *buffer, const QByteArray &storage);
+    static bool isTransferred(const ArrayBuffer *buffer, const Object *transferList);
+    static ReturnedValue deserialize(const char *&, ExecutionEngine *, const QVector<QByteArray> &buffers, Value *bufferObjects);
 };
 
 }
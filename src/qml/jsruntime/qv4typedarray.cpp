@@ -359,7 +359,7 @@ ReturnedValue TypedArrayCtor::virtualCallAsConstructor(const FunctionObject *f,
         updateProto(scope, array);
         return array.asReturnedValue();
     }
-    Scoped<ArrayBuffer> buffer(scope, argc ? argv[0] : Value::undefinedValue());
+    Scoped<SharedArrayBuffer> buffer(scope, argc ? argv[0] : Value::undefinedValue());
     if (!!buffer) {
         // ECMA 6 22.2.1.4
 
@@ -391,7 +391,8 @@ ReturnedValue TypedArrayCtor::virtualCallAsConstructor(const FunctionObject *f,
         }
 
         Scoped<TypedArray> array(scope, TypedArray::create(scope.engine, that->d()->type));
-        array->d()->buffer.set(scope.engine, buffer->d());
+        // Views on a SharedArrayBuffer only use the parts shared with ArrayBuffer
+        array->d()->buffer.set(scope.engine, static_cast<Heap::ArrayBuffer *>(buffer->d()));
         array->d()->byteLength = byteLength;
         array->d()->byteOffset = byteOffset;
 
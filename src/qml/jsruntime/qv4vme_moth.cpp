@@ -62,6 +62,7 @@
 #include "qv4alloca_p.h"
 
 #include <private/qv4baselinejit_p.h>
+#include <private/qv4backgroundjit_p.h>
 
 #undef COUNT_INSTRUCTIONS
 
@@ -424,10 +425,16 @@ ReturnedValue VME::exec(CppStackFrame *frame, ExecutionEngine *engine)
 #ifdef V4_ENABLE_JIT
     if (debugger == nullptr) {
         if (function->jittedCode == nullptr) {
-            if (engine->canJIT(function))
-                QV4::JIT::BaselineJIT(function).generate();
-            else
+            if (engine->backgroundJIT)
+                engine->backgroundJIT->publishCompiledFunctions();
+        }
+        if (function->jittedCode == nullptr) {
+            if (!engine->canJIT(function))
                 ++function->interpreterCallCount;
+            else if (engine->backgroundJIT)
+                engine->backgroundJIT->enqueue(function);
+            else
+                QV4::JIT::BaselineJIT(function).generate();
         }
         if (function->jittedCode != nullptr)
             return function->jittedCode(frame, engine);
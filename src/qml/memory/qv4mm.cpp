@@ -54,7 +54,12 @@
 
 #include <QElapsedTimer>
 #include <QMap>
+#include <QMutex>
+#include <QRunnable>
 #include <QScopedValueRollback>
+#include <QThread>
+#include <QThreadPool>
+#include <QWaitCondition>
 
 #include <iostream>
 #include <cstdlib>
@@ -300,16 +305,52 @@ static void increaseFreedCountForClass(const char *className)
 //bool Chunk::sweep(ClassDestroyStatsCallback classCountPtr)
 bool Chunk::sweep(ExecutionEngine *engine)
 {
-    bool hasUsedSlots = false;
-    SDUMP() << "sweeping chunk" << this;
+    destroyUnmarkedObjects();
+    uint freedSlots = 0;
+    bool hasUsedSlots = sweepSlots(&freedSlots);
+    Q_V4_PROFILE_DEALLOC(engine, freedSlots * Chunk::SlotSize, Profiling::SmallItem);
+    return hasUsedSlots;
+}
+
+// Calls the destructors of all objects that haven't been marked. This has to
+// happen on the engine's thread.
+void Chunk::destroyUnmarkedObjects()
+{
     HeapItem *o = realBase();
-    bool lastSlotFree = false;
     for (uint i = 0; i < Chunk::EntriesInBitmap; ++i) {
-#if WRITEBARRIER(none)
         Q_ASSERT((grayBitmap[i] | blackBitmap[i]) == blackBitmap[i]); // check that we don't have gray only objects
-#endif
         quintptr toFree = objectBitmap[i] ^ blackBitmap[i];
         Q_ASSERT((toFree & objectBitmap[i]) == toFree); // check all black objects are marked as being used
+        while (toFree) {
+            uint index = qCountTrailingZeroBits(toFree);
+            toFree ^= (static_cast<quintptr>(1) << index); // mask out freed slot
+
+            HeapItem *itemToFree = o + index;
+            Heap::Base *b = *itemToFree;
+            const VTable *v = b->internalClass->vtable;
+//            if (Q_UNLIKELY(classCountPtr))
+//                classCountPtr(v->className);
+            if (v->destroy) {
+                v->destroy(b);
+                b->_checkIsDestroyed();
+            }
+#ifdef V4_USE_HEAPTRACK
+            heaptrack_report_free(itemToFree);
+#endif
+        }
+        o += Chunk::Bits;
+    }
+}
+
+// Frees the slots of all unmarked objects. Only touches the bitmaps, so it can
+// run on a different thread once destroyUnmarkedObjects() has been called.
+bool Chunk::sweepSlots(uint *freedSlots)
+{
+    bool hasUsedSlots = false;
+    SDUMP() << "sweeping chunk" << this;
+    bool lastSlotFree = false;
+    for (uint i = 0; i < Chunk::EntriesInBitmap; ++i) {
+        quintptr toFree = objectBitmap[i] ^ blackBitmap[i];
         quintptr e = extendsBitmap[i];
         SDUMP() << "   index=" << i;
         SDUMP() << "        toFree      =" << binary(toFree);
@@ -333,23 +374,8 @@ bool Chunk::sweep(ExecutionEngine *engine)
             Q_ASSERT(qCountTrailingZeroBits(result) - index != 0); // ensure we freed something
             result |= mask; // ensure we don't clear stuff to the right of the current object
             e &= result;
-
-            HeapItem *itemToFree = o + index;
-            Heap::Base *b = *itemToFree;
-            const VTable *v = b->internalClass->vtable;
-//            if (Q_UNLIKELY(classCountPtr))
-//                classCountPtr(v->className);
-            if (v->destroy) {
-                v->destroy(b);
-                b->_checkIsDestroyed();
-            }
-#ifdef V4_USE_HEAPTRACK
-            heaptrack_report_free(itemToFree);
-#endif
         }
-        Q_V4_PROFILE_DEALLOC(engine, qPopulationCount((objectBitmap[i] | extendsBitmap[i])
-                                                      - (blackBitmap[i] | e)) * Chunk::SlotSize,
-                             Profiling::SmallItem);
+        *freedSlots += qPopulationCount((objectBitmap[i] | extendsBitmap[i]) - (blackBitmap[i] | e));
         objectBitmap[i] = blackBitmap[i];
         grayBitmap[i] = 0;
         hasUsedSlots |= (blackBitmap[i] != 0);
@@ -358,7 +384,6 @@ bool Chunk::sweep(ExecutionEngine *engine)
         SDUMP() << "        new extends =" << binary(e);
         SDUMP() << "        lastSlotFree" << lastSlotFree;
         Q_ASSERT((objectBitmap[i] & extendsBitmap[i]) == 0);
-        o += Chunk::Bits;
     }
     //    DEBUG << "swept chunk" << this << "freed" << slotsFreed << "slots.";
     return hasUsedSlots;
@@ -411,6 +436,8 @@ void Chunk::freeAll(ExecutionEngine *engine)
 void Chunk::resetBlackBits()
 {
     memset(blackBitmap, 0, sizeof(blackBitmap));
+    // gray bits are only meaningful for black objects
+    memset(grayBitmap, 0, sizeof(grayBitmap));
 }
 
 void Chunk::collectGrayItems(MarkStack *markStack)
@@ -418,9 +445,7 @@ void Chunk::collectGrayItems(MarkStack *markStack)
     //    DEBUG << "sweeping chunk" << this << (*freeList);
     HeapItem *o = realBase();
     for (uint i = 0; i < Chunk::EntriesInBitmap; ++i) {
-#if WRITEBARRIER(none)
         Q_ASSERT((grayBitmap[i] | blackBitmap[i]) == blackBitmap[i]); // check that we don't have gray only objects
-#endif
         quintptr toMark = blackBitmap[i] & grayBitmap[i]; // correct for a Steele type barrier
         Q_ASSERT((toMark & objectBitmap[i]) == toMark); // check all black objects are marked as being used
         //        DEBUG << hex << "   index=" << i << toFree;
@@ -435,6 +460,8 @@ void Chunk::collectGrayItems(MarkStack *markStack)
             Heap::Base *b = *itemToFree;
             Q_ASSERT(b->inUse());
             markStack->push(b);
+            if (markStack->top >= markStack->limit)
+                markStack->drain();
         }
         grayBitmap[i] = 0;
         o += Chunk::Bits;
@@ -443,7 +470,7 @@ void Chunk::collectGrayItems(MarkStack *markStack)
 
 }
 
-void Chunk::sortIntoBins(HeapItem **bins, uint nBins)
+void Chunk::sortIntoBins(HeapItem **bins, uint nBins, HeapItem **tails)
 {
 //    qDebug() << "sortIntoBins:";
     HeapItem *base = realBase();
@@ -497,6 +524,8 @@ void Chunk::sortIntoBins(HeapItem **bins, uint nBins)
             Q_ASSERT(freeEnd > freeStart && freeEnd <= NumSlots);
             freeItem->freeData.availableSlots = nSlots;
             uint bin = qMin(nBins - 1, nSlots);
+            if (tails && !bins[bin])
+                tails[bin] = freeItem;
             freeItem->freeData.next = bins[bin];
             bins[bin] = freeItem;
         }
@@ -517,6 +546,8 @@ HeapItem *BlockAllocator::allocate(size_t size, bool forceAllocation) {
 
     HeapItem *m;
 
+retry:
+
     if (slotsRequired < NumBins - 1) {
         m = freeBins[slotsRequired];
         if (m) {
@@ -585,6 +616,9 @@ HeapItem *BlockAllocator::allocate(size_t size, bool forceAllocation) {
         }
     }
 
+    if (!m && isSweeping() && collectSweptChunks(/*wait*/ true))
+        goto retry;
+
     if (!m) {
         if (!forceAllocation)
             return nullptr;
@@ -600,6 +634,14 @@ HeapItem *BlockAllocator::allocate(size_t size, bool forceAllocation) {
 
 done:
     m->setAllocatedSlots(slotsRequired);
+    if (Q_UNLIKELY(allocateBlack)) {
+        // allocate black during incremental marking, and gray so that the final marking
+        // step scans the object once it has been initialized
+        Chunk *c = m->chunk();
+        size_t index = m - c->realBase();
+        Chunk::setBit(c->blackBitmap, index);
+        Chunk::setBit(c->grayBitmap, index);
+    }
     Q_V4_PROFILE_ALLOC(engine, slotsRequired * Chunk::SlotSize, Profiling::SmallItem);
 #ifdef V4_USE_HEAPTRACK
     heaptrack_report_alloc(m, slotsRequired * Chunk::SlotSize);
@@ -636,6 +678,176 @@ void BlockAllocator::sweep()
     chunks.erase(firstEmptyChunk, chunks.end());
 }
 
+struct SweptChunk {
+    HeapItem *bins[BlockAllocator::NumBins];
+    HeapItem *tails[BlockAllocator::NumBins];
+    uint usedSlots;
+    uint freedSlots;
+    bool hasUsedSlots;
+};
+
+// Shared between a BlockAllocator and the helper thread sweeping its chunks. Chunks are
+// claimed through nextChunk, so that the allocator can sweep chunks itself instead of
+// waiting for the helper thread.
+struct ConcurrentSweep
+{
+    ConcurrentSweep(const std::vector<Chunk *> &chunks, bool keepBlackBits)
+        : chunks(chunks), results(chunks.size()), keepBlackBits(keepBlackBits)
+    {
+        memset(results.data(), 0, results.size() * sizeof(SweptChunk));
+    }
+
+    void sweepChunk(int index)
+    {
+        Chunk *c = chunks[index];
+        SweptChunk &r = results[index];
+        r.hasUsedSlots = c->sweepSlots(&r.freedSlots);
+        if (r.hasUsedSlots) {
+            c->sortIntoBins(r.bins, BlockAllocator::NumBins, r.tails);
+            r.usedSlots = c->nUsedSlots();
+        }
+        if (!keepBlackBits)
+            c->resetBlackBits();
+    }
+
+    const std::vector<Chunk *> chunks;
+    std::vector<SweptChunk> results;
+    const bool keepBlackBits;
+    QAtomicInt nextChunk;
+    int nCollected = 0; // only accessed by the allocator
+
+    QMutex mutex;
+    QWaitCondition sweptCondition;
+    std::vector<int> swept; // swept by the helper thread, but not collected yet
+};
+
+class ConcurrentSweepJob : public QRunnable
+{
+public:
+    ConcurrentSweepJob(const QSharedPointer<ConcurrentSweep> &sweep) : sweep(sweep) {}
+
+    void run() override
+    {
+        const int nChunks = int(sweep->chunks.size());
+        int index;
+        while ((index = sweep->nextChunk.fetchAndAddRelaxed(1)) < nChunks) {
+            sweep->sweepChunk(index);
+            QMutexLocker locker(&sweep->mutex);
+            sweep->swept.push_back(index);
+            sweep->sweptCondition.wakeAll();
+        }
+    }
+
+private:
+    QSharedPointer<ConcurrentSweep> sweep;
+};
+
+Q_GLOBAL_STATIC(QThreadPool, sweeperThreadPool)
+
+void BlockAllocator::destroyUnmarkedObjects()
+{
+    for (auto c : chunks)
+        c->destroyUnmarkedObjects();
+}
+
+void BlockAllocator::startConcurrentSweep()
+{
+    Q_ASSERT(!isSweeping());
+    nextFree = nullptr;
+    nFree = 0;
+    memset(freeBins, 0, sizeof(freeBins));
+    usedSlotsAfterLastSweep = 0;
+
+    if (chunks.empty())
+        return;
+
+    concurrentSweep = QSharedPointer<ConcurrentSweep>::create(chunks, generational);
+    sweeperThreadPool()->start(new ConcurrentSweepJob(concurrentSweep));
+}
+
+// Hands the free slots of swept chunks to the allocator. If wait is true, and no chunk
+// has been swept yet, sweeps one itself or waits for the helper thread. Returns true
+// if any chunk was collected.
+bool BlockAllocator::collectSweptChunks(bool wait)
+{
+    if (!isSweeping())
+        return false;
+
+    ConcurrentSweep *sweep = concurrentSweep.data();
+    const int nChunks = int(sweep->chunks.size());
+
+    auto collect = [this, sweep](int index) {
+        const SweptChunk &r = sweep->results[index];
+        Q_V4_PROFILE_DEALLOC(engine, r.freedSlots * Chunk::SlotSize, Profiling::SmallItem);
+        if (r.hasUsedSlots) {
+            for (uint i = 0; i < NumBins; ++i) {
+                if (!r.bins[i])
+                    continue;
+                r.tails[i]->freeData.next = freeBins[i];
+                freeBins[i] = r.bins[i];
+            }
+            usedSlotsAfterLastSweep += r.usedSlots;
+        }
+        ++sweep->nCollected;
+    };
+
+    bool collected = false;
+    while (true) {
+        std::vector<int> swept;
+        {
+            QMutexLocker locker(&sweep->mutex);
+            if (wait && sweep->swept.empty() && sweep->nCollected < nChunks
+                    && sweep->nextChunk.load() >= nChunks) {
+                // all remaining chunks are being swept by the helper thread
+                sweep->sweptCondition.wait(&sweep->mutex);
+            }
+            std::swap(swept, sweep->swept);
+        }
+        for (int index : swept) {
+            collect(index);
+            collected = true;
+        }
+
+        if (!collected && wait) {
+            const int index = sweep->nextChunk.fetchAndAddRelaxed(1);
+            if (index < nChunks) {
+                sweep->sweepChunk(index);
+                collect(index);
+                collected = true;
+            }
+        }
+
+        if (sweep->nCollected == nChunks)
+            break;
+        if (collected || !wait)
+            return collected;
+    }
+
+    // All chunks are swept. Only free the empty ones now, to avoid that the sweeping
+    // accesses freed memory. Chunks allocated in the meantime got appended to the vector.
+    std::vector<Chunk *> usedChunks;
+    usedChunks.reserve(chunks.size());
+    for (size_t i = 0; i < chunks.size(); ++i) {
+        if (i < size_t(nChunks) && !sweep->results[i].hasUsedSlots) {
+            Q_ASSERT(chunks[i] == sweep->chunks[i]);
+            Q_V4_PROFILE_DEALLOC(engine, Chunk::DataSize, Profiling::HeapPage);
+            chunkAllocator->free(chunks[i]);
+        } else {
+            usedChunks.push_back(chunks[i]);
+        }
+    }
+    chunks.swap(usedChunks);
+
+    concurrentSweep.reset();
+    return collected;
+}
+
+void BlockAllocator::finishSweep()
+{
+    while (isSweeping())
+        collectSweptChunks(true);
+}
+
 void BlockAllocator::freeAll()
 {
     for (auto c : chunks)
@@ -648,12 +860,15 @@ void BlockAllocator::freeAll()
 
 void BlockAllocator::resetBlackBits()
 {
+    if (isSweeping())
+        return; // done by the concurrent sweep
     for (auto c : chunks)
         c->resetBlackBits();
 }
 
 void BlockAllocator::collectGrayItems(MarkStack *markStack)
 {
+    Q_ASSERT(!isSweeping());
     for (auto c : chunks)
         c->collectGrayItems(markStack);
 
@@ -675,6 +890,10 @@ HeapItem *HugeItemAllocator::allocate(size_t size) {
     Q_ASSERT(c);
     chunks.push_back(HugeChunk{m, c, size});
     Chunk::setBit(c->objectBitmap, c->first() - c->realBase());
+    if (Q_UNLIKELY(allocateBlack)) {
+        Chunk::setBit(c->blackBitmap, c->first() - c->realBase());
+        Chunk::setBit(c->grayBitmap, c->first() - c->realBase());
+    }
     Q_V4_PROFILE_ALLOC(engine, size, Profiling::LargeItem);
 #ifdef V4_USE_HEAPTRACK
     heaptrack_report_alloc(c, size);
@@ -710,7 +929,8 @@ void HugeItemAllocator::sweep(ClassDestroyStatsCallback classCountPtr)
 {
     auto isBlack = [this, classCountPtr] (const HugeChunk &c) {
         bool b = c.chunk->first()->isBlack();
-        Chunk::clearBit(c.chunk->blackBitmap, c.chunk->first() - c.chunk->realBase());
+        if (!generational)
+            Chunk::clearBit(c.chunk->blackBitmap, c.chunk->first() - c.chunk->realBase());
         if (!b) {
             Q_V4_PROFILE_DEALLOC(engine, c.size, Profiling::LargeItem);
             freeHugeChunk(chunkAllocator, c, classCountPtr);
@@ -724,20 +944,27 @@ void HugeItemAllocator::sweep(ClassDestroyStatsCallback classCountPtr)
 
 void HugeItemAllocator::resetBlackBits()
 {
-    for (auto c : chunks)
+    for (auto c : chunks) {
         Chunk::clearBit(c.chunk->blackBitmap, c.chunk->first() - c.chunk->realBase());
+        Chunk::clearBit(c.chunk->grayBitmap, c.chunk->first() - c.chunk->realBase());
+    }
 }
 
 void HugeItemAllocator::collectGrayItems(MarkStack *markStack)
 {
-    for (auto c : chunks)
+    for (auto c : chunks) {
         // Correct for a Steele type barrier
-        if (Chunk::testBit(c.chunk->blackBitmap, c.chunk->first() - c.chunk->realBase()) &&
-            Chunk::testBit(c.chunk->grayBitmap, c.chunk->first() - c.chunk->realBase())) {
+        const size_t index = c.chunk->first() - c.chunk->realBase();
+        if (Chunk::testBit(c.chunk->blackBitmap, index) &&
+            Chunk::testBit(c.chunk->grayBitmap, index)) {
             HeapItem *i = c.chunk->first();
             Heap::Base *b = *i;
-            b->mark(markStack);
+            markStack->push(b);
+            if (markStack->top >= markStack->limit)
+                markStack->drain();
         }
+        Chunk::clearBit(c.chunk->grayBitmap, index);
+    }
 }
 
 void HugeItemAllocator::freeAll()
@@ -762,6 +989,25 @@ MemoryManager::MemoryManager(ExecutionEngine *engine)
     , gcStats(lcGcStats().isDebugEnabled())
     , gcCollectorStats(lcGcAllocatorStats().isDebugEnabled())
 {
+    // Sweeping on a helper thread makes the collector statistics meaningless.
+    bool ok;
+    const int sweepEnv = qEnvironmentVariableIntValue(QV4_MM_CONCURRENT_SWEEP, &ok);
+    concurrentSweep = (!ok || sweepEnv != 0) && QThread::idealThreadCount() > 1
+            && !aggressiveGC && !gcCollectorStats;
+
+    // Incremental and generational collection are exclusive, as both use the gray bits.
+    if (!qEnvironmentVariableIsEmpty(QV4_MM_INCREMENTAL_GC)) {
+        incrementalGCSliceUsecs = qEnvironmentVariableIntValue(QV4_MM_INCREMENTAL_GC, &ok);
+        if (!ok || incrementalGCSliceUsecs <= 0)
+            incrementalGCSliceUsecs = 1000;
+    } else if (!qEnvironmentVariableIsEmpty(QV4_MM_GENERATIONAL_GC)) {
+        // The write barrier stays active, and records the old objects written to
+        generationalGC = true;
+        blockAllocator.generational = true;
+        icAllocator.generational = true;
+        hugeItemAllocator.generational = true;
+        engine->writeBarrierActive = true;
+    }
 #ifdef V4_USE_VALGRIND
     VALGRIND_CREATE_MEMPOOL(this, 0, true);
 #endif
@@ -859,6 +1105,33 @@ void MarkStack::drain()
     }
 }
 
+bool MarkStack::drain(QDeadlineTimer deadline)
+{
+    enum { ObjectsBetweenDeadlineChecks = 64 };
+    while (top > base) {
+        for (int i = 0; i < ObjectsBetweenDeadlineChecks && top > base; ++i) {
+            Heap::Base *h = pop();
+            ++markStackSize;
+            Q_ASSERT(h);
+            h->internalClass->vtable->markObjects(h, this);
+        }
+        if (deadline.hasExpired())
+            return top == base;
+    }
+    return true;
+}
+
+void WriteBarrier::markGraySlowPath(Heap::Base *base)
+{
+    // Only black objects need to be rescanned. White ones will be scanned anyway
+    // should they get marked later on.
+    const HeapItem *h = reinterpret_cast<const HeapItem *>(base);
+    Chunk *c = h->chunk();
+    size_t index = h - c->realBase();
+    if (Chunk::testBit(c->blackBitmap, index))
+        Chunk::setBit(c->grayBitmap, index);
+}
+
 void MemoryManager::collectRoots(MarkStack *markStack)
 {
     engine->markObjects(markStack);
@@ -904,13 +1177,22 @@ void MemoryManager::collectRoots(MarkStack *markStack)
     }
 }
 
-void MemoryManager::mark()
+void MemoryManager::mark(GCType type)
 {
     markStackSize = 0;
 
     MarkStack markStack(engine);
     collectRoots(&markStack);
 
+    if (type == MinorGC) {
+        // Old objects are black already, and marking stops at them. The ones that got
+        // written to since the last collection have been grayed by the write barrier
+        // and form the remembered set.
+        blockAllocator.collectGrayItems(&markStack);
+        hugeItemAllocator.collectGrayItems(&markStack);
+        icAllocator.collectGrayItems(&markStack);
+    }
+
     markStack.drain();
 }
 
@@ -985,16 +1267,40 @@ void MemoryManager::sweep(bool lastSweep, ClassDestroyStatsCallback classCountPt
 
     if (!lastSweep) {
         engine->identifierTable->sweep();
-        blockAllocator.sweep(/*classCountPtr*/);
-        hugeItemAllocator.sweep(classCountPtr);
-        icAllocator.sweep(/*classCountPtr*/);
+        if (concurrentSweep && !classCountPtr) {
+            // All destructors run here before handing the chunks to the helper thread,
+            // as they can have side effects and access other unmarked objects.
+            blockAllocator.destroyUnmarkedObjects();
+            hugeItemAllocator.sweep(classCountPtr);
+            icAllocator.destroyUnmarkedObjects();
+            blockAllocator.startConcurrentSweep();
+            icAllocator.startConcurrentSweep();
+        } else {
+            blockAllocator.sweep(/*classCountPtr*/);
+            hugeItemAllocator.sweep(classCountPtr);
+            icAllocator.sweep(/*classCountPtr*/);
+        }
     }
 }
 
+void MemoryManager::finishSweep()
+{
+    if (!blockAllocator.isSweeping() && !icAllocator.isSweeping())
+        return;
+    blockAllocator.finishSweep();
+    icAllocator.finishSweep();
+    if (lastGCType == FullGC)
+        usedSlotsAfterLastFullSweep = blockAllocator.usedSlotsAfterLastSweep + icAllocator.usedSlotsAfterLastSweep;
+}
+
 bool MemoryManager::shouldRunGC() const
 {
+    if (blockAllocator.isSweeping() || icAllocator.isSweeping())
+        return false; // the previous collection hasn't completed yet
     size_t total = blockAllocator.totalSlots() + icAllocator.totalSlots();
-    if (total > MinSlotsGCLimit && usedSlotsAfterLastFullSweep * GCOverallocation < total * 100)
+    // The concurrent sweep may have completed while allocating, so don't rely on usedSlotsAfterLastFullSweep
+    size_t usedSlots = blockAllocator.usedSlotsAfterLastSweep + icAllocator.usedSlotsAfterLastSweep;
+    if (total > MinSlotsGCLimit && usedSlots * GCOverallocation < total * 100)
         return true;
     return false;
 }
@@ -1028,23 +1334,47 @@ size_t dumpBins(BlockAllocator *b, bool printOutput = true)
     return totalSlotMem*Chunk::SlotSize;
 }
 
-void MemoryManager::runGC()
+void MemoryManager::runGC(GCType type)
 {
     if (gcBlocked) {
 //        qDebug() << "Not running GC.";
         return;
     }
 
+    if (incrementalGCInProgress()) {
+        finishIncrementalGC();
+        return;
+    }
+
     QScopedValueRollback<bool> gcBlocker(gcBlocked, true);
 //    qDebug() << "runGC";
 
+    QElapsedTimer pauseTimer;
+    pauseTimer.start();
+
+    finishSweep();
+
+    if (type == MinorGC) {
+        // Too much has been promoted since the last full collection
+        const size_t usedSlots = blockAllocator.usedSlotsAfterLastSweep + icAllocator.usedSlotsAfterLastSweep;
+        if (!generationalGC || usedSlots > 2 * usedSlotsAfterLastFullSweep)
+            type = FullGC;
+    }
+    if (generationalGC && type == FullGC) {
+        // everything needs to be marked again
+        blockAllocator.resetBlackBits();
+        hugeItemAllocator.resetBlackBits();
+        icAllocator.resetBlackBits();
+    }
+    lastGCType = type;
+
     if (gcStats) {
         statistics.maxReservedMem = qMax(statistics.maxReservedMem, getAllocatedMem());
         statistics.maxAllocatedMem = qMax(statistics.maxAllocatedMem, getUsedMem() + getLargeItemsMem());
     }
 
     if (!gcCollectorStats) {
-        mark();
+        mark(type);
         sweep();
     } else {
         bool triggeredByUnmanagedHeap = (unmanagedHeapSize > unmanagedHeapSizeGCLimit);
@@ -1055,7 +1385,7 @@ void MemoryManager::runGC()
         const size_t largeItemsBefore = getLargeItemsMem();
 
         const QLoggingCategory &stats = lcGcAllocatorStats();
-        qDebug(stats) << "========== GC ==========";
+        qDebug(stats) << (type == MinorGC ? "========== Minor GC ==========" : "========== GC ==========");
 #ifdef MM_STATS
         qDebug(stats) << "    Triggered by alloc request of" << lastAllocRequestedSlots << "slots.";
         qDebug(stats) << "    Allocations since last GC" << allocationCount;
@@ -1068,7 +1398,7 @@ void MemoryManager::runGC()
 
         QElapsedTimer t;
         t.start();
-        mark();
+        mark(type);
         qint64 markTime = t.nsecsElapsed()/1000;
         t.restart();
         sweep(false, increaseFreedCountForClass);
@@ -1120,8 +1450,12 @@ void MemoryManager::runGC()
         qDebug(stats) << "======== End GC ========";
     }
 
-    if (gcStats)
+    if (gcStats) {
+        // The used memory is only known once the sweep is complete, and reading the chunk
+        // bitmaps while the sweeper thread rewrites them would race.
+        finishSweep();
         statistics.maxUsedMem = qMax(statistics.maxUsedMem, getUsedMem() + getLargeItemsMem());
+    }
 
     if (aggressiveGC) {
         // ensure we don't 'loose' any memory
@@ -1129,12 +1463,148 @@ void MemoryManager::runGC()
                  == blockAllocator.usedMem() + dumpBins(&blockAllocator, false));
     }
 
-    usedSlotsAfterLastFullSweep = blockAllocator.usedSlotsAfterLastSweep + icAllocator.usedSlotsAfterLastSweep;
+    if (type == FullGC && !blockAllocator.isSweeping() && !icAllocator.isSweeping())
+        usedSlotsAfterLastFullSweep = blockAllocator.usedSlotsAfterLastSweep + icAllocator.usedSlotsAfterLastSweep;
+
+    // reset all black bits, unless they mark the old generation
+    if (!generationalGC) {
+        blockAllocator.resetBlackBits();
+        hugeItemAllocator.resetBlackBits();
+        icAllocator.resetBlackBits();
+    }
+
+    ++pauseStatistics.cycles;
+    if (type == MinorGC)
+        ++pauseStatistics.minorCycles;
+    recordPause(pauseTimer.nsecsElapsed()/1000);
+}
+
+void MemoryManager::triggerGC()
+{
+    if (incrementalGCEnabled())
+        collectIncrementally(incrementalGCSliceUsecs);
+    else
+        runGC(generationalGC ? MinorGC : FullGC);
+}
+
+void MemoryManager::startIncrementalGC()
+{
+    if (gcBlocked || incrementalGCInProgress() || !incrementalGCEnabled())
+        return;
+
+    QScopedValueRollback<bool> gcBlocker(gcBlocked, true);
+    QElapsedTimer pauseTimer;
+    pauseTimer.start();
+
+    finishSweep();
+
+    if (gcStats) {
+        statistics.maxReservedMem = qMax(statistics.maxReservedMem, getAllocatedMem());
+        statistics.maxAllocatedMem = qMax(statistics.maxAllocatedMem, getUsedMem() + getLargeItemsMem());
+    }
+
+    markStackSize = 0;
+    incrementalMarkStack = new MarkStack(engine);
+    collectRoots(incrementalMarkStack);
+    engine->writeBarrierActive = true;
+    blockAllocator.allocateBlack = true;
+    icAllocator.allocateBlack = true;
+    hugeItemAllocator.allocateBlack = true;
+
+    recordPause(pauseTimer.nsecsElapsed()/1000);
+}
+
+// Marks objects until the mark stack is empty or budgetUsecs have passed. Returns
+// true if there is nothing left to mark, and finishIncrementalGC() can be called.
+bool MemoryManager::markIncrementally(qint64 budgetUsecs)
+{
+    if (gcBlocked || !incrementalGCInProgress())
+        return false;
+
+    QScopedValueRollback<bool> gcBlocker(gcBlocked, true);
+    QElapsedTimer pauseTimer;
+    pauseTimer.start();
+
+    QDeadlineTimer deadline;
+    deadline.setPreciseRemainingTime(0, budgetUsecs * 1000);
+    const bool done = incrementalMarkStack->drain(deadline);
+
+    recordPause(pauseTimer.nsecsElapsed()/1000);
+    return done;
+}
+
+void MemoryManager::finishIncrementalGC()
+{
+    if (gcBlocked || !incrementalGCInProgress())
+        return;
+
+    QScopedValueRollback<bool> gcBlocker(gcBlocked, true);
+    QElapsedTimer pauseTimer;
+    pauseTimer.start();
+
+    // The roots are not covered by the write barrier, and objects written to
+    // since they were marked have been grayed. Rescan both.
+    MarkStack *markStack = incrementalMarkStack;
+    collectRoots(markStack);
+    markStack->drain();
+    blockAllocator.collectGrayItems(markStack);
+    hugeItemAllocator.collectGrayItems(markStack);
+    icAllocator.collectGrayItems(markStack);
+    markStack->drain();
+
+    engine->writeBarrierActive = false;
+    blockAllocator.allocateBlack = false;
+    icAllocator.allocateBlack = false;
+    hugeItemAllocator.allocateBlack = false;
+    incrementalMarkStack = nullptr;
+    delete markStack;
+
+    sweep();
+
+    if (gcStats) {
+        // The used memory is only known once the sweep is complete, and reading the chunk
+        // bitmaps while the sweeper thread rewrites them would race.
+        finishSweep();
+        statistics.maxUsedMem = qMax(statistics.maxUsedMem, getUsedMem() + getLargeItemsMem());
+    }
+
+    if (!blockAllocator.isSweeping() && !icAllocator.isSweeping())
+        usedSlotsAfterLastFullSweep = blockAllocator.usedSlotsAfterLastSweep + icAllocator.usedSlotsAfterLastSweep;
 
-    // reset all black bits
     blockAllocator.resetBlackBits();
     hugeItemAllocator.resetBlackBits();
     icAllocator.resetBlackBits();
+
+    ++pauseStatistics.cycles;
+    recordPause(pauseTimer.nsecsElapsed()/1000);
+}
+
+// Advances the garbage collector by at most budgetUsecs of marking. Starts a new
+// cycle if none is in progress, and finishes it once everything has been marked.
+// Returns true if a cycle was completed.
+bool MemoryManager::collectIncrementally(qint64 budgetUsecs)
+{
+    if (gcBlocked || !incrementalGCEnabled())
+        return false;
+
+    if (!incrementalGCInProgress()) {
+        startIncrementalGC();
+        return false;
+    }
+
+    if (!markIncrementally(budgetUsecs))
+        return false;
+
+    finishIncrementalGC();
+    return true;
+}
+
+void MemoryManager::recordPause(qint64 usecs)
+{
+    ++pauseStatistics.pauses;
+    pauseStatistics.lastPauseUsecs = usecs;
+    pauseStatistics.maxPauseUsecs = qMax(pauseStatistics.maxPauseUsecs, usecs);
+    pauseStatistics.totalPauseUsecs += usecs;
 }
 
 size_t MemoryManager::getUsedMem() const
@@ -1166,6 +1636,17 @@ void MemoryManager::registerWeakSet(Heap::SetObject *set)
 
 MemoryManager::~MemoryManager()
 {
+    finishSweep();
+
+    if (incrementalGCInProgress()) {
+        engine->writeBarrierActive = false;
+        delete incrementalMarkStack;
+        incrementalMarkStack = nullptr;
+        blockAllocator.resetBlackBits();
+        hugeItemAllocator.resetBlackBits();
+        icAllocator.resetBlackBits();
+    }
+
     delete m_persistentValues;
 
     dumpStats();
@@ -1193,6 +1674,11 @@ void MemoryManager::dumpStats() const
     qDebug(stats) << "Total memory allocated:" << statistics.maxReservedMem;
     qDebug(stats) << "Max memory used before a GC run:" << statistics.maxAllocatedMem;
     qDebug(stats) << "Max memory used after a GC run:" << statistics.maxUsedMem;
+    qDebug(stats) << "Number of GC cycles:" << pauseStatistics.cycles;
+    qDebug(stats) << "Number of minor GC cycles:" << pauseStatistics.minorCycles;
+    qDebug(stats) << "Number of GC pauses:" << pauseStatistics.pauses;
+    qDebug(stats) << "Longest GC pause:" << pauseStatistics.maxPauseUsecs << "us";
+    qDebug(stats) << "Total time spent in GC pauses:" << pauseStatistics.totalPauseUsecs << "us";
     qDebug(stats) << "Requests for different item sizes:";
     for (int i = 1; i < BlockAllocator::NumBins - 1; ++i)
         qDebug(stats) << "     <" << (i << Chunk::SlotSizeShift) << " bytes: " << statistics.allocations[i];
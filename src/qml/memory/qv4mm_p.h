@@ -57,10 +57,14 @@
 #include <private/qv4object_p.h>
 #include <private/qv4mmdefs_p.h>
 #include <QVector>
+#include <QSharedPointer>
 
 #define QV4_MM_MAXBLOCK_SHIFT "QV4_MM_MAXBLOCK_SHIFT"
 #define QV4_MM_MAX_CHUNK_SIZE "QV4_MM_MAX_CHUNK_SIZE"
 #define QV4_MM_STATS "QV4_MM_STATS"
+#define QV4_MM_INCREMENTAL_GC "QV4_MM_INCREMENTAL_GC"
+#define QV4_MM_CONCURRENT_SWEEP "QV4_MM_CONCURRENT_SWEEP"
+#define QV4_MM_GENERATIONAL_GC "QV4_MM_GENERATIONAL_GC"
 
 #define MM_DEBUG 0
 
@@ -70,6 +74,7 @@ namespace QV4 {
 
 struct ChunkAllocator;
 struct MemorySegment;
+struct ConcurrentSweep;
 
 struct BlockAllocator {
     BlockAllocator(ChunkAllocator *chunkAllocator, ExecutionEngine *engine)
@@ -93,6 +98,7 @@ struct BlockAllocator {
     size_t allocatedMem() const {
         return chunks.size()*Chunk::DataSize;
     }
+    // While chunks are being swept concurrently, this is only an approximation.
     size_t usedMem() const {
         uint used = 0;
         for (auto c : chunks)
@@ -105,6 +111,15 @@ struct BlockAllocator {
     void resetBlackBits();
     void collectGrayItems(MarkStack *markStack);
 
+    // Concurrent sweeping: unmarked objects are destroyed on the engine's thread, the
+    // chunk bitmaps and free lists are then rebuilt on a helper thread. Allocations only
+    // wait for (or sweep themselves) chunks that haven't been swept yet.
+    void destroyUnmarkedObjects();
+    void startConcurrentSweep();
+    bool collectSweptChunks(bool wait);
+    void finishSweep();
+    bool isSweeping() const { return !concurrentSweep.isNull(); }
+
     // bump allocations
     HeapItem *nextFree = nullptr;
     size_t nFree = 0;
@@ -114,6 +129,9 @@ struct BlockAllocator {
     ExecutionEngine *engine;
     std::vector<Chunk *> chunks;
     uint *allocationStats = nullptr;
+    QSharedPointer<ConcurrentSweep> concurrentSweep;
+    bool allocateBlack = false;
+    bool generational = false; // black bits mark old objects and survive collections
 };
 
 struct HugeItemAllocator {
@@ -143,6 +161,8 @@ struct HugeItemAllocator {
     };
 
     std::vector<HugeChunk> chunks;
+    bool allocateBlack = false;
+    bool generational = false;
 };
 
 
@@ -255,7 +275,28 @@ public:
         return t->d();
     }
 
-    void runGC();
+    enum GCType {
+        FullGC,
+        // Only collects objects allocated since the last collection. The surviving ones
+        // are promoted to the old generation, which is only collected by a full GC.
+        MinorGC
+    };
+    void runGC(GCType type = FullGC);
+    // Waits for a concurrent sweep of the previous collection to complete
+    void finishSweep();
+
+    // Incremental garbage collection splits the mark phase into slices with a time budget.
+    // In between slices the write barrier is active and grays black objects that get
+    // written to. The final slice rescans the roots and the grayed objects and sweeps.
+    // It has to be enabled through QV4_MM_INCREMENTAL_GC when the engine is created, as
+    // the JIT needs to know about the write barrier when generating code.
+    bool incrementalGCEnabled() const { return incrementalGCSliceUsecs > 0; }
+    bool writeBarrierRequired() const { return incrementalGCEnabled() || generationalGC; }
+    bool incrementalGCInProgress() const { return incrementalMarkStack != nullptr; }
+    void startIncrementalGC();
+    bool markIncrementally(qint64 budgetUsecs);
+    void finishIncrementalGC();
+    bool collectIncrementally(qint64 budgetUsecs);
 
     void dumpStats() const;
 
@@ -289,10 +330,12 @@ private:
     };
 
     void collectFromJSStack(MarkStack *markStack) const;
-    void mark();
+    void mark(GCType type);
     void sweep(bool lastSweep = false, ClassDestroyStatsCallback classCountPtr = nullptr);
     bool shouldRunGC() const;
+    void triggerGC();
     void collectRoots(MarkStack *markStack);
+    void recordPause(qint64 usecs);
 
     HeapItem *allocate(BlockAllocator *allocator, std::size_t size)
     {
@@ -304,9 +347,11 @@ private:
 
         if (unmanagedHeapSize > unmanagedHeapSizeGCLimit) {
             if (!didGCRun)
-                runGC();
+                triggerGC();
 
-            if (3*unmanagedHeapSizeGCLimit <= 4 * unmanagedHeapSize) {
+            if (incrementalGCInProgress()) {
+                // limits are adjusted once the cycle has finished
+            } else if (3*unmanagedHeapSizeGCLimit <= 4 * unmanagedHeapSize) {
                 // more than 75% full, raise limit
                 unmanagedHeapSizeGCLimit = std::max(unmanagedHeapSizeGCLimit,
                                                     unmanagedHeapSize) * 2;
@@ -325,7 +370,7 @@ private:
             return m;
 
         if (!didGCRun && shouldRunGC())
-            runGC();
+            triggerGC();
 
         return allocator->allocate(size, true);
     }
@@ -341,16 +386,22 @@ public:
     QVector<Value *> m_pendingFreedObjectWrapperValue;
     Heap::MapObject *weakMaps = nullptr;
     Heap::SetObject *weakSets = nullptr;
+    MarkStack *incrementalMarkStack = nullptr;
 
     std::size_t unmanagedHeapSize = 0; // the amount of bytes of heap that is not managed by the memory manager, but which is held onto by managed items.
     std::size_t unmanagedHeapSizeGCLimit;
     std::size_t usedSlotsAfterLastFullSweep = 0;
 
     bool gcBlocked = false;
+    bool concurrentSweep = false;
+    bool generationalGC = false;
+    GCType lastGCType = FullGC;
     bool aggressiveGC = false;
     bool gcStats = false;
     bool gcCollectorStats = false;
 
+    qint64 incrementalGCSliceUsecs = 0;
+
     int allocationCount = 0;
     size_t lastAllocRequestedSlots = 0;
 
@@ -360,6 +411,15 @@ public:
         size_t maxUsedMem = 0;
         uint allocations[BlockAllocator::NumBins];
     } statistics;
+
+    struct {
+        uint cycles = 0;
+        uint minorCycles = 0;
+        uint pauses = 0;
+        qint64 lastPauseUsecs = 0;
+        qint64 maxPauseUsecs = 0;
+        qint64 totalPauseUsecs = 0;
+    } pauseStatistics;
 };
 
 }
@@ -53,6 +53,7 @@
 #include <private/qv4global_p.h>
 #include <private/qv4runtimeapi_p.h>
 #include <QtCore/qalgorithms.h>
+#include <QtCore/qdeadlinetimer.h>
 #include <qdebug.h>
 
 QT_BEGIN_NAMESPACE
@@ -190,9 +191,11 @@ struct Chunk {
     void resetBlackBits();
     void collectGrayItems(QV4::MarkStack *markStack);
     bool sweep(ExecutionEngine *engine);
+    void destroyUnmarkedObjects();
+    bool sweepSlots(uint *freedSlots);
     void freeAll(ExecutionEngine *engine);
 
-    void sortIntoBins(HeapItem **bins, uint nBins);
+    void sortIntoBins(HeapItem **bins, uint nBins, HeapItem **tails = nullptr);
 };
 
 struct HeapItem {
@@ -285,6 +288,8 @@ struct MarkStack {
         return *top;
     }
     void drain();
+    // Drains until the stack is empty or the deadline expired. Returns true if empty.
+    bool drain(QDeadlineTimer deadline);
 
 };
 
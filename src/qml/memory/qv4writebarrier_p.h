@@ -55,7 +55,7 @@
 
 QT_BEGIN_NAMESPACE
 
-#define WRITEBARRIER_none 1
+#define WRITEBARRIER_steele 1
 
 #define WRITEBARRIER(x) (1/WRITEBARRIER_##x == 1)
 
@@ -77,25 +77,37 @@ enum NewValueType {
 // ### this needs to be filled with a real memory fence once marking is concurrent
 Q_ALWAYS_INLINE void fence() {}
 
-#if WRITEBARRIER(none)
+#if WRITEBARRIER(steele)
+
+// A Steele type barrier: while an incremental mark phase is ongoing, any black object
+// that gets written to is grayed again, so that the memory manager rescans it in the
+// final marking step. With generational collection black objects are the old ones, and
+// the grayed ones form the remembered set for minor collections. Otherwise this is
+// only a flag check.
 
 template <NewValueType type>
 static Q_CONSTEXPR inline bool isRequired() {
-    return false;
+    return type != Primitive;
+}
+
+Q_QML_EXPORT void markGraySlowPath(Heap::Base *base);
+
+inline void markDirty(EngineBase *engine, Heap::Base *base)
+{
+    if (Q_UNLIKELY(engine->writeBarrierActive))
+        markGraySlowPath(base);
 }
 
 inline void write(EngineBase *engine, Heap::Base *base, ReturnedValue *slot, ReturnedValue value)
 {
-    Q_UNUSED(engine);
-    Q_UNUSED(base);
     *slot = value;
+    markDirty(engine, base);
 }
 
 inline void write(EngineBase *engine, Heap::Base *base, Heap::Base **slot, Heap::Base *value)
 {
-    Q_UNUSED(engine);
-    Q_UNUSED(base);
     *slot = value;
+    markDirty(engine, base);
 }
 
 #endif
@@ -163,12 +163,7 @@ void QQmlBinding::update(QQmlPropertyData::WriteFlags flags)
 
     // Check for a binding update loop
     if (Q_UNLIKELY(updatingFlag())) {
-        QQmlPropertyData *d = nullptr;
-        QQmlPropertyData vtd;
-        getPropertyData(&d, &vtd);
-        Q_ASSERT(d);
-        QQmlProperty p = QQmlPropertyPrivate::restore(targetObject(), *d, &vtd, nullptr);
-        QQmlAbstractBinding::printBindingLoopError(p);
+        reportBindingLoop();
         return;
     }
     setUpdatingFlag(true);
@@ -188,6 +183,16 @@ void QQmlBinding::update(QQmlPropertyData::WriteFlags flags)
         setUpdatingFlag(false);
 }
 
+void QQmlBinding::reportBindingLoop()
+{
+    QQmlPropertyData *d = nullptr;
+    QQmlPropertyData vtd;
+    getPropertyData(&d, &vtd);
+    Q_ASSERT(d);
+    QQmlProperty p = QQmlPropertyPrivate::restore(targetObject(), *d, &vtd, nullptr);
+    QQmlAbstractBinding::printBindingLoopError(p);
+}
+
 QV4::ReturnedValue QQmlBinding::evaluate(bool *isUndefined)
 {
     QV4::ExecutionEngine *v4 = context()->engine->handle();
@@ -527,6 +532,13 @@ QString QQmlBinding::expressionIdentifier() const
 
 void QQmlBinding::expressionChanged()
 {
+    if (QQmlContextData *ctxt = context()) {
+        QQmlBindingScheduler &scheduler = QQmlEnginePrivate::get(ctxt->engine)->bindingScheduler;
+        if (scheduler.isEnabled()) {
+            scheduler.schedule(this);
+            return;
+        }
+    }
     update();
 }
 
@@ -71,6 +71,7 @@ class Q_QML_PRIVATE_EXPORT QQmlBinding : public QQmlJavaScriptExpression,
                                          public QQmlAbstractBinding
 {
     friend class QQmlAbstractBinding;
+    friend class QQmlBindingScheduler;
 public:
     typedef QExplicitlySharedDataPointer<QQmlBinding> Ptr;
 
@@ -138,10 +139,16 @@ private:
     inline bool enabledFlag() const;
     inline void setEnabledFlag(bool);
 
+    void reportBindingLoop();
+
     static QQmlBinding *newBinding(QQmlEnginePrivate *engine, const QQmlPropertyData *property);
 
     QQmlSourceLocation *m_sourceLocation = nullptr; // used for Qt.binding() created functions
     QV4::PersistentValue m_boundFunction; // used for Qt.binding() that are created from a bound function object
+
+    // Used by QQmlBindingScheduler
+    int m_schedulerDepth = 0;
+    bool m_scheduled = false;
 };
 
 bool QQmlBinding::updatingFlag() const
@@ -0,0 +1,223 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtQml module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include "qqmlbindingscheduler_p.h"
+#include <private/qqmlbinding_p.h>
+#include <private/qqmlglobal_p.h>
+
+#include <QtCore/qloggingcategory.h>
+#include <QtCore/qscopedvaluerollback.h>
+#include <QtCore/qthreadstorage.h>
+
+#include <algorithm>
+
+QT_BEGIN_NAMESPACE
+
+DEFINE_BOOL_CONFIG_OPTION(deferredBindingUpdates, QML_DEFERRED_BINDINGS)
+
+Q_LOGGING_CATEGORY(lcBindingScheduler, "qt.qml.binding.scheduler")
+
+// A binding that keeps making itself dirty through a chain this long is considered a loop.
+static const int MaximumChainLength = 1000;
+
+typedef QVector<QQmlBindingScheduler *> SchedulerList;
+Q_GLOBAL_STATIC(QThreadStorage<SchedulerList>, pendingSchedulers)
+
+static void addPendingScheduler(QQmlBindingScheduler *scheduler)
+{
+    SchedulerList &pending = pendingSchedulers()->localData();
+    if (!pending.contains(scheduler))
+        pending.append(scheduler);
+}
+
+static void removePendingScheduler(QQmlBindingScheduler *scheduler)
+{
+    if (!pendingSchedulers.exists() || !pendingSchedulers()->hasLocalData())
+        return;
+    pendingSchedulers()->localData().removeOne(scheduler);
+}
+
+bool QQmlBindingScheduler::EntryOrder::operator()(const Entry &lhs, const Entry &rhs) const
+{
+    // std::push_heap() and std::pop_heap() keep the greatest element on top, so the
+    // shallowest and then oldest entry has to compare greatest.
+    if (lhs.depth != rhs.depth)
+        return lhs.depth > rhs.depth;
+    return lhs.sequence > rhs.sequence;
+}
+
+QQmlBindingScheduler::QQmlBindingScheduler()
+    : QObject(nullptr)
+    , m_enabled(deferredBindingUpdates())
+{
+    const QMetaObject &metaObject = QQmlBindingScheduler::staticMetaObject;
+    m_flushMethod = metaObject.method(metaObject.indexOfSlot("flush()"));
+}
+
+QQmlBindingScheduler::~QQmlBindingScheduler()
+{
+    clear();
+}
+
+/*!
+    Enables or disables deferred binding updates. Bindings that are dirty when the scheduler is
+    disabled are evaluated right away.
+
+    The default is taken from the \c QML_DEFERRED_BINDINGS environment variable.
+*/
+void QQmlBindingScheduler::setEnabled(bool enabled)
+{
+    if (m_enabled == enabled)
+        return;
+    m_enabled = enabled;
+    if (!enabled)
+        flush();
+}
+
+void QQmlBindingScheduler::schedule(QQmlBinding *binding)
+{
+    ++m_statistics.scheduled;
+
+    // m_currentDepth is -1 outside of flush(), so bindings made dirty by regular property
+    // writes start at depth 0.
+    const int depth = m_currentDepth + 1;
+    const int chainLength = m_currentChainLength + 1;
+
+    if (binding->m_scheduled) {
+        ++m_statistics.coalesced;
+        if (depth > binding->m_schedulerDepth) {
+            // Dirtied again by a binding that is at the same depth or deeper. Move it behind
+            // that binding, the old entry is skipped by flush().
+            binding->m_schedulerDepth = depth;
+            push(binding, depth, chainLength);
+        }
+        return;
+    }
+
+    if (Q_UNLIKELY(chainLength > MaximumChainLength)) {
+        binding->m_schedulerDepth = 0;
+        binding->reportBindingLoop();
+        return;
+    }
+
+    binding->m_scheduled = true;
+    binding->m_schedulerDepth = qMax(binding->m_schedulerDepth, depth);
+    push(binding, binding->m_schedulerDepth, chainLength);
+}
+
+void QQmlBindingScheduler::push(QQmlBinding *binding, int depth, int chainLength)
+{
+    m_queue.append(Entry { depth, chainLength, m_nextSequence++, QExplicitlySharedDataPointer<QQmlBinding>(binding) });
+    std::push_heap(m_queue.begin(), m_queue.end(), EntryOrder());
+
+    if (m_flushing)
+        return;
+
+    addPendingScheduler(this);
+    if (!m_flushOutstanding) {
+        m_flushMethod.invoke(this, Qt::QueuedConnection);
+        m_flushOutstanding = true;
+    }
+}
+
+/*!
+    Drops all dirty bindings without evaluating them.
+*/
+void QQmlBindingScheduler::clear()
+{
+    for (const Entry &entry : qAsConst(m_queue))
+        entry.binding->m_scheduled = false;
+    m_queue.clear();
+    removePendingScheduler(this);
+}
+
+/*!
+    Evaluates all dirty bindings, including the ones that become dirty while doing so. Each
+    binding is evaluated at most once per depth it is scheduled at.
+*/
+void QQmlBindingScheduler::flush()
+{
+    m_flushOutstanding = false;
+    if (m_flushing || m_queue.isEmpty())
+        return;
+
+    QScopedValueRollback<bool> flushing(m_flushing, true);
+    ++m_statistics.flushes;
+    const quint64 evaluationsBefore = m_statistics.evaluations;
+    const quint64 coalescedBefore = m_statistics.coalesced;
+
+    while (!m_queue.isEmpty()) {
+        std::pop_heap(m_queue.begin(), m_queue.end(), EntryOrder());
+        const Entry entry = m_queue.takeLast();
+        QQmlBinding *binding = entry.binding.data();
+        if (!binding->m_scheduled || binding->m_schedulerDepth != entry.depth)
+            continue;
+        binding->m_scheduled = false;
+        // The target object was deleted, or the binding removed from it, while queued
+        if (!binding->isAddedToObject())
+            continue;
+
+        QScopedValueRollback<int> currentDepth(m_currentDepth, entry.depth);
+        QScopedValueRollback<int> currentChainLength(m_currentChainLength, entry.chainLength);
+        ++m_statistics.evaluations;
+        binding->update();
+    }
+
+    removePendingScheduler(this);
+
+    qCDebug(lcBindingScheduler) << "Evaluated" << (m_statistics.evaluations - evaluationsBefore)
+                                << "bindings, saved" << (m_statistics.coalesced - coalescedBefore)
+                                << "evaluations";
+}
+
+void QQmlBindingScheduler::flushAll()
+{
+    if (!pendingSchedulers.exists() || !pendingSchedulers()->hasLocalData())
+        return;
+
+    // Flushing one scheduler can destroy another one, so re-check against the live list.
+    const SchedulerList snapshot = pendingSchedulers()->localData();
+    for (QQmlBindingScheduler *scheduler : snapshot) {
+        if (pendingSchedulers()->localData().contains(scheduler))
+            scheduler->flush();
+    }
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,132 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtQml module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QQMLBINDINGSCHEDULER_P_H
+#define QQMLBINDINGSCHEDULER_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtCore/qglobal.h>
+#include <QtCore/qobject.h>
+#include <QtCore/qmetaobject.h>
+#include <QtCore/qshareddata.h>
+#include <QtCore/qvector.h>
+#include <private/qtqmlglobal_p.h>
+
+QT_BEGIN_NAMESPACE
+
+class QQmlBinding;
+
+// Defers the re-evaluation of bindings whose dependencies changed. Instead of running each
+// binding as soon as a notifier fires, the binding is marked dirty and queued. The queue is
+// flushed from the event loop and before a QQuickWindow polishes its items, in order of
+// dependency depth, so that a binding that depends on several changed bindings runs once,
+// after all of them, and never observes intermediate values.
+//
+// The depth of a binding is learned while flushing: a binding that becomes dirty while another
+// one is being evaluated is placed at least one level deeper. Depths are kept across flushes.
+class Q_QML_PRIVATE_EXPORT QQmlBindingScheduler : public QObject
+{
+    Q_OBJECT
+public:
+    struct Statistics
+    {
+        quint64 scheduled = 0;      // notifications received for bindings
+        quint64 coalesced = 0;      // notifications for bindings that were already dirty
+        quint64 evaluations = 0;    // bindings evaluated by flush()
+        quint64 flushes = 0;
+    };
+
+    QQmlBindingScheduler();
+    ~QQmlBindingScheduler() override;
+
+    bool isEnabled() const { return m_enabled; }
+    void setEnabled(bool enabled);
+
+    bool hasPendingBindings() const { return !m_queue.isEmpty(); }
+    void schedule(QQmlBinding *binding);
+    void clear();
+
+    const Statistics &statistics() const { return m_statistics; }
+    void resetStatistics() { m_statistics = Statistics(); }
+
+    // Flushes all schedulers of the current thread that have dirty bindings.
+    static void flushAll();
+
+public Q_SLOTS:
+    void flush();
+
+private:
+    struct Entry
+    {
+        int depth;
+        int chainLength;
+        quint64 sequence;
+        QExplicitlySharedDataPointer<QQmlBinding> binding;
+    };
+    struct EntryOrder
+    {
+        bool operator()(const Entry &lhs, const Entry &rhs) const;
+    };
+
+    void push(QQmlBinding *binding, int depth, int chainLength);
+
+    QVector<Entry> m_queue; // binary heap, shallowest and oldest entry first
+    QMetaMethod m_flushMethod;
+    Statistics m_statistics;
+    quint64 m_nextSequence = 0;
+    int m_currentDepth = -1;
+    int m_currentChainLength = 0;
+    bool m_enabled = false;
+    bool m_flushing = false;
+    bool m_flushOutstanding = false;
+};
+
+QT_END_NAMESPACE
+
+#endif // QQMLBINDINGSCHEDULER_P_H
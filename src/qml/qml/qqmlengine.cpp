@@ -268,6 +268,9 @@ void QQmlEnginePrivate::defineQtQuick2Module()
 #if QT_CONFIG(qml_locale)
     qmlRegisterUncreatableType<QQmlLocale>("QtQuick", 2, 0, "Locale", QQmlEngine::tr("Locale cannot be instantiated.  Use Qt.locale()"));
 #endif
+#if QT_CONFIG(qml_worker_script)
+    qmlRegisterType<QQuickWorkerScript, 12>("QtQuick", 2, 12, "WorkerScript");
+#endif
 
     // Auto-increment the import to stay in sync with ALL future QtQuick minor versions from 5.11 onward
     qmlRegisterModule("QtQuick", 2, QT_VERSION_MINOR);
@@ -1075,6 +1078,7 @@ QQmlEngine::~QQmlEngine()
     QJSEnginePrivate::removeFromDebugServer(this);
 
     d->typeLoader.invalidate();
+    d->bindingScheduler.clear();
 
     // Emit onDestruction signals for the root context before
     // we destroy the contexts, engine, Singleton Types etc. that
@@ -54,6 +54,7 @@
 #include "qqmlengine.h"
 
 #include "qqmltypeloader_p.h"
+#include "qqmlbindingscheduler_p.h"
 #include "qqmlimport_p.h"
 #include <private/qpodvector_p.h>
 #include "qqml.h"
@@ -180,6 +181,7 @@ public:
 
     QQmlImportDatabase importDatabase;
     QQmlTypeLoader typeLoader;
+    QQmlBindingScheduler bindingScheduler;
 
     QString offlineStoragePath;
 
@@ -2051,7 +2051,7 @@ bool QQmlImportDatabase::registerPluginTypes(QObject *instance, const QString &b
     {
         // Create a scope for QWriteLocker to keep it as narrow as possible, and
         // to ensure that we release it before the call to initalizeEngine below
-        QMutexLocker lock(QQmlMetaType::typeRegistrationLock());
+        QQmlMetaTypeRegistrationLocker lock;
 
         if (!typeNamespace.isEmpty()) {
             // This is an 'identified' module
@@ -2090,7 +2090,7 @@ bool QQmlImportDatabase::registerPluginTypes(QObject *instance, const QString &b
 
         iface->registerTypes(moduleId);
         QQmlMetaType::setTypeRegistrationNamespace(QString());
-    } // QWriteLocker lock(QQmlMetaType::typeRegistrationLock())
+    } // QQmlMetaTypeRegistrationLocker lock
 
     if (!failureRecorder.failures().isEmpty()) {
         if (errors) {
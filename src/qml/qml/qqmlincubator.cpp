@@ -44,6 +44,7 @@
 #include "qqmlexpression_p.h"
 #include "qqmlmemoryprofiler_p.h"
 #include "qqmlobjectcreator_p.h"
+#include <private/qv4mm_p.h>
 
 void QQmlEnginePrivate::incubate(QQmlIncubator &i, QQmlContextData *forContext)
 {
@@ -389,6 +390,14 @@ void QQmlIncubationController::incubateFor(int msecs)
     do {
         static_cast<QQmlIncubatorPrivate*>(d->incubatorList.first())->incubate(i);
     } while (d && d->incubatorCount != 0 && !i.shouldInterrupt());
+
+    // Spend the rest of the time slot on an ongoing incremental garbage collection
+    if (d && d->incubatorCount == 0) {
+        QV4::MemoryManager *mm = d->v4engine()->memoryManager;
+        const qint64 remaining = i.remainingNSecs();
+        if (mm->incrementalGCInProgress() && remaining > 0)
+            mm->collectIncrementally(remaining / 1000);
+    }
 }
 
 /*!
@@ -68,6 +68,8 @@ Q_DECLARE_LOGGING_CATEGORY(DBG_DISK_CACHE)
 
 QT_BEGIN_NAMESPACE
 
+struct QQmlMetaTypeSnapshot;
+
 struct QQmlMetaTypeData
 {
     QQmlMetaTypeData();
@@ -119,6 +121,9 @@ struct QQmlMetaTypeData
 
     QHash<const QMetaObject *, QQmlPropertyCache *> propertyCaches;
     QQmlPropertyCache *propertyCache(const QMetaObject *metaObject, int minorVersion);
+
+    // Snapshots replaced while someone may still be reading them, see QQmlMetaTypeSnapshot
+    QVector<const QQmlMetaTypeSnapshot *> retiredSnapshots;
     QQmlPropertyCache *propertyCache(const QQmlType &type, int minorVersion);
 
     void startRecordingTypeRegFailures(QStringList *storage)
@@ -170,6 +175,111 @@ public:
 Q_GLOBAL_STATIC(QQmlMetaTypeData, metaTypeData)
 Q_GLOBAL_STATIC_WITH_ARGS(QMutex, metaTypeDataLock, (QMutex::Recursive))
 
+/*
+    An immutable copy of the tables read by the frequent lookups, so that those don't need
+    to take metaTypeDataLock. Changes to the tables go through QQmlMetaTypeRegistrationLocker,
+    which drops the current snapshot, and the next reader builds a new one under the lock.
+    The containers are implicitly shared with QQmlMetaTypeData, so building a snapshot is
+    cheap; the next change detaches them. The snapshot holds on to the types list, which
+    keeps the QQmlTypePrivates in the hashes alive.
+
+    A replaced snapshot is only deleted once no reader is active, which is tracked by a
+    single counter. Readers increment it before loading the snapshot pointer and writers
+    check it after replacing the pointer, both with ordered operations, so a reader either
+    sees the new pointer or the writer sees the reader.
+*/
+struct QQmlMetaTypeSnapshot
+{
+    explicit QQmlMetaTypeSnapshot(const QQmlMetaTypeData *data)
+        : types(data->types)
+        , idToType(data->idToType)
+        , nameToType(data->nameToType)
+        , urlToType(data->urlToType)
+        , urlToNonFileImportType(data->urlToNonFileImportType)
+        , metaObjectToType(data->metaObjectToType)
+        , objects(data->objects)
+        , interfaces(data->interfaces)
+        , lists(data->lists)
+        , qmlLists(data->qmlLists)
+    {}
+
+    const QList<QQmlType> types;
+    const QQmlMetaTypeData::Ids idToType;
+    const QQmlMetaTypeData::Names nameToType;
+    const QQmlMetaTypeData::Files urlToType;
+    const QQmlMetaTypeData::Files urlToNonFileImportType;
+    const QQmlMetaTypeData::MetaObjects metaObjectToType;
+    const QBitArray objects;
+    const QBitArray interfaces;
+    const QBitArray lists;
+    const QHash<int, int> qmlLists;
+};
+
+static QAtomicPointer<const QQmlMetaTypeSnapshot> metaTypeSnapshot;
+static QAtomicInt metaTypeSnapshotReaders;
+static int metaTypeWriteDepth = 0; // guarded by metaTypeDataLock
+
+// NOTE: caller must hold a QMutexLocker on "data"
+static void invalidateMetaTypeSnapshot(QQmlMetaTypeData *data)
+{
+    if (const QQmlMetaTypeSnapshot *old = metaTypeSnapshot.fetchAndStoreOrdered(nullptr))
+        data->retiredSnapshots.append(old);
+    if (!data->retiredSnapshots.isEmpty() && metaTypeSnapshotReaders.fetchAndAddOrdered(0) == 0) {
+        qDeleteAll(data->retiredSnapshots);
+        data->retiredSnapshots.clear();
+    }
+}
+
+QQmlMetaTypeRegistrationLocker::QQmlMetaTypeRegistrationLocker()
+{
+    metaTypeDataLock()->lock();
+    ++metaTypeWriteDepth;
+    invalidateMetaTypeSnapshot(metaTypeData());
+}
+
+QQmlMetaTypeRegistrationLocker::~QQmlMetaTypeRegistrationLocker()
+{
+    --metaTypeWriteDepth;
+    invalidateMetaTypeSnapshot(metaTypeData());
+    metaTypeDataLock()->unlock();
+}
+
+class QQmlMetaTypeSnapshotReader
+{
+public:
+    QQmlMetaTypeSnapshotReader()
+    {
+        metaTypeSnapshotReaders.ref();
+        m_snapshot = metaTypeSnapshot.loadAcquire();
+        if (!m_snapshot) {
+            QMutexLocker lock(metaTypeDataLock());
+            m_snapshot = metaTypeSnapshot.loadAcquire();
+            if (!m_snapshot) {
+                m_snapshot = new QQmlMetaTypeSnapshot(metaTypeData());
+                // A lookup in the middle of a change on this thread must not publish the
+                // half done change to the other threads, see QQmlMetaTypeRegistrationLocker
+                m_owned = metaTypeWriteDepth > 0;
+                if (!m_owned)
+                    metaTypeSnapshot.storeRelease(m_snapshot);
+            }
+        }
+    }
+
+    ~QQmlMetaTypeSnapshotReader()
+    {
+        if (m_owned)
+            delete m_snapshot;
+        metaTypeSnapshotReaders.deref();
+    }
+
+    const QQmlMetaTypeSnapshot *operator->() const { return m_snapshot; }
+
+private:
+    Q_DISABLE_COPY(QQmlMetaTypeSnapshotReader)
+    const QQmlMetaTypeSnapshot *m_snapshot;
+    bool m_owned = false;
+};
+
 static uint qHash(const QQmlMetaTypeData::VersionedUri &v)
 {
     return v.uri.hash() ^ qHash(v.majorVersion);
@@ -196,6 +306,8 @@ QQmlMetaTypeData::~QQmlMetaTypeData()
     for (QHash<const QMetaObject *, QQmlPropertyCache *>::Iterator it = propertyCaches.begin(), end = propertyCaches.end();
          it != end; ++it)
         (*it)->release();
+    qDeleteAll(retiredSnapshots);
+    delete metaTypeSnapshot.fetchAndStoreOrdered(nullptr);
 }
 
 class QQmlTypePrivate
@@ -1627,7 +1739,7 @@ QQmlType QQmlTypeModuleVersion::type(const QV4::String *name) const
 void qmlClearTypeRegistrations() // Declared in qqml.h
 {
     //Only cleans global static, assumed no running engine
-    QMutexLocker lock(metaTypeDataLock());
+    QQmlMetaTypeRegistrationLocker lock;
     QQmlMetaTypeData *data = metaTypeData();
 
     for (QQmlMetaTypeData::TypeModules::const_iterator i = data->uriToModule.constBegin(), cend = data->uriToModule.constEnd(); i != cend; ++i)
@@ -1663,7 +1775,7 @@ QQmlType registerInterface(const QQmlPrivate::RegisterInterface &interface)
     if (interface.version > 0)
         qFatal("qmlRegisterType(): Cannot mix incompatible QML versions.");
 
-    QMutexLocker lock(metaTypeDataLock());
+    QQmlMetaTypeRegistrationLocker lock;
     QQmlMetaTypeData *data = metaTypeData();
 
     QQmlType type(data, interface);
@@ -1798,7 +1910,7 @@ void addTypeToData(QQmlTypePrivate *type, QQmlMetaTypeData *data)
 
 QQmlType registerType(const QQmlPrivate::RegisterType &type)
 {
-    QMutexLocker lock(metaTypeDataLock());
+    QQmlMetaTypeRegistrationLocker lock;
     QQmlMetaTypeData *data = metaTypeData();
     QString elementName = QString::fromUtf8(type.elementName);
     if (!checkRegistration(QQmlType::CppType, data, type.uri, elementName, type.versionMajor))
@@ -1815,7 +1927,7 @@ QQmlType registerType(const QQmlPrivate::RegisterType &type)
 
 QQmlType registerSingletonType(const QQmlPrivate::RegisterSingletonType &type)
 {
-    QMutexLocker lock(metaTypeDataLock());
+    QQmlMetaTypeRegistrationLocker lock;
     QQmlMetaTypeData *data = metaTypeData();
     QString typeName = QString::fromUtf8(type.typeName);
     if (!checkRegistration(QQmlType::SingletonType, data, type.uri, typeName, type.versionMajor))
@@ -1831,7 +1943,7 @@ QQmlType registerSingletonType(const QQmlPrivate::RegisterSingletonType &type)
 QQmlType QQmlMetaType::registerCompositeSingletonType(const QQmlPrivate::RegisterCompositeSingletonType &type)
 {
     // Assumes URL is absolute and valid. Checking of user input should happen before the URL enters type.
-    QMutexLocker lock(metaTypeDataLock());
+    QQmlMetaTypeRegistrationLocker lock;
     QQmlMetaTypeData *data = metaTypeData();
     QString typeName = QString::fromUtf8(type.typeName);
     bool fileImport = false;
@@ -1853,7 +1965,7 @@ QQmlType QQmlMetaType::registerCompositeSingletonType(const QQmlPrivate::Registe
 QQmlType QQmlMetaType::registerCompositeType(const QQmlPrivate::RegisterCompositeType &type)
 {
     // Assumes URL is absolute and valid. Checking of user input should happen before the URL enters type.
-    QMutexLocker lock(metaTypeDataLock());
+    QQmlMetaTypeRegistrationLocker lock;
     QQmlMetaTypeData *data = metaTypeData();
     QString typeName = QString::fromUtf8(type.typeName);
     bool fileImport = false;
@@ -1894,7 +2006,7 @@ void QQmlMetaType::registerInternalCompositeType(QV4::CompiledData::CompilationU
     compilationUnit->metaTypeId = ptr_type;
     compilationUnit->listMetaTypeId = lst_type;
 
-    QMutexLocker lock(metaTypeDataLock());
+    QQmlMetaTypeRegistrationLocker lock;
     QQmlMetaTypeData *d = metaTypeData();
     d->qmlLists.insert(lst_type, ptr_type);
 }
@@ -1904,7 +2016,7 @@ void QQmlMetaType::unregisterInternalCompositeType(QV4::CompiledData::Compilatio
     int ptr_type = compilationUnit->metaTypeId;
     int lst_type = compilationUnit->listMetaTypeId;
 
-    QMutexLocker lock(metaTypeDataLock());
+    QQmlMetaTypeRegistrationLocker lock;
     QQmlMetaTypeData *d = metaTypeData();
     d->qmlLists.remove(lst_type);
 
@@ -2124,8 +2236,7 @@ bool QQmlMetaType::isQObject(int userType)
     if (userType == QMetaType::QObjectStar)
         return true;
 
-    QMutexLocker lock(metaTypeDataLock());
-    QQmlMetaTypeData *data = metaTypeData();
+    QQmlMetaTypeSnapshotReader data;
     return userType >= 0 && userType < data->objects.size() && data->objects.testBit(userType);
 }
 
@@ -2134,8 +2245,7 @@ bool QQmlMetaType::isQObject(int userType)
  */
 int QQmlMetaType::listType(int id)
 {
-    QMutexLocker lock(metaTypeDataLock());
-    QQmlMetaTypeData *data = metaTypeData();
+    QQmlMetaTypeSnapshotReader data;
     QHash<int, int>::ConstIterator iter = data->qmlLists.constFind(id);
     if (iter != data->qmlLists.cend())
         return *iter;
@@ -2236,8 +2346,7 @@ QQmlMetaType::TypeCategory QQmlMetaType::typeCategory(int userType)
     if (userType == QMetaType::QObjectStar)
         return Object;
 
-    QMutexLocker lock(metaTypeDataLock());
-    QQmlMetaTypeData *data = metaTypeData();
+    QQmlMetaTypeSnapshotReader data;
     if (data->qmlLists.contains(userType))
         return List;
     else if (userType < data->objects.size() && data->objects.testBit(userType))
@@ -2253,17 +2362,13 @@ QQmlMetaType::TypeCategory QQmlMetaType::typeCategory(int userType)
 */
 bool QQmlMetaType::isInterface(int userType)
 {
-    QMutexLocker lock(metaTypeDataLock());
-    QQmlMetaTypeData *data = metaTypeData();
+    QQmlMetaTypeSnapshotReader data;
     return userType >= 0 && userType < data->interfaces.size() && data->interfaces.testBit(userType);
 }
 
 const char *QQmlMetaType::interfaceIId(int userType)
 {
-    QMutexLocker lock(metaTypeDataLock());
-    QQmlMetaTypeData *data = metaTypeData();
-    QQmlType type(data->idToType.value(userType));
-    lock.unlock();
+    QQmlType type = qmlType(userType, TypeIdCategory::MetaType);
     if (type.isInterface() && type.typeId() == userType)
         return type.interfaceIId();
     else
@@ -2272,8 +2377,7 @@ const char *QQmlMetaType::interfaceIId(int userType)
 
 bool QQmlMetaType::isList(int userType)
 {
-    QMutexLocker lock(metaTypeDataLock());
-    QQmlMetaTypeData *data = metaTypeData();
+    QQmlMetaTypeSnapshotReader data;
     if (data->qmlLists.contains(userType))
         return true;
     return userType >= 0 && userType < data->lists.size() && data->lists.testBit(userType);
@@ -2339,8 +2443,7 @@ QQmlType QQmlMetaType::qmlType(const QString &qualifiedName, int version_major,
 QQmlType QQmlMetaType::qmlType(const QHashedStringRef &name, const QHashedStringRef &module, int version_major, int version_minor)
 {
     Q_ASSERT(version_major >= 0 && version_minor >= 0);
-    QMutexLocker lock(metaTypeDataLock());
-    QQmlMetaTypeData *data = metaTypeData();
+    QQmlMetaTypeSnapshotReader data;
 
     QQmlMetaTypeData::Names::ConstIterator it = data->nameToType.constFind(name);
     while (it != data->nameToType.cend() && it.key() == name) {
@@ -2360,8 +2463,7 @@ QQmlType QQmlMetaType::qmlType(const QHashedStringRef &name, const QHashedString
 */
 QQmlType QQmlMetaType::qmlType(const QMetaObject *metaObject)
 {
-    QMutexLocker lock(metaTypeDataLock());
-    QQmlMetaTypeData *data = metaTypeData();
+    QQmlMetaTypeSnapshotReader data;
 
     return QQmlType(data->metaObjectToType.value(metaObject));
 }
@@ -2374,8 +2476,7 @@ QQmlType QQmlMetaType::qmlType(const QMetaObject *metaObject)
 QQmlType QQmlMetaType::qmlType(const QMetaObject *metaObject, const QHashedStringRef &module, int version_major, int version_minor)
 {
     Q_ASSERT(version_major >= 0 && version_minor >= 0);
-    QMutexLocker lock(metaTypeDataLock());
-    QQmlMetaTypeData *data = metaTypeData();
+    QQmlMetaTypeSnapshotReader data;
 
     QQmlMetaTypeData::MetaObjects::const_iterator it = data->metaObjectToType.constFind(metaObject);
     while (it != data->metaObjectToType.cend() && it.key() == metaObject) {
@@ -2395,8 +2496,7 @@ QQmlType QQmlMetaType::qmlType(const QMetaObject *metaObject, const QHashedStrin
 */
 QQmlType QQmlMetaType::qmlType(int typeId, TypeIdCategory category)
 {
-    QMutexLocker lock(metaTypeDataLock());
-    QQmlMetaTypeData *data = metaTypeData();
+    QQmlMetaTypeSnapshotReader data;
 
     if (category == TypeIdCategory::MetaType) {
         QQmlTypePrivate *type = data->idToType.value(typeId);
@@ -2419,8 +2519,7 @@ QQmlType QQmlMetaType::qmlType(int typeId, TypeIdCategory category)
 QQmlType QQmlMetaType::qmlType(const QUrl &unNormalizedUrl, bool includeNonFileImports /* = false */)
 {
     const QUrl url = QQmlTypeLoader::normalize(unNormalizedUrl);
-    QMutexLocker lock(metaTypeDataLock());
-    QQmlMetaTypeData *data = metaTypeData();
+    QQmlMetaTypeSnapshotReader data;
 
     QQmlType type(data->urlToType.value(url));
     if (!type.isValid() && includeNonFileImports)
@@ -2569,7 +2668,7 @@ QQmlPropertyCache *QQmlMetaType::propertyCache(const QQmlType &type, int minorVe
 
 void qmlUnregisterType(int typeIndex)
 {
-    QMutexLocker lock(metaTypeDataLock());
+    QQmlMetaTypeRegistrationLocker lock;
     QQmlMetaTypeData *data = metaTypeData();
     {
         const QQmlTypePrivate *d = data->types.value(typeIndex).priv();
@@ -2590,7 +2689,7 @@ void qmlUnregisterType(int typeIndex)
 
 void QQmlMetaType::freeUnusedTypesAndCaches()
 {
-    QMutexLocker lock(metaTypeDataLock());
+    QQmlMetaTypeRegistrationLocker lock;
     QQmlMetaTypeData *data = metaTypeData();
 
     {
@@ -376,6 +376,17 @@ public:
     { return _failures; }
 };
 
+// Holds the type registration lock for a change to the registered types. Lookups from other
+// threads don't take the lock, and only see the change once the outermost locker is gone.
+class Q_QML_PRIVATE_EXPORT QQmlMetaTypeRegistrationLocker
+{
+    Q_DISABLE_COPY(QQmlMetaTypeRegistrationLocker)
+
+public:
+    QQmlMetaTypeRegistrationLocker();
+    ~QQmlMetaTypeRegistrationLocker();
+};
+
 QT_END_NAMESPACE
 
 #endif // QQMLMETATYPE_P_H
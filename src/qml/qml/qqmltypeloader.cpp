@@ -67,6 +67,8 @@
 #include <QtQml/qqmlextensioninterface.h>
 #include <QtCore/qcryptographichash.h>
 #include <QtCore/qscopeguard.h>
+#include <QtCore/qrunnable.h>
+#include <QtCore/qthreadpool.h>
 
 #include <functional>
 
@@ -104,6 +106,7 @@
 DEFINE_BOOL_CONFIG_OPTION(dumpErrors, QML_DUMP_ERRORS);
 DEFINE_BOOL_CONFIG_OPTION(disableDiskCache, QML_DISABLE_DISK_CACHE);
 DEFINE_BOOL_CONFIG_OPTION(forceDiskCache, QML_FORCE_DISK_CACHE);
+DEFINE_BOOL_CONFIG_OPTION(contentHashDiskCache, QML_DISK_CACHE_CONTENT_HASH);
 
 Q_DECLARE_LOGGING_CATEGORY(DBG_DISK_CACHE)
 Q_LOGGING_CATEGORY(DBG_DISK_CACHE, "qt.qml.diskcache")
@@ -155,6 +158,8 @@ public:
 #endif // qml_network
     void load(QQmlDataBlob *b);
     void loadAsync(QQmlDataBlob *b);
+    void postPreparedData();
+    void waitForPreparedData(QQmlDataBlob *b);
     void loadWithStaticData(QQmlDataBlob *b, const QByteArray &);
     void loadWithStaticDataAsync(QQmlDataBlob *b, const QByteArray &);
     void loadWithCachedUnit(QQmlDataBlob *b, const QV4::CompiledData::Unit *unit);
@@ -168,6 +173,8 @@ protected:
 
 private:
     void loadThread(QQmlDataBlob *b);
+    void preparedDataThread();
+    void waitForPreparedDataThread(QQmlDataBlob *b);
     void loadWithStaticDataThread(QQmlDataBlob *b, const QByteArray &);
     void loadWithCachedUnitThread(QQmlDataBlob *b, const QV4::CompiledData::Unit *unit);
     void callCompletedMain(QQmlDataBlob *b);
@@ -256,7 +263,7 @@ Create a new QQmlDataBlob for \a url and of the provided \a type.
 */
 QQmlDataBlob::QQmlDataBlob(const QUrl &url, Type type, QQmlTypeLoader *manager)
 : m_typeLoader(manager), m_type(type), m_url(url), m_finalUrl(url), m_redirectCount(0),
-  m_inCallback(false), m_isDone(false)
+  m_inCallback(false), m_isDone(false), m_isPreparing(false)
 {
     //Set here because we need to get the engine from the manager
     if (m_typeLoader->engine() && m_typeLoader->engine()->urlInterceptor())
@@ -518,6 +525,33 @@ void QQmlDataBlob::addDependency(QQmlDataBlob *blob)
     blob->m_waitingOnMe.append(this);
 }
 
+/*!
+Invoked in the load thread when data for the blob has arrived, before dataReceived().
+Return true to have prepareData() called with the same data on a loader worker thread
+first.  Implementors should copy whatever state prepareData() needs from the engine or
+the type loader here, as neither may be accessed from the worker thread.
+
+The default implementation returns false.
+*/
+bool QQmlDataBlob::beginPrepareData()
+{
+    return false;
+}
+
+/*!
+Invoked on a loader worker thread if beginPrepareData() returned true.  Implementors
+should use this callback for work that depends only on \a data, such as reading and
+parsing the source, and store the results for dataReceived().  Unrelated blobs are
+prepared concurrently, so this callback must not touch the engine, the type loader or
+any other blob, and it must not call setError() or addDependency().
+
+The default implementation does nothing.
+*/
+void QQmlDataBlob::prepareData(const SourceCodeData &data)
+{
+    Q_UNUSED(data);
+}
+
 /*!
 \fn void QQmlDataBlob::dataReceived(const Data &data)
 
@@ -838,6 +872,16 @@ void QQmlTypeLoaderThread::loadAsync(QQmlDataBlob *b)
     postMethodToThread(&This::loadThread, b);
 }
 
+void QQmlTypeLoaderThread::postPreparedData()
+{
+    postMethodToThread(&This::preparedDataThread);
+}
+
+void QQmlTypeLoaderThread::waitForPreparedData(QQmlDataBlob *b)
+{
+    callMethodInThread(&This::waitForPreparedDataThread, b);
+}
+
 void QQmlTypeLoaderThread::loadWithStaticData(QQmlDataBlob *b, const QByteArray &d)
 {
     b->addref();
@@ -906,6 +950,16 @@ void QQmlTypeLoaderThread::loadThread(QQmlDataBlob *b)
     b->release();
 }
 
+void QQmlTypeLoaderThread::preparedDataThread()
+{
+    m_loader->processPreparedData();
+}
+
+void QQmlTypeLoaderThread::waitForPreparedDataThread(QQmlDataBlob *b)
+{
+    m_loader->waitForPreparedData(b);
+}
+
 void QQmlTypeLoaderThread::loadWithStaticDataThread(QQmlDataBlob *b, const QByteArray &d)
 {
     m_loader->loadWithStaticDataThread(b, d);
@@ -973,6 +1027,12 @@ one of these three preconditions are met.
 \endlist
 
 Thus QQmlDataBlob::done() will always eventually be called, even if the blob has an error set.
+
+Reading, parsing and compiling the source of a QML or JavaScript file only depends on the
+file itself, so QQmlTypeData and QQmlScriptBlob do that work in QQmlDataBlob::prepareData()
+on a pool of worker threads.  Once a blob is prepared, the rest of its processing, starting
+with QQmlDataBlob::dataReceived(), continues on the loader thread.  The size of the pool is
+set with setWorkerThreadCount().
 */
 
 void QQmlTypeLoader::invalidate()
@@ -983,6 +1043,16 @@ void QQmlTypeLoader::invalidate()
         m_thread = nullptr;
     }
 
+#if QT_CONFIG(thread)
+    delete m_workerPool;
+    m_workerPool = nullptr;
+    for (PrepareJob *job : qAsConst(m_preparedJobs)) {
+        job->blob->release();
+        delete job;
+    }
+    m_preparedJobs.clear();
+#endif
+
 #if QT_CONFIG(qml_network)
     // Need to delete the network replies after
     // the loader thread is shutdown as it could be
@@ -1073,6 +1143,10 @@ void QQmlTypeLoader::doLoad(const Loader &loader, QQmlDataBlob *blob, Mode mode)
     } else {
         unlock();
         loader.load(this, blob);
+        // The blob and its local dependencies are prepared on the worker threads. Finish them
+        // off before returning, so that synchronous loads of local files still complete here.
+        if (hasPendingPreparedData())
+            m_thread->waitForPreparedData(blob);
         lock();
         if (mode == PreferSynchronous) {
             if (!blob->isCompleteOrError())
@@ -1292,7 +1366,53 @@ void QQmlTypeLoader::setData(QQmlDataBlob *blob, const QString &fileName)
     setData(blob, d);
 }
 
+#if QT_CONFIG(thread)
+class QQmlTypeLoader::PrepareJob : public QRunnable
+{
+public:
+    PrepareJob(QQmlTypeLoader *loader, QQmlDataBlob *blob, const QQmlDataBlob::SourceCodeData &data)
+        : loader(loader)
+        , blob(blob)
+        , data(data)
+    {
+        setAutoDelete(false);
+        // Released on the loader thread, once the job has been processed.
+        blob->addref();
+    }
+
+    void run() override
+    {
+        blob->prepareData(data);
+        loader->prepareJobFinished(this);
+    }
+
+    QQmlTypeLoader *loader;
+    QQmlDataBlob *blob;
+    QQmlDataBlob::SourceCodeData data;
+};
+#endif
+
 void QQmlTypeLoader::setData(QQmlDataBlob *blob, const QQmlDataBlob::SourceCodeData &d)
+{
+#if QT_CONFIG(thread)
+    QMutexLocker locker(&m_prepareMutex);
+    if (m_workerThreadCount > 0 && !m_workersStopped && blob->beginPrepareData()) {
+        if (!m_workerPool) {
+            m_workerPool = new QThreadPool;
+            m_workerPool->setMaxThreadCount(m_workerThreadCount);
+        }
+        ++m_pendingPrepareJobs;
+        blob->m_isPreparing = true;
+        m_workerPool->start(new PrepareJob(this, blob, d));
+        return;
+    }
+    locker.unlock();
+#endif
+
+    processData(blob, d);
+}
+
+void QQmlTypeLoader::processData(QQmlDataBlob *blob, const QQmlDataBlob::SourceCodeData &d)
 {
     QML_MEMORY_SCOPE_URL(blob->url());
     QQmlCompilingProfiler prof(profiler(), blob);
@@ -1332,10 +1452,121 @@ void QQmlTypeLoader::setCachedUnit(QQmlDataBlob *blob, const QV4::CompiledData::
     blob->tryDone();
 }
 
+#if QT_CONFIG(thread)
+// Called on a worker thread.
+void QQmlTypeLoader::prepareJobFinished(PrepareJob *job)
+{
+    QMutexLocker locker(&m_prepareMutex);
+    m_preparedJobs.append(job);
+    --m_pendingPrepareJobs;
+    m_prepareCondition.wakeAll();
+    if (m_preparedDataPosted)
+        return;
+    m_preparedDataPosted = true;
+    locker.unlock();
+
+    m_thread->postPreparedData();
+}
+
+void QQmlTypeLoader::stopWorkerThreads()
+{
+    {
+        QMutexLocker locker(&m_prepareMutex);
+        m_workersStopped = true;
+    }
+
+    // Every job that is still running posts its result to the loader thread,
+    // which processes it before shutting down.
+    if (m_workerPool)
+        m_workerPool->waitForDone();
+}
+#endif
+
+bool QQmlTypeLoader::hasPendingPreparedData()
+{
+#if QT_CONFIG(thread)
+    QMutexLocker locker(&m_prepareMutex);
+    return m_pendingPrepareJobs > 0 || !m_preparedJobs.isEmpty();
+#else
+    return false;
+#endif
+}
+
+void QQmlTypeLoader::processPreparedData()
+{
+    ASSERT_LOADTHREAD();
+
+#if QT_CONFIG(thread)
+    QVector<PrepareJob *> jobs;
+    {
+        QMutexLocker locker(&m_prepareMutex);
+        jobs.swap(m_preparedJobs);
+        m_preparedDataPosted = false;
+    }
+
+    for (PrepareJob *job : qAsConst(jobs)) {
+        job->blob->m_isPreparing = false;
+        processData(job->blob, job->data);
+        job->blob->release();
+        delete job;
+    }
+#endif
+}
+
+/*!
+Returns true if \a blob, or any blob it is still waiting for, is being prepared on a worker
+thread or has been prepared but not processed yet.
+*/
+bool QQmlTypeLoader::isPreparing(QQmlDataBlob *blob, QSet<QQmlDataBlob *> *visited) const
+{
+    if (blob->m_isPreparing)
+        return true;
+    if (visited->contains(blob))
+        return false;
+    visited->insert(blob);
+    for (const QQmlRefPointer<QQmlDataBlob> &dependency : qAsConst(blob->m_waitingFor)) {
+        if (isPreparing(dependency.data(), visited))
+            return true;
+    }
+    return false;
+}
+
+/*!
+Processes prepared blobs until neither \a blob nor any of its dependencies are being prepared
+on the worker threads. Processing a blob can start loading its dependencies, which are waited
+for as well. Jobs for unrelated blobs are left running.
+*/
+void QQmlTypeLoader::waitForPreparedData(QQmlDataBlob *blob)
+{
+    ASSERT_LOADTHREAD();
+
+#if QT_CONFIG(thread)
+    QMutexLocker locker(&m_prepareMutex);
+    for (;;) {
+        if (!m_preparedJobs.isEmpty()) {
+            locker.unlock();
+            processPreparedData();
+            locker.relock();
+            continue;
+        }
+        QSet<QQmlDataBlob *> visited;
+        if (!isPreparing(blob, &visited))
+            break;
+        m_prepareCondition.wait(&m_prepareMutex);
+    }
+#else
+    Q_UNUSED(blob);
+#endif
+}
+
 void QQmlTypeLoader::shutdownThread()
 {
-    if (m_thread && !m_thread->isShutdown())
+    if (m_thread && !m_thread->isShutdown()) {
+#if QT_CONFIG(thread)
+        stopWorkerThreads();
+#endif
         m_thread->shutdown();
+    }
 }
 
 QQmlTypeLoader::Blob::Blob(const QUrl &url, QQmlDataBlob::Type type, QQmlTypeLoader *loader)
@@ -1636,7 +1867,13 @@ QQmlTypeLoader::QQmlTypeLoader(QQmlEngine *engine)
     , m_thread(new QQmlTypeLoaderThread(this))
     , m_mutex(m_thread->mutex())
     , m_typeCacheTrimThreshold(TYPELOADER_MINIMUM_TRIM_THRESHOLD)
+    , m_workerThreadCount(0)
+    , m_diskCacheValidation(contentHashDiskCache() ? DiskCacheValidation::ContentHash
+                                                   : DiskCacheValidation::TimeStamp)
 {
+    bool ok = false;
+    const int workerThreadCount = qEnvironmentVariableIntValue("QML_TYPELOADER_WORKER_THREADS", &ok);
+    setWorkerThreadCount(ok ? workerThreadCount : QThread::idealThreadCount());
 }
 
 /*!
@@ -1653,6 +1890,53 @@ QQmlTypeLoader::~QQmlTypeLoader()
     invalidate();
 }
 
+/*!
+Returns the maximum number of worker threads used to read, parse and compile source files.
+*/
+int QQmlTypeLoader::workerThreadCount() const
+{
+#if QT_CONFIG(thread)
+    QMutexLocker locker(&m_prepareMutex);
+#endif
+    return m_workerThreadCount;
+}
+
+/*!
+Sets the maximum number of worker threads used to read, parse and compile source files
+to \a count, bounded by QThread::idealThreadCount().  A count of 0 does all the work on
+the loader thread.
+
+The default is taken from the \c QML_TYPELOADER_WORKER_THREADS environment variable, or
+QThread::idealThreadCount() if it is not set.
+*/
+void QQmlTypeLoader::setWorkerThreadCount(int count)
+{
+#if QT_CONFIG(thread)
+    QMutexLocker locker(&m_prepareMutex);
+    m_workerThreadCount = qBound(0, count, QThread::idealThreadCount());
+    if (m_workerPool && m_workerThreadCount > 0)
+        m_workerPool->setMaxThreadCount(m_workerThreadCount);
+#else
+    Q_UNUSED(count);
+#endif
+}
+
+/*!
+\enum QQmlTypeLoader::DiskCacheValidation
+
+Selects how cached compilation units are matched against their source files.
+
+\value TimeStamp The cache is valid if the source file's modification time is unchanged.
+\value ContentHash The cache is valid if the source file's contents hash to the same value,
+regardless of its modification time. Cache files are named after the hash, so they can be
+shared between machines and kept in a read-only directory given by the
+\c QML_DISK_CACHE_SHARED_PATH environment variable. That directory is not used with
+\c TimeStamp validation.
+
+The default is \c TimeStamp, or \c ContentHash if the \c QML_DISK_CACHE_CONTENT_HASH
+environment variable is set. It must be changed before any files are loaded.
+*/
+
 QQmlImportDatabase *QQmlTypeLoader::importDatabase() const
 {
     return &QQmlEnginePrivate::get(engine())->importDatabase;
@@ -2145,25 +2429,110 @@ void QQmlTypeData::unregisterCallback(TypeDataCallback *callback)
     Q_ASSERT(!m_callbacks.contains(callback));
 }
 
-bool QQmlTypeData::tryLoadFromDiskCache()
+// Thread-safe, so that it can be called from prepareData()
+static QQmlRefPointer<QV4::CompiledData::CompilationUnit> loadUnitFromDiskCache(
+        const QUrl &url, const QDateTime &sourceTimeStamp, quint64 sourceHash)
 {
-    if (disableDiskCache() && !forceDiskCache())
-        return false;
+    QQmlRefPointer<QV4::CompiledData::CompilationUnit> unit = QV4::Compiler::Codegen::createUnitForLoading();
+    QString error;
+    if (!unit->loadFromDisk(url, sourceTimeStamp, &error, sourceHash)) {
+        qCDebug(DBG_DISK_CACHE) << "Error loading" << url.toString() << "from disk cache:" << error;
+        return QQmlRefPointer<QV4::CompiledData::CompilationUnit>();
+    }
+    return unit;
+}
 
-    if (isDebugging())
-        return false;
+// Thread-safe, so that it can be called from prepareData()
+static QmlIR::Document *parseQmlSource(const QQmlDataBlob::SourceCodeData &data, const QSet<QString> &illegalNames,
+                                       bool debugging, bool useContentHash, const QUrl &url,
+                                       const QString &finalUrlString, QList<QQmlError> *errors)
+{
+    QScopedPointer<QmlIR::Document> document(new QmlIR::Document(debugging));
+    document->jsModule.sourceTimeStamp = data.sourceTimeStamp();
+    if (useContentHash)
+        document->jsModule.sourceHash = data.sourceHash();
+    QmlIR::IRBuilder compiler(illegalNames);
 
+    QString sourceError;
+    const QString source = data.readAll(&sourceError);
+    if (!sourceError.isEmpty()) {
+        QQmlError e;
+        e.setUrl(url);
+        e.setDescription(sourceError);
+        errors->append(e);
+        return document.take();
+    }
+
+    if (!compiler.generateFromQml(source, finalUrlString, document.data())) {
+        errors->reserve(compiler.errors.count());
+        for (const QQmlJS::DiagnosticMessage &msg : qAsConst(compiler.errors)) {
+            QQmlError e;
+            e.setUrl(url);
+            e.setLine(msg.loc.startLine);
+            e.setColumn(msg.loc.startColumn);
+            e.setDescription(msg.message);
+            errors->append(e);
+        }
+    }
+    return document.take();
+}
+
+bool QQmlTypeData::beginPrepareData()
+{
     QV4::ExecutionEngine *v4 = typeLoader()->engine()->handle();
     if (!v4)
         return false;
 
-    QQmlRefPointer<QV4::CompiledData::CompilationUnit> unit = QV4::Compiler::Codegen::createUnitForLoading();
-    {
-        QString error;
-        if (!unit->loadFromDisk(url(), m_backupSourceCode.sourceTimeStamp(), &error)) {
-            qCDebug(DBG_DISK_CACHE) << "Error loading" << urlString() << "from disk cache:" << error;
+    m_prepared.reset(new PreparedData);
+    m_prepared->illegalNames = v4->v8Engine->illegalNames();
+    m_prepared->url = url();
+    m_prepared->finalUrlString = finalUrlString();
+    m_prepared->debugging = isDebugging();
+    m_prepared->useDiskCache = (!disableDiskCache() || forceDiskCache()) && !m_prepared->debugging;
+    m_prepared->useContentHash = typeLoader()->diskCacheValidation() == QQmlTypeLoader::DiskCacheValidation::ContentHash;
+    return true;
+}
+
+void QQmlTypeData::prepareData(const SourceCodeData &data)
+{
+    PreparedData *prepared = m_prepared.data();
+    if (prepared->useDiskCache) {
+        prepared->cachedUnit = loadUnitFromDiskCache(prepared->url, data.sourceTimeStamp(),
+                                                     prepared->useContentHash ? data.sourceHash() : 0);
+        if (prepared->cachedUnit)
+            return;
+    }
+
+    if (!data.exists() || data.isEmpty())
+        return;
+
+    prepared->document.reset(parseQmlSource(data, prepared->illegalNames, prepared->debugging, prepared->useContentHash,
+                                            prepared->url, prepared->finalUrlString, &prepared->errors));
+}
+
+bool QQmlTypeData::tryLoadFromDiskCache()
+{
+    QQmlRefPointer<QV4::CompiledData::CompilationUnit> unit;
+    if (m_prepared) {
+        unit = m_prepared->cachedUnit;
+        if (!unit)
+            return false;
+    } else {
+        if (disableDiskCache() && !forceDiskCache())
+            return false;
+
+        if (isDebugging())
+            return false;
+
+        QV4::ExecutionEngine *v4 = typeLoader()->engine()->handle();
+        if (!v4)
+            return false;
+
+        const bool useContentHash = typeLoader()->diskCacheValidation() == QQmlTypeLoader::DiskCacheValidation::ContentHash;
+        unit = loadUnitFromDiskCache(url(), m_backupSourceCode.sourceTimeStamp(),
+                                     useContentHash ? m_backupSourceCode.sourceHash() : 0);
+        if (!unit)
             return false;
-        }
     }
 
     if (unit->unitData()->flags & QV4::CompiledData::Unit::PendingTypeCompilation) {
@@ -2469,13 +2838,18 @@ void QQmlTypeData::dataReceived(const SourceCodeData &data)
 {
     m_backupSourceCode = data;
 
-    if (tryLoadFromDiskCache())
+    if (tryLoadFromDiskCache()) {
+        m_prepared.reset();
         return;
+    }
 
-    if (isError())
+    if (isError()) {
+        m_prepared.reset();
         return;
+    }
 
     if (!m_backupSourceCode.exists() || m_backupSourceCode.isEmpty()) {
+        m_prepared.reset();
         if (m_cachedUnitStatus == QQmlMetaType::CachedUnitLookupError::VersionMismatch)
             setError(QQmlTypeLoader::tr("File was compiled ahead of time with an incompatible version of Qt and the original file cannot be found. Please recompile"));
         else if (!m_backupSourceCode.exists())
@@ -2504,29 +2878,18 @@ void QQmlTypeData::initializeFromCachedUnit(const QV4::CompiledData::Unit *unit)
 
 bool QQmlTypeData::loadFromSource()
 {
-    m_document.reset(new QmlIR::Document(isDebugging()));
-    m_document->jsModule.sourceTimeStamp = m_backupSourceCode.sourceTimeStamp();
-    QQmlEngine *qmlEngine = typeLoader()->engine();
-    QmlIR::IRBuilder compiler(qmlEngine->handle()->v8Engine->illegalNames());
-
-    QString sourceError;
-    const QString source = m_backupSourceCode.readAll(&sourceError);
-    if (!sourceError.isEmpty()) {
-        setError(sourceError);
-        return false;
+    QList<QQmlError> errors;
+    if (m_prepared && m_prepared->document) {
+        m_document.swap(m_prepared->document);
+        errors = m_prepared->errors;
+    } else {
+        const bool useContentHash = typeLoader()->diskCacheValidation() == QQmlTypeLoader::DiskCacheValidation::ContentHash;
+        m_document.reset(parseQmlSource(m_backupSourceCode, typeLoader()->engine()->handle()->v8Engine->illegalNames(),
+                                        isDebugging(), useContentHash, url(), finalUrlString(), &errors));
     }
+    m_prepared.reset();
 
-    if (!compiler.generateFromQml(source, finalUrlString(), m_document.data())) {
-        QList<QQmlError> errors;
-        errors.reserve(compiler.errors.count());
-        for (const QQmlJS::DiagnosticMessage &msg : qAsConst(compiler.errors)) {
-            QQmlError e;
-            e.setUrl(url());
-            e.setLine(msg.loc.startLine);
-            e.setColumn(msg.loc.startColumn);
-            e.setDescription(msg.message);
-            errors << e;
-        }
+    if (!errors.isEmpty()) {
         setError(errors);
         return false;
     }
@@ -2659,7 +3022,9 @@ void QQmlTypeData::compile(const QQmlRefPointer<QQmlTypeNameCache> &typeNameCach
         QString errorString;
         if (m_compiledData->saveToDisk(url(), &errorString)) {
             QString error;
-            if (!m_compiledData->loadFromDisk(url(), m_backupSourceCode.sourceTimeStamp(), &error)) {
+            const bool useContentHash = typeLoader()->diskCacheValidation() == QQmlTypeLoader::DiskCacheValidation::ContentHash;
+            if (!m_compiledData->loadFromDisk(url(), m_backupSourceCode.sourceTimeStamp(), &error,
+                                              useContentHash ? m_backupSourceCode.sourceHash() : 0)) {
                 // ignore error, keep using the in-memory compilation unit.
             }
         } else {
@@ -3008,62 +3373,80 @@ QQmlRefPointer<QQmlScriptData> QQmlScriptBlob::scriptData() const
     return m_scriptData;
 }
 
-void QQmlScriptBlob::dataReceived(const SourceCodeData &data)
+bool QQmlScriptBlob::beginPrepareData()
 {
-    if (!disableDiskCache() || forceDiskCache()) {
-        QQmlRefPointer<QV4::CompiledData::CompilationUnit> unit = QV4::Compiler::Codegen::createUnitForLoading();
-        QString error;
-        if (unit->loadFromDisk(url(), data.sourceTimeStamp(), &error)) {
-            initializeFromCompilationUnit(unit);
+    m_prepared.reset(new PreparedData);
+    m_prepared->url = url();
+    m_prepared->urlString = urlString();
+    m_prepared->finalUrlString = finalUrlString();
+    m_prepared->debugging = isDebugging();
+    m_prepared->useDiskCache = !disableDiskCache() || forceDiskCache();
+    m_prepared->useContentHash = typeLoader()->diskCacheValidation() == QQmlTypeLoader::DiskCacheValidation::ContentHash;
+    m_prepared->cachedUnitStatus = m_cachedUnitStatus;
+    return true;
+}
+
+void QQmlScriptBlob::prepareData(const SourceCodeData &data)
+{
+    loadOrCompile(m_prepared.data(), data, m_isModule);
+}
+
+// Only touches \a prepared, so that it can run on a worker thread.
+void QQmlScriptBlob::loadOrCompile(PreparedData *prepared, const SourceCodeData &data, bool isModule)
+{
+    const quint64 sourceHash = prepared->useContentHash ? data.sourceHash() : 0;
+    if (prepared->useDiskCache) {
+        prepared->unit = loadUnitFromDiskCache(prepared->url, data.sourceTimeStamp(), sourceHash);
+        if (prepared->unit)
             return;
-        } else {
-            qCDebug(DBG_DISK_CACHE()) << "Error loading" << urlString() << "from disk cache:" << error;
-        }
     }
 
+    auto addError = [prepared](const QString &description) {
+        QQmlError e;
+        e.setDescription(description);
+        e.setUrl(prepared->url);
+        prepared->errors.append(e);
+    };
+
     if (!data.exists()) {
-        if (m_cachedUnitStatus == QQmlMetaType::CachedUnitLookupError::VersionMismatch)
-            setError(QQmlTypeLoader::tr("File was compiled ahead of time with an incompatible version of Qt and the original file cannot be found. Please recompile"));
+        if (prepared->cachedUnitStatus == QQmlMetaType::CachedUnitLookupError::VersionMismatch)
+            addError(QQmlTypeLoader::tr("File was compiled ahead of time with an incompatible version of Qt and the original file cannot be found. Please recompile"));
         else
-            setError(QQmlTypeLoader::tr("No such file or directory"));
+            addError(QQmlTypeLoader::tr("No such file or directory"));
         return;
     }
 
     QString error;
     QString source = data.readAll(&error);
     if (!error.isEmpty()) {
-        setError(error);
+        addError(error);
         return;
     }
 
     QQmlRefPointer<QV4::CompiledData::CompilationUnit> unit;
 
-    if (m_isModule) {
+    if (isModule) {
         QList<QQmlJS::DiagnosticMessage> diagnostics;
-        unit = QV4::ExecutionEngine::compileModule(isDebugging(), urlString(), source, data.sourceTimeStamp(), &diagnostics);
-        QList<QQmlError> errors = QQmlEnginePrivate::qmlErrorFromDiagnostics(urlString(), diagnostics);
-        if (!errors.isEmpty()) {
-            setError(errors);
+        unit = QV4::ExecutionEngine::compileModule(prepared->debugging, prepared->urlString, source, data.sourceTimeStamp(), &diagnostics, sourceHash);
+        prepared->errors = QQmlEnginePrivate::qmlErrorFromDiagnostics(prepared->urlString, diagnostics);
+        if (!prepared->errors.isEmpty())
             return;
-        }
     } else {
-        QmlIR::Document irUnit(isDebugging());
+        QmlIR::Document irUnit(prepared->debugging);
 
         irUnit.jsModule.sourceTimeStamp = data.sourceTimeStamp();
+        irUnit.jsModule.sourceHash = sourceHash;
 
         QmlIR::ScriptDirectivesCollector collector(&irUnit);
         irUnit.jsParserEngine.setDirectives(&collector);
 
-        QList<QQmlError> errors;
         unit = QV4::Script::precompile(
-                    &irUnit.jsModule, &irUnit.jsParserEngine, &irUnit.jsGenerator, urlString(), finalUrlString(),
-                    source, &errors, QV4::Compiler::ContextType::ScriptImportedByQML);
+                    &irUnit.jsModule, &irUnit.jsParserEngine, &irUnit.jsGenerator, prepared->urlString, prepared->finalUrlString,
+                    source, &prepared->errors, QV4::Compiler::ContextType::ScriptImportedByQML);
         // No need to addref on unit, it's initial refcount is 1
         source.clear();
-        if (!errors.isEmpty()) {
-            setError(errors);
+        if (!prepared->errors.isEmpty())
             return;
-        }
         if (!unit) {
             unit.adopt(new QV4::CompiledData::CompilationUnit);
         }
@@ -3073,11 +3456,11 @@ void QQmlScriptBlob::dataReceived(const SourceCodeData &data)
         qmlGenerator.generate(irUnit);
     }
 
-    if ((!disableDiskCache() || forceDiskCache()) && !isDebugging()) {
+    if (prepared->useDiskCache && !prepared->debugging) {
         QString errorString;
-        if (unit->saveToDisk(url(), &errorString)) {
+        if (unit->saveToDisk(prepared->url, &errorString)) {
             QString error;
-            if (!unit->loadFromDisk(url(), data.sourceTimeStamp(), &error)) {
+            if (!unit->loadFromDisk(prepared->url, data.sourceTimeStamp(), &error, sourceHash)) {
                 // ignore error, keep using the in-memory compilation unit.
             }
         } else {
@@ -3085,7 +3468,23 @@ void QQmlScriptBlob::dataReceived(const SourceCodeData &data)
         }
     }
 
-    initializeFromCompilationUnit(unit);
+    prepared->unit = unit;
+}
+
+void QQmlScriptBlob::dataReceived(const SourceCodeData &data)
+{
+    if (!m_prepared) {
+        beginPrepareData();
+        prepareData(data);
+    }
+
+    QScopedPointer<PreparedData> prepared(m_prepared.take());
+    if (!prepared->errors.isEmpty()) {
+        setError(prepared->errors);
+        return;
+    }
+
+    initializeFromCompilationUnit(prepared->unit);
 }
 
 void QQmlScriptBlob::initializeFromCachedUnit(const QV4::CompiledData::Unit *unit)
@@ -3289,6 +3688,33 @@ QDateTime QQmlDataBlob::SourceCodeData::sourceTimeStamp() const
     return fileInfo.lastModified();
 }
 
+quint64 QQmlDataBlob::SourceCodeData::sourceHash() const
+{
+    if (cachedSourceHash)
+        return cachedSourceHash;
+
+    if (hasInlineSourceCode) {
+        const QByteArray utf8 = inlineSourceCode.toUtf8();
+        cachedSourceHash = QV4::CompiledData::computeSourceHash(utf8.constData(), utf8.size());
+        return cachedSourceHash;
+    }
+
+    // Hash the raw bytes, so that the result matches what qmlcachegen computes.
+    QFile f(fileInfo.absoluteFilePath());
+    if (!f.open(QIODevice::ReadOnly))
+        return 0;
+
+    const qint64 fileSize = fileInfo.size();
+    if (uchar *mappedData = f.map(0, fileSize)) {
+        cachedSourceHash = QV4::CompiledData::computeSourceHash(reinterpret_cast<const char *>(mappedData), fileSize);
+        f.unmap(mappedData);
+    } else {
+        const QByteArray data = f.readAll();
+        cachedSourceHash = QV4::CompiledData::computeSourceHash(data.constData(), data.size());
+    }
+    return cachedSourceHash;
+}
+
 bool QQmlDataBlob::SourceCodeData::exists() const
 {
     if (hasInlineSourceCode)
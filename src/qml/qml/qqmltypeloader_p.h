@@ -56,6 +56,8 @@
 #include <QtCore/qatomic.h>
 #include <QtCore/qfileinfo.h>
 #include <QtCore/qcache.h>
+#include <QtCore/qmutex.h>
+#include <QtCore/qwaitcondition.h>
 #if QT_CONFIG(qml_network)
 #include <QtNetwork/qnetworkreply.h>
 #endif
@@ -85,6 +87,7 @@ class QQmlTypeData;
 class QQmlTypeLoader;
 class QQmlExtensionInterface;
 class QQmlProfiler;
+class QThreadPool;
 struct QQmlCompileError;
 
 namespace QmlIR {
@@ -139,6 +142,7 @@ public:
     public:
         QString readAll(QString *error) const;
         QDateTime sourceTimeStamp() const;
+        quint64 sourceHash() const;
         bool exists() const;
         bool isEmpty() const;
     private:
@@ -146,6 +150,7 @@ public:
         friend class QQmlTypeLoader;
         QString inlineSourceCode;
         QFileInfo fileInfo;
+        mutable quint64 cachedSourceHash = 0;
         bool hasInlineSourceCode = false;
     };
 
@@ -159,6 +164,7 @@ protected:
     void addDependency(QQmlDataBlob *);
 
     // Callbacks made in load thread
+    virtual bool beginPrepareData();
     virtual void dataReceived(const SourceCodeData &) = 0;
     virtual void initializeFromCachedUnit(const QV4::CompiledData::Unit*) = 0;
     virtual void done();
@@ -169,6 +175,9 @@ protected:
     virtual void dependencyComplete(QQmlDataBlob *);
     virtual void allDependenciesDone();
 
+    // Callbacks made in a loader worker thread, between beginPrepareData() and dataReceived()
+    virtual void prepareData(const SourceCodeData &);
+
     // Callbacks made in main thread
     virtual void downloadProgressChanged(qreal);
     virtual void completed();
@@ -222,6 +231,8 @@ private:
     int m_redirectCount:30;
     bool m_inCallback:1;
     bool m_isDone:1;
+    // Set while prepareData() is pending on a worker thread. Only used on the loader thread.
+    bool m_isPreparing:1;
 };
 
 class QQmlTypeLoaderThread;
@@ -336,6 +347,16 @@ public:
     void initializeEngine(QQmlExtensionInterface *, const char *);
     void invalidate();
 
+    int workerThreadCount() const;
+    void setWorkerThreadCount(int count);
+
+    enum class DiskCacheValidation {
+        TimeStamp,
+        ContentHash
+    };
+    DiskCacheValidation diskCacheValidation() const { return m_diskCacheValidation; }
+    void setDiskCacheValidation(DiskCacheValidation validation) { m_diskCacheValidation = validation; }
+
 #if !QT_CONFIG(qml_debug)
     quintptr profiler() const { return 0; }
     void setProfiler(quintptr) {}
@@ -368,6 +389,17 @@ private:
     void setData(QQmlDataBlob *, const QString &fileName);
     void setData(QQmlDataBlob *, const QQmlDataBlob::SourceCodeData &);
     void setCachedUnit(QQmlDataBlob *blob, const QV4::CompiledData::Unit *unit);
+    void processData(QQmlDataBlob *, const QQmlDataBlob::SourceCodeData &);
+
+#if QT_CONFIG(thread)
+    class PrepareJob;
+    void prepareJobFinished(PrepareJob *job);
+    void stopWorkerThreads();
+#endif
+    bool hasPendingPreparedData();
+    void processPreparedData();
+    bool isPreparing(QQmlDataBlob *blob, QSet<QQmlDataBlob *> *visited) const;
+    void waitForPreparedData(QQmlDataBlob *blob);
 
     template<typename T>
     struct TypedCallback
@@ -409,6 +441,21 @@ private:
     ImportDirCache m_importDirCache;
     ImportQmlDirCache m_importQmlDirCache;
 
+#if QT_CONFIG(thread)
+    // Source files are read, parsed and compiled on m_workerPool. Finished jobs are queued
+    // in m_preparedJobs and handed back to the loader thread, which continues loading them
+    // in the usual order.
+    QThreadPool *m_workerPool = nullptr;
+    mutable QMutex m_prepareMutex;
+    QWaitCondition m_prepareCondition;
+    QVector<PrepareJob *> m_preparedJobs;
+    int m_pendingPrepareJobs = 0;
+    bool m_preparedDataPosted = false;
+    bool m_workersStopped = false;
+#endif
+    int m_workerThreadCount;
+    DiskCacheValidation m_diskCacheValidation;
+
     template<typename Loader>
     void doLoad(const Loader &loader, QQmlDataBlob *blob, Mode mode);
     void updateTypeCacheTrimThreshold();
@@ -474,6 +521,9 @@ protected:
 
     QString stringAt(int index) const override;
 
+    bool beginPrepareData() override;
+    void prepareData(const SourceCodeData &) override;
+
 private:
     bool tryLoadFromDiskCache();
     bool loadFromSource();
@@ -518,6 +568,21 @@ private:
 
     bool m_implicitImportLoaded;
     bool loadImplicitImport();
+
+    // Results of prepareData(), consumed by dataReceived()
+    struct PreparedData
+    {
+        QSet<QString> illegalNames;
+        QUrl url;
+        QString finalUrlString;
+        bool debugging = false;
+        bool useDiskCache = false;
+        bool useContentHash = false;
+        QQmlRefPointer<QV4::CompiledData::CompilationUnit> cachedUnit;
+        QScopedPointer<QmlIR::Document> document;
+        QList<QQmlError> errors;
+    };
+    QScopedPointer<PreparedData> m_prepared;
 };
 
 // QQmlScriptData instances are created, uninitialized, by the loader in the
@@ -579,6 +644,8 @@ public:
     QQmlRefPointer<QQmlScriptData> scriptData() const;
 
 protected:
+    bool beginPrepareData() override;
+    void prepareData(const SourceCodeData &) override;
     void dataReceived(const SourceCodeData &) override;
     void initializeFromCachedUnit(const QV4::CompiledData::Unit *unit) override;
     void done() override;
@@ -586,12 +653,27 @@ protected:
     QString stringAt(int index) const override;
 
 private:
+    struct PreparedData
+    {
+        QUrl url;
+        QString urlString;
+        QString finalUrlString;
+        bool debugging = false;
+        bool useDiskCache = false;
+        bool useContentHash = false;
+        QQmlMetaType::CachedUnitLookupError cachedUnitStatus = QQmlMetaType::CachedUnitLookupError::NoError;
+        QQmlRefPointer<QV4::CompiledData::CompilationUnit> unit;
+        QList<QQmlError> errors;
+    };
+    static void loadOrCompile(PreparedData *prepared, const SourceCodeData &data, bool isModule);
+
     void scriptImported(const QQmlRefPointer<QQmlScriptBlob> &blob, const QV4::CompiledData::Location &location, const QString &qualifier, const QString &nameSpace) override;
     void initializeFromCompilationUnit(const QQmlRefPointer<QV4::CompiledData::CompilationUnit> &unit);
 
     QList<ScriptReference> m_scripts;
     QQmlRefPointer<QQmlScriptData> m_scriptData;
     const bool m_isModule;
+    QScopedPointer<PreparedData> m_prepared;
 };
 
 class Q_AUTOTEST_EXPORT QQmlQmldirData : public QQmlTypeLoader::Blob
@@ -482,7 +482,62 @@ ReturnedValue QQmlValueTypeWrapper::lookupGetter(Lookup *lookup, ExecutionEngine
 bool QQmlValueTypeWrapper::virtualResolveLookupSetter(Object *object, ExecutionEngine *engine, Lookup *lookup,
                                                       const Value &value)
 {
-    return Object::virtualResolveLookupSetter(object, engine, lookup, value);
+    // Keep this code in sync with ::virtualPut
+    PropertyKey id = engine->identifierTable->asPropertyKey(engine->currentStackFrame->v4Function->compilationUnit->
+                                                            runtimeStrings[lookup->nameIndex]);
+    if (!id.isString())
+        return Object::virtualResolveLookupSetter(object, engine, lookup, value);
+
+    QQmlValueTypeWrapper *r = static_cast<QQmlValueTypeWrapper *>(object);
+    Scope scope(engine);
+    ScopedString name(scope, id.asStringOrSymbol());
+
+    QQmlPropertyData *result = r->d()->propertyCache()->property(name.getPointer(), nullptr, nullptr);
+    if (!result) {
+        lookup->setter = Lookup::setterFallback;
+        return lookup->setter(lookup, engine, *object, value);
+    }
+
+    lookup->qgadgetLookup.ic = r->internalClass();
+    lookup->qgadgetLookup.propertyCache = r->d()->propertyCache();
+    lookup->qgadgetLookup.propertyCache->addref();
+    lookup->qgadgetLookup.propertyData = result;
+    lookup->setter = QQmlValueTypeWrapper::lookupSetter;
+    return lookup->setter(lookup, engine, *object, value);
+}
+
+bool QQmlValueTypeWrapper::lookupSetter(Lookup *lookup, ExecutionEngine *engine, Value &object, const Value &value)
+{
+    const auto revertLookup = [lookup, engine, &object, &value]() {
+        lookup->qgadgetLookup.propertyCache->release();
+        lookup->qgadgetLookup.propertyCache = nullptr;
+        lookup->setter = Lookup::setterGeneric;
+        return Lookup::setterGeneric(lookup, engine, object, value);
+    };
+
+    // we can safely cast to a QV4::Object here. If object is something else,
+    // the internal class won't match
+    Heap::Object *o = static_cast<Heap::Object *>(object.heapObject());
+    if (!o || o->internalClass != lookup->qgadgetLookup.ic)
+        return revertLookup();
+
+    Heap::QQmlValueTypeWrapper *valueTypeWrapper = static_cast<Heap::QQmlValueTypeWrapper *>(o);
+    if (valueTypeWrapper->propertyCache() != lookup->qgadgetLookup.propertyCache)
+        return revertLookup();
+
+    if (engine->hasException)
+        return false;
+
+    int writeBackPropertyType = -1;
+    if (!readReferenceForWrite(engine, valueTypeWrapper, &writeBackPropertyType))
+        return false;
+
+    // Reading a QVariant reference can change its type, and with it the property cache
+    if (valueTypeWrapper->propertyCache() != lookup->qgadgetLookup.propertyCache)
+        return revertLookup();
+
+    return setGadgetProperty(engine, valueTypeWrapper, lookup->qgadgetLookup.propertyData, value,
+                             writeBackPropertyType);
 }
 
 ReturnedValue QQmlValueTypeWrapper::virtualGet(const Managed *m, PropertyKey id, const Value *receiver, bool *hasProperty)
@@ -525,25 +580,46 @@ bool QQmlValueTypeWrapper::virtualPut(Managed *m, PropertyKey id, const Value &v
         return false;
 
     Scoped<QQmlValueTypeWrapper> r(scope, static_cast<QQmlValueTypeWrapper *>(m));
-    Scoped<QQmlValueTypeReference> reference(scope, m->d());
 
+    // Note: readReferenceValue() can change the reference->type, so resolve the property after it.
     int writeBackPropertyType = -1;
+    if (!readReferenceForWrite(v4, r->d(), &writeBackPropertyType))
+        return false;
 
-    if (reference) {
-        QMetaProperty writebackProperty = reference->d()->object->metaObject()->property(reference->d()->property);
+    ScopedString name(scope, id.asStringOrSymbol());
+    const QQmlPropertyData *pd = r->d()->propertyCache()->property(name.getPointer(), nullptr, nullptr);
+    if (!pd)
+        return false;
 
-        if (!writebackProperty.isWritable() || !reference->readReferenceValue())
-            return false;
+    return setGadgetProperty(v4, r->d(), pd, value, writeBackPropertyType);
+}
 
-        writeBackPropertyType = writebackProperty.userType();
-    }
+bool QQmlValueTypeWrapper::readReferenceForWrite(ExecutionEngine *v4, Heap::QQmlValueTypeWrapper *wrapper,
+                                                 int *writeBackPropertyType)
+{
+    Scope scope(v4);
+    Scoped<QQmlValueTypeReference> reference(scope, wrapper);
+    if (!reference)
+        return true;
 
-    ScopedString name(scope, id.asStringOrSymbol());
+    QMetaProperty writebackProperty = reference->d()->object->metaObject()->property(reference->d()->property);
+    if (!writebackProperty.isWritable() || !reference->readReferenceValue())
+        return false;
+
+    *writeBackPropertyType = writebackProperty.userType();
+    return true;
+}
+
+// The reference, if any, must have been read with readReferenceForWrite() before pd was resolved.
+bool QQmlValueTypeWrapper::setGadgetProperty(ExecutionEngine *v4, Heap::QQmlValueTypeWrapper *wrapper,
+                                             const QQmlPropertyData *pd, const Value &value,
+                                             int writeBackPropertyType)
+{
+    Scope scope(v4);
+    Scoped<QQmlValueTypeWrapper> r(scope, wrapper);
+    Scoped<QQmlValueTypeReference> reference(scope, wrapper);
 
     const QMetaObject *metaObject = r->d()->propertyCache()->metaObject();
-    const QQmlPropertyData *pd = r->d()->propertyCache()->property(name.getPointer(), nullptr, nullptr);
-    if (!pd)
-        return false;
 
     if (reference) {
         QV4::ScopedFunctionObject f(scope, value);
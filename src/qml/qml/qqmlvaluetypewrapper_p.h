@@ -115,8 +115,15 @@ public:
     static ReturnedValue virtualResolveLookupGetter(const Object *object, ExecutionEngine *engine, Lookup *lookup);
     static bool virtualResolveLookupSetter(Object *object, ExecutionEngine *engine, Lookup *lookup, const Value &value);
     static ReturnedValue lookupGetter(Lookup *lookup, ExecutionEngine *engine, const Value &object);
+    static bool lookupSetter(Lookup *lookup, ExecutionEngine *engine, Value &object, const Value &value);
 
     static void initProto(ExecutionEngine *v4);
+
+private:
+    static bool readReferenceForWrite(ExecutionEngine *v4, Heap::QQmlValueTypeWrapper *wrapper,
+                                      int *writeBackPropertyType);
+    static bool setGadgetProperty(ExecutionEngine *v4, Heap::QQmlValueTypeWrapper *wrapper,
+                                  const QQmlPropertyData *pd, const Value &value, int writeBackPropertyType);
 };
 
 }
@@ -102,6 +102,7 @@ public:
 
     inline void reset();
     inline bool shouldInterrupt() const;
+    inline qint64 remainingNSecs() const;
 private:
     enum Mode { None, Time, Flag };
     Mode mode;
@@ -167,6 +168,13 @@ void QQmlInstantiationInterrupt::reset()
         timer.start();
 }
 
+qint64 QQmlInstantiationInterrupt::remainingNSecs() const
+{
+    if (mode == None || !nsecs)
+        return 0;
+    return qMax(qint64(0), nsecs - timer.nsecsElapsed());
+}
+
 bool QQmlInstantiationInterrupt::shouldInterrupt() const
 {
     if (mode == None) {
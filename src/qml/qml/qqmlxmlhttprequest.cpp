@@ -1029,6 +1029,8 @@ public:
     QString headers() const;
 
     QString responseBody();
+    bool isUtf8Response();
+    bool hasJsonContentType() const;
     const QByteArray & rawResponseBody() const;
     bool receivedXml() const;
 
@@ -1487,9 +1489,19 @@ QV4::ReturnedValue QQmlXMLHttpRequest::jsonResponseBody(QV4::ExecutionEngine* en
         Scope scope(engine);
 
         QJsonParseError error;
-        const QString& jtext = responseBody();
-        JsonParser parser(scope.engine, jtext.constData(), jtext.length());
-        ScopedValue jsonObject(scope, parser.parse(&error));
+        ScopedValue jsonObject(scope);
+        const bool utf8 = isUtf8Response();
+        if (utf8) {
+            // Parse the bytes directly instead of decoding them to a QString first
+            Utf8JsonParser parser(scope.engine, m_responseEntityBody.constData(), m_responseEntityBody.length());
+            jsonObject = parser.parse(&error);
+        }
+        // Invalid UTF-8 is decoded to replacement characters, as it always was
+        if (!utf8 || error.error == QJsonParseError::IllegalUTF8String) {
+            const QString& jtext = responseBody();
+            JsonParser parser(scope.engine, jtext.constData(), jtext.length());
+            jsonObject = parser.parse(&error);
+        }
         if (error.error != QJsonParseError::NoError)
             return engine->throwSyntaxError(QStringLiteral("JSON.parse: Parse error"));
 
@@ -1535,6 +1547,29 @@ QTextCodec* QQmlXMLHttpRequest::findTextCodec() const
 #endif
 
 
+bool QQmlXMLHttpRequest::hasJsonContentType() const
+{
+    QByteArray contentType = m_request.rawHeader("Content-Type").toLower();
+    const int parameters = contentType.indexOf(';');
+    if (parameters >= 0)
+        contentType.truncate(parameters);
+    contentType = contentType.trimmed();
+    return contentType == "application/json" || contentType.endsWith("+json");
+}
+
+bool QQmlXMLHttpRequest::isUtf8Response()
+{
+#if QT_CONFIG(textcodec)
+    if (!m_textCodec)
+        m_textCodec = findTextCodec();
+    // 106 is the MIB enum of UTF-8
+    if (m_textCodec && m_textCodec->mibEnum() != 106)
+        return false;
+#endif
+    // A byte order mark is skipped when decoding, but not by the parser
+    return !m_responseEntityBody.startsWith("\xef\xbb\xbf");
+}
+
 QString QQmlXMLHttpRequest::responseBody()
 {
 #if QT_CONFIG(textcodec)
@@ -1852,8 +1887,15 @@ ReturnedValue QQmlXMLHttpRequestCtor::method_send(const FunctionObject *b, const
 
     QByteArray data;
     if (argc > 0) {
+        const Object *object = argv[0].as<Object>();
         if (const ArrayBuffer *buffer = argv[0].as<ArrayBuffer>()) {
             data = buffer->asByteArray();
+        } else if (object && r->hasJsonContentType()
+                   && (object->as<ArrayObject>() || object->d()->vtable() == Object::staticVTable())) {
+            // Send plain objects and arrays as JSON, encoded straight to UTF-8
+            data = JsonObject::stringifyToUtf8(scope.engine, argv[0]);
+            if (scope.engine->hasException)
+                return Encode::undefined();
         } else {
             data = argv[0].toQStringNoThrow().toUtf8();
         }
@@ -255,6 +255,7 @@ QQmlDelegateModel::~QQmlDelegateModel()
     Q_D(QQmlDelegateModel);
     d->disconnectFromAbstractItemModel();
     d->m_adaptorModel.setObject(nullptr, this);
+    d->drainReusableItemsPool(0);
 
     for (QQmlDelegateModelItem *cacheItem : qAsConst(d->m_cache)) {
         if (cacheItem->object) {
@@ -416,6 +417,7 @@ void QQmlDelegateModel::setModel(const QVariant &model)
     if (d->m_complete)
         _q_itemsRemoved(0, d->m_count);
 
+    d->drainReusableItemsPool(0);
     d->disconnectFromAbstractItemModel();
     d->m_adaptorModel.setModel(model, this, d->m_context->engine());
     d->connectToAbstractItemModel();
@@ -455,6 +457,7 @@ void QQmlDelegateModel::setDelegate(QQmlComponent *delegate)
     if (d->m_delegate == delegate)
         return;
     bool wasValid = d->m_delegate != nullptr;
+    d->drainReusableItemsPool(0);
     d->m_delegate.setObject(delegate, this);
     d->m_delegateValidated = false;
     if (d->m_delegateChooser)
@@ -515,6 +518,7 @@ void QQmlDelegateModel::setRootIndex(const QVariant &root)
     const bool changed = d->m_adaptorModel.rootIndex != modelIndex;
     if (changed || !d->m_adaptorModel.isValid()) {
         const int oldCount = d->m_count;
+        d->drainReusableItemsPool(0);
         d->m_adaptorModel.rootIndex = modelIndex;
         if (!d->m_adaptorModel.isValid() && d->m_adaptorModel.aim()) {
             // The previous root index was invalidated, so we need to reconnect the model.
@@ -584,8 +588,9 @@ int QQmlDelegateModel::count() const
     return d->m_compositor.count(d->m_compositorGroup);
 }
 
-QQmlDelegateModel::ReleaseFlags QQmlDelegateModelPrivate::release(QObject *object)
+QQmlDelegateModel::ReleaseFlags QQmlDelegateModelPrivate::release(QObject *object, QQmlInstanceModel::ReusableFlag reusable)
 {
+    Q_Q(QQmlDelegateModel);
     if (!object)
         return QQmlDelegateModel::ReleaseFlags(0);
 
@@ -596,6 +601,21 @@ QQmlDelegateModel::ReleaseFlags QQmlDelegateModelPrivate::release(QObject *objec
     if (!cacheItem->releaseObject())
         return QQmlDelegateModel::Referenced;
 
+    // Only items that nobody but the view has seen can be pooled. Items that are
+    // still incubating, held on to from JavaScript, or part of a package are
+    // destroyed as before.
+    if (reusable == QQmlInstanceModel::Reusable
+            && cacheItem->delegate
+            && cacheItem->scriptRef == 1
+            && !cacheItem->incubationTask
+            && !(cacheItem->groups & Compositor::UnresolvedFlag)
+            && !qmlobject_cast<QQuickPackage *>(object)) {
+        removeCacheItem(cacheItem);
+        m_reusableItemsPool.insertItem(cacheItem);
+        emit q->itemPooled(cacheItem->index, object);
+        return QQmlInstanceModel::Pooled;
+    }
+
     cacheItem->destroyObject();
     emitDestroyingItem(object);
     if (cacheItem->incubationTask) {
@@ -610,13 +630,78 @@ QQmlDelegateModel::ReleaseFlags QQmlDelegateModelPrivate::release(QObject *objec
   Returns ReleaseStatus flags.
 */
 
-QQmlDelegateModel::ReleaseFlags QQmlDelegateModel::release(QObject *item)
+QQmlDelegateModel::ReleaseFlags QQmlDelegateModel::release(QObject *item, QQmlInstanceModel::ReusableFlag reusableFlag)
 {
     Q_D(QQmlDelegateModel);
-    QQmlInstanceModel::ReleaseFlags stat = d->release(item);
+    QQmlInstanceModel::ReleaseFlags stat = d->release(item, reusableFlag);
     return stat;
 }
 
+QQmlComponent *QQmlDelegateModelPrivate::resolveDelegate(int index)
+{
+    QQmlComponent *delegate = m_delegate;
+    if (m_delegateChooser) {
+        QQmlAbstractDelegateComponent *chooser = m_delegateChooser;
+        do {
+            delegate = chooser->delegate(&m_adaptorModel, index);
+            chooser = qobject_cast<QQmlAbstractDelegateComponent *>(delegate);
+        } while (chooser);
+    }
+    return delegate;
+}
+
+void QQmlDelegateModelPrivate::reuseItem(QQmlDelegateModelItem *item, int newModelIndex, int newGroups)
+{
+    Q_Q(QQmlDelegateModel);
+    // Update the context properties of the recycled item, and let the
+    // application know that all role data has changed as well.
+    item->groups = newGroups;
+    item->setModelIndex(newModelIndex, m_adaptorModel.rowAt(newModelIndex), m_adaptorModel.columnAt(newModelIndex));
+    m_adaptorModel.notify(QList<QQmlDelegateModelItem *>() << item, newModelIndex, 1, QVector<int>());
+
+    if (QQmlDelegateModelAttached *att = item->attached) {
+        att->resetCurrentIndex();
+        att->emitChanges();
+    }
+
+    emit q->itemReused(newModelIndex, item->object);
+}
+
+void QQmlDelegateModelPrivate::drainReusableItemsPool(int maxPoolTime)
+{
+    m_reusableItemsPool.drain(maxPoolTime, [this](QQmlDelegateModelItem *cacheItem) {
+        QObject *object = cacheItem->object;
+        cacheItem->destroyObject();
+        emitDestroyingItem(object);
+        // The item is no longer in the cache, so Dispose() would find nothing to remove
+        --cacheItem->scriptRef;
+        if (!cacheItem->isReferenced())
+            delete cacheItem;
+    });
+}
+
+/*
+  Destroys the items that have been resting in the pool of reusable items
+  for more than \a maxPoolTime calls. A maxPoolTime of 0 empties the pool.
+*/
+void QQmlDelegateModel::drainReusableItemsPool(int maxPoolTime)
+{
+    Q_D(QQmlDelegateModel);
+    d->drainReusableItemsPool(maxPoolTime);
+}
+
+int QQmlDelegateModel::poolSize()
+{
+    Q_D(QQmlDelegateModel);
+    return d->m_reusableItemsPool.size();
+}
+
+QQmlInstanceModel::PoolStatistics QQmlDelegateModel::poolStatistics()
+{
+    Q_D(QQmlDelegateModel);
+    return d->m_reusableItemsPool.statistics();
+}
+
 // Cancel a requested async item
 void QQmlDelegateModel::cancel(int index)
 {
@@ -1009,10 +1094,28 @@ QObject *QQmlDelegateModelPrivate::object(Compositor::Group group, int index, QQ
     QQmlDelegateModelItem *cacheItem = it->inCache() ? m_cache.at(it.cacheIndex) : 0;
 
     if (!cacheItem) {
+        QQmlComponent *delegate = resolveDelegate(index);
+        if (!delegate)
+            return nullptr;
+
+        // Prefer recycling an item that the view released earlier over creating a new one
+        cacheItem = m_reusableItemsPool.takeItem(delegate);
+        if (cacheItem) {
+            addCacheItem(cacheItem, it);
+            reuseItem(cacheItem, it.modelIndex(), it->flags);
+            cacheItem->referenceObject();
+
+            if (index == m_compositor.count(group) - 1)
+                requestMoreIfNecessary();
+
+            return cacheItem->object;
+        }
+
         cacheItem = m_adaptorModel.createItem(m_cacheMetaType, it.modelIndex());
         if (!cacheItem)
             return nullptr;
 
+        cacheItem->delegate = delegate;
         cacheItem->groups = it->flags;
         addCacheItem(cacheItem, it);
     }
@@ -1029,15 +1132,12 @@ QObject *QQmlDelegateModelPrivate::object(Compositor::Group group, int index, QQ
             cacheItem->incubationTask->forceCompletion();
         }
     } else if (!cacheItem->object) {
-        QQmlComponent *delegate = m_delegate;
-        if (m_delegateChooser) {
-            QQmlAbstractDelegateComponent *chooser = m_delegateChooser;
-            do {
-                delegate = chooser->delegate(&m_adaptorModel, index);
-                chooser = qobject_cast<QQmlAbstractDelegateComponent *>(delegate);
-            } while (chooser);
+        QQmlComponent *delegate = cacheItem->delegate;
+        if (!delegate) {
+            delegate = resolveDelegate(index);
             if (!delegate)
                 return nullptr;
+            cacheItem->delegate = delegate;
         }
 
         QQmlContext *creationContext = delegate->creationContext();
@@ -3320,7 +3420,7 @@ QObject *QQmlPartsModel::object(int index, QQmlIncubator::IncubationMode incubat
     return nullptr;
 }
 
-QQmlInstanceModel::ReleaseFlags QQmlPartsModel::release(QObject *item)
+QQmlInstanceModel::ReleaseFlags QQmlPartsModel::release(QObject *item, ReusableFlag)
 {
     QQmlInstanceModel::ReleaseFlags flags = nullptr;
 
@@ -3537,6 +3637,62 @@ QV4::ReturnedValue QQmlDelegateModelEngineData::array(QV4::ExecutionEngine *v4,
     return o.asReturnedValue();
 }
 
+//============================================================================
+
+void QQmlReusableDelegateModelItemsPool::insertItem(QQmlDelegateModelItem *modelItem)
+{
+    // The view decides per item if it can be recycled by passing Reusable to
+    // release(). Pooled items keep their object and context alive, just not
+    // visible, until the next object() call for the same delegate picks them
+    // up again, or the view drains the pool after it has finished a refill.
+    Q_ASSERT(!modelItem->incubationTask);
+    Q_ASSERT(!modelItem->isObjectReferenced());
+    Q_ASSERT(modelItem->object);
+    Q_ASSERT(modelItem->delegate);
+
+    modelItem->poolTime = 0;
+    m_reusableItemsPool.append(modelItem);
+    ++m_statistics.pooled;
+}
+
+QQmlDelegateModelItem *QQmlReusableDelegateModelItemsPool::takeItem(const QQmlComponent *delegate)
+{
+    // Find the oldest item in the pool that was made from the same delegate as
+    // the given argument, remove it from the pool, and return it.
+    for (auto it = m_reusableItemsPool.begin(); it != m_reusableItemsPool.end(); ++it) {
+        if ((*it)->delegate != delegate)
+            continue;
+        auto modelItem = *it;
+        m_reusableItemsPool.erase(it);
+        ++m_statistics.reused;
+        return modelItem;
+    }
+
+    ++m_statistics.misses;
+    return nullptr;
+}
+
+void QQmlReusableDelegateModelItemsPool::drain(int maxPoolTime, std::function<void(QQmlDelegateModelItem *cacheItem)> releaseItem)
+{
+    // Rather than releasing all pooled items upon a call to this function, each
+    // item has a poolTime. The poolTime specifies for how many loading cycles an item
+    // has been resting in the pool. And for each invocation of this function, poolTime
+    // will increase. If poolTime is equal to, or exceeds, maxPoolTime, it will be removed
+    // from the pool and released. This way, the view can tweak a bit for how long
+    // items should stay in "circulation", even if they are not recycled right away.
+    for (auto it = m_reusableItemsPool.begin(); it != m_reusableItemsPool.end();) {
+        auto modelItem = *it;
+        modelItem->poolTime++;
+        if (modelItem->poolTime <= maxPoolTime) {
+            ++it;
+        } else {
+            it = m_reusableItemsPool.erase(it);
+            ++m_statistics.drained;
+            releaseItem(modelItem);
+        }
+    }
+}
+
 QT_END_NAMESPACE
 
 #include "moc_qqmldelegatemodel_p.cpp"
@@ -112,7 +112,7 @@ public:
     int count() const override;
     bool isValid() const override { return delegate() != nullptr; }
     QObject *object(int index, QQmlIncubator::IncubationMode incubationMode = QQmlIncubator::AsynchronousIfNested) override;
-    ReleaseFlags release(QObject *object) override;
+    ReleaseFlags release(QObject *object, ReusableFlag reusableFlag = NotReusable) override;
     void cancel(int index) override;
     QString stringValue(int index, const QString &role) override;
     void setWatchedRoles(const QList<QByteArray> &roles) override;
@@ -120,6 +120,10 @@ public:
 
     int indexOf(QObject *object, QObject *objectContext) const override;
 
+    void drainReusableItemsPool(int maxPoolTime) override;
+    int poolSize() override;
+    PoolStatistics poolStatistics() override;
+
     QString filterGroup() const;
     void setFilterGroup(const QString &group);
     void resetFilterGroup();
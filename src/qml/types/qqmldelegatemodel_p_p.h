@@ -49,6 +49,8 @@
 #include <private/qqmladaptormodel_p.h>
 #include <private/qqmlopenmetaobject_p.h>
 
+#include <functional>
+
 //
 //  W A R N I N G
 //  -------------
@@ -167,6 +169,25 @@ protected:
     int column;
 };
 
+class Q_QML_PRIVATE_EXPORT QQmlReusableDelegateModelItemsPool
+{
+public:
+    typedef QQmlInstanceModel::PoolStatistics Statistics;
+
+    void insertItem(QQmlDelegateModelItem *modelItem);
+    QQmlDelegateModelItem *takeItem(const QQmlComponent *delegate);
+    void drain(int maxPoolTime, std::function<void(QQmlDelegateModelItem *cacheItem)> releaseItem);
+    int size() const { return m_reusableItemsPool.size(); }
+    bool isEmpty() const { return m_reusableItemsPool.isEmpty(); }
+
+    const Statistics &statistics() const { return m_statistics; }
+    void resetStatistics() { m_statistics = Statistics(); }
+
+private:
+    QList<QQmlDelegateModelItem *> m_reusableItemsPool;
+    Statistics m_statistics;
+};
+
 namespace QV4 {
 namespace Heap {
 struct QQmlDelegateModelItemObject : Object {
@@ -275,7 +296,10 @@ public:
 
     void requestMoreIfNecessary();
     QObject *object(Compositor::Group group, int index, QQmlIncubator::IncubationMode incubationMode);
-    QQmlDelegateModel::ReleaseFlags release(QObject *object);
+    QQmlDelegateModel::ReleaseFlags release(QObject *object, QQmlInstanceModel::ReusableFlag reusable = QQmlInstanceModel::NotReusable);
+    QQmlComponent *resolveDelegate(int index);
+    void reuseItem(QQmlDelegateModelItem *item, int newModelIndex, int newGroups);
+    void drainReusableItemsPool(int maxPoolTime);
     QString stringValue(Compositor::Group group, int index, const QString &name);
     void emitCreatedPackage(QQDMIncubationTask *incubationTask, QQuickPackage *package);
     void emitInitPackage(QQDMIncubationTask *incubationTask, QQuickPackage *package);
@@ -334,6 +358,7 @@ public:
     QQmlDelegateModelGroupEmitterList m_pendingParts;
 
     QList<QQmlDelegateModelItem *> m_cache;
+    QQmlReusableDelegateModelItemsPool m_reusableItemsPool;
     QList<QQDMIncubationTask *> m_finishedIncubating;
     QList<QByteArray> m_watchedRoles;
 
@@ -377,7 +402,7 @@ public:
     int count() const override;
     bool isValid() const override;
     QObject *object(int index, QQmlIncubator::IncubationMode incubationMode = QQmlIncubator::AsynchronousIfNested) override;
-    ReleaseFlags release(QObject *item) override;
+    ReleaseFlags release(QObject *item, ReusableFlag reusableFlag = NotReusable) override;
     QString stringValue(int index, const QString &role) override;
     QList<QByteArray> watchedRoles() const { return m_watchedRoles; }
     void setWatchedRoles(const QList<QByteArray> &roles) override;
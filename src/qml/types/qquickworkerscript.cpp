@@ -54,6 +54,8 @@
 #include <QtCore/qwaitcondition.h>
 #include <QtCore/qfile.h>
 #include <QtCore/qdatetime.h>
+#include <QtCore/qelapsedtimer.h>
+#include <QtCore/qqueue.h>
 #include <QtQml/qqmlinfo.h>
 #include <QtQml/qqmlfile.h>
 #if QT_CONFIG(qml_network)
@@ -63,6 +65,7 @@
 
 #include <private/qv8engine_p.h>
 #include <private/qv4serialize_p.h>
+#include <private/qv4atomics_p.h>
 
 #include <private/qv4value_p.h>
 #include <private/qv4functionobject_p.h>
@@ -77,49 +80,21 @@ class WorkerDataEvent : public QEvent
 public:
     enum Type { WorkerData = QEvent::User };
 
-    WorkerDataEvent(int workerId, const QByteArray &data);
+    WorkerDataEvent(int workerId, const QV4::SerializedData &data);
     virtual ~WorkerDataEvent();
 
     int workerId() const;
-    QByteArray data() const;
-
-private:
-    int m_id;
-    QByteArray m_data;
-};
-
-class WorkerLoadEvent : public QEvent
-{
-public:
-    enum Type { WorkerLoad = WorkerDataEvent::WorkerData + 1 };
-
-    WorkerLoadEvent(int workerId, const QUrl &url);
-
-    int workerId() const;
-    QUrl url() const;
-
-private:
-    int m_id;
-    QUrl m_url;
-};
-
-class WorkerRemoveEvent : public QEvent
-{
-public:
-    enum Type { WorkerRemove = WorkerLoadEvent::WorkerLoad + 1 };
-
-    WorkerRemoveEvent(int workerId);
-
-    int workerId() const;
+    QV4::SerializedData data() const;
 
 private:
     int m_id;
+    QV4::SerializedData m_data;
 };
 
 class WorkerErrorEvent : public QEvent
 {
 public:
-    enum Type { WorkerError = WorkerRemoveEvent::WorkerRemove + 1 };
+    enum Type { WorkerError = WorkerDataEvent::WorkerData + 3 };
 
     WorkerErrorEvent(const QQmlError &error);
 
@@ -134,12 +109,14 @@ class QQuickWorkerScriptEnginePrivate : public QObject
     Q_OBJECT
 public:
     enum WorkerEventTypes {
-        WorkerDestroyEvent = QEvent::User + 100
+        WorkerDestroyEvent = QEvent::User + 100,
+        WorkerRunEvent
     };
 
-    QQuickWorkerScriptEnginePrivate(QQmlEngine *eng);
+    QQuickWorkerScriptEnginePrivate(QQmlEngine *eng, int index);
 
     QQmlEngine *qmlengine;
+    const int threadIndex;
 
     QMutex m_lock;
     QWaitCondition m_wait;
@@ -161,10 +138,32 @@ public:
         int id = -1;
     };
 
+    // Everything the owner asks of a worker goes through a queue per worker, so
+    // that loads, messages and removal keep their order for that worker, while
+    // the workers sharing this thread take turns.
+    struct Task {
+        enum Kind { Load, Message, Remove };
+
+        Kind kind;
+        QUrl url;
+        QV4::SerializedData data;
+        qint64 postedAt;
+    };
+
+    struct TaskQueue {
+        QQueue<Task> tasks;
+        QQuickWorkerScriptEngine::Statistics statistics;
+    };
+
     QHash<int, WorkerScript *> workers;
+    QHash<int, TaskQueue> queues;
+    QQueue<int> readyWorkers;
+    QElapsedTimer clock;
+    bool runScheduled;
+
     QV4::ReturnedValue getWorker(WorkerScript *);
 
-    int m_nextId;
+    void postTask(int id, Task::Kind kind, const QUrl &url = QUrl(), const QV4::SerializedData &data = QV4::SerializedData());
 
     static QV4::ReturnedValue method_sendMessage(const QV4::FunctionObject *, const QV4::Value *thisObject, const QV4::Value *argv, int argc);
 
@@ -175,14 +174,30 @@ protected:
     bool event(QEvent *) override;
 
 private:
-    void processMessage(int, const QByteArray &);
+    void runNextTask();
+    void processMessage(int, const QV4::SerializedData &);
     void processLoad(int, const QUrl &);
+    void processRemove(int);
     void reportScriptException(WorkerScript *, const QQmlError &error);
 };
 
-QQuickWorkerScriptEnginePrivate::QQuickWorkerScriptEnginePrivate(QQmlEngine *engine)
-: qmlengine(engine), m_nextId(0)
+class QQuickWorkerScriptThread : public QThread
 {
+public:
+    QQuickWorkerScriptThread(QQmlEngine *engine, int index);
+    ~QQuickWorkerScriptThread();
+
+    QQuickWorkerScriptEnginePrivate *d;
+    int workerCount = 0;
+
+protected:
+    void run() override;
+};
+
+QQuickWorkerScriptEnginePrivate::QQuickWorkerScriptEnginePrivate(QQmlEngine *engine, int index)
+: qmlengine(engine), threadIndex(index), runScheduled(false)
+{
+    clock.start();
 }
 
 QV4::ReturnedValue QQuickWorkerScriptEnginePrivate::method_sendMessage(const QV4::FunctionObject *b,
@@ -192,7 +207,8 @@ QV4::ReturnedValue QQuickWorkerScriptEnginePrivate::method_sendMessage(const QV4
     WorkerScript *script = static_cast<WorkerScript *>(scope.engine->v8Engine);
 
     QV4::ScopedValue v(scope, argc > 0 ? argv[0] : QV4::Value::undefinedValue());
-    QByteArray data = QV4::Serialize::serialize(v, scope.engine);
+    QV4::ScopedValue transferList(scope, argc > 1 ? argv[1] : QV4::Value::undefinedValue());
+    QV4::SerializedData data = QV4::Serialize::serialize(v, transferList, scope.engine);
 
     QMutexLocker locker(&script->p->m_lock);
     if (script && script->owner)
@@ -201,34 +217,97 @@ QV4::ReturnedValue QQuickWorkerScriptEnginePrivate::method_sendMessage(const QV4
     return QV4::Encode::undefined();
 }
 
+void QQuickWorkerScriptEnginePrivate::postTask(int id, Task::Kind kind, const QUrl &url, const QV4::SerializedData &data)
+{
+    QMutexLocker locker(&m_lock);
+    TaskQueue &queue = queues[id];
+    if (queue.tasks.isEmpty())
+        readyWorkers.enqueue(id);
+    queue.tasks.enqueue(Task { kind, url, data, clock.nsecsElapsed() });
+    queue.statistics.queueDepth = queue.tasks.count();
+
+    if (!runScheduled) {
+        runScheduled = true;
+        QCoreApplication::postEvent(this, new QEvent((QEvent::Type)WorkerRunEvent));
+    }
+}
+
+void QQuickWorkerScriptEnginePrivate::runNextTask()
+{
+    // Handle a single task per event, taking the workers in turn, so that a
+    // worker that is flooded with messages can't starve the others on this thread.
+    int id;
+    Task task;
+    {
+        QMutexLocker locker(&m_lock);
+        if (readyWorkers.isEmpty()) {
+            runScheduled = false;
+            return;
+        }
+
+        id = readyWorkers.dequeue();
+        TaskQueue &queue = queues[id];
+        task = queue.tasks.dequeue();
+        queue.statistics.queueDepth = queue.tasks.count();
+        if (!queue.tasks.isEmpty())
+            readyWorkers.enqueue(id);
+
+        const qint64 latency = (clock.nsecsElapsed() - task.postedAt) / 1000;
+        ++queue.statistics.processed;
+        queue.statistics.totalLatency += latency;
+        queue.statistics.maximumLatency = qMax(queue.statistics.maximumLatency, latency);
+
+        if (readyWorkers.isEmpty())
+            runScheduled = false;
+        else
+            QCoreApplication::postEvent(this, new QEvent((QEvent::Type)WorkerRunEvent));
+    }
+
+    switch (task.kind) {
+    case Task::Load:
+        processLoad(id, task.url);
+        break;
+    case Task::Message:
+        processMessage(id, task.data);
+        break;
+    case Task::Remove:
+        processRemove(id);
+        break;
+    }
+}
+
 bool QQuickWorkerScriptEnginePrivate::event(QEvent *event)
 {
-    if (event->type() == (QEvent::Type)WorkerDataEvent::WorkerData) {
-        WorkerDataEvent *workerEvent = static_cast<WorkerDataEvent *>(event);
-        processMessage(workerEvent->workerId(), workerEvent->data());
-        return true;
-    } else if (event->type() == (QEvent::Type)WorkerLoadEvent::WorkerLoad) {
-        WorkerLoadEvent *workerEvent = static_cast<WorkerLoadEvent *>(event);
-        processLoad(workerEvent->workerId(), workerEvent->url());
+    if (event->type() == (QEvent::Type)WorkerRunEvent) {
+        runNextTask();
         return true;
     } else if (event->type() == (QEvent::Type)WorkerDestroyEvent) {
         emit stopThread();
         return true;
-    } else if (event->type() == (QEvent::Type)WorkerRemoveEvent::WorkerRemove) {
-        QMutexLocker locker(&m_lock);
-        WorkerRemoveEvent *workerEvent = static_cast<WorkerRemoveEvent *>(event);
-        QHash<int, WorkerScript *>::iterator itr = workers.find(workerEvent->workerId());
-        if (itr != workers.end()) {
-            delete itr.value();
-            workers.erase(itr);
-        }
-        return true;
     } else {
         return QObject::event(event);
     }
 }
 
-void QQuickWorkerScriptEnginePrivate::processMessage(int id, const QByteArray &data)
+void QQuickWorkerScriptEnginePrivate::processRemove(int id)
+{
+    QMutexLocker locker(&m_lock);
+    QHash<int, WorkerScript *>::iterator itr = workers.find(id);
+    if (itr != workers.end()) {
+        delete itr.value();
+        workers.erase(itr);
+    }
+
+    // Drop whatever was queued after the removal, as there is nobody left to handle it
+    auto queue = queues.find(id);
+    if (queue != queues.end()) {
+        if (!queue->tasks.isEmpty())
+            readyWorkers.removeAll(id);
+        queues.erase(queue);
+    }
+}
+
+void QQuickWorkerScriptEnginePrivate::processMessage(int id, const QV4::SerializedData &data)
 {
     WorkerScript *script = workers.value(id);
     if (!script)
@@ -309,7 +388,7 @@ void QQuickWorkerScriptEnginePrivate::reportScriptException(WorkerScript *script
         QCoreApplication::postEvent(script->owner, new WorkerErrorEvent(error));
 }
 
-WorkerDataEvent::WorkerDataEvent(int workerId, const QByteArray &data)
+WorkerDataEvent::WorkerDataEvent(int workerId, const QV4::SerializedData &data)
 : QEvent((QEvent::Type)WorkerData), m_id(workerId), m_data(data)
 {
 }
@@ -323,74 +402,151 @@ int WorkerDataEvent::workerId() const
     return m_id;
 }
 
-QByteArray WorkerDataEvent::data() const
+QV4::SerializedData WorkerDataEvent::data() const
 {
     return m_data;
 }
 
-WorkerLoadEvent::WorkerLoadEvent(int workerId, const QUrl &url)
-: QEvent((QEvent::Type)WorkerLoad), m_id(workerId), m_url(url)
+WorkerErrorEvent::WorkerErrorEvent(const QQmlError &error)
+: QEvent((QEvent::Type)WorkerError), m_error(error)
 {
 }
 
-int WorkerLoadEvent::workerId() const
+QQmlError WorkerErrorEvent::error() const
 {
-    return m_id;
+    return m_error;
 }
 
-QUrl WorkerLoadEvent::url() const
+QQuickWorkerScriptThread::QQuickWorkerScriptThread(QQmlEngine *engine, int index)
+: d(new QQuickWorkerScriptEnginePrivate(engine, index))
 {
-    return m_url;
+    d->m_lock.lock();
+    QObject::connect(d, SIGNAL(stopThread()), this, SLOT(quit()), Qt::DirectConnection);
+    start(QThread::LowestPriority);
+    d->m_wait.wait(&d->m_lock);
+    d->moveToThread(this);
+    d->m_lock.unlock();
 }
 
-WorkerRemoveEvent::WorkerRemoveEvent(int workerId)
-: QEvent((QEvent::Type)WorkerRemove), m_id(workerId)
+QQuickWorkerScriptThread::~QQuickWorkerScriptThread()
 {
+    wait();
+    delete d;
 }
 
-int WorkerRemoveEvent::workerId() const
+void QQuickWorkerScriptThread::run()
 {
-    return m_id;
-}
+    d->m_lock.lock();
 
-WorkerErrorEvent::WorkerErrorEvent(const QQmlError &error)
-: QEvent((QEvent::Type)WorkerError), m_error(error)
-{
-}
+    d->m_wait.wakeAll();
 
-QQmlError WorkerErrorEvent::error() const
-{
-    return m_error;
+    d->m_lock.unlock();
+
+    exec();
+
+    qDeleteAll(d->workers);
+    d->workers.clear();
 }
 
+/*!
+    \internal
+
+    The worker scripts of an engine are spread over a pool of up to
+    maximumThreadCount() threads, which are started as they are needed.
+    The default is a single thread, as in earlier versions: workers that are
+    passed the same ListModel modify its worker copy without locking, so
+    they must not run concurrently. A larger pool is opt-in, through
+    setMaximumThreadCount() or the QML_WORKERSCRIPT_THREADS environment
+    variable.
+*/
 QQuickWorkerScriptEngine::QQuickWorkerScriptEngine(QQmlEngine *parent)
-: QThread(parent), d(new QQuickWorkerScriptEnginePrivate(parent))
+: QObject(parent), m_qmlEngine(parent), m_nextId(0)
 {
-    d->m_lock.lock();
-    connect(d, SIGNAL(stopThread()), this, SLOT(quit()), Qt::DirectConnection);
-    start(QThread::LowestPriority);
-    d->m_wait.wait(&d->m_lock);
-    d->moveToThread(this);
-    d->m_lock.unlock();
+    bool ok = false;
+    const int threadCount = qEnvironmentVariableIntValue("QML_WORKERSCRIPT_THREADS", &ok);
+    m_maximumThreadCount = qMax(1, ok ? threadCount : 1);
 }
 
 QQuickWorkerScriptEngine::~QQuickWorkerScriptEngine()
 {
-    d->m_lock.lock();
-    QCoreApplication::postEvent(d, new QEvent((QEvent::Type)QQuickWorkerScriptEnginePrivate::WorkerDestroyEvent));
-    d->m_lock.unlock();
+    for (QQuickWorkerScriptThread *thread : qAsConst(m_threads)) {
+        thread->d->m_lock.lock();
+        QCoreApplication::postEvent(thread->d, new QEvent((QEvent::Type)QQuickWorkerScriptEnginePrivate::WorkerDestroyEvent));
+        thread->d->m_lock.unlock();
+
+        // A script blocked in Atomics.wait() would keep the thread from ever seeing the event
+        QV4::Atomics::interruptWaiters(thread);
+    }
 
     //We have to force to cleanup the main thread's event queue here
     //to make sure the main GUI release all pending locks/wait conditions which
     //some worker script/agent are waiting for (QQmlListModelWorkerAgent::sync() for example).
-    while (!isFinished()) {
-        // We can't simply wait here, because the worker thread will not terminate
-        // until the main thread processes the last data event it generates
-        QCoreApplication::processEvents();
-        yieldCurrentThread();
+    for (QQuickWorkerScriptThread *thread : qAsConst(m_threads)) {
+        while (!thread->isFinished()) {
+            // We can't simply wait here, because the worker thread will not terminate
+            // until the main thread processes the last data event it generates
+            QCoreApplication::processEvents();
+            QThread::yieldCurrentThread();
+        }
+        QV4::Atomics::resetInterrupt(thread);
     }
 
-    d->deleteLater();
+    qDeleteAll(m_threads);
+}
+
+/*!
+    \internal
+
+    Returns the maximum number of threads that worker scripts are spread over.
+*/
+int QQuickWorkerScriptEngine::maximumThreadCount() const
+{
+    return m_maximumThreadCount;
+}
+
+/*!
+    \internal
+
+    Sets the maximum number of worker threads to \a count. Threads that are
+    already running are kept, but no new workers are assigned to them if they
+    are beyond the new maximum.
+*/
+void QQuickWorkerScriptEngine::setMaximumThreadCount(int count)
+{
+    m_maximumThreadCount = qMax(1, count);
+}
+
+/*!
+    \internal
+
+    Returns the number of worker threads that have been started.
+*/
+int QQuickWorkerScriptEngine::activeThreadCount() const
+{
+    return m_threads.count();
+}
+
+QQuickWorkerScriptThread *QQuickWorkerScriptEngine::threadForWorker(int id) const
+{
+    return m_workerThreads.value(id);
+}
+
+/*!
+    \internal
+
+    Returns the queue depth and latency statistics of the worker \a id,
+    together with the index of the thread it runs in.
+*/
+QQuickWorkerScriptEngine::Statistics QQuickWorkerScriptEngine::statistics(int id) const
+{
+    QQuickWorkerScriptThread *thread = threadForWorker(id);
+    if (!thread)
+        return Statistics();
+
+    QMutexLocker locker(&thread->d->m_lock);
+    Statistics statistics = thread->d->queues.value(id).statistics;
+    statistics.thread = thread->d->threadIndex;
+    return statistics;
 }
 
 QQuickWorkerScriptEnginePrivate::WorkerScript::WorkerScript(int id, QQuickWorkerScriptEnginePrivate *parent)
@@ -429,51 +585,84 @@ QNetworkAccessManager *QQuickWorkerScriptEnginePrivate::WorkerScript::networkAcc
 }
 #endif
 
-int QQuickWorkerScriptEngine::registerWorkerScript(QQuickWorkerScript *owner)
+/*!
+    \internal
+
+    Creates a worker for \a owner. If \a preferredThread is not negative, the
+    worker is pinned to that thread of the pool. Otherwise it goes to the
+    thread running the fewest workers, starting a new thread while the pool
+    is not full yet.
+*/
+int QQuickWorkerScriptEngine::registerWorkerScript(QQuickWorkerScript *owner, int preferredThread)
 {
     typedef QQuickWorkerScriptEnginePrivate::WorkerScript WorkerScript;
-    WorkerScript *script = new WorkerScript(d->m_nextId++, d);
+
+    int index = -1;
+    if (preferredThread >= 0) {
+        index = preferredThread % m_maximumThreadCount;
+    } else if (m_threads.count() < m_maximumThreadCount) {
+        // Reuse an idle thread before starting a new one
+        for (int i = 0; i < m_threads.count(); ++i) {
+            if (m_threads.at(i)->workerCount == 0) {
+                index = i;
+                break;
+            }
+        }
+        if (index == -1)
+            index = m_threads.count();
+    } else {
+        index = 0;
+        for (int i = 1; i < m_maximumThreadCount; ++i) {
+            if (m_threads.at(i)->workerCount < m_threads.at(index)->workerCount)
+                index = i;
+        }
+    }
+
+    while (m_threads.count() <= index)
+        m_threads.append(new QQuickWorkerScriptThread(m_qmlEngine, m_threads.count()));
+
+    QQuickWorkerScriptThread *thread = m_threads.at(index);
+    WorkerScript *script = new WorkerScript(m_nextId++, thread->d);
 
     script->owner = owner;
 
-    d->m_lock.lock();
-    d->workers.insert(script->id, script);
-    d->m_lock.unlock();
+    thread->d->m_lock.lock();
+    thread->d->workers.insert(script->id, script);
+    thread->d->m_lock.unlock();
+
+    ++thread->workerCount;
+    m_workerThreads.insert(script->id, thread);
 
     return script->id;
 }
 
 void QQuickWorkerScriptEngine::removeWorkerScript(int id)
 {
-    QQuickWorkerScriptEnginePrivate::WorkerScript* script = d->workers.value(id);
-    if (script) {
+    QQuickWorkerScriptThread *thread = m_workerThreads.take(id);
+    if (!thread)
+        return;
+
+    --thread->workerCount;
+
+    thread->d->m_lock.lock();
+    QQuickWorkerScriptEnginePrivate::WorkerScript* script = thread->d->workers.value(id);
+    if (script)
         script->owner = nullptr;
-        QCoreApplication::postEvent(d, new WorkerRemoveEvent(id));
-    }
-}
+    thread->d->m_lock.unlock();
 
-void QQuickWorkerScriptEngine::executeUrl(int id, const QUrl &url)
-{
-    QCoreApplication::postEvent(d, new WorkerLoadEvent(id, url));
+    thread->d->postTask(id, QQuickWorkerScriptEnginePrivate::Task::Remove);
 }
 
-void QQuickWorkerScriptEngine::sendMessage(int id, const QByteArray &data)
+void QQuickWorkerScriptEngine::executeUrl(int id, const QUrl &url)
 {
-    QCoreApplication::postEvent(d, new WorkerDataEvent(id, data));
+    if (QQuickWorkerScriptThread *thread = threadForWorker(id))
+        thread->d->postTask(id, QQuickWorkerScriptEnginePrivate::Task::Load, url);
 }
 
-void QQuickWorkerScriptEngine::run()
+void QQuickWorkerScriptEngine::sendMessage(int id, const QV4::SerializedData &data)
 {
-    d->m_lock.lock();
-
-    d->m_wait.wakeAll();
-
-    d->m_lock.unlock();
-
-    exec();
-
-    qDeleteAll(d->workers);
-    d->workers.clear();
+    if (QQuickWorkerScriptThread *thread = threadForWorker(id))
+        thread->d->postTask(id, QQuickWorkerScriptEnginePrivate::Task::Message, QUrl(), data);
 }
 
 
@@ -484,7 +673,7 @@ void QQuickWorkerScriptEngine::run()
     \inqmlmodule QtQuick
     \brief Enables the use of threads in a Qt Quick application.
 
-    Use WorkerScript to run operations in a new thread.
+    Use WorkerScript to run operations in a separate thread.
     This is useful for running operations in the background so
     that the main GUI thread is not blocked.
 
@@ -514,7 +703,8 @@ void QQuickWorkerScriptEngine::run()
 
     \note Each WorkerScript element will instantiate a separate JavaScript engine to ensure perfect
     isolation and thread-safety. If the impact of that results in a memory consumption that is too
-    high for your environment, then consider sharing a WorkerScript element.
+    high for your environment, then consider sharing a WorkerScript element. The engines
+    themselves run on a shared pool of threads, see \l workerThread.
 
     \section3 Restrictions
 
@@ -535,7 +725,7 @@ void QQuickWorkerScriptEngine::run()
         {Threaded ListModel Example}
 */
 QQuickWorkerScript::QQuickWorkerScript(QObject *parent)
-: QObject(parent), m_engine(nullptr), m_scriptId(-1), m_componentComplete(true)
+: QObject(parent), m_engine(nullptr), m_scriptId(-1), m_workerThread(-1), m_componentComplete(true)
 {
 }
 
@@ -573,7 +763,60 @@ void QQuickWorkerScript::setSource(const QUrl &source)
 }
 
 /*!
-    \qmlmethod WorkerScript::sendMessage(jsobject message)
+    \qmlproperty int WorkerScript::workerThread
+    \since 5.12
+
+    The worker scripts of an application share a pool of threads. Each
+    WorkerScript is assigned to the thread running the fewest workers when it
+    is created, and the workers sharing a thread take turns handling their
+    messages.
+
+    Setting this property to a non-negative value pins the worker to that
+    thread of the pool instead. The value is taken modulo the size of the
+    pool. It has to be set before the component is completed; later changes
+    have no effect.
+
+    The default value is -1, meaning the thread is chosen automatically.
+    The pool consists of a single thread, unless a larger size is set with
+    the \c QML_WORKERSCRIPT_THREADS environment variable.
+
+    \note Workers that are passed the same ListModel must run on the same
+    thread. When the pool has more than one thread, pin them to one thread
+    with this property.
+*/
+int QQuickWorkerScript::workerThread() const
+{
+    return m_workerThread;
+}
+
+void QQuickWorkerScript::setWorkerThread(int thread)
+{
+    if (m_workerThread == thread)
+        return;
+
+    if (m_engine) {
+        qmlWarning(this) << "Cannot change the worker thread of a WorkerScript that is already running";
+        return;
+    }
+
+    m_workerThread = thread;
+    emit workerThreadChanged();
+}
+
+/*!
+    \internal
+
+    Returns the queue statistics of this worker, see QQuickWorkerScriptEngine::statistics().
+*/
+QQuickWorkerScriptEngine::Statistics QQuickWorkerScript::statistics() const
+{
+    if (!m_engine)
+        return QQuickWorkerScriptEngine::Statistics();
+    return m_engine->statistics(m_scriptId);
+}
+
+/*!
+    \qmlmethod WorkerScript::sendMessage(jsobject message, array transferList)
 
     Sends the given \a message to a worker script handler in another
     thread. The other worker script handler can receive this message
@@ -585,12 +828,26 @@ void QQuickWorkerScript::setSource(const QUrl &source)
     \list
     \li boolean, number, string
     \li JavaScript objects and arrays
+    \li ArrayBuffer and typed array objects
+    \li Map and Set objects
     \li ListModel objects (any other type of QObject* is not allowed)
     \endlist
 
     All objects and arrays are copied to the \c message. With the exception
     of ListModel objects, any modifications by the other thread to an object
     passed in \c message will not be reflected in the original object.
+
+    Since Qt 5.12, ArrayBuffer objects listed in the optional \a transferList
+    are moved to the other thread instead of being copied. Their contents
+    are handed over without copying any data, and the buffers are detached
+    in the sending thread, so that their \c byteLength becomes 0. The same
+    applies to \c WorkerScript.sendMessage() called from the worker script.
+
+    A SharedArrayBuffer is neither copied nor transferred: the receiving side
+    gets a SharedArrayBuffer using the same memory, so that both threads can
+    coordinate through the \c Atomics functions. \c Atomics.wait() blocks the
+    whole worker thread, including the other workers running in it, and can
+    not be called from the main thread.
 */
 void QQuickWorkerScript::sendMessage(QQmlV4Function *args)
 {
@@ -603,8 +860,11 @@ void QQuickWorkerScript::sendMessage(QQmlV4Function *args)
     QV4::ScopedValue argument(scope, QV4::Value::undefinedValue());
     if (args->length() != 0)
         argument = (*args)[0];
+    QV4::ScopedValue transferList(scope, QV4::Value::undefinedValue());
+    if (args->length() > 1)
+        transferList = (*args)[1];
 
-    m_engine->sendMessage(m_scriptId, QV4::Serialize::serialize(argument, scope.engine));
+    m_engine->sendMessage(m_scriptId, QV4::Serialize::serialize(argument, transferList, scope.engine));
 }
 
 void QQuickWorkerScript::classBegin()
@@ -623,7 +883,7 @@ QQuickWorkerScriptEngine *QQuickWorkerScript::engine()
         }
 
         m_engine = QQmlEnginePrivate::get(engine)->getWorkerScriptEngine();
-        m_scriptId = m_engine->registerWorkerScript(this);
+        m_scriptId = m_engine->registerWorkerScript(this, m_workerThread);
 
         if (m_source.isValid())
             m_engine->executeUrl(m_scriptId, m_source);
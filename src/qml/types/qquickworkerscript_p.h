@@ -57,29 +57,51 @@
 #include <QtCore/qthread.h>
 #include <QtQml/qjsvalue.h>
 #include <QtCore/qurl.h>
+#include <QtCore/qhash.h>
+#include <QtCore/qvector.h>
 
 QT_BEGIN_NAMESPACE
 
+namespace QV4 {
+struct SerializedData;
+}
 
 class QQuickWorkerScript;
-class QQuickWorkerScriptEnginePrivate;
-class QQuickWorkerScriptEngine : public QThread
+class QQuickWorkerScriptThread;
+class Q_AUTOTEST_EXPORT QQuickWorkerScriptEngine : public QObject
 {
 Q_OBJECT
 public:
+    struct Statistics {
+        int thread = -1;
+        int queueDepth = 0;
+        int processed = 0;
+        qint64 totalLatency = 0; // microseconds between posting and handling a task
+        qint64 maximumLatency = 0;
+    };
+
     QQuickWorkerScriptEngine(QQmlEngine *parent = nullptr);
     ~QQuickWorkerScriptEngine();
 
-    int registerWorkerScript(QQuickWorkerScript *);
+    int registerWorkerScript(QQuickWorkerScript *, int preferredThread = -1);
     void removeWorkerScript(int);
     void executeUrl(int, const QUrl &);
-    void sendMessage(int, const QByteArray &);
+    void sendMessage(int, const QV4::SerializedData &);
 
-protected:
-    void run() override;
+    int maximumThreadCount() const;
+    void setMaximumThreadCount(int count);
+    int activeThreadCount() const;
+
+    Statistics statistics(int id) const;
 
 private:
-    QQuickWorkerScriptEnginePrivate *d;
+    QQuickWorkerScriptThread *threadForWorker(int id) const;
+
+    QQmlEngine *m_qmlEngine;
+    QVector<QQuickWorkerScriptThread *> m_threads;
+    QHash<int, QQuickWorkerScriptThread *> m_workerThreads;
+    int m_maximumThreadCount;
+    int m_nextId;
 };
 
 class QQmlV4Function;
@@ -88,6 +110,7 @@ class Q_AUTOTEST_EXPORT QQuickWorkerScript : public QObject, public QQmlParserSt
 {
     Q_OBJECT
     Q_PROPERTY(QUrl source READ source WRITE setSource NOTIFY sourceChanged)
+    Q_PROPERTY(int workerThread READ workerThread WRITE setWorkerThread NOTIFY workerThreadChanged REVISION 12)
 
     Q_INTERFACES(QQmlParserStatus)
 public:
@@ -97,11 +120,17 @@ public:
     QUrl source() const;
     void setSource(const QUrl &);
 
+    int workerThread() const;
+    void setWorkerThread(int index);
+
+    QQuickWorkerScriptEngine::Statistics statistics() const;
+
 public Q_SLOTS:
     void sendMessage(QQmlV4Function*);
 
 Q_SIGNALS:
     void sourceChanged();
+    Q_REVISION(12) void workerThreadChanged();
     void message(const QQmlV4Handle &messageObject);
 
 protected:
@@ -113,6 +142,7 @@ private:
     QQuickWorkerScriptEngine *engine();
     QQuickWorkerScriptEngine *m_engine;
     int m_scriptId;
+    int m_workerThread;
     QUrl m_source;
     bool m_componentComplete;
 };
@@ -185,6 +185,7 @@ public:
     void removeItem(FxViewItem *item);
 
     FxViewItem *newViewItem(int index, QQuickItem *item) override;
+    QQuickItemViewAttached *getAttachedObject(const QObject *object) const override;
     void initializeViewItem(FxViewItem *item) override;
     void repositionItemAt(FxViewItem *item, int index, qreal sizeBuffer) override;
     void repositionPackageItemAt(QQuickItem *item, int index) override;
@@ -459,6 +460,12 @@ void QQuickGridViewPrivate::resetColumns()
     columns = qMax(1, qFloor(length / colSize()));
 }
 
+QQuickItemViewAttached *QQuickGridViewPrivate::getAttachedObject(const QObject *object) const
+{
+    QObject *attachedObject = qmlAttachedPropertiesObject<QQuickGridView>(object, false);
+    return static_cast<QQuickItemViewAttached *>(attachedObject);
+}
+
 FxViewItem *QQuickGridViewPrivate::newViewItem(int modelIndex, QQuickItem *item)
 {
     Q_Q(QQuickGridView);
@@ -576,7 +583,7 @@ void QQuickGridViewPrivate::removeItem(FxViewItem *item)
         item->releaseAfterTransition = true;
         releasePendingTransition.append(item);
     } else {
-        releaseItem(item);
+        releaseItem(item, reusableFlag);
     }
 }
 
@@ -1309,6 +1316,57 @@ void QQuickGridView::setHighlightFollowsCurrentItem(bool autoHighlight)
     The corresponding handler is \c onRemove.
 */
 
+/*!
+    \qmlattachedsignal QtQuick::GridView::pooled()
+    \since 5.12
+
+    This signal is emitted after an item has been added to the reuse
+    pool. You can use it to pause ongoing timers or animations inside
+    the item, or free up resources that cannot be reused.
+
+    This signal is emitted only if the \l reuseItems property is \c true.
+
+    \sa reuseItems, reused
+*/
+
+/*!
+    \qmlattachedsignal QtQuick::GridView::reused()
+    \since 5.12
+
+    This signal is emitted after an item has been taken out of the pool and
+    placed in the view again, and its model properties such as \c index have
+    been updated. It is not emitted the first time an item is created.
+
+    This signal is emitted only if the \l reuseItems property is \c true.
+
+    \sa reuseItems, pooled
+*/
+
+/*!
+    \qmlproperty bool QtQuick::GridView::reuseItems
+    \since 5.12
+
+    This property holds whether or not items instantiated from the \l delegate
+    should be reused. If set to \c false, any currently pooled items are
+    destroyed.
+
+    When an item is flicked out of the view, it is normally destroyed, and a new
+    item is created from scratch for the index that is flicked in on the opposite
+    side. With \c reuseItems set to \c true, the released item is instead moved
+    into a pool of reusable items, and taken out again the next time the view
+    needs an item made from the same delegate. Only the model properties, such
+    as \c index and the model roles, are updated when an item is reused. Any
+    other state stored inside the delegate is kept, so it should be reset in
+    the \l {GridView::reused}{reused} handler.
+
+    Reusing items is only supported for delegate models created by the view
+    itself, or a \l DelegateModel, and not for \l Package based delegates.
+
+    The default value is \c false.
+
+    \sa GridView::pooled, GridView::reused
+*/
+
 
 /*!
     \qmlproperty model QtQuick::GridView::model
@@ -3229,6 +3229,9 @@ QQuickItemPrivate::QQuickItemPrivate()
 #else
     , touchEnabled(false)
 #endif
+    , hitTestBoundsDirty(true)
+    , hitTestUnbounded(false)
+    , containsBeyondBounds(false)
     , dirtyAttributes(0)
     , nextDirtyItem(nullptr)
     , prevDirtyItem(nullptr)
@@ -6125,6 +6128,8 @@ void QQuickItemPrivate::dirty(DirtyType type)
     Q_Q(QQuickItem);
     if (type & (TransformOrigin | Transform | BasicTransform | Position | Size))
         transformChanged();
+    if (type & (TransformOrigin | Transform | BasicTransform | Position | Size | ChildrenChanged | Clip))
+        markHitTestBoundsDirty();
 
     if (!(dirtyAttributes & type) || (window && !prevDirtyItem)) {
         dirtyAttributes |= type;
@@ -6135,6 +6140,69 @@ void QQuickItemPrivate::dirty(DirtyType type)
     }
 }
 
+void QQuickItemPrivate::markHitTestBoundsDirty()
+{
+    // An item with dirty bounds always has dirty ancestors, so we can stop at the first one
+    for (QQuickItemPrivate *d = this; d && !d->hitTestBoundsDirty;
+         d = d->parentItem ? QQuickItemPrivate::get(d->parentItem) : nullptr)
+        d->hitTestBoundsDirty = true;
+}
+
+void QQuickItemPrivate::updateHitTestBounds()
+{
+    qreal left = 0;
+    qreal top = 0;
+    qreal right = width;
+    qreal bottom = height;
+    bool unbounded = containsBeyondBounds || mask || hasPointerHandlers();
+    for (QQuickItem *child : qAsConst(childItems)) {
+        QQuickItemPrivate *childPrivate = QQuickItemPrivate::get(child);
+        if (childPrivate->hitTestBoundsDirty)
+            childPrivate->updateHitTestBounds();
+        // Children of a clipping item are only hit where the item itself is
+        unbounded |= childPrivate->hitTestUnbounded;
+        if (flags & QQuickItem::ItemClipsChildrenToShape)
+            continue;
+        const QRectF &r = childPrivate->hitTestBounds;
+        left = qMin(left, r.left());
+        top = qMin(top, r.top());
+        right = qMax(right, r.right());
+        bottom = qMax(bottom, r.bottom());
+    }
+
+    QTransform t;
+    itemToParentTransform(t);
+    hitTestBounds = t.mapRect(QRectF(left, top, right - left, bottom - top));
+    hitTestUnbounded = unbounded;
+    hitTestBoundsDirty = false;
+}
+
+/*!
+    \internal
+
+    Returns false if neither the item nor any of its descendants can contain
+    \a parentPos, given in the coordinates of the parent item. This assumes
+    that contains() is limited to the item's own rectangle, unless a
+    containment mask or pointer handlers are involved or containsBeyondBounds
+    is set.
+*/
+bool QQuickItemPrivate::subtreeMayContain(const QPointF &parentPos)
+{
+    if (hitTestBoundsDirty)
+        updateHitTestBounds();
+    return hitTestUnbounded
+            || (parentPos.x() >= hitTestBounds.left() && parentPos.x() <= hitTestBounds.right()
+                && parentPos.y() >= hitTestBounds.top() && parentPos.y() <= hitTestBounds.bottom());
+}
+
+void QQuickItemPrivate::setContainsBeyondBounds(bool beyond)
+{
+    if (containsBeyondBounds == beyond)
+        return;
+    containsBeyondBounds = beyond;
+    markHitTestBoundsDirty();
+}
+
 void QQuickItemPrivate::addToDirtyList()
 {
     Q_Q(QQuickItem);
@@ -7689,6 +7757,11 @@ void QQuickItem::setKeepTouchGrab(bool keep)
   Note that this method is generally used to check whether the item is under the mouse cursor,
   and for that reason, the implementation of this function should be as light-weight
   as possible.
+
+  When looking for the items under a pointer, the window skips items whose
+  bounding rect, together with the bounding rects of their children, does not
+  contain the point. Reimplementations should therefore not return true for
+  points outside of boundingRect(); use \l containmentMask for that instead.
 */
 bool QQuickItem::contains(const QPointF &point) const
 {
@@ -7756,6 +7829,7 @@ void QQuickItem::setContainmentMask(QObject *mask)
         d->extra.value().maskContains = mask->metaObject()->method(methodIndex);
     }
     d->mask = mask;
+    d->markHitTestBoundsDirty();
     quickMask = qobject_cast<QQuickItem *>(mask);
     if (quickMask) {
         QQuickItemPrivate *maskPrivate = QQuickItemPrivate::get(quickMask);
@@ -8216,6 +8290,7 @@ void QQuickItemPrivate::addPointerHandler(QQuickPointerHandler *h)
     auto &handlers = extra.value().pointerHandlers;
     if (!handlers.contains(h))
         handlers.prepend(h);
+    markHitTestBoundsDirty();
 }
 
 #if QT_CONFIG(quick_shadereffect)
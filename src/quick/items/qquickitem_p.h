@@ -469,6 +469,11 @@ public:
     bool isTabFence:1;
     bool replayingPressEvent:1;
     bool touchEnabled:1;
+    // See subtreeMayContain(). containsBeyondBounds is for items whose contains()
+    // may accept points outside of their (0, 0, width, height) rectangle.
+    bool hitTestBoundsDirty:1;
+    bool hitTestUnbounded:1;
+    bool containsBeyondBounds:1;
 
     enum DirtyType {
         TransformOrigin         = 0x00000001,
@@ -537,6 +542,14 @@ public:
     QTransform windowToItemTransform() const;
     QTransform itemToWindowTransform() const;
     void itemToParentTransform(QTransform &) const;
+
+    // Pointer hit-testing index: each item caches the bounds of itself and its
+    // descendants in its parent's coordinates, so that the window can skip whole
+    // subtrees which can not contain a point.
+    void markHitTestBoundsDirty();
+    void updateHitTestBounds();
+    bool subtreeMayContain(const QPointF &parentPos);
+    void setContainsBeyondBounds(bool beyond);
     QTransform globalToWindowTransform() const;
     QTransform windowToGlobalTransform() const;
 
@@ -557,6 +570,7 @@ public:
     qreal baselineOffset;
 
     QList<QQuickTransform *> transforms;
+    QRectF hitTestBounds;
 
     inline qreal z() const { return extra.isAllocated()?extra->z:0; }
     inline qreal scale() const { return extra.isAllocated()?extra->scale:1; }
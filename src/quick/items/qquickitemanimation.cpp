@@ -531,6 +531,7 @@ QAbstractAnimationJob* QQuickAnchorAnimation::transition(QQuickStateActions &act
     QQuickAnimationPropertyUpdater *data = new QQuickAnimationPropertyUpdater;
     data->interpolatorType = QMetaType::QReal;
     data->interpolator = d->interpolator;
+    data->typedInterpolation = true;
     data->reverse = direction == Backward ? true : false;
     data->fromSourced = false;
     data->fromDefined = false;
@@ -472,6 +472,18 @@ static void qt_quickitems_defineModule(const char *uri, int major, int minor)
 #if QT_CONFIG(quick_tableview)
     qmlRegisterType<QQuickTableView>(uri, 2, 12, "TableView");
 #endif
+#if QT_CONFIG(quick_listview)
+    qmlRegisterType<QQuickListView, 12>(uri, 2, 12, "ListView");
+#endif
+#if QT_CONFIG(quick_gridview)
+    qmlRegisterType<QQuickGridView, 12>(uri, 2, 12, "GridView");
+#endif
+#if QT_CONFIG(quick_pathview)
+    qmlRegisterType<QQuickPathView, 12>(uri, 2, 12, "PathView");
+#endif
+#if QT_CONFIG(quick_itemview)
+    qmlRegisterUncreatableType<QQuickItemView, 12>(uri, 2, 12, itemViewName, itemViewMessage);
+#endif
 }
 
 static void initResources()
@@ -197,6 +197,8 @@ void QQuickItemView::setModel(const QVariant &m)
         disconnect(d->model, SIGNAL(initItem(int,QObject*)), this, SLOT(initItem(int,QObject*)));
         disconnect(d->model, SIGNAL(createdItem(int,QObject*)), this, SLOT(createdItem(int,QObject*)));
         disconnect(d->model, SIGNAL(destroyingItem(QObject*)), this, SLOT(destroyingItem(QObject*)));
+        disconnect(d->model, SIGNAL(itemPooled(int,QObject*)), this, SLOT(onItemPooled(int,QObject*)));
+        disconnect(d->model, SIGNAL(itemReused(int,QObject*)), this, SLOT(onItemReused(int,QObject*)));
     }
 
     QQmlInstanceModel *oldModel = d->model;
@@ -232,6 +234,8 @@ void QQuickItemView::setModel(const QVariant &m)
         connect(d->model, SIGNAL(createdItem(int,QObject*)), this, SLOT(createdItem(int,QObject*)));
         connect(d->model, SIGNAL(initItem(int,QObject*)), this, SLOT(initItem(int,QObject*)));
         connect(d->model, SIGNAL(destroyingItem(QObject*)), this, SLOT(destroyingItem(QObject*)));
+        connect(d->model, SIGNAL(itemPooled(int,QObject*)), this, SLOT(onItemPooled(int,QObject*)));
+        connect(d->model, SIGNAL(itemReused(int,QObject*)), this, SLOT(onItemReused(int,QObject*)));
         if (isComponentComplete()) {
             d->updateSectionCriteria();
             d->refill();
@@ -397,6 +401,29 @@ void QQuickItemView::setCacheBuffer(int b)
     }
 }
 
+bool QQuickItemView::reuseItems() const
+{
+    Q_D(const QQuickItemView);
+    return d->reusableFlag == QQmlInstanceModel::Reusable;
+}
+
+void QQuickItemView::setReuseItems(bool reuse)
+{
+    Q_D(QQuickItemView);
+    if (reuseItems() == reuse)
+        return;
+
+    d->reusableFlag = reuse ? QQmlInstanceModel::Reusable : QQmlInstanceModel::NotReusable;
+
+    if (!reuse && d->model) {
+        // When we're told to not reuse items, we
+        // immediately, as documented, drain the pool.
+        d->model->drainReusableItemsPool(0);
+    }
+
+    emit reuseItemsChanged();
+}
+
 int QQuickItemView::displayMarginBeginning() const
 {
     Q_D(const QQuickItemView);
@@ -1481,6 +1508,7 @@ QQuickItemViewPrivate::QQuickItemViewPrivate()
     , haveHighlightRange(false), autoHighlight(true), highlightRangeStartValid(false), highlightRangeEndValid(false)
     , fillCacheBuffer(false), inRequest(false)
     , runDelayedRemoveTransition(false), delegateValidated(false)
+    , reusableFlag(QQmlInstanceModel::NotReusable)
 {
     bufferPause.addAnimationChangeListener(this, QAbstractAnimationJob::Completion);
     bufferPause.setLoopCount(1);
@@ -1764,6 +1792,12 @@ void QQuickItemViewPrivate::refill(qreal from, qreal to)
         if (prevCount != itemCount)
             emit q->countChanged();
     } while (currentChanges.hasPendingChanges() || bufferedChanges.hasPendingChanges());
+
+    if (reusableFlag == QQmlInstanceModel::Reusable) {
+        // Items released while flicking have now had the chance to be picked up
+        // again by the opposite edge. Keep the rest around for one more refill.
+        model->drainReusableItemsPool(1);
+    }
 }
 
 void QQuickItemViewPrivate::regenerate(bool orientationChanged)
@@ -2332,6 +2366,22 @@ void QQuickItemView::initItem(int, QObject *object)
     }
 }
 
+void QQuickItemView::onItemPooled(int modelIndex, QObject *object)
+{
+    Q_UNUSED(modelIndex);
+
+    if (auto *attached = d_func()->getAttachedObject(object))
+        emit attached->pooled();
+}
+
+void QQuickItemView::onItemReused(int modelIndex, QObject *object)
+{
+    Q_UNUSED(modelIndex);
+
+    if (auto *attached = d_func()->getAttachedObject(object))
+        emit attached->reused();
+}
+
 void QQuickItemView::destroyingItem(QObject *object)
 {
     Q_D(QQuickItemView);
@@ -2342,7 +2392,7 @@ void QQuickItemView::destroyingItem(QObject *object)
     }
 }
 
-bool QQuickItemViewPrivate::releaseItem(FxViewItem *item)
+bool QQuickItemViewPrivate::releaseItem(FxViewItem *item, QQmlInstanceModel::ReusableFlag reusableFlag)
 {
     Q_Q(QQuickItemView);
     if (!item || !model)
@@ -2351,9 +2401,18 @@ bool QQuickItemViewPrivate::releaseItem(FxViewItem *item)
         trackedItem = nullptr;
     item->trackGeometry(false);
 
-    QQmlInstanceModel::ReleaseFlags flags = model->release(item->item);
+    QQmlInstanceModel::ReleaseFlags flags = model->release(item->item, reusableFlag);
     if (item->item) {
-        if (flags == 0) {
+        if (flags & QQmlInstanceModel::Pooled) {
+            // The item stays alive in the model's pool until it is reused or
+            // drained. Hide it, and make sure it doesn't come back with focus.
+            QQuickItemPrivate::get(item->item)->setCulled(true);
+            if (QQuickWindow *window = item->item->window()) {
+                const auto focusItem = qobject_cast<QQuickItem *>(window->focusObject());
+                if (focusItem && (item->item == focusItem || item->item->isAncestorOf(focusItem)))
+                    item->item->setFocus(false);
+            }
+        } else if (flags == 0) {
             // item was not destroyed, and we no longer reference it.
             QQuickItemPrivate::get(item->item)->setCulled(true);
             unrequestedItems.insert(item->item, model->indexOf(item->item, q));
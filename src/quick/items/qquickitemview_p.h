@@ -110,6 +110,8 @@ class Q_QUICK_PRIVATE_EXPORT QQuickItemView : public QQuickFlickable
     Q_PROPERTY(qreal preferredHighlightEnd READ preferredHighlightEnd WRITE setPreferredHighlightEnd NOTIFY preferredHighlightEndChanged RESET resetPreferredHighlightEnd)
     Q_PROPERTY(int highlightMoveDuration READ highlightMoveDuration WRITE setHighlightMoveDuration NOTIFY highlightMoveDurationChanged)
 
+    Q_PROPERTY(bool reuseItems READ reuseItems WRITE setReuseItems NOTIFY reuseItemsChanged REVISION 12)
+
 public:
     // this holds all layout enum values so they can be referred to by other enums
     // to ensure consistent values - e.g. QML references to GridView.TopToBottom flow
@@ -153,6 +155,9 @@ public:
     int cacheBuffer() const;
     void setCacheBuffer(int);
 
+    bool reuseItems() const;
+    void setReuseItems(bool reuse);
+
     int displayMarginBeginning() const;
     void setDisplayMarginBeginning(int);
 
@@ -276,6 +281,8 @@ Q_SIGNALS:
     void preferredHighlightEndChanged();
     void highlightMoveDurationChanged();
 
+    Q_REVISION(12) void reuseItemsChanged();
+
 protected:
     void updatePolish() override;
     void componentComplete() override;
@@ -291,6 +298,8 @@ protected Q_SLOTS:
     virtual void initItem(int index, QObject *item);
     void modelUpdated(const QQmlChangeSet &changeSet, bool reset);
     void destroyingItem(QObject *item);
+    void onItemPooled(int modelIndex, QObject *object);
+    void onItemReused(int modelIndex, QObject *object);
     void animStopped();
     void trackedPositionChanged();
 
@@ -390,6 +399,9 @@ Q_SIGNALS:
     void add();
     void remove();
 
+    void pooled();
+    void reused();
+
     void sectionChanged();
     void prevSectionChanged();
     void nextSectionChanged();
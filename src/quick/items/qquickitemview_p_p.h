@@ -174,7 +174,7 @@ public:
     void mirrorChange() override;
 
     FxViewItem *createItem(int modelIndex,QQmlIncubator::IncubationMode incubationMode = QQmlIncubator::AsynchronousIfNested);
-    virtual bool releaseItem(FxViewItem *item);
+    virtual bool releaseItem(FxViewItem *item, QQmlInstanceModel::ReusableFlag reusableFlag = QQmlInstanceModel::NotReusable);
 
     QQuickItem *createHighlightItem() const;
     QQuickItem *createComponentItem(QQmlComponent *component, qreal zValue, bool createDefault = false) const;
@@ -289,6 +289,8 @@ public:
     QQuickItemViewTransitioner *transitioner;
     QList<FxViewItem *> releasePendingTransition;
 
+    QQmlInstanceModel::ReusableFlag reusableFlag;
+
     mutable qreal minExtent;
     mutable qreal maxExtent;
 
@@ -340,6 +342,7 @@ protected:
     virtual void visibleItemsChanged() {}
 
     virtual FxViewItem *newViewItem(int index, QQuickItem *item) = 0;
+    virtual QQuickItemViewAttached *getAttachedObject(const QObject *) const { return nullptr; }
     virtual void repositionItemAt(FxViewItem *item, int index, qreal sizeBuffer) = 0;
     virtual void repositionPackageItemAt(QQuickItem *item, int index) = 0;
     virtual void resetFirstItemPosition(qreal pos = 0.0) = 0;
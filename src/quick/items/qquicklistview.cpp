@@ -90,8 +90,9 @@ public:
     void removeItem(FxViewItem *item);
 
     FxViewItem *newViewItem(int index, QQuickItem *item) override;
+    QQuickItemViewAttached *getAttachedObject(const QObject *object) const override;
     void initializeViewItem(FxViewItem *item) override;
-    bool releaseItem(FxViewItem *item) override;
+    bool releaseItem(FxViewItem *item, QQmlInstanceModel::ReusableFlag reusableFlag = QQmlInstanceModel::NotReusable) override;
     void repositionItemAt(FxViewItem *item, int index, qreal sizeBuffer) override;
     void repositionPackageItemAt(QQuickItem *item, int index) override;
     void resetFirstItemPosition(qreal pos = 0.0) override;
@@ -631,7 +632,13 @@ void QQuickListViewPrivate::initializeViewItem(FxViewItem *item)
     }
 }
 
-bool QQuickListViewPrivate::releaseItem(FxViewItem *item)
+QQuickItemViewAttached *QQuickListViewPrivate::getAttachedObject(const QObject *object) const
+{
+    QObject *attachedObject = qmlAttachedPropertiesObject<QQuickListView>(object, false);
+    return static_cast<QQuickItemViewAttached *>(attachedObject);
+}
+
+bool QQuickListViewPrivate::releaseItem(FxViewItem *item, QQmlInstanceModel::ReusableFlag reusableFlag)
 {
     if (!item || !model)
         return true;
@@ -639,7 +646,7 @@ bool QQuickListViewPrivate::releaseItem(FxViewItem *item)
     QPointer<QQuickItem> it = item->item;
     QQuickListViewAttached *att = static_cast<QQuickListViewAttached*>(item->attached);
 
-    bool released = QQuickItemViewPrivate::releaseItem(item);
+    bool released = QQuickItemViewPrivate::releaseItem(item, reusableFlag);
     if (released && it && att && att->m_sectionItem) {
         // We hold no more references to this item
         int i = 0;
@@ -734,7 +741,7 @@ void QQuickListViewPrivate::removeItem(FxViewItem *item)
         releasePendingTransition.append(item);
     } else {
         qCDebug(lcItemViewDelegateLifecycle) << "\treleasing stationary item" << item->index << (QObject *)(item->item);
-        releaseItem(item);
+        releaseItem(item, reusableFlag);
     }
 }
 
@@ -1992,6 +1999,57 @@ QQuickListView::~QQuickListView()
     The corresponding handler is \c onRemove.
 */
 
+/*!
+    \qmlattachedsignal QtQuick::ListView::pooled()
+    \since 5.12
+
+    This signal is emitted after an item has been added to the reuse
+    pool. You can use it to pause ongoing timers or animations inside
+    the item, or free up resources that cannot be reused.
+
+    This signal is emitted only if the \l reuseItems property is \c true.
+
+    \sa reuseItems, reused
+*/
+
+/*!
+    \qmlattachedsignal QtQuick::ListView::reused()
+    \since 5.12
+
+    This signal is emitted after an item has been taken out of the pool and
+    placed in the view again, and its model properties such as \c index have
+    been updated. It is not emitted the first time an item is created.
+
+    This signal is emitted only if the \l reuseItems property is \c true.
+
+    \sa reuseItems, pooled
+*/
+
+/*!
+    \qmlproperty bool QtQuick::ListView::reuseItems
+    \since 5.12
+
+    This property holds whether or not items instantiated from the \l delegate
+    should be reused. If set to \c false, any currently pooled items are
+    destroyed.
+
+    When an item is flicked out of the view, it is normally destroyed, and a new
+    item is created from scratch for the index that is flicked in on the opposite
+    side. With \c reuseItems set to \c true, the released item is instead moved
+    into a pool of reusable items, and taken out again the next time the view
+    needs an item made from the same delegate. Only the model properties, such
+    as \c index and the model roles, are updated when an item is reused. Any
+    other state stored inside the delegate is kept, so it should be reset in
+    the \l {ListView::reused}{reused} handler.
+
+    Reusing items is only supported for delegate models created by the view
+    itself, or a \l DelegateModel, and not for \l Package based delegates.
+
+    The default value is \c false.
+
+    \sa ListView::pooled, ListView::reused
+*/
+
 /*!
     \qmlproperty model QtQuick::ListView::model
     This property holds the model providing data for the list.
@@ -106,6 +106,7 @@ QQuickPathViewPrivate::QQuickPathViewPrivate()
     , highlightRangeStart(0), highlightRangeEnd(0)
     , highlightRangeMode(QQuickPathView::StrictlyEnforceRange)
     , highlightMoveDuration(300), modelCount(0), snapMode(QQuickPathView::NoSnap)
+    , reusableFlag(QQmlInstanceModel::NotReusable)
 {
 }
 
@@ -144,6 +145,8 @@ QQuickItem *QQuickPathViewPrivate::getItem(int modelIndex, qreal z, bool async)
         item->setParentItem(q);
         requestedIndex = -1;
         QQuickItemPrivate *itemPrivate = QQuickItemPrivate::get(item);
+        // A recycled item was culled when it went into the pool
+        itemPrivate->setCulled(false);
         itemPrivate->addItemChangeListener(this, QQuickItemPrivate::Geometry);
     }
     inRequest = false;
@@ -195,15 +198,20 @@ void QQuickPathView::initItem(int index, QObject *object)
     }
 }
 
-void QQuickPathViewPrivate::releaseItem(QQuickItem *item)
+void QQuickPathViewPrivate::releaseItem(QQuickItem *item, QQmlInstanceModel::ReusableFlag reusableFlag)
 {
     if (!item || !model)
         return;
     qCDebug(lcItemViewDelegateLifecycle) << "release" << item;
     QQuickItemPrivate *itemPrivate = QQuickItemPrivate::get(item);
     itemPrivate->removeItemChangeListener(this, QQuickItemPrivate::Geometry);
-    QQmlInstanceModel::ReleaseFlags flags = model->release(item);
-    if (!flags) {
+    QQmlInstanceModel::ReleaseFlags flags = model->release(item, reusableFlag);
+    if (flags & QQmlInstanceModel::Pooled) {
+        // The item rests in the model's pool until it is reused or drained
+        itemPrivate->setCulled(true);
+        if (QQuickPathViewAttached *att = attached(item))
+            att->setOnPath(false);
+    } else if (!flags) {
         // item was not destroyed, and we no longer reference it.
         if (QQuickPathViewAttached *att = attached(item))
             att->setOnPath(false);
@@ -595,6 +603,32 @@ QQuickPathView::~QQuickPathView()
     \snippet qml/pathview/pathview.qml 1
 */
 
+/*!
+    \qmlattachedsignal QtQuick::PathView::pooled()
+    \since 5.12
+
+    This signal is emitted after an item has been added to the reuse
+    pool. You can use it to pause ongoing timers or animations inside
+    the item, or free up resources that cannot be reused.
+
+    This signal is emitted only if the \l reuseItems property is \c true.
+
+    \sa reuseItems, reused
+*/
+
+/*!
+    \qmlattachedsignal QtQuick::PathView::reused()
+    \since 5.12
+
+    This signal is emitted after an item has been taken out of the pool and
+    placed in the view again, and its model properties such as \c index have
+    been updated. It is not emitted the first time an item is created.
+
+    This signal is emitted only if the \l reuseItems property is \c true.
+
+    \sa reuseItems, pooled
+*/
+
 /*!
     \qmlproperty model QtQuick::PathView::model
     This property holds the model providing data for the view.
@@ -630,6 +664,10 @@ void QQuickPathView::setModel(const QVariant &m)
                              this, QQuickPathView, SLOT(createdItem(int,QObject*)));
         qmlobject_disconnect(d->model, QQmlInstanceModel, SIGNAL(initItem(int,QObject*)),
                              this, QQuickPathView, SLOT(initItem(int,QObject*)));
+        qmlobject_disconnect(d->model, QQmlInstanceModel, SIGNAL(itemPooled(int,QObject*)),
+                             this, QQuickPathView, SLOT(onItemPooled(int,QObject*)));
+        qmlobject_disconnect(d->model, QQmlInstanceModel, SIGNAL(itemReused(int,QObject*)),
+                             this, QQuickPathView, SLOT(onItemReused(int,QObject*)));
         d->clear();
     }
 
@@ -661,6 +699,10 @@ void QQuickPathView::setModel(const QVariant &m)
                           this, QQuickPathView, SLOT(createdItem(int,QObject*)));
         qmlobject_connect(d->model, QQmlInstanceModel, SIGNAL(initItem(int,QObject*)),
                           this, QQuickPathView, SLOT(initItem(int,QObject*)));
+        qmlobject_connect(d->model, QQmlInstanceModel, SIGNAL(itemPooled(int,QObject*)),
+                          this, QQuickPathView, SLOT(onItemPooled(int,QObject*)));
+        qmlobject_connect(d->model, QQmlInstanceModel, SIGNAL(itemReused(int,QObject*)),
+                          this, QQuickPathView, SLOT(onItemReused(int,QObject*)));
         d->modelCount = d->model->count();
     }
     if (isComponentComplete()) {
@@ -1347,6 +1389,50 @@ void QQuickPathView::setCacheItemCount(int i)
     emit cacheItemCountChanged();
 }
 
+/*!
+    \qmlproperty bool QtQuick::PathView::reuseItems
+    \since 5.12
+
+    This property holds whether or not items instantiated from the \l delegate
+    should be reused. If set to \c false, any currently pooled items are
+    destroyed.
+
+    When an item moves off the path, it is normally destroyed, and a new
+    item is created from scratch for the index that moves onto the path on the
+    opposite side. With \c reuseItems set to \c true, the released item is instead moved
+    into a pool of reusable items, and taken out again the next time the view
+    needs an item made from the same delegate. Only the model properties, such
+    as \c index and the model roles, are updated when an item is reused. Any
+    other state stored inside the delegate is kept, so it should be reset in
+    the \l {PathView::reused}{reused} handler.
+
+    Reusing items is only supported for delegate models created by the view
+    itself, or a \l DelegateModel, and not for \l Package based delegates.
+
+    The default value is \c false.
+
+    \sa PathView::pooled, PathView::reused
+*/
+bool QQuickPathView::reuseItems() const
+{
+    Q_D(const QQuickPathView);
+    return d->reusableFlag == QQmlInstanceModel::Reusable;
+}
+
+void QQuickPathView::setReuseItems(bool reuse)
+{
+    Q_D(QQuickPathView);
+    if (reuseItems() == reuse)
+        return;
+
+    d->reusableFlag = reuse ? QQmlInstanceModel::Reusable : QQmlInstanceModel::NotReusable;
+
+    if (!reuse && d->model)
+        d->model->drainReusableItemsPool(0);
+
+    emit reuseItemsChanged();
+}
+
 /*!
     \qmlproperty enumeration QtQuick::PathView::snapMode
 
@@ -1981,7 +2067,7 @@ void QQuickPathView::refill()
                 att->setOnPath(pos < 1.0);
             if (!d->isInBound(pos, d->mappedRange - d->mappedCache, 1.0 + d->mappedCache)) {
                 qCDebug(lcItemViewDelegateLifecycle) << "release" << idx << "@" << pos << ", !isInBound: lower" << (d->mappedRange - d->mappedCache) << "upper" << (1.0 + d->mappedCache);
-                d->releaseItem(item);
+                d->releaseItem(item, d->reusableFlag);
                 it = d->items.erase(it);
             } else {
                 ++it;
@@ -2164,9 +2250,12 @@ void QQuickPathView::refill()
             att->setOnPath(currentVisible);
     }
     for (QQuickItem *item : qAsConst(d->itemCache))
-        d->releaseItem(item);
+        d->releaseItem(item, d->reusableFlag);
     d->itemCache.clear();
 
+    if (d->reusableFlag == QQmlInstanceModel::Reusable)
+        d->model->drainReusableItemsPool(1);
+
     d->inRefill = false;
     if (currentChanged)
         emit currentItemChanged();
@@ -2276,6 +2365,28 @@ void QQuickPathView::destroyingItem(QObject *item)
     Q_UNUSED(item);
 }
 
+void QQuickPathView::onItemPooled(int modelIndex, QObject *object)
+{
+    Q_D(QQuickPathView);
+    Q_UNUSED(modelIndex);
+
+    if (QQuickItem *item = qmlobject_cast<QQuickItem *>(object)) {
+        if (QQuickPathViewAttached *att = d->attached(item))
+            emit att->pooled();
+    }
+}
+
+void QQuickPathView::onItemReused(int modelIndex, QObject *object)
+{
+    Q_D(QQuickPathView);
+    Q_UNUSED(modelIndex);
+
+    if (QQuickItem *item = qmlobject_cast<QQuickItem *>(object)) {
+        if (QQuickPathViewAttached *att = d->attached(item))
+            emit att->reused();
+    }
+}
+
 void QQuickPathView::ticked()
 {
     Q_D(QQuickPathView);
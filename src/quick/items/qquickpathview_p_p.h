@@ -97,7 +97,7 @@ public:
     }
 
     QQuickItem *getItem(int modelIndex, qreal z = 0, bool async=false);
-    void releaseItem(QQuickItem *item);
+    void releaseItem(QQuickItem *item, QQmlInstanceModel::ReusableFlag reusableFlag = QQmlInstanceModel::NotReusable);
     QQuickPathViewAttached *attached(QQuickItem *item);
     QQmlOpenMetaObjectType *attachedType();
     void clear();
@@ -188,6 +188,7 @@ public:
     int modelCount;
     QPODVector<qreal,10> velocityBuffer;
     QQuickPathView::SnapMode snapMode;
+    QQmlInstanceModel::ReusableFlag reusableFlag;
 };
 
 QT_END_NAMESPACE
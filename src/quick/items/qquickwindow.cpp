@@ -75,6 +75,7 @@
 #include <private/qqmlmemoryprofiler_p.h>
 #include <private/qqmldebugserviceinterfaces_p.h>
 #include <private/qqmldebugconnector_p.h>
+#include <private/qqmlbindingscheduler_p.h>
 #if QT_CONFIG(opengl)
 # include <private/qopenglvertexarrayobject_p.h>
 # include <private/qsgdefaultrendercontext_p.h>
@@ -294,6 +295,10 @@ static bool transformDirtyOnItemOrAncestor(const QQuickItem *item)
 
 void QQuickWindowPrivate::polishItems()
 {
+    // Deferred bindings have to settle before items are polished and synced to the
+    // scene graph, otherwise the frame would show stale values.
+    QQmlBindingScheduler::flushAll();
+
     // An item can trigger polish on another item, or itself for that matter,
     // during its updatePolish() call. Because of this, we cannot simply
     // iterate through the set, we must continue pulling items out until it
@@ -1870,10 +1875,14 @@ bool QQuickWindowPrivate::deliverHoverEvent(QQuickItem *item, const QPointF &sce
 
     qCDebug(DBG_HOVER_TRACE) << q << item << scenePos << lastScenePos << "subtreeHoverEnabled" << itemPrivate->subtreeHoverEnabled;
     if (itemPrivate->subtreeHoverEnabled) {
+        const QPointF itemPos = item->mapFromScene(scenePos);
         QList<QQuickItem *> children = itemPrivate->paintOrderChildItems();
         for (int ii = children.count() - 1; ii >= 0; --ii) {
             QQuickItem *child = children.at(ii);
-            if (!child->isVisible() || !child->isEnabled() || QQuickItemPrivate::get(child)->culled)
+            QQuickItemPrivate *childPrivate = QQuickItemPrivate::get(child);
+            if (!child->isVisible() || !child->isEnabled() || childPrivate->culled)
+                continue;
+            if (!childPrivate->subtreeMayContain(itemPos))
                 continue;
             if (deliverHoverEvent(child, scenePos, lastScenePos, modifiers, timestamp, accepted))
                 return true;
@@ -2365,19 +2374,27 @@ void QQuickWindowPrivate::deliverPointerEvent(QQuickPointerEvent *event)
 }
 
 // check if item or any of its child items contain the point, or if any pointer handler "wants" the point
-// FIXME: should this be iterative instead of recursive?
 // If checkMouseButtons is true, it means we are finding targets for a mouse event, so no item for which acceptedMouseButtons() is NoButton will be added.
 // If checkAcceptsTouch is true, it means we are finding targets for a touch event, so either acceptTouchEvents() must return true OR
 // it must accept a synth. mouse event, thus if acceptTouchEvents() returns false but acceptedMouseButtons() is true, gets added; if not, it doesn't.
 QVector<QQuickItem *> QQuickWindowPrivate::pointerTargets(QQuickItem *item, QQuickEventPoint *point, bool checkMouseButtons, bool checkAcceptsTouch) const
 {
     QVector<QQuickItem *> targets;
+    collectPointerTargets(item, point, checkMouseButtons, checkAcceptsTouch, targets);
+    return targets;
+}
+
+// FIXME: should this be iterative instead of recursive?
+// Subtrees whose cached bounds (see QQuickItemPrivate::subtreeMayContain()) don't contain the point are skipped.
+void QQuickWindowPrivate::collectPointerTargets(QQuickItem *item, QQuickEventPoint *point, bool checkMouseButtons, bool checkAcceptsTouch,
+                                                QVector<QQuickItem *> &targets) const
+{
     auto itemPrivate = QQuickItemPrivate::get(item);
     QPointF itemPos = item->mapFromScene(point->scenePosition());
     // if the item clips, we can potentially return early
     if (itemPrivate->flags & QQuickItem::ItemClipsChildrenToShape) {
         if (!item->contains(itemPos))
-            return targets;
+            return;
     }
 
     // recurse for children
@@ -2387,7 +2404,9 @@ QVector<QQuickItem *> QQuickWindowPrivate::pointerTargets(QQuickItem *item, QQui
         auto childPrivate = QQuickItemPrivate::get(child);
         if (!child->isVisible() || !child->isEnabled() || childPrivate->culled)
             continue;
-        targets << pointerTargets(child, point, checkMouseButtons, checkAcceptsTouch);
+        if (!childPrivate->subtreeMayContain(itemPos))
+            continue;
+        collectPointerTargets(child, point, checkMouseButtons, checkAcceptsTouch, targets);
     }
 
     bool relevant = item->contains(itemPos);
@@ -2403,7 +2422,6 @@ QVector<QQuickItem *> QQuickWindowPrivate::pointerTargets(QQuickItem *item, QQui
     }
     if (relevant)
         targets << item; // add this item last: children take precedence
-    return targets;
 }
 
 // return the joined lists
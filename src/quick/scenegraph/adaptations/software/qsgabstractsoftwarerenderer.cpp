@@ -45,6 +45,14 @@
 #include "qsgsoftwarerenderablenode_p.h"
 
 #include <QtCore/QLoggingCategory>
+#include <QtCore/QAtomicInt>
+#include <QtCore/QRunnable>
+#include <QtCore/QSemaphore>
+#include <QtCore/QThread>
+#include <QtCore/QThreadPool>
+#include <QtCore/QVector>
+#include <QtGui/QImage>
+#include <QtGui/QPainter>
 #include <QtGui/QWindow>
 #include <QtQuick/QSGSimpleRectNode>
 
@@ -142,6 +150,134 @@ QRegion QSGAbstractSoftwareRenderer::renderNodes(QPainter *painter)
     return dirtyRegion;
 }
 
+namespace {
+// Paints the nodes into the bands of the image, which are given in logical coordinates
+class QSGSoftwareTileRenderer : public QRunnable
+{
+public:
+    QSGSoftwareTileRenderer(const QLinkedList<QSGSoftwareRenderableNode *> &nodes, QImage *image, uchar *bits,
+                            const QVector<QRect> &tiles, QSemaphore *done)
+        : m_nodes(nodes), m_image(image), m_bits(bits), m_tiles(tiles), m_done(done)
+    {}
+
+    void run() override
+    {
+        const int dpr = qRound(m_image->devicePixelRatioF());
+        const int bytesPerPixel = m_image->depth() / 8;
+        for (const QRect &tile : m_tiles) {
+            const QRect deviceTile(tile.topLeft() * dpr, tile.size() * dpr);
+            QImage image(m_bits + deviceTile.y() * m_image->bytesPerLine() + deviceTile.x() * bytesPerPixel,
+                         deviceTile.width(), deviceTile.height(), m_image->bytesPerLine(), m_image->format());
+            image.setDevicePixelRatio(dpr);
+            QPainter painter(&image);
+            painter.setRenderHint(QPainter::Antialiasing);
+            bool background = true;
+            for (auto it = m_nodes.constBegin(); it != m_nodes.constEnd(); ++it) {
+                (*it)->paintTile(&painter, tile, background);
+                background = false;
+            }
+        }
+        m_done->release();
+    }
+
+private:
+    const QLinkedList<QSGSoftwareRenderableNode *> &m_nodes;
+    const QImage *m_image;
+    uchar *m_bits;
+    QVector<QRect> m_tiles;
+    QSemaphore *m_done;
+};
+}
+
+Q_GLOBAL_STATIC(QThreadPool, qsg_software_render_pool)
+
+static int qsg_software_default_render_threads()
+{
+    bool ok = false;
+    const int count = qEnvironmentVariableIntValue("QSG_SOFTWARE_RENDER_THREADS", &ok);
+    return qMax(1, ok ? count : QThread::idealThreadCount());
+}
+
+static QBasicAtomicInt qsg_software_forced_render_threads = Q_BASIC_ATOMIC_INITIALIZER(0);
+
+void qsg_software_set_render_threads(int count)
+{
+    qsg_software_forced_render_threads.storeRelease(qMax(0, count));
+}
+
+static int qsg_software_render_threads()
+{
+    static const int defaultCount = qsg_software_default_render_threads();
+    const int forced = qsg_software_forced_render_threads.loadAcquire();
+    return forced > 0 ? forced : defaultCount;
+}
+
+/*
+    Whether renderNodesTiled() can be used for this frame: the device has to be an image we
+    can address tiles of at whole pixels, there must be no QSGRenderNodes, which paint with
+    the shared painter, and the update has to be large enough to be worth it. The number of
+    threads can be set with QSG_SOFTWARE_RENDER_THREADS, 1 disables tiled rendering.
+*/
+bool QSGAbstractSoftwareRenderer::canRenderTiled(QPaintDevice *device, const QRegion &updateRegion) const
+{
+    if (qsg_software_render_threads() < 2 || device->devType() != QInternal::Image)
+        return false;
+    const QImage *image = static_cast<const QImage *>(device);
+    if (image->depth() < 8 || image->depth() % 8 || image->colorCount()
+            || image->devicePixelRatioF() != qRound(image->devicePixelRatioF()))
+        return false;
+    const QRect bounds = updateRegion.boundingRect();
+    if (qint64(bounds.width()) * bounds.height() < 256 * 256)
+        return false;
+    for (auto node : m_renderableNodes) {
+        if (node->type() == QSGSoftwareRenderableNode::RenderNode)
+            return false;
+    }
+    return true;
+}
+
+/*
+    Does the same as renderNodes(), but splits the update region into horizontal bands which
+    are painted on the render thread pool, each with its own painter clipped to the band. The
+    nodes are painted in the same order within each band, so the result is the same.
+*/
+QRegion QSGAbstractSoftwareRenderer::renderNodesTiled(QImage *image, const QRegion &updateRegion)
+{
+    QRegion dirtyRegion;
+    if (m_renderableNodes.isEmpty())
+        return dirtyRegion;
+
+    const int dpr = qRound(image->devicePixelRatioF());
+    for (auto node : m_renderableNodes)
+        node->prepareTiledRender(dpr);
+
+    const QRect imageRect(QPoint(0, 0), image->size() / dpr);
+    const QRect bounds = updateRegion.boundingRect() & imageRect;
+    const int threads = qsg_software_render_threads();
+    // A few bands per thread, so that a band that is expensive to paint doesn't hold up the rest
+    const int bandHeight = qMax(16, (bounds.height() + threads * 4 - 1) / (threads * 4));
+    QVector<QVector<QRect>> work(threads);
+    int band = 0;
+    for (int y = bounds.top(); y <= bounds.bottom(); y += bandHeight, ++band) {
+        const QRect tile = QRect(bounds.left(), y, bounds.width(), bandHeight) & bounds;
+        if (updateRegion.intersects(tile))
+            work[band % threads].append(tile);
+    }
+
+    uchar *bits = image->bits();
+    QThreadPool *pool = qsg_software_render_pool();
+    pool->setMaxThreadCount(qMax(pool->maxThreadCount(), threads - 1));
+    QSemaphore done;
+    for (int i = 1; i < threads; ++i)
+        pool->start(new QSGSoftwareTileRenderer(m_renderableNodes, image, bits, work.at(i), &done));
+    QSGSoftwareTileRenderer(m_renderableNodes, image, bits, work.at(0), &done).run();
+    done.acquire(threads);
+
+    for (auto node : m_renderableNodes)
+        dirtyRegion += node->finishRender();
+    return dirtyRegion;
+}
+
 void QSGAbstractSoftwareRenderer::buildRenderList()
 {
     // Clear the previous renderlist
@@ -58,11 +58,16 @@
 
 QT_BEGIN_NAMESPACE
 
+class QImage;
+class QPaintDevice;
 class QSGSimpleRectNode;
 
 class QSGSoftwareRenderableNode;
 class QSGSoftwareRenderableNodeUpdater;
 
+// For autotests, overrides QSG_SOFTWARE_RENDER_THREADS. 0 goes back to the default.
+Q_QUICK_PRIVATE_EXPORT void qsg_software_set_render_threads(int count);
+
 class Q_QUICK_PRIVATE_EXPORT QSGAbstractSoftwareRenderer : public QSGRenderer
 {
 public:
@@ -79,6 +84,8 @@ public:
 
 protected:
     QRegion renderNodes(QPainter *painter);
+    bool canRenderTiled(QPaintDevice *device, const QRegion &updateRegion) const;
+    QRegion renderNodesTiled(QImage *image, const QRegion &updateRegion);
     void buildRenderList();
     QRegion optimizeRenderList();
 
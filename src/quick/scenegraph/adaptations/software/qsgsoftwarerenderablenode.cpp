@@ -55,6 +55,7 @@
 #include <private/qsgtexture_p.h>
 
 #include <qmath.h>
+#include <QtCore/qmutex.h>
 
 Q_LOGGING_CATEGORY(lcRenderable, "qt.scenegraph.softwarecontext.renderable")
 
@@ -249,11 +250,8 @@ QRegion QSGSoftwareRenderableNode::renderNode(QPainter *painter, bool forceOpaqu
 
     // Check for don't paint conditions
     if (m_nodeType != RenderNode) {
-        if (!m_isDirty || qFuzzyIsNull(m_opacity) || m_dirtyRegion.isEmpty()) {
-            m_isDirty = false;
-            m_dirtyRegion = QRegion();
-            return QRegion();
-        }
+        if (!needsPainting())
+            return finishRender();
     } else {
         if (!m_isDirty || qFuzzyIsNull(m_opacity)) {
             m_isDirty = false;
@@ -286,16 +284,86 @@ QRegion QSGSoftwareRenderableNode::renderNode(QPainter *painter, bool forceOpaqu
         }
     }
 
+    // m_dirtyRegion already accounts for clipRegion
+    paint(painter, m_dirtyRegion, QPoint(), forceOpaquePainting);
+    return finishRender();
+}
+
+bool QSGSoftwareRenderableNode::needsPainting() const
+{
+    Q_ASSERT(m_nodeType != RenderNode);
+    return m_isDirty && !qFuzzyIsNull(m_opacity) && !m_dirtyRegion.isEmpty();
+}
+
+/*
+    Does what painting the node at the start of renderNode() would change in the node itself,
+    so that paintTile() only reads it.
+*/
+void QSGSoftwareRenderableNode::prepareTiledRender(qreal devicePixelRatio)
+{
+    Q_ASSERT(m_nodeType != RenderNode);
+    if (m_nodeType == Rectangle)
+        m_handle.rectangleNode->updateDevicePixelRatio(devicePixelRatio);
+    else if (m_nodeType == SimpleImage)
+        static_cast<QSGSoftwareImageNode *>(m_handle.simpleImageNode)->ensureCachedMirroredPixmap();
+}
+
+/*
+    Paints the part of the node in \a tile, in logical window coordinates, with a painter
+    whose device only covers that tile. Several tiles may be painted at once. Glyph nodes
+    go through the glyph caches of their font engines, so those are painted one at a time.
+*/
+void QSGSoftwareRenderableNode::paintTile(QPainter *painter, const QRect &tile, bool forceOpaquePainting) const
+{
+    Q_ASSERT(painter);
+    if (!needsPainting())
+        return;
+    const QRegion clip = m_dirtyRegion & tile;
+    if (clip.isEmpty())
+        return;
+
+    if (m_nodeType == Glyph) {
+        static QBasicMutex glyphMutex;
+        QMutexLocker lock(&glyphMutex);
+        paint(painter, clip, tile.topLeft(), forceOpaquePainting);
+    } else {
+        paint(painter, clip, tile.topLeft(), forceOpaquePainting);
+    }
+}
+
+QRegion QSGSoftwareRenderableNode::finishRender()
+{
+    if (m_nodeType != RenderNode && !needsPainting()) {
+        m_isDirty = false;
+        m_dirtyRegion = QRegion();
+        return QRegion();
+    }
+
+    QRegion areaToBeFlushed = m_dirtyRegion;
+    m_previousDirtyRegion = QRegion(m_boundingRectMax);
+    m_isDirty = false;
+    m_dirtyRegion = QRegion();
+
+    return areaToBeFlushed;
+}
+
+void QSGSoftwareRenderableNode::paint(QPainter *painter, const QRegion &clip, const QPoint &origin,
+                                      bool forceOpaquePainting) const
+{
     painter->save();
     painter->setOpacity(m_opacity);
 
-    // Set clipRegion to m_dirtyRegion (in world coordinates, so must be done before the setTransform below)
-    // as m_dirtyRegion already accounts for clipRegion
-    painter->setClipRegion(m_dirtyRegion, Qt::ReplaceClip);
+    // Set the clip in world coordinates, so must be done before the setTransform below
+    QTransform originTransform;
+    if (!origin.isNull()) {
+        originTransform = QTransform::fromTranslate(-origin.x(), -origin.y());
+        painter->setTransform(originTransform);
+    }
+    painter->setClipRegion(clip, Qt::ReplaceClip);
     if (m_clipRegion.rectCount() > 1)
         painter->setClipRegion(m_clipRegion, Qt::IntersectClip);
 
-    painter->setTransform(m_transform, false); //precalculated worldTransform
+    painter->setTransform(m_transform * originTransform, false); //precalculated worldTransform
     if (forceOpaquePainting || m_isOpaque)
         painter->setCompositionMode(QPainter::CompositionMode_Source);
 
@@ -346,13 +414,6 @@ QRegion QSGSoftwareRenderableNode::renderNode(QPainter *painter, bool forceOpaqu
     }
 
     painter->restore();
-
-    QRegion areaToBeFlushed = m_dirtyRegion;
-    m_previousDirtyRegion = QRegion(m_boundingRectMax);
-    m_isDirty = false;
-    m_dirtyRegion = QRegion();
-
-    return areaToBeFlushed;
 }
 
 bool QSGSoftwareRenderableNode::isDirtyRegionEmpty() const
@@ -98,6 +98,10 @@ public:
     void update();
 
     QRegion renderNode(QPainter *painter, bool forceOpaquePainting = false);
+    // Tiled rendering, see QSGAbstractSoftwareRenderer::renderNodesTiled()
+    void prepareTiledRender(qreal devicePixelRatio);
+    void paintTile(QPainter *painter, const QRect &tile, bool forceOpaquePainting = false) const;
+    QRegion finishRender();
     QRect boundingRectMin() const { return m_boundingRectMin; }
     QRect boundingRectMax() const { return m_boundingRectMax; }
     NodeType type() const { return m_nodeType; }
@@ -123,6 +127,9 @@ public:
     QRegion dirtyRegion() const;
 
 private:
+    bool needsPainting() const;
+    void paint(QPainter *painter, const QRegion &clip, const QPoint &origin, bool forceOpaquePainting) const;
+
     union RenderableNodeHandle {
         QSGNode *node;
         QSGSimpleRectNode *simpleRectNode;
@@ -146,21 +146,25 @@ void QSGSoftwareRenderer::render()
         m_paintDevice = m_backingStore->paintDevice();
     }
 
-    QPainter painter(m_paintDevice);
-    painter.setRenderHint(QPainter::Antialiasing);
-    auto rc = static_cast<QSGSoftwareRenderContext *>(context());
-    QPainter *prevPainter = rc->m_activePainter;
-    rc->m_activePainter = &painter;
-
     // Render the contents Renderlist
-    m_flushRegion = renderNodes(&painter);
+    if (canRenderTiled(m_paintDevice, updateRegion)) {
+        m_flushRegion = renderNodesTiled(static_cast<QImage *>(m_paintDevice), updateRegion);
+    } else {
+        QPainter painter(m_paintDevice);
+        painter.setRenderHint(QPainter::Antialiasing);
+        auto rc = static_cast<QSGSoftwareRenderContext *>(context());
+        QPainter *prevPainter = rc->m_activePainter;
+        rc->m_activePainter = &painter;
+
+        m_flushRegion = renderNodes(&painter);
+
+        painter.end();
+        rc->m_activePainter = prevPainter;
+    }
     qint64 renderTime = renderTimer.elapsed();
 
-    painter.end();
     if (m_backingStore != nullptr)
         m_backingStore->endPaint();
-
-    rc->m_activePainter = prevPainter;
     qCDebug(lcRenderer) << "render" << m_flushRegion << buildRenderListTime << optimizeRenderListTime << renderTime;
 }
 
@@ -49,11 +49,133 @@
 
 #include <private/qquickprofiler_p.h>
 #include <QElapsedTimer>
+#include <QCryptographicHash>
+#include <QFile>
+#include <QLockFile>
+#include <QRunnable>
+#include <QSemaphore>
+#include <QStandardPaths>
+#include <QThread>
+#include <QThreadPool>
 
 QT_BEGIN_NAMESPACE
 
 static QElapsedTimer qsg_render_timer;
 
+QSGDistanceFieldDiskCache::QSGDistanceFieldDiskCache(const QString &fileName, const QByteArray &key)
+    : m_file(fileName)
+    , m_header(QByteArrayLiteral("QSGDF\x01\0\0") + key)
+{
+    if (!m_file.open(QIODevice::ReadOnly))
+        return;
+    const qint64 size = m_file.size();
+    m_data = size > m_header.size() ? m_file.map(0, size) : nullptr;
+    if (!m_data || memcmp(m_data, m_header.constData(), m_header.size()) != 0) {
+        m_data = nullptr;
+        m_file.close();
+        return;
+    }
+
+    qint64 offset = m_header.size();
+    while (offset + qint64(sizeof(Record)) <= size) {
+        Record record;
+        memcpy(&record, m_data + offset, sizeof(Record));
+        const qint64 end = offset + qint64(sizeof(Record)) + qint64(record.width) * record.height;
+        if (end > size)
+            break;
+        m_offsets.insert(record.glyph, offset);
+        offset = end;
+    }
+}
+
+bool QSGDistanceFieldDiskCache::find(glyph_t glyph, const QPainterPath &path, bool doubleResolution,
+                                     QDistanceField *field) const
+{
+    const auto it = m_offsets.constFind(glyph);
+    if (it == m_offsets.constEnd())
+        return false;
+    Record record;
+    memcpy(&record, m_data + *it, sizeof(Record));
+
+    // A single line across the bounds gives a field of the right size, which is cheaper to
+    // make than the glyph's. Two moveTo()s would not do, the second replaces the first.
+    const QRectF bounds = path.boundingRect();
+    QPainterPath boundsPath;
+    boundsPath.moveTo(bounds.topLeft());
+    boundsPath.lineTo(bounds.bottomRight());
+    QDistanceField restored(boundsPath, glyph, doubleResolution);
+    if (restored.width() != int(record.width) || restored.height() != int(record.height))
+        return false;
+    memcpy(restored.bits(), m_data + *it + sizeof(Record), size_t(record.width) * record.height);
+    *field = restored;
+    return true;
+}
+
+void QSGDistanceFieldDiskCache::store(const QVector<QDistanceField> &fields)
+{
+    QByteArray data;
+    for (const QDistanceField &field : fields) {
+        if (field.isNull() || contains(field.glyph()))
+            continue;
+        const Record record = { field.glyph(), quint32(field.width()), quint32(field.height()) };
+        data.append(reinterpret_cast<const char *>(&record), sizeof(Record));
+        data.append(reinterpret_cast<const char *>(field.constBits()), field.width() * field.height());
+        m_stored.insert(field.glyph());
+    }
+    if (data.isEmpty())
+        return;
+
+    // Processes sharing the cache take turns, so that only the one creating the file writes
+    // the header and records never interleave. The cache is only an optimization, so give up
+    // rather than wait long for another process.
+    QLockFile lock(m_file.fileName() + QLatin1String(".lock"));
+    if (!lock.tryLock(100))
+        return;
+    QFile file(m_file.fileName());
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Append))
+        return;
+    if (file.size() == 0)
+        data.prepend(m_header);
+    file.write(data);
+}
+
+static QString qsg_distanceFieldDiskCachePath()
+{
+    static const QString path = qEnvironmentVariableIntValue("QSG_DISTANCEFIELD_DISK_CACHE") > 0
+            ? QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + QLatin1String("/qsgdistancefields/")
+            : QString();
+    return path;
+}
+
+namespace {
+class QSGDistanceFieldRunner : public QRunnable
+{
+public:
+    QSGDistanceFieldRunner(QDistanceField *fields, const QPainterPath *paths, const glyph_t *glyphs,
+                           int count, bool doubleResolution, QSemaphore *done)
+        : m_fields(fields), m_paths(paths), m_glyphs(glyphs), m_count(count)
+        , m_doubleResolution(doubleResolution), m_done(done)
+    {}
+
+    void run() override
+    {
+        for (int i = 0; i < m_count; ++i)
+            m_fields[i] = QDistanceField(m_paths[i], m_glyphs[i], m_doubleResolution);
+        m_done->release();
+    }
+
+private:
+    QDistanceField *m_fields;
+    const QPainterPath *m_paths;
+    const glyph_t *m_glyphs;
+    int m_count;
+    bool m_doubleResolution;
+    QSemaphore *m_done;
+};
+}
+
+Q_GLOBAL_STATIC(QThreadPool, qsg_distancefield_pool)
+
 QSGDistanceFieldGlyphCache::Texture QSGDistanceFieldGlyphCache::s_emptyTexture;
 
 QSGDistanceFieldGlyphCache::QSGDistanceFieldGlyphCache(const QRawFont &font)
@@ -77,6 +199,42 @@ QSGDistanceFieldGlyphCache::~QSGDistanceFieldGlyphCache()
 {
 }
 
+/*!
+    \internal
+
+    The on-disk cache of this font's distance fields, if QSG_DISTANCEFIELD_DISK_CACHE is
+    set. The font is identified by its 'head' table, which includes the checksum of the
+    whole font file, so fonts without one are not cached.
+*/
+QSGDistanceFieldDiskCache *QSGDistanceFieldGlyphCache::diskCache()
+{
+    if (m_diskCacheChecked)
+        return m_diskCache.data();
+    m_diskCacheChecked = true;
+
+    const QString dir = qsg_distanceFieldDiskCachePath();
+    if (dir.isEmpty())
+        return nullptr;
+    const QByteArray head = m_referenceFont.fontTable("head");
+    if (head.isEmpty())
+        return nullptr;
+
+    QCryptographicHash hash(QCryptographicHash::Md5);
+    hash.addData(QT_VERSION_STR);
+    hash.addData(head);
+    hash.addData(m_referenceFont.familyName().toUtf8());
+    hash.addData(m_referenceFont.styleName().toUtf8());
+    const int baseSize = QT_DISTANCEFIELD_BASEFONTSIZE(m_doubleGlyphResolution);
+    hash.addData(reinterpret_cast<const char *>(&baseSize), sizeof(baseSize));
+    hash.addData(reinterpret_cast<const char *>(&m_doubleGlyphResolution), sizeof(m_doubleGlyphResolution));
+    const QByteArray key = hash.result();
+
+    if (!QDir().mkpath(dir))
+        return nullptr;
+    m_diskCache.reset(new QSGDistanceFieldDiskCache(dir + QString::fromLatin1(key.toHex()), key));
+    return m_diskCache.data();
+}
+
 QSGDistanceFieldGlyphCache::GlyphData &QSGDistanceFieldGlyphCache::emptyData(glyph_t glyph)
 {
     GlyphData gd;
@@ -174,17 +332,60 @@ void QSGDistanceFieldGlyphCache::update()
         qsg_render_timer.start();
     Q_QUICK_SG_PROFILE_START(QQuickProfiler::SceneGraphAdaptationLayerFrame);
 
-    QList<QDistanceField> distanceFields;
     const int pendingGlyphsSize = m_pendingGlyphs.size();
-    distanceFields.reserve(pendingGlyphsSize);
+    QVector<QDistanceField> distanceFields(pendingGlyphsSize);
+    QVector<QPainterPath> paths;
+    QVector<glyph_t> glyphs;
+    QVector<int> generated;
+    paths.reserve(pendingGlyphsSize);
+    glyphs.reserve(pendingGlyphsSize);
+    generated.reserve(pendingGlyphsSize);
+
+    // Glyphs found in the disk cache don't need to be generated again
+    QSGDistanceFieldDiskCache *disk = diskCache();
+    int cachedCount = 0;
     for (int i = 0; i < pendingGlyphsSize; ++i) {
-        GlyphData &gd = glyphData(m_pendingGlyphs.at(i));
-        distanceFields.append(QDistanceField(gd.path,
-                                             m_pendingGlyphs.at(i),
-                                             m_doubleGlyphResolution));
+        const glyph_t glyph = m_pendingGlyphs.at(i);
+        GlyphData &gd = glyphData(glyph);
+        if (disk && disk->find(glyph, gd.path, m_doubleGlyphResolution, &distanceFields[i])) {
+            ++cachedCount;
+        } else {
+            paths.append(gd.path);
+            glyphs.append(glyph);
+            generated.append(i);
+        }
         gd.path = QPainterPath(); // no longer needed, so release memory used by the painter path
     }
 
+    qint64 diskTime = 0;
+    if (profileFrames)
+        diskTime = qsg_render_timer.nsecsElapsed();
+
+    // Generate the rest on the calling thread and the distance field pool, in contiguous ranges
+    QVector<QDistanceField> fields(generated.size());
+    const int threads = qBound(1, generated.size() / 4, QThread::idealThreadCount());
+    if (threads > 1) {
+        QThreadPool *pool = qsg_distancefield_pool();
+        pool->setMaxThreadCount(qMax(pool->maxThreadCount(), threads - 1));
+        QSemaphore done;
+        const int count = generated.size();
+        for (int t = 1; t < threads; ++t) {
+            const int begin = count * t / threads;
+            const int end = count * (t + 1) / threads;
+            pool->start(new QSGDistanceFieldRunner(fields.data() + begin, paths.constData() + begin,
+                                                   glyphs.constData() + begin, end - begin,
+                                                   m_doubleGlyphResolution, &done));
+        }
+        QSGDistanceFieldRunner(fields.data(), paths.constData(), glyphs.constData(), count / threads,
+                               m_doubleGlyphResolution, &done).run();
+        done.acquire(threads);
+    } else {
+        for (int i = 0; i < generated.size(); ++i)
+            fields[i] = QDistanceField(paths.at(i), glyphs.at(i), m_doubleGlyphResolution);
+    }
+    for (int i = 0; i < generated.size(); ++i)
+        distanceFields[generated.at(i)] = fields.at(i);
+
     qint64 renderTime = 0;
     int count = m_pendingGlyphs.size();
     if (profileFrames)
@@ -194,7 +395,14 @@ void QSGDistanceFieldGlyphCache::update()
 
     m_pendingGlyphs.reset();
 
-    storeGlyphs(distanceFields);
+    if (disk)
+        disk->store(fields);
+
+    qint64 storeTime = 0;
+    if (profileFrames)
+        storeTime = qsg_render_timer.nsecsElapsed();
+
+    storeGlyphs(distanceFields.toList());
 
 #if defined(QSG_DISTANCEFIELD_CACHE_DEBUG)
     for (Texture texture : qAsConst(m_textures))
@@ -204,11 +412,16 @@ void QSGDistanceFieldGlyphCache::update()
     if (QSG_LOG_TIME_GLYPH().isDebugEnabled()) {
         quint64 now = qsg_render_timer.elapsed();
         qCDebug(QSG_LOG_TIME_GLYPH,
-                "distancefield: %d glyphs prepared in %dms, rendering=%d, upload=%d",
+                "distancefield: %d glyphs prepared in %dms, rendering=%d (%d threads), upload=%d, "
+                "disk cache: %d glyphs read in %dms, written in %dms",
                 count,
                 (int) now,
-                int(renderTime / 1000000),
-                int((now - (renderTime / 1000000))));
+                int((renderTime - diskTime) / 1000000),
+                threads,
+                int(now - (storeTime / 1000000)),
+                cachedCount,
+                int(diskTime / 1000000),
+                int((storeTime - renderTime) / 1000000));
     }
     Q_QUICK_SG_PROFILE_END_WITH_PAYLOAD(QQuickProfiler::SceneGraphAdaptationLayerFrame,
                                         QQuickProfiler::SceneGraphAdaptationLayerGlyphStore,
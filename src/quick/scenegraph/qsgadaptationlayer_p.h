@@ -58,8 +58,12 @@
 #include <QtGui/qbrush.h>
 #include <QtGui/qcolor.h>
 #include <QtCore/qsharedpointer.h>
+#include <QtCore/qscopedpointer.h>
 #include <QtGui/qglyphrun.h>
 #include <QtCore/qurl.h>
+#include <QtCore/qfile.h>
+#include <QtCore/qhash.h>
+#include <QtCore/qset.h>
 #include <private/qfontengine_p.h>
 #include <QtGui/private/qdatabuffer_p.h>
 #include <private/qdistancefield_p.h>
@@ -408,6 +412,37 @@ public:
 };
 typedef QIntrusiveList<QSGDistanceFieldGlyphConsumer, &QSGDistanceFieldGlyphConsumer::node> QSGDistanceFieldGlyphConsumerList;
 
+/*
+    Distance fields of glyphs generated in earlier runs, one file per font and resolution:
+    a header, followed by records of glyph index, width, height and the field itself. The
+    file is only ever appended to, and records cut short by a crash are ignored.
+
+    Fields are looked up by glyph and recreated from the outline's bounding rect, which
+    determines their size, so the size has to match for a record to be used.
+*/
+class Q_QUICK_PRIVATE_EXPORT QSGDistanceFieldDiskCache
+{
+public:
+    QSGDistanceFieldDiskCache(const QString &fileName, const QByteArray &key);
+
+    bool find(glyph_t glyph, const QPainterPath &path, bool doubleResolution, QDistanceField *field) const;
+    void store(const QVector<QDistanceField> &fields);
+    bool contains(glyph_t glyph) const { return m_offsets.contains(glyph) || m_stored.contains(glyph); }
+
+private:
+    struct Record {
+        quint32 glyph;
+        quint32 width;
+        quint32 height;
+    };
+
+    QFile m_file;
+    QByteArray m_header;
+    const uchar *m_data = nullptr;
+    QHash<glyph_t, qint64> m_offsets;
+    QSet<glyph_t> m_stored;
+};
+
 class Q_QUICK_PRIVATE_EXPORT QSGDistanceFieldGlyphCache
 {
 public:
@@ -518,6 +553,10 @@ protected:
     QRawFont m_referenceFont;
 
 private:
+    QSGDistanceFieldDiskCache *diskCache();
+
+    QScopedPointer<QSGDistanceFieldDiskCache> m_diskCache;
+    bool m_diskCacheChecked = false;
     int m_glyphCount;
     QList<Texture> m_textures;
     QHash<glyph_t, GlyphData> m_glyphsData;
@@ -66,6 +66,7 @@
 #include <QtCore/qpoint.h>
 #include <QtCore/qsize.h>
 #include <QtCore/qmath.h>
+#include <QtGui/qvector3d.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -2547,6 +2548,87 @@ QQmlListProperty<QObject> QQuickPropertyAnimation::exclude()
     return QQmlListProperty<QObject>(this, d->exclude);
 }
 
+// These match the interpolators QVariantAnimation uses for the types
+template <typename T>
+static inline T qquick_interpolate(const T &from, const T &to, qreal progress)
+{
+    return T(from + (to - from) * progress);
+}
+
+template <>
+inline QColor qquick_interpolate(const QColor &from, const QColor &to, qreal progress)
+{
+    return QColor(qBound(0, qquick_interpolate(from.red(), to.red(), progress), 255),
+                  qBound(0, qquick_interpolate(from.green(), to.green(), progress), 255),
+                  qBound(0, qquick_interpolate(from.blue(), to.blue(), progress), 255),
+                  qBound(0, qquick_interpolate(from.alpha(), to.alpha(), progress), 255));
+}
+
+template <>
+inline QRectF qquick_interpolate(const QRectF &from, const QRectF &to, qreal progress)
+{
+    return QRectF(qquick_interpolate(from.x(), to.x(), progress),
+                  qquick_interpolate(from.y(), to.y(), progress),
+                  qquick_interpolate(from.width(), to.width(), progress),
+                  qquick_interpolate(from.height(), to.height(), progress));
+}
+
+template <typename T>
+static inline void qquick_writeInterpolated(QObject *object, const QQmlPropertyData &property,
+                                            const QQuickStateAction &action, qreal progress)
+{
+    T value = qquick_interpolate(*static_cast<const T *>(action.fromValue.constData()),
+                                 *static_cast<const T *>(action.toValue.constData()), progress);
+    property.writeProperty(object, &value, QQmlPropertyData::BypassInterceptor | QQmlPropertyData::DontRemoveBinding);
+}
+
+/*
+    Interpolates and writes the value of a plain property of one of the common types without
+    going through QVariant, which is what QQmlPropertyPrivate::write() ends up doing for them.
+    Returns false if the property or the values don't qualify.
+*/
+static bool qquick_interpolateTyped(const QQuickStateAction &action, qreal progress)
+{
+    const QQmlPropertyPrivate *p = QQmlPropertyPrivate::get(action.property);
+    if (!p || !p->object || p->valueTypeData.isValid())
+        return false;
+    const QQmlPropertyData &core = p->core;
+    if (!core.isValid() || !core.isWritable() || core.isFunction() || core.isEnum() || core.isQList())
+        return false;
+    const int type = core.propType();
+    if (action.fromValue.userType() != type || action.toValue.userType() != type)
+        return false;
+
+    switch (type) {
+    case QMetaType::Double:
+        qquick_writeInterpolated<double>(p->object, core, action, progress);
+        return true;
+    case QMetaType::Float:
+        qquick_writeInterpolated<float>(p->object, core, action, progress);
+        return true;
+    case QMetaType::Int:
+        qquick_writeInterpolated<int>(p->object, core, action, progress);
+        return true;
+    case QMetaType::QColor:
+        qquick_writeInterpolated<QColor>(p->object, core, action, progress);
+        return true;
+    case QMetaType::QPointF:
+        qquick_writeInterpolated<QPointF>(p->object, core, action, progress);
+        return true;
+    case QMetaType::QSizeF:
+        qquick_writeInterpolated<QSizeF>(p->object, core, action, progress);
+        return true;
+    case QMetaType::QRectF:
+        qquick_writeInterpolated<QRectF>(p->object, core, action, progress);
+        return true;
+    case QMetaType::QVector3D:
+        qquick_writeInterpolated<QVector3D>(p->object, core, action, progress);
+        return true;
+    default:
+        return false;
+    }
+}
+
 void QQuickAnimationPropertyUpdater::setValue(qreal v)
 {
     bool deleted = false;
@@ -2565,6 +2647,11 @@ void QQuickAnimationPropertyUpdater::setValue(qreal v)
                     QQuickPropertyAnimationPrivate::convertVariant(action.fromValue, interpolatorType);
                 }
             }
+            if (typedInterpolation && qquick_interpolateTyped(action, v)) {
+                if (deleted)
+                    return;
+                continue;
+            }
             if (!interpolatorType) {
                 int propType = action.property.propertyType();
                 if (!prevInterpolatorType || prevInterpolatorType != propType) {
@@ -2722,6 +2809,9 @@ QAbstractAnimationJob* QQuickPropertyAnimation::transition(QQuickStateActions &a
         QQuickAnimationPropertyUpdater *data = new QQuickAnimationPropertyUpdater;
         data->interpolatorType = d->interpolatorType;
         data->interpolator = d->interpolator;
+        // RotationAnimation's directions use their own interpolators
+        data->typedInterpolation = !d->interpolatorType
+                || d->interpolator == QVariantAnimationPrivate::getInterpolator(d->interpolatorType);
         data->reverse = direction == Backward ? true : false;
         data->fromSourced = false;
         data->fromDefined = d->fromIsDefined;
@@ -306,7 +306,7 @@ public:
 class Q_AUTOTEST_EXPORT QQuickAnimationPropertyUpdater : public QQuickBulkValueUpdater
 {
 public:
-    QQuickAnimationPropertyUpdater() : interpolatorType(0), interpolator(nullptr), prevInterpolatorType(0), reverse(false), fromSourced(false), fromDefined(false), wasDeleted(nullptr) {}
+    QQuickAnimationPropertyUpdater() : interpolatorType(0), interpolator(nullptr), prevInterpolatorType(0), reverse(false), fromSourced(false), fromDefined(false), typedInterpolation(false), wasDeleted(nullptr) {}
     ~QQuickAnimationPropertyUpdater() override;
 
     void setValue(qreal v) override;
@@ -320,6 +320,7 @@ public:
     bool reverse;
     bool fromSourced;
     bool fromDefined;
+    bool typedInterpolation;    //values of common types are interpolated without QVariant
     bool *wasDeleted;
 };
 
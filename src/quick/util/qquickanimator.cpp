@@ -232,18 +232,18 @@ void QQuickAnimatorPrivate::apply(QQuickAnimatorJob *job,
             job->setTarget(qobject_cast<QQuickItem *>(action.property.object()));
 
             if (isFromDefined)
-                job->setFrom(from);
+                setJobFrom(job, QVariant());
             else if (action.fromValue.isValid())
-                job->setFrom(action.fromValue.toReal());
+                setJobFrom(job, action.fromValue);
             else
-                job->setFrom(action.property.read().toReal());
+                setJobFrom(job, action.property.read());
 
             if (isToDefined)
-                job->setTo(to);
+                setJobTo(job, QVariant());
             else if (action.toValue.isValid())
-                job->setTo(action.toValue.toReal());
+                setJobTo(job, action.toValue);
             else
-                job->setTo(action.property.read().toReal());
+                setJobTo(job, action.property.read());
 
             // This magic line is in sync with what PropertyAnimation does
             // and prevents the animation to end up in the "completeList"
@@ -255,8 +255,8 @@ void QQuickAnimatorPrivate::apply(QQuickAnimatorJob *job,
 
     if (modified.isEmpty()) {
         job->setTarget(target);
-        job->setFrom(from);
-        job->setTo(to);
+        setJobFrom(job, QVariant());
+        setJobTo(job, QVariant());
     }
 
     if (!job->target()) {
@@ -271,6 +271,16 @@ void QQuickAnimatorPrivate::apply(QQuickAnimatorJob *job,
     job->setEasingCurve(easing);
 }
 
+void QQuickAnimatorPrivate::setJobFrom(QQuickAnimatorJob *job, const QVariant &value) const
+{
+    job->setFrom(value.isValid() ? value.toReal() : from);
+}
+
+void QQuickAnimatorPrivate::setJobTo(QQuickAnimatorJob *job, const QVariant &value) const
+{
+    job->setTo(value.isValid() ? value.toReal() : to);
+}
+
 QAbstractAnimationJob *QQuickAnimator::transition(QQuickStateActions &actions,
                                                   QQmlProperties &modified,
                                                   TransitionDirection direction,
@@ -504,6 +514,140 @@ QQuickRotationAnimator::RotationDirection QQuickRotationAnimator::direction() co
     return d->direction;
 }
 
+/*!
+    \qmltype ColorAnimator
+    \instantiates QQuickColorAnimator
+    \inqmlmodule QtQuick
+    \since 5.12
+    \ingroup qtquick-transitions-animations
+    \inherits Animator
+    \brief The ColorAnimator type animates the color of a Rectangle.
+
+    \l{Animator} types are different from normal Animation types. When
+    using an Animator, the animation can be run in the render thread
+    and the property value will jump to the end when the animation is
+    complete.
+
+    The value of Rectangle::color is updated after the animation has finished.
+
+    Besides \l Rectangle, the animator can target custom items whose paint
+    node is a QSGGeometryNode with a QSGFlatColorMaterial. For those, the
+    material's color is animated.
+
+    The color animators of an item update its scene graph node once per frame,
+    so animating both the color and the border color of a Rectangle with a
+    ColorAnimator and a \l BorderColorAnimator costs a single node update.
+
+    \qml
+    Rectangle {
+        width: 100; height: 100
+        color: "white"
+        ColorAnimator on color { from: "white"; to: "red"; duration: 500; loops: Animation.Infinite }
+    }
+    \endqml
+
+    \sa ColorAnimation, BorderColorAnimator
+ */
+
+QQuickColorAnimator::QQuickColorAnimator(QObject *parent)
+    : QQuickAnimator(*new QQuickColorAnimatorPrivate, parent)
+{
+}
+
+QQuickColorAnimator::QQuickColorAnimator(QQuickColorAnimatorPrivate &dd, QObject *parent)
+    : QQuickAnimator(dd, parent)
+{
+}
+
+QQuickAnimatorJob *QQuickColorAnimator::createJob() const
+{
+    return new QQuickColorAnimatorJob(QQuickColorAnimatorJob::Color);
+}
+
+/*!
+    \qmlproperty color QtQuick::ColorAnimator::from
+    This property holds the color value at which the animation should begin.
+
+    If it is not set, the animation starts at the current color of the target.
+*/
+QColor QQuickColorAnimator::from() const
+{
+    Q_D(const QQuickColorAnimator);
+    return d->fromColor;
+}
+
+void QQuickColorAnimator::setFrom(const QColor &from)
+{
+    Q_D(QQuickColorAnimator);
+    d->isFromDefined = from.isValid();
+    d->fromColor = from;
+}
+
+/*!
+    \qmlproperty color QtQuick::ColorAnimator::to
+    This property holds the color value at which the animation should end.
+*/
+QColor QQuickColorAnimator::to() const
+{
+    Q_D(const QQuickColorAnimator);
+    return d->toColor;
+}
+
+void QQuickColorAnimator::setTo(const QColor &to)
+{
+    Q_D(QQuickColorAnimator);
+    d->isToDefined = true;
+    d->toColor = to;
+}
+
+void QQuickColorAnimatorPrivate::setJobFrom(QQuickAnimatorJob *job, const QVariant &value) const
+{
+    static_cast<QQuickColorAnimatorJob *>(job)->setFromColor(value.isValid() ? value.value<QColor>() : fromColor);
+}
+
+void QQuickColorAnimatorPrivate::setJobTo(QQuickAnimatorJob *job, const QVariant &value) const
+{
+    static_cast<QQuickColorAnimatorJob *>(job)->setToColor(value.isValid() ? value.value<QColor>() : toColor);
+}
+
+/*!
+    \qmltype BorderColorAnimator
+    \instantiates QQuickBorderColorAnimator
+    \inqmlmodule QtQuick
+    \since 5.12
+    \ingroup qtquick-transitions-animations
+    \inherits ColorAnimator
+    \brief The BorderColorAnimator type animates the border color of a Rectangle.
+
+    \l{Animator} types are different from normal Animation types. When
+    using an Animator, the animation can be run in the render thread
+    and the property value will jump to the end when the animation is
+    complete.
+
+    The value of Rectangle::border.color is updated after the animation has
+    finished.
+
+    \qml
+    Rectangle {
+        width: 100; height: 100
+        border.width: 4
+        BorderColorAnimator on border.color { from: "black"; to: "yellow"; duration: 500 }
+    }
+    \endqml
+
+    \sa ColorAnimator
+ */
+
+QQuickBorderColorAnimator::QQuickBorderColorAnimator(QObject *parent)
+    : QQuickColorAnimator(parent)
+{
+}
+
+QQuickAnimatorJob *QQuickBorderColorAnimator::createJob() const
+{
+    return new QQuickColorAnimatorJob(QQuickColorAnimatorJob::BorderColor);
+}
+
 #if QT_CONFIG(quick_shadereffect) && QT_CONFIG(opengl)
 /*!
     \qmltype UniformAnimator
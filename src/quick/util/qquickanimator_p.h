@@ -170,6 +170,39 @@ protected:
     QString propertyName() const override { return QStringLiteral("rotation"); }
 };
 
+class QQuickColorAnimatorPrivate;
+class Q_QUICK_PRIVATE_EXPORT QQuickColorAnimator : public QQuickAnimator
+{
+    Q_OBJECT
+    Q_DECLARE_PRIVATE(QQuickColorAnimator)
+    Q_PROPERTY(QColor from READ from WRITE setFrom)
+    Q_PROPERTY(QColor to READ to WRITE setTo)
+
+public:
+    QQuickColorAnimator(QObject *parent = nullptr);
+
+    QColor from() const;
+    void setFrom(const QColor &from);
+
+    QColor to() const;
+    void setTo(const QColor &to);
+
+protected:
+    QQuickColorAnimator(QQuickColorAnimatorPrivate &dd, QObject *parent);
+    QQuickAnimatorJob *createJob() const override;
+    QString propertyName() const override { return QStringLiteral("color"); }
+};
+
+class Q_QUICK_PRIVATE_EXPORT QQuickBorderColorAnimator : public QQuickColorAnimator
+{
+    Q_OBJECT
+public:
+    QQuickBorderColorAnimator(QObject *parent = nullptr);
+protected:
+    QQuickAnimatorJob *createJob() const override;
+    QString propertyName() const override { return QStringLiteral("border.color"); }
+};
+
 #if QT_CONFIG(quick_shadereffect) && QT_CONFIG(opengl)
 class QQuickUniformAnimatorPrivate;
 class Q_QUICK_PRIVATE_EXPORT QQuickUniformAnimator : public QQuickAnimator
@@ -201,6 +234,8 @@ QML_DECLARE_TYPE(QQuickYAnimator)
 QML_DECLARE_TYPE(QQuickScaleAnimator)
 QML_DECLARE_TYPE(QQuickRotationAnimator)
 QML_DECLARE_TYPE(QQuickOpacityAnimator)
+QML_DECLARE_TYPE(QQuickColorAnimator)
+QML_DECLARE_TYPE(QQuickBorderColorAnimator)
 #if QT_CONFIG(quick_shadereffect) && QT_CONFIG(opengl)
 QML_DECLARE_TYPE(QQuickUniformAnimator)
 #endif
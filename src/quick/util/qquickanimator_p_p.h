@@ -83,6 +83,10 @@ public:
     uint isToDefined : 1;
 
     void apply(QQuickAnimatorJob *job, const QString &propertyName, QQuickStateActions &actions, QQmlProperties &modified, QObject *defaultTarget);
+
+    // An invalid value stands for the animator's own from or to
+    virtual void setJobFrom(QQuickAnimatorJob *job, const QVariant &value) const;
+    virtual void setJobTo(QQuickAnimatorJob *job, const QVariant &value) const;
 };
 
 class QQuickRotationAnimatorPrivate : public QQuickAnimatorPrivate
@@ -95,6 +99,16 @@ public:
     QQuickRotationAnimator::RotationDirection direction;
 };
 
+class QQuickColorAnimatorPrivate : public QQuickAnimatorPrivate
+{
+public:
+    QColor fromColor;
+    QColor toColor;
+
+    void setJobFrom(QQuickAnimatorJob *job, const QVariant &value) const override;
+    void setJobTo(QQuickAnimatorJob *job, const QVariant &value) const override;
+};
+
 class QQuickUniformAnimatorPrivate : public QQuickAnimatorPrivate
 {
 public:
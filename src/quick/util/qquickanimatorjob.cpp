@@ -50,22 +50,26 @@
 # include <private/qquickshadereffect_p.h>
 #endif
 #include <private/qanimationgroupjob_p.h>
+#include <private/qquickrectangle_p.h>
+#include <private/qsgadaptationlayer_p.h>
+#include <QtQuick/qsgflatcolormaterial.h>
 
 #include <qcoreapplication.h>
 #include <qdebug.h>
 
 QT_BEGIN_NAMESPACE
 
-struct QQuickTransformAnimatorHelperStore
+template <typename Helper>
+struct QQuickAnimatorHelperStore
 {
-    QHash<QQuickItem *, QQuickTransformAnimatorJob::Helper *> store;
+    QHash<QQuickItem *, Helper *> store;
     QMutex mutex;
 
-    QQuickTransformAnimatorJob::Helper *acquire(QQuickItem *item) {
+    Helper *acquire(QQuickItem *item) {
         mutex.lock();
-        QQuickTransformAnimatorJob::Helper *helper = store.value(item);
+        Helper *helper = store.value(item);
         if (!helper) {
-            helper = new QQuickTransformAnimatorJob::Helper();
+            helper = new Helper();
             helper->item = item;
             store[item] = helper;
         } else {
@@ -75,7 +79,7 @@ struct QQuickTransformAnimatorHelperStore
         return helper;
     }
 
-    void release(QQuickTransformAnimatorJob::Helper *helper) {
+    void release(Helper *helper) {
         mutex.lock();
         if (--helper->ref == 0) {
             store.remove(helper->item);
@@ -84,7 +88,8 @@ struct QQuickTransformAnimatorHelperStore
         mutex.unlock();
     }
 };
-Q_GLOBAL_STATIC(QQuickTransformAnimatorHelperStore, qquick_transform_animatorjob_helper_store);
+Q_GLOBAL_STATIC(QQuickAnimatorHelperStore<QQuickTransformAnimatorJob::Helper>, qquick_transform_animatorjob_helper_store);
+Q_GLOBAL_STATIC(QQuickAnimatorHelperStore<QQuickColorAnimatorJob::Helper>, qquick_color_animatorjob_helper_store);
 
 QQuickAnimatorProxyJob::QQuickAnimatorProxyJob(QAbstractAnimationJob *job, QObject *item)
     : m_controller(nullptr)
@@ -610,6 +615,171 @@ void QQuickOpacityAnimatorJob::updateCurrentTime(int time)
     m_opacityNode->setOpacity(m_value);
 }
 
+QQuickColorAnimatorJob::QQuickColorAnimatorJob(ColorRole role)
+    : m_role(role)
+    , m_helper(nullptr)
+{
+}
+
+QQuickColorAnimatorJob::~QQuickColorAnimatorJob()
+{
+    if (m_helper)
+        qquick_color_animatorjob_helper_store()->release(m_helper);
+}
+
+QColor QQuickColorAnimatorJob::targetColor() const
+{
+    if (m_role == BorderColor) {
+        if (QQuickRectangle *rectangle = qobject_cast<QQuickRectangle *>(m_target))
+            return rectangle->border()->color();
+        return QColor();
+    }
+    return m_target->property("color").value<QColor>();
+}
+
+void QQuickColorAnimatorJob::preSync()
+{
+    if (m_helper && (m_helper->item != m_target || !m_target)) {
+        qquick_color_animatorjob_helper_store()->release(m_helper);
+        m_helper = nullptr;
+    }
+
+    if (!m_target) {
+        invalidate();
+        return;
+    }
+
+    // The GUI thread is locked, so the target can be read
+    if (!m_fromColor.isValid())
+        m_fromColor = targetColor();
+
+    if (!m_helper)
+        m_helper = qquick_color_animatorjob_helper_store()->acquire(m_target);
+}
+
+void QQuickColorAnimatorJob::postSync()
+{
+    if (!m_target) {
+        invalidate();
+        return;
+    }
+
+    if (!m_helper)
+        return;
+
+    m_helper->sync();
+
+    // The sync may have written the item's own color to a node we already animated
+    if (m_colorValue.isValid()) {
+        if (m_role == Color)
+            m_helper->colorChanged = true;
+        else
+            m_helper->borderColorChanged = true;
+    }
+}
+
+void QQuickColorAnimatorJob::invalidate()
+{
+    if (m_helper)
+        m_helper->node = nullptr;
+}
+
+void QQuickColorAnimatorJob::Helper::sync()
+{
+    QSGNode *paintNode = QQuickItemPrivate::get(item)->paintNode;
+    isRectangle = qobject_cast<QQuickRectangle *>(item) != nullptr;
+    node = nullptr;
+    if (!paintNode)
+        return;
+
+    if (isRectangle) {
+        node = paintNode;
+    } else if (paintNode->type() == QSGNode::GeometryNodeType) {
+        // Any other item can have its color animated if it paints with a flat color material
+        static QSGFlatColorMaterial flatColorMaterial;
+        QSGMaterial *material = static_cast<QSGGeometryNode *>(paintNode)->material();
+        if (material && material->type() == flatColorMaterial.type())
+            node = paintNode;
+    }
+}
+
+void QQuickColorAnimatorJob::Helper::commit()
+{
+    if (!(colorChanged || borderColorChanged) || !node)
+        return;
+
+    if (isRectangle) {
+        QSGInternalRectangleNode *rectangle = static_cast<QSGInternalRectangleNode *>(node);
+        if (colorChanged)
+            rectangle->setColor(color);
+        if (borderColorChanged)
+            rectangle->setPenColor(borderColor);
+        rectangle->update();
+    } else if (colorChanged) {
+        QSGGeometryNode *geometryNode = static_cast<QSGGeometryNode *>(node);
+        static_cast<QSGFlatColorMaterial *>(geometryNode->material())->setColor(color);
+        geometryNode->markDirty(QSGNode::DirtyMaterial);
+    }
+
+    colorChanged = false;
+    borderColorChanged = false;
+}
+
+void QQuickColorAnimatorJob::commit()
+{
+    if (m_helper)
+        m_helper->commit();
+}
+
+void QQuickColorAnimatorJob::updateCurrentTime(int time)
+{
+#if QT_CONFIG(opengl)
+    Q_ASSERT(!m_controller || !m_controller->m_window->openglContext() || m_controller->m_window->openglContext()->thread() == QThread::currentThread());
+#endif
+    if (!m_helper)
+        return;
+
+    const qreal t = progress(time);
+    const QColor from = m_fromColor.toRgb();
+    const QColor to = m_toColor.toRgb();
+    m_colorValue = QColor::fromRgbF(from.redF() + (to.redF() - from.redF()) * t,
+                                    from.greenF() + (to.greenF() - from.greenF()) * t,
+                                    from.blueF() + (to.blueF() - from.blueF()) * t,
+                                    from.alphaF() + (to.alphaF() - from.alphaF()) * t);
+
+    if (m_role == Color) {
+        m_helper->color = m_colorValue;
+        m_helper->colorChanged = true;
+    } else {
+        m_helper->borderColor = m_colorValue;
+        m_helper->borderColorChanged = true;
+    }
+}
+
+QColor QQuickColorAnimatorJob::colorValue() const
+{
+    QColor value = m_toColor;
+    if (m_controller) {
+        m_controller->lock();
+        if (m_colorValue.isValid())
+            value = m_colorValue;
+        m_controller->unlock();
+    }
+    return value;
+}
+
+void QQuickColorAnimatorJob::writeBack()
+{
+    if (!m_target)
+        return;
+
+    if (m_role == BorderColor) {
+        if (QQuickRectangle *rectangle = qobject_cast<QQuickRectangle *>(m_target))
+            rectangle->border()->setColor(colorValue());
+    } else {
+        m_target->setProperty("color", colorValue());
+    }
+}
 
 #if QT_CONFIG(quick_shadereffect) && QT_CONFIG(opengl)
 QQuickUniformAnimatorJob::QQuickUniformAnimatorJob()
@@ -59,6 +59,7 @@
 #include <QtQuick/qquickitem.h>
 
 #include <QtCore/qeasingcurve.h>
+#include <QtGui/qcolor.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -72,6 +73,7 @@ class QQuickAnimatorProxyJobPrivate;
 class QQuickOpenGLShaderEffectNode;
 
 class QSGOpacityNode;
+class QSGNode;
 
 class Q_QUICK_PRIVATE_EXPORT QQuickAnimatorProxyJob : public QObject, public QAbstractAnimationJob
 {
@@ -289,6 +291,76 @@ public:
 private:
     QSGOpacityNode *m_opacityNode;
 };
+class Q_QUICK_PRIVATE_EXPORT QQuickColorAnimatorJob : public QQuickAnimatorJob
+{
+public:
+    enum ColorRole {
+        Color,
+        BorderColor
+    };
+
+    // Shared by the color animators of one item, so that a tick updates its node once
+    struct Helper
+    {
+        Helper()
+            : ref(1)
+            , item(nullptr)
+            , node(nullptr)
+            , isRectangle(false)
+            , colorChanged(false)
+            , borderColorChanged(false)
+        {
+        }
+
+        void sync();
+        void commit();
+
+        int ref;
+        QQuickItem *item;
+        QSGNode *node;
+
+        QColor color;
+        QColor borderColor;
+
+        uint isRectangle : 1;
+        uint colorChanged : 1;
+        uint borderColorChanged : 1;
+    };
+
+    QQuickColorAnimatorJob(ColorRole role);
+    ~QQuickColorAnimatorJob();
+
+    ColorRole role() const { return m_role; }
+
+    // An invalid from color starts the animation at the current color of the target
+    void setFromColor(const QColor &from) { m_fromColor = from; }
+    QColor fromColor() const { return m_fromColor; }
+
+    void setToColor(const QColor &to) { m_toColor = to; }
+    QColor toColor() const { return m_toColor; }
+
+    QColor colorValue() const;
+
+    void preSync() override;
+    void postSync() override;
+    void commit() override;
+
+    void updateCurrentTime(int time) override;
+    void writeBack() override;
+
+protected:
+    void invalidate() override;
+
+private:
+    QColor targetColor() const;
+
+    ColorRole m_role;
+    QColor m_fromColor;
+    QColor m_toColor;
+    QColor m_colorValue;
+    Helper *m_helper;
+};
+
 #if QT_CONFIG(opengl)
 class Q_QUICK_PRIVATE_EXPORT QQuickUniformAnimatorJob : public QQuickAnimatorJob
 {
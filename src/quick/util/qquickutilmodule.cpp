@@ -111,6 +111,8 @@ void QQuickUtilModule::defineModule()
     qmlRegisterType<QQuickScaleAnimator>("QtQuick", 2, 2, "ScaleAnimator");
     qmlRegisterType<QQuickRotationAnimator>("QtQuick", 2, 2, "RotationAnimator");
     qmlRegisterType<QQuickOpacityAnimator>("QtQuick", 2, 2, "OpacityAnimator");
+    qmlRegisterType<QQuickColorAnimator>("QtQuick", 2, 12, "ColorAnimator");
+    qmlRegisterType<QQuickBorderColorAnimator>("QtQuick", 2, 12, "BorderColorAnimator");
 #if QT_CONFIG(quick_shadereffect) && QT_CONFIG(opengl)
     qmlRegisterType<QQuickUniformAnimator>("QtQuick", 2, 2, "UniformAnimator");
 #endif
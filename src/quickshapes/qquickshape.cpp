@@ -838,6 +838,8 @@ void QQuickShape::setContainsMode(QQuickShape::ContainsMode containsMode)
         return;
 
     d->containsMode = containsMode;
+    // The paths are not confined to the item's own rectangle
+    d->setContainsBeyondBounds(containsMode == FillContains);
     emit containsModeChanged();
 }
 
@@ -0,0 +1,85 @@
+/****************************************************************************
+**
+** Copyright (C) 2016 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+import QtQuick 2.0
+import QtQuick.Particles 2.0
+
+Rectangle {
+    color: "black"
+    width: 320
+    height: 320
+
+    ParticleSystem {
+        id: sys
+        objectName: "system"
+        anchors.fill: parent
+        running: false //Test will manage it
+
+        ImageParticle {
+            source: "../../shared/star.png"
+        }
+
+        Emitter{
+            id: emitter
+            anchors.fill: parent
+            size: 8
+            lifeSpan: Emitter.InfiniteLife
+            enabled: false
+            velocity: AngleDirection { angleVariation: 360; magnitude: 40 }
+            acceleration: AngleDirection { angleVariation: 360; magnitude: 10 }
+            Component.onCompleted: emitter.burst(600);
+        }
+
+        //Disabled, the test runs them one at a time
+        Gravity {
+            objectName: "gravity"
+            enabled: false
+            x: 80
+            width: 160
+            height: 320
+            magnitude: 20
+            angle: 60
+        }
+
+        Friction {
+            objectName: "friction"
+            enabled: false
+            anchors.fill: parent
+            factor: 0.5
+            threshold: 30
+        }
+
+        Wander {
+            objectName: "wander"
+            enabled: false
+            pace: 200
+            xVariance: 60
+            yVariance: 60
+        }
+    }
+}
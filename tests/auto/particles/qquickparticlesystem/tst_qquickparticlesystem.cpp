@@ -29,7 +29,9 @@
 #include <QtTest/QtTest>
 #include "../shared/particlestestsshared.h"
 #include <private/qquickparticlesystem_p.h>
+#include <private/qquickparticleaffector_p.h>
 #include <private/qabstractanimation_p.h>
+#include <QtCore/qrandom.h>
 
 #include "../../shared/util.h"
 
@@ -43,6 +45,11 @@ private slots:
     void initTestCase();
     void test_basic();
     void test_affectorscrash();
+    void test_kinematicsStorage();
+    void test_batchedAffectors_data();
+    void test_batchedAffectors();
+    void test_collisions();
+    void test_threadedSimulation();
 };
 
 void tst_qquickparticlesystem::initTestCase()
@@ -86,6 +93,206 @@ void tst_qquickparticlesystem::test_affectorscrash()
     // This should have crashed by now
 }
 
+void tst_qquickparticlesystem::test_kinematicsStorage()
+{
+    QQuickView* view = createView(testFileUrl("basic.qml"), 600);
+    QQuickParticleSystem* system = view->rootObject()->findChild<QQuickParticleSystem*>("system");
+    ensureAnimTime(600, system->m_animation);
+
+    // The per particle data is a view on the structure-of-arrays storage of the group
+    QQuickParticleGroupData *gd = system->groupData[0];
+    QVERIFY(gd->kinematics.size() * QQuickParticleKinematicsBlock::Size >= gd->size());
+    for (int i = 0; i < gd->size(); ++i) {
+        QQuickParticleData *d = gd->data[i];
+        QQuickParticleKinematicsBlock *block = gd->kinematics[i / QQuickParticleKinematicsBlock::Size];
+        const int slot = i % QQuickParticleKinematicsBlock::Size;
+        QCOMPARE(&d->x, &block->values[QQuickParticleKinematicsBlock::X][slot]);
+        QCOMPARE(&d->t, &block->values[QQuickParticleKinematicsBlock::T][slot]);
+        QCOMPARE(&d->ay, &block->values[QQuickParticleKinematicsBlock::AY][slot]);
+    }
+
+    // Copies outside of a group have their own storage
+    QQuickParticleData copy(*gd->data[0]);
+    QCOMPARE(copy.lifeSpan, gd->data[0]->lifeSpan);
+    copy.vx = 42.f;
+    QVERIFY(gd->data[0]->vx != 42.f);
+    delete view;
+}
+
+void tst_qquickparticlesystem::test_batchedAffectors_data()
+{
+    QTest::addColumn<QString>("affector");
+    QTest::newRow("Gravity") << "gravity";
+    QTest::newRow("Friction") << "friction";
+    QTest::newRow("Wander") << "wander";
+}
+
+void tst_qquickparticlesystem::test_batchedAffectors()
+{
+    QFETCH(QString, affector);
+    QScopedPointer<QQuickView> view(createView(testFileUrl("batchedaffectors.qml")));
+    QQuickParticleSystem* system = view->rootObject()->findChild<QQuickParticleSystem*>("system");
+    //Pretend we're running, but we manually advance the simulation
+    system->m_running = true;
+    system->m_animation = 0;
+    system->reset();
+    system->updateCurrentTime(1);
+    system->updateCurrentTime(17);
+
+    QQuickParticleAffector *a = view->rootObject()->findChild<QQuickParticleAffector*>(affector);
+    QVERIFY(a);
+    QVERIFY(a->isBatched());
+    a->setEnabled(true);
+
+    QQuickParticleGroupData *gd = system->groupData[0];
+    QVERIFY(gd->size() > QQuickParticleKinematicsBlock::Size);
+    auto snapshot = [gd]() {
+        QVector<float> values;
+        for (QQuickParticleKinematicsBlock *block : qAsConst(gd->kinematics)) {
+            for (int f = 0; f < QQuickParticleKinematicsBlock::FieldCount; ++f)
+                for (int i = 0; i < QQuickParticleKinematicsBlock::Size; ++i)
+                    values << block->values[f][i];
+        }
+        return values;
+    };
+    auto restore = [gd](const QVector<float> &values) {
+        int v = 0;
+        for (QQuickParticleKinematicsBlock *block : qAsConst(gd->kinematics)) {
+            for (int f = 0; f < QQuickParticleKinematicsBlock::FieldCount; ++f)
+                for (int i = 0; i < QQuickParticleKinematicsBlock::Size; ++i)
+                    block->values[f][i] = values.at(v++);
+        }
+    };
+
+    // A frame shorter than a simulation step, so that both paths draw the random numbers in particle order
+    const QVector<float> before = snapshot();
+    system->timeInt = 33;
+    system->needsReset.clear();
+    QRandomGenerator::global()->seed(42);
+    a->affectSystem(0.016);
+    const QVector<float> batched = snapshot();
+    const int batchedResets = system->needsReset.size();
+    QVERIFY(batchedResets > 0);
+
+    restore(before);
+    system->needsReset.clear();
+    a->disableBatching();
+    QRandomGenerator::global()->seed(42);
+    a->affectSystem(0.016);
+    const QVector<float> perParticle = snapshot();
+    QCOMPARE(system->needsReset.size(), batchedResets);
+
+    // The batched kernels compute in float, the per particle path partly in qreal
+    int changed = 0;
+    for (int i = 0; i < gd->size(); ++i) {
+        const int block = i / QQuickParticleKinematicsBlock::Size;
+        const int slot = i % QQuickParticleKinematicsBlock::Size;
+        for (int f = 0; f < QQuickParticleKinematicsBlock::FieldCount; ++f) {
+            const int v = (block * QQuickParticleKinematicsBlock::FieldCount + f) * QQuickParticleKinematicsBlock::Size + slot;
+            const float expected = perParticle.at(v);
+            QVERIFY2(qAbs(batched.at(v) - expected) <= 0.001f * qMax(1.0f, qAbs(expected)),
+                     qPrintable(QString("particle %1, field %2: %3 batched, %4 per particle")
+                                .arg(i).arg(f).arg(batched.at(v)).arg(expected)));
+            if (expected != before.at(v))
+                changed++;
+        }
+    }
+    QVERIFY(changed > 0);
+}
+
+void tst_qquickparticlesystem::test_collisions()
+{
+    QQuickView* view = createView(testFileUrl("collisions.qml"), 600);
+    QQuickParticleSystem* system = view->rootObject()->findChild<QQuickParticleSystem*>("system");
+    ensureAnimTime(600, system->m_animation);
+
+    // Each frame hashes the colliding group once, and compares far fewer pairs than a full scan
+    QQuickParticleGroupData *a = system->groupData[system->groupIds["A"]];
+    QQuickParticleGroupData *b = system->groupData[system->groupIds["B"]];
+    const QQuickParticleSystem::CollisionStatistics &stats = system->collisionStatistics;
+    QVERIFY(stats.queries > 0);
+    QCOMPARE(stats.hashBuilds, 1);
+    QVERIFY(stats.candidates < stats.queries * b->size());
+
+    // The broad phase must not change which particles collide
+    QQuickParticleSpatialHash hash;
+    hash.build(b, system);
+    int colliding = 0;
+    for (QQuickParticleData *d : qAsConst(a->data)) {
+        if (!d->stillAlive(system))
+            continue;
+        qreal x = d->curX(system);
+        qreal y = d->curY(system);
+        qreal halfSize = d->curSize(system) / 2;
+        bool expected = false;
+        for (QQuickParticleData *other : qAsConst(b->data)) {
+            if (!other->stillAlive(system))
+                continue;
+            qreal otherX = other->curX(system);
+            qreal otherY = other->curY(system);
+            qreal otherHalfSize = other->curSize(system) / 2;
+            if (x + halfSize > otherX - otherHalfSize && x - halfSize < otherX + otherHalfSize
+                    && y + halfSize > otherY - otherHalfSize && y - halfSize < otherY + otherHalfSize) {
+                expected = true;
+                break;
+            }
+        }
+        int tested = 0;
+        QCOMPARE(hash.intersects(x, y, halfSize, &tested), expected);
+        QCOMPARE(system->isColliding(d, QStringList() << "B"), expected);
+        colliding += expected;
+    }
+    QVERIFY(colliding > 0);
+    delete view;
+}
+
+void tst_qquickparticlesystem::test_threadedSimulation()
+{
+    QScopedPointer<QQuickView> view(createView(testFileUrl("threaded.qml")));
+    QQuickParticleSystem* system = view->rootObject()->findChild<QQuickParticleSystem*>("system");
+    //Pretend we're running, but we manually advance the simulation
+    system->m_running = true;
+    system->m_animation = 0;
+    system->reset();
+    system->updateCurrentTime(1);
+    system->updateCurrentTime(17);
+
+    QQuickParticleGroupData *gd = system->groupData[0];
+    QVERIFY(gd->kinematics.size() > 4);
+    auto snapshot = [gd]() {
+        QVector<float> values;
+        for (QQuickParticleKinematicsBlock *block : qAsConst(gd->kinematics)) {
+            for (int f = 0; f < QQuickParticleKinematicsBlock::FieldCount; ++f)
+                for (int i = 0; i < QQuickParticleKinematicsBlock::Size; ++i)
+                    values << block->values[f][i];
+        }
+        return values;
+    };
+    auto restore = [gd](const QVector<float> &values) {
+        int v = 0;
+        for (QQuickParticleKinematicsBlock *block : qAsConst(gd->kinematics)) {
+            for (int f = 0; f < QQuickParticleKinematicsBlock::FieldCount; ++f)
+                for (int i = 0; i < QQuickParticleKinematicsBlock::Size; ++i)
+                    block->values[f][i] = values.at(v++);
+        }
+    };
+
+    // The same frame simulated on one and on several threads gives the same particles
+    const QVector<float> before = snapshot();
+    system->simulationThreads = 1;
+    system->updateCurrentTime(100);
+    const QVector<float> serial = snapshot();
+    const int serialResets = system->needsReset.size();
+    QVERIFY(serialResets > 0);
+
+    restore(before);
+    system->timeInt = 17;
+    system->simulationThreads = 4;
+    system->updateCurrentTime(100);
+    QCOMPARE(snapshot(), serial);
+    QCOMPARE(system->needsReset.size(), serialResets);
+}
+
 QTEST_MAIN(tst_qquickparticlesystem);
 
 #include "tst_qquickparticlesystem.moc"
@@ -145,9 +145,10 @@ bool Test262Runner::run()
             qDebug() << "Running in parallel with" << QThread::idealThreadCount() << "threads.";
     }
 
-    if (flags & ForceJIT)
+    if (flags & ForceJIT) {
         qputenv("QV4_JIT_CALL_THRESHOLD", QByteArray("0"));
-    else if (flags & ForceBytecode)
+        qputenv("QV4_JIT_SYNCHRONOUS", QByteArray("1"));
+    } else if (flags & ForceBytecode)
         qputenv("QV4_FORCE_INTERPRETER", QByteArray("1"));
 
     if (flags & WithTestExpectations)
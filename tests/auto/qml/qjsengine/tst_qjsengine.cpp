@@ -35,11 +35,14 @@
 #include <qgraphicsitem.h>
 #include <qstandarditemmodel.h>
 #include <QtCore/qnumeric.h>
+#include <QtCore/qbuffer.h>
 #include <qqmlengine.h>
 #include <qqmlcomponent.h>
 #include <stdlib.h>
+#include <limits>
 #include <private/qv4alloca_p.h>
 #include <private/qjsvalue_p.h>
+#include <private/qv4jsonobject_p.h>
 #include <QScopeGuard>
 
 #ifdef Q_CC_MSVC
@@ -128,6 +131,10 @@ private slots:
     void reentrancy_objectCreation();
     void jsIncDecNonObjectProperty();
     void JSONparse();
+    void JSONparseSameShapes();
+    void JSONstringify_data();
+    void JSONstringify();
+    void JSONstringifyToDevice();
     void arraySort();
     void lookupOnDisappearingProperty();
     void arrayConcat();
@@ -3036,6 +3043,115 @@ void tst_QJSEngine::JSONparse()
     QVERIFY(ret.isObject());
 }
 
+void tst_QJSEngine::JSONparseSameShapes()
+{
+    QJSEngine eng;
+    QJSValue ret = eng.evaluate(
+            "var json = '[{\"a\": 1, \"b\": \"x\"}, {\"a\": 2, \"b\": \"y\"},"
+            "             {\"a\": 3, \"c\": true}, {\"a\": 4, \"b\": \"z\", \"a\": 5},"
+            "             {\"\\\\u0061\": 6, \"b\": \"w\", \"0\": 7}, {\"a\": -12345678, \"b\": 1e3}]';\n"
+            "var list = JSON.parse(json);\n"
+            "JSON.stringify(list) + ' ' + Object.keys(list[3]).join(',') + ' ' + Object.keys(list[4]).join(',')");
+    QCOMPARE(ret.toString(), QStringLiteral(
+            "[{\"a\":1,\"b\":\"x\"},{\"a\":2,\"b\":\"y\"},{\"a\":3,\"c\":true},{\"a\":5,\"b\":\"z\"},"
+            "{\"0\":7,\"a\":6,\"b\":\"w\"},{\"a\":-12345678,\"b\":1000}] a,b 0,a,b"));
+}
+
+void tst_QJSEngine::JSONstringify_data()
+{
+    QTest::addColumn<QString>("code");
+    QTest::addColumn<QString>("expected");
+
+    QTest::newRow("same shapes")
+            << "JSON.stringify([{a: 1, b: 'x'}, {a: 2, b: 'y'}, {a: 3, c: undefined, b: 'z'}])"
+            << "[{\"a\":1,\"b\":\"x\"},{\"a\":2,\"b\":\"y\"},{\"a\":3,\"b\":\"z\"}]";
+    QTest::newRow("gap")
+            << "JSON.stringify({a: [1, {}], b: {c: []}}, null, 2)"
+            << "{\n  \"a\": [\n    1,\n    {}\n  ],\n  \"b\": {\n    \"c\": []\n  }\n}";
+    QTest::newRow("toJSON")
+            << "JSON.stringify({a: {toJSON: function(key) { return key + '!'; }}, b: [{toJSON: function(key) { return key; }}]})"
+            << "{\"a\":\"a!\",\"b\":[\"0\"]}";
+    QTest::newRow("replacer")
+            << "JSON.stringify({a: 1, b: 2, c: [3]}, function(key, value) { return key === 'b' ? undefined : value; })"
+            << "{\"a\":1,\"c\":[3]}";
+    QTest::newRow("property list")
+            << "JSON.stringify({a: 1, b: 2, c: 3}, ['c', 'a'])"
+            << "{\"c\":3,\"a\":1}";
+    QTest::newRow("accessor")
+            << "var o = {a: 1}; Object.defineProperty(o, 'b', {get: function() { return 2; }, enumerable: true});"
+               "Object.defineProperty(o, 'c', {value: 3}); JSON.stringify([o, {a: 4}])"
+            << "[{\"a\":1,\"b\":2},{\"a\":4}]";
+    QTest::newRow("changed by toJSON")
+            << "var o = {a: {toJSON: function() { delete o.b; return 1; }}, b: 2, c: 3}; JSON.stringify(o)"
+            << "{\"a\":1,\"c\":3}";
+    QTest::newRow("escapes")
+            << "JSON.stringify('\"\\\\\\n\\u0001\\u00e9')"
+            << "\"\\\"\\\\\\n\\u0001\u00e9\"";
+    QTest::newRow("holes and functions")
+            << "JSON.stringify([, function() {}, undefined, NaN, -0.5])"
+            << "[null,null,null,null,-0.5]";
+    QTest::newRow("cycle")
+            << "var a = []; for (var i = 0, o = a; i < 40; ++i) o = o[0] = [];"
+               "o.push(a); try { JSON.stringify(a); 'no error' } catch (e) { e instanceof TypeError }"
+            << "true";
+}
+
+void tst_QJSEngine::JSONstringify()
+{
+    QFETCH(QString, code);
+    QFETCH(QString, expected);
+
+    QJSEngine eng;
+    QJSValue ret = eng.evaluate(code);
+    QVERIFY2(!ret.isError(), qPrintable(ret.toString()));
+    QCOMPARE(ret.toString(), expected);
+}
+
+// Accepts maxWrites writes, and fails all further ones
+class FailingDevice : public QBuffer
+{
+public:
+    FailingDevice(int maxWrites) : maxWrites(maxWrites) {}
+
+    int writes = 0;
+    int maxWrites;
+
+protected:
+    qint64 writeData(const char *data, qint64 len) override
+    {
+        if (++writes > maxWrites)
+            return -1;
+        return QBuffer::writeData(data, len);
+    }
+};
+
+void tst_QJSEngine::JSONstringifyToDevice()
+{
+    QJSEngine eng;
+    QV4::ExecutionEngine *v4 = eng.handle();
+    // Large enough to be written out in several parts
+    QJSValue value = eng.evaluate("var list = []; for (var i = 0; i < 20000; ++i) list.push({index: i, text: 'abcdefghij'}); list");
+    QV4::Scope scope(v4);
+    QV4::ScopedValue v(scope, *QJSValuePrivate::getValue(&value));
+
+    {
+        FailingDevice device(std::numeric_limits<int>::max());
+        QVERIFY(device.open(QIODevice::WriteOnly));
+        QVERIFY(QV4::JsonObject::stringifyToUtf8(v4, v, &device));
+        QVERIFY(device.writes > 1);
+        QCOMPARE(device.data(), QV4::JsonObject::stringifyToUtf8(v4, v));
+    }
+
+    {
+        // Serialization stops at the first failed write
+        FailingDevice device(1);
+        QVERIFY(device.open(QIODevice::WriteOnly));
+        QVERIFY(!QV4::JsonObject::stringifyToUtf8(v4, v, &device));
+        QCOMPARE(device.writes, 2);
+        QVERIFY(!v4->hasException);
+    }
+}
+
 void tst_QJSEngine::arraySort()
 {
     // tests that calling Array.sort with a bad sort function doesn't cause issues
@@ -29,6 +29,7 @@
 #include <qtest.h>
 
 #include <private/qv4compileddata_p.h>
+#include <private/qv4compilationunitbundle_p.h>
 #include <private/qv4compiler_p.h>
 #include <private/qv8engine_p.h>
 #include <private/qv4engine_p.h>
@@ -41,6 +42,7 @@
 #include <QCryptographicHash>
 #include <QStandardPaths>
 #include <QDirIterator>
+#include <QScopeGuard>
 
 class tst_qmldiskcache: public QObject
 {
@@ -63,6 +65,8 @@ private slots:
     void singletonDependency();
     void cppRegisteredSingletonDependency();
     void cacheModuleScripts();
+    void cacheBundle();
+    void contentHashValidation();
 
 private:
     QDir m_qmlCacheDirectory;
@@ -941,6 +945,125 @@ void tst_qmldiskcache::cacheModuleScripts()
     }
 }
 
+void tst_qmldiskcache::cacheBundle()
+{
+    QQmlEngine engine;
+    TestCompiler testCompiler(&engine);
+    QVERIFY(testCompiler.tempDir.isValid());
+
+    const QByteArray contents = QByteArrayLiteral("import QtQml 2.0\n"
+                                                  "QtObject {\n"
+                                                  "    property int value: 42\n"
+                                                  "}");
+    QVERIFY2(testCompiler.compile(contents), qPrintable(testCompiler.lastErrorString));
+
+    QV4::CompilationUnitBundle::Entry entry;
+    entry.sourcePath = testCompiler.testFilePath;
+    {
+        QFile f(testCompiler.cacheFilePath);
+        QVERIFY(f.open(QIODevice::ReadOnly));
+        entry.unitData = f.readAll();
+    }
+
+    const QString bundlePath = testCompiler.tempDir.path() + QStringLiteral("/app.qmlcb");
+    QString errorString;
+    QVERIFY2(QV4::CompilationUnitBundle::write(bundlePath, { entry }, &errorString), qPrintable(errorString));
+    QVERIFY(!QV4::CompilationUnitBundle::write(bundlePath, { entry, entry }, &errorString));
+
+    {
+        QV4::CompilationUnitBundle bundle;
+        QVERIFY2(bundle.open(bundlePath, &errorString), qPrintable(errorString));
+        QCOMPARE(bundle.count(), 1);
+        QVERIFY(!bundle.unit(testCompiler.tempDir.path() + QStringLiteral("/other.qml")));
+
+        const QV4::CompiledData::Unit *unit = bundle.unit(testCompiler.testFilePath);
+        QVERIFY(unit);
+        QVERIFY(quintptr(unit) % 16 == 0);
+        QVERIFY(unit->flags & QV4::CompiledData::Unit::StaticData);
+        QVERIFY2(unit->verifyHeader(QFileInfo(testCompiler.testFilePath).lastModified(), &errorString), qPrintable(errorString));
+        QCOMPARE(quint32(unit->qmlUnit()->nObjects), quint32(1));
+
+        // A rebuilt source only invalidates its own entry.
+        QVERIFY2(testCompiler.compile(contents + QByteArrayLiteral("\n")), qPrintable(testCompiler.lastErrorString));
+        QVERIFY(!unit->verifyHeader(QFileInfo(testCompiler.testFilePath).lastModified(), &errorString));
+    }
+
+    {
+        QFile f(bundlePath);
+        QVERIFY(f.open(QIODevice::ReadWrite));
+        QVERIFY(f.seek(8));
+        const quint32 bogusVersion = ~0U;
+        f.write(reinterpret_cast<const char *>(&bogusVersion), sizeof(bogusVersion));
+    }
+
+    QV4::CompilationUnitBundle bundle;
+    QVERIFY(!bundle.open(bundlePath, &errorString));
+    QVERIFY(!bundle.isOpen());
+    QVERIFY(!bundle.unit(testCompiler.testFilePath));
+}
+
+void tst_qmldiskcache::contentHashValidation()
+{
+    QQmlEngine engine;
+    QQmlEnginePrivate::get(&engine)->typeLoader.setDiskCacheValidation(QQmlTypeLoader::DiskCacheValidation::ContentHash);
+    TestCompiler testCompiler(&engine);
+    QVERIFY(testCompiler.tempDir.isValid());
+
+    const QByteArray contents = QByteArrayLiteral("import QtQml 2.0\n"
+                                                  "QtObject {\n"
+                                                  "    property int value: 42\n"
+                                                  "}");
+    QVERIFY2(testCompiler.compile(contents), qPrintable(testCompiler.lastErrorString));
+
+    const QUrl url = QUrl::fromLocalFile(testCompiler.testFilePath);
+    const quint64 sourceHash = QV4::CompiledData::computeSourceHash(contents.constData(), contents.size());
+    QVERIFY(sourceHash != 0);
+    const QString cachePath = QV4::CompiledData::CompilationUnit::localCacheFilePath(url, sourceHash);
+    QVERIFY(QFile::exists(cachePath));
+    QVERIFY(!QFile::exists(testCompiler.cacheFilePath));
+
+    QString errorString;
+    {
+        // Only the content matters, not the time stamp.
+        QFile f(testCompiler.testFilePath);
+        QVERIFY(f.open(QIODevice::ReadWrite));
+        QVERIFY(f.setFileTime(QDateTime::currentDateTime().addSecs(3600), QFileDevice::FileModificationTime));
+    }
+    {
+        QQmlRefPointer<QV4::CompiledData::CompilationUnit> unit = QV4::Compiler::Codegen::createUnitForLoading();
+        QVERIFY2(unit->loadFromDisk(url, QFileInfo(testCompiler.testFilePath).lastModified(), &errorString, sourceHash),
+                 qPrintable(errorString));
+        QCOMPARE(quint64(unit->unitData()->sourceHash), sourceHash);
+
+        const QByteArray newContents = contents + QByteArrayLiteral("\n");
+        const quint64 newSourceHash = QV4::CompiledData::computeSourceHash(newContents.constData(), newContents.size());
+        QVERIFY(newSourceHash != sourceHash);
+        QVERIFY(!unit->unitData()->verifyHeader(QDateTime(), &errorString, newSourceHash));
+    }
+
+    // A populated read-only directory is used before the local cache.
+    const QString sharedPath = testCompiler.tempDir.path() + QStringLiteral("/shared");
+    QVERIFY(QDir().mkpath(sharedPath));
+    qputenv("QML_DISK_CACHE_SHARED_PATH", QFile::encodeName(sharedPath));
+    auto unsetSharedPath = qScopeGuard([]() { qunsetenv("QML_DISK_CACHE_SHARED_PATH"); });
+
+    const QString sharedCachePath = QV4::CompiledData::CompilationUnit::sharedCacheFilePath(url, sourceHash);
+    QVERIFY(sharedCachePath.startsWith(sharedPath));
+    // Files validated by time stamp are never looked up in the shared directory.
+    QVERIFY(QV4::CompiledData::CompilationUnit::sharedCacheFilePath(url, 0).isEmpty());
+    QVERIFY(QFile::copy(cachePath, sharedCachePath));
+    QVERIFY(QFile::remove(cachePath));
+
+    engine.clearComponentCache();
+    {
+        CleanlyLoadingComponent component(&engine, testCompiler.testFilePath);
+        QScopedPointer<QObject> obj(component.create());
+        QVERIFY(!obj.isNull());
+        QCOMPARE(obj->property("value").toInt(), 42);
+    }
+    QVERIFY(!QFile::exists(cachePath));
+}
+
 QTEST_MAIN(tst_qmldiskcache)
 
 #include "tst_qmldiskcache.moc"
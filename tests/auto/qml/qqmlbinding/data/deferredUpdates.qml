@@ -0,0 +1,9 @@
+import QtQml 2.0
+
+QtObject {
+    property int source: 1
+    property int left: source * 2
+    property int right: source * 3
+    property int sum: { sums.push(left + right); return left + right }
+    property var sums: []
+}
@@ -29,6 +29,8 @@
 #include <QtQml/qqmlengine.h>
 #include <QtQml/qqmlcomponent.h>
 #include <private/qqmlbind_p.h>
+#include <private/qqmlengine_p.h>
+#include <private/qqmlbindingscheduler_p.h>
 #include <QtQuick/private/qquickrectangle_p.h>
 #include "../../shared/util.h"
 
@@ -51,6 +53,8 @@ private slots:
     void disabledOnReadonlyProperty();
     void delayed();
     void bindingOverwriting();
+    void deferredUpdates();
+    void deferredUpdateTargetDeleted();
 
 private:
     QQmlEngine engine;
@@ -319,6 +323,71 @@ void tst_qqmlbinding::bindingOverwriting()
     QCOMPARE(messageHandler.messages().count(), 2);
 }
 
+void tst_qqmlbinding::deferredUpdates()
+{
+    QQmlEngine engine;
+    QQmlBindingScheduler &scheduler = QQmlEnginePrivate::get(&engine)->bindingScheduler;
+    scheduler.setEnabled(true);
+
+    QQmlComponent c(&engine, testFileUrl("deferredUpdates.qml"));
+    QScopedPointer<QObject> object(c.create());
+    QVERIFY2(object, qPrintable(c.errorString()));
+    // bindings can be dirtied by bindings enabled after them during creation
+    scheduler.flush();
+    QCOMPARE(object->property("sum").toInt(), 5);
+    const int initialSums = object->property("sums").toList().count();
+    scheduler.resetStatistics();
+
+    object->setProperty("source", 2);
+    // doesn't update immediately
+    QVERIFY(scheduler.hasPendingBindings());
+    QCOMPARE(object->property("sum").toInt(), 5);
+
+    scheduler.flush();
+    QVERIFY(!scheduler.hasPendingBindings());
+    QCOMPARE(object->property("sum").toInt(), 10);
+    // the diamond is evaluated once, without the intermediate 4 + 3
+    QCOMPARE(object->property("sums").toList().last().toInt(), 10);
+    QCOMPARE(object->property("sums").toList().count(), initialSums + 1);
+    QCOMPARE(scheduler.statistics().evaluations, quint64(3));
+    QCOMPARE(scheduler.statistics().coalesced, quint64(1));
+
+    // the queued flush runs from the event loop as well
+    object->setProperty("source", 3);
+    QTRY_COMPARE(object->property("sum").toInt(), 15);
+    QCOMPARE(object->property("sums").toList().count(), initialSums + 2);
+
+    scheduler.setEnabled(false);
+    object->setProperty("source", 4);
+    QCOMPARE(object->property("sum").toInt(), 20);
+}
+
+void tst_qqmlbinding::deferredUpdateTargetDeleted()
+{
+    QQmlEngine engine;
+    QQmlBindingScheduler &scheduler = QQmlEnginePrivate::get(&engine)->bindingScheduler;
+    scheduler.setEnabled(true);
+
+    QQmlComponent c(&engine, testFileUrl("deferredUpdateTargetDeleted.qml"));
+    QScopedPointer<QObject> object(c.create());
+    QVERIFY2(object, qPrintable(c.errorString()));
+    scheduler.flush();
+
+    QObject *target = object->property("target").value<QObject *>();
+    QVERIFY(target);
+    QCOMPARE(target->property("value").toInt(), 2);
+
+    scheduler.resetStatistics();
+    object->setProperty("source", 2);
+    QVERIFY(scheduler.hasPendingBindings());
+
+    // the queued binding must not touch its deleted target
+    delete target;
+    scheduler.flush();
+    QVERIFY(!scheduler.hasPendingBindings());
+    QCOMPARE(scheduler.statistics().evaluations, quint64(0));
+}
+
 QTEST_MAIN(tst_qqmlbinding)
 
 #include "tst_qqmlbinding.moc"
@@ -0,0 +1,37 @@
+import QtQml 2.0
+
+QtObject {
+    id: root
+
+    property int intValue: 0
+    property real realValue: 0
+    property string stringValue
+    property point pointValue
+    readonly property int readOnlyValue: 1
+    property bool success: false
+
+    function assignAll(target, i) {
+        target.intValue = i;
+        target.realValue = i / 2;
+        target.stringValue = "s" + i;
+        target.pointValue.x = i;
+        target.pointValue.y = i / 2;
+    }
+
+    Component.onCompleted: {
+        for (var i = 0; i < 10; ++i)
+            assignAll(root, i);
+
+        var threw = false;
+        for (var j = 0; j < 3; ++j) {
+            try {
+                root.readOnlyValue = j;
+            } catch (e) {
+                threw = true;
+            }
+        }
+
+        success = threw && readOnlyValue === 1 && intValue === 9 && realValue === 4.5
+                && stringValue === "s9" && pointValue.x === 9 && pointValue.y === 4.5;
+    }
+}
@@ -368,6 +368,7 @@ private slots:
     void saveAccumulatorBeforeToInt32();
     void intMinDividedByMinusOne();
     void undefinedPropertiesInObjectWrapper();
+    void qobjectSetterLookups();
 
 private:
 //    static void propertyVarWeakRefCallback(v8::Persistent<v8::Value> object, void* parameter);
@@ -8968,6 +8969,18 @@ void tst_qqmlecmascript::undefinedPropertiesInObjectWrapper()
     QVERIFY(!object.isNull());
 }
 
+void tst_qqmlecmascript::qobjectSetterLookups()
+{
+    QQmlEngine engine;
+    QQmlComponent component(&engine, testFileUrl("qobjectSetterLookups.qml"));
+    QScopedPointer<QObject> object(component.create());
+    QVERIFY2(!object.isNull(), qPrintable(component.errorString()));
+    QCOMPARE(object->property("intValue").toInt(), 9);
+    QCOMPARE(object->property("stringValue").toString(), QStringLiteral("s9"));
+    QCOMPARE(object->property("pointValue").toPointF(), QPointF(9, 4.5));
+    QVERIFY(object->property("success").toBool());
+}
+
 QTEST_MAIN(tst_qqmlecmascript)
 
 #include "tst_qqmlecmascript.moc"
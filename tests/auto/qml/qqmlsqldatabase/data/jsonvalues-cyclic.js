@@ -0,0 +1,30 @@
+.import QtQuick.LocalStorage 2.0 as Sql
+
+function test() {
+    var db = Sql.LocalStorage.openDatabaseSync("QmlTestDB-jsonvalues-cyclic", "", "Test database from Qt autotests", 1000000);
+    var r="transaction_not_finished";
+
+    var cyclic = { name: "cyclic" };
+    cyclic.self = cyclic;
+
+    db.transaction(
+        function(tx) {
+            tx.executeSql('CREATE TABLE IF NOT EXISTS CyclicValues(name TEXT, value TEXT)');
+            try {
+                tx.executeSql('INSERT INTO CyclicValues VALUES(?, ?)', [ 'cyclic', cyclic ]);
+                r = "SHOULD NOT SUCCEED";
+                return
+            } catch (err) {
+                if (!(err instanceof TypeError)) {
+                    r = "WRONG ERROR=" + err;
+                    return
+                }
+            }
+            // The statement must not have run with a null value
+            var rs = tx.executeSql("SELECT * FROM CyclicValues");
+            r = rs.rows.length === 0 ? "passed" : "statement_executed";
+        }
+    );
+
+    return r;
+}
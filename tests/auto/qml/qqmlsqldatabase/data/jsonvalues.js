@@ -0,0 +1,30 @@
+.import QtQuick.LocalStorage 2.0 as Sql
+
+function test() {
+    var db = Sql.LocalStorage.openDatabaseSync("QmlTestDB-jsonvalues", "", "Test database from Qt autotests", 1000000);
+    var r="transaction_not_finished";
+
+    db.transaction(
+        function(tx) {
+            tx.executeSql('CREATE TABLE IF NOT EXISTS JsonValues(name TEXT, value TEXT)');
+            tx.executeSql('INSERT INTO JsonValues VALUES(?, ?)', [ 'object', { a: 1, b: "two" } ]);
+            tx.executeSql('INSERT INTO JsonValues VALUES(?, ?)', [ 'array', [ 1, "two", null ] ]);
+            var rs = tx.executeSql("SELECT * FROM JsonValues ORDER BY name");
+            if (rs.rows.length !== 2) {
+                r = "wrong_row_count"
+                return
+            }
+            if (rs.rows.item(0).value !== '[1,"two",null]') {
+                r = "wrong_array_text: " + rs.rows.item(0).value
+                return
+            }
+            if (rs.rows.item(1).value !== '{"a":1,"b":"two"}') {
+                r = "wrong_object_text: " + rs.rows.item(1).value
+                return
+            }
+            r = "passed";
+        }
+    );
+
+    return r;
+}
@@ -0,0 +1,6 @@
+import QtQml 2.0
+import "parallel_loading.js" as Helper
+
+QtObject {
+    property int value: Helper.square(2)
+}
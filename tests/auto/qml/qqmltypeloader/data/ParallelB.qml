@@ -0,0 +1,5 @@
+import QtQml 2.0
+
+ParallelA {
+    property int other: value + 1
+}
@@ -0,0 +1,7 @@
+import QtQml 2.0
+import "parallel_loading.js" as Helper
+
+QtObject {
+    property int value: Helper.square(3)
+    property QtObject child: ParallelB {}
+}
@@ -0,0 +1,3 @@
+.pragma library
+
+function square(x) { return x * x; }
@@ -0,0 +1,8 @@
+import QtQml 2.0
+
+QtObject {
+    property QtObject a: ParallelA {}
+    property QtObject b: ParallelB {}
+    property QtObject c: ParallelC {}
+    property int sum: a.value + b.other + c.value + c.child.other
+}
@@ -56,6 +56,8 @@ private slots:
     void qmlSingletonWithinModule();
     void multiSingletonModule();
     void implicitComponentModule();
+    void parallelLoading_data();
+    void parallelLoading();
 };
 
 void tst_QQMLTypeLoader::testLoadComplete()
@@ -503,6 +505,53 @@ void tst_QQMLTypeLoader::implicitComponentModule()
     checkCleanCacheLoad(QLatin1String("implicitComponentModule"));
 }
 
+void tst_QQMLTypeLoader::parallelLoading_data()
+{
+    QTest::addColumn<int>("workerThreadCount");
+
+    QTest::newRow("no workers") << 0;
+    QTest::newRow("one worker") << 1;
+    QTest::newRow("four workers") << 4;
+}
+
+void tst_QQMLTypeLoader::parallelLoading()
+{
+    QFETCH(int, workerThreadCount);
+
+    QQmlEngine engine;
+    QQmlTypeLoader &loader = QQmlEnginePrivate::get(&engine)->typeLoader;
+    loader.setWorkerThreadCount(workerThreadCount);
+    QCOMPARE(loader.workerThreadCount(), qMin(workerThreadCount, QThread::idealThreadCount()));
+
+    {
+        // Local dependencies prepared on the workers still complete synchronously.
+        QQmlComponent component(&engine, testFileUrl("parallel_loading.qml"));
+        QCOMPARE(component.status(), QQmlComponent::Ready);
+        QScopedPointer<QObject> obj(component.create());
+        QVERIFY(!obj.isNull());
+        QCOMPARE(obj->property("sum").toInt(), 23);
+    }
+
+    {
+        QQmlComponent component(&engine, testFileUrl("parallel_loading_error.qml"));
+        QCOMPARE(component.status(), QQmlComponent::Error);
+        const QList<QQmlError> errors = component.errors();
+        QVERIFY(!errors.isEmpty());
+        QVERIFY(std::any_of(errors.cbegin(), errors.cend(), [this](const QQmlError &error) {
+            return error.url() == testFileUrl("ParallelBroken.qml");
+        }));
+    }
+
+    {
+        QQmlComponent component(&engine);
+        component.loadUrl(testFileUrl("parallel_loading.qml"), QQmlComponent::Asynchronous);
+        QTRY_COMPARE(component.status(), QQmlComponent::Ready);
+        QScopedPointer<QObject> obj(component.create());
+        QVERIFY(!obj.isNull());
+        QCOMPARE(obj->property("sum").toInt(), 23);
+    }
+}
+
 QTEST_MAIN(tst_QQMLTypeLoader)
 
 #include "tst_qqmltypeloader.moc"
@@ -0,0 +1,22 @@
+import QtQuick 2.0
+
+QtObject {
+    property string url;
+    property bool result: false
+
+    Component.onCompleted: {
+        var request = new XMLHttpRequest();
+        request.open("GET", url, true);
+        request.responseType = "json";
+
+        request.onreadystatechange = function() {
+            if (request.readyState == XMLHttpRequest.DONE) {
+                // The stray Latin-1 byte decodes to a replacement character
+                var object = request.response;
+                result = object.name == "caf\ufffd" && object.size === 1;
+            }
+        }
+
+        request.send(null);
+    }
+}
@@ -0,0 +1,26 @@
+import QtQuick 2.0
+
+QtObject {
+    property string url;
+    property bool result: false
+
+    Component.onCompleted: {
+        var request = new XMLHttpRequest();
+        request.open("GET", url, true);
+        request.responseType = "json";
+
+        request.onreadystatechange = function() {
+            if (request.readyState == XMLHttpRequest.DONE) {
+                var list = request.response;
+                result = list.length == 4
+                        && list[0].name == "café" && list[0].size === 1
+                        && list[1].name == "日本" && list[1].size === 2
+                        && list[2].name == "😀 \"quoted\" é" && list[2].size === 3.5
+                        && list[3].name == "plain" && list[3].count === -4
+                        && Object.keys(list[3]).join() == "name,count";
+            }
+        }
+
+        request.send(null);
+    }
+}
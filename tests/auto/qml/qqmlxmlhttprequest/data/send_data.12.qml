@@ -0,0 +1,24 @@
+import QtQuick 2.0
+
+QtObject {
+    property string url
+
+    property bool dataOK: false
+
+    Component.onCompleted: {
+        var x = new XMLHttpRequest;
+        x.open("POST", url);
+        x.setRequestHeader("Content-Type", "application/json");
+        x.setRequestHeader("Accept-Language","en-US");
+
+        // Test to the end
+        x.onreadystatechange = function() {
+            if (x.readyState == XMLHttpRequest.DONE) {
+                dataOK = (x.responseText == "QML Rocks!\n");
+            }
+        }
+
+        x.send({ name: "café", list: [1, 2.5, null, true], skipped: undefined });
+    }
+}
+
@@ -85,6 +85,8 @@ private slots:
     void getAllResponseHeaders_args();
     void getBinaryData();
     void getJsonData();
+    void getJsonDataUtf8();
+    void getJsonDataInvalidUtf8();
     void status();
     void status_data();
     void statusText();
@@ -600,6 +602,7 @@ void tst_qqmlxmlhttprequest::send_withdata_data()
     QTest::newRow("PUT") << "send_data.6.expect" << "send_data.6.qml";
     QTest::newRow("Correct content-type - no charset") << "send_data.1.expect" << "send_data.7.qml";
     QTest::newRow("ArrayBuffer") << "send_data.11.expect" << "send_data.11.qml";
+    QTest::newRow("JSON object") << "send_data.12.expect" << "send_data.12.qml";
 }
 
 void tst_qqmlxmlhttprequest::send_options()
@@ -890,6 +893,40 @@ void tst_qqmlxmlhttprequest::getJsonData()
     QTRY_VERIFY(object->property("result").toBool());
 }
 
+void tst_qqmlxmlhttprequest::getJsonDataUtf8()
+{
+    TestHTTPServer server;
+    QVERIFY2(server.listen(), qPrintable(server.errorString()));
+    QVERIFY(server.wait(testFileUrl("receive_json_utf8_data.expect"),
+                        testFileUrl("receive_binary_data.reply"),
+                        testFileUrl("json_utf8.data")));
+
+    QQmlComponent component(&engine, testFileUrl("receiveJsonUtf8Data.qml"));
+    QScopedPointer<QObject> object(component.beginCreate(engine.rootContext()));
+    QVERIFY(!object.isNull());
+    object->setProperty("url", server.urlString("/json_utf8.data"));
+    component.completeCreate();
+
+    QTRY_VERIFY(object->property("result").toBool());
+}
+
+void tst_qqmlxmlhttprequest::getJsonDataInvalidUtf8()
+{
+    TestHTTPServer server;
+    QVERIFY2(server.listen(), qPrintable(server.errorString()));
+    QVERIFY(server.wait(testFileUrl("receive_json_invalid_utf8_data.expect"),
+                        testFileUrl("receive_binary_data.reply"),
+                        testFileUrl("json_invalid_utf8.data")));
+
+    QQmlComponent component(&engine, testFileUrl("receiveJsonInvalidUtf8Data.qml"));
+    QScopedPointer<QObject> object(component.beginCreate(engine.rootContext()));
+    QVERIFY(!object.isNull());
+    object->setProperty("url", server.urlString("/json_invalid_utf8.data"));
+    component.completeCreate();
+
+    QTRY_VERIFY(object->property("result").toBool());
+}
+
 void tst_qqmlxmlhttprequest::status()
 {
     QFETCH(QUrl, replyUrl);
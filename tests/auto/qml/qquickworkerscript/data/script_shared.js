@@ -0,0 +1,6 @@
+WorkerScript.onMessage = function(msg) {
+    var shared = msg.shared
+    var result = Atomics.wait(shared, 0, 0, 10000)
+    Atomics.store(shared, 1, 42)
+    WorkerScript.sendMessage({ result: result, value: Atomics.load(shared, 0) })
+}
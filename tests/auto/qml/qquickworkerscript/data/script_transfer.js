@@ -0,0 +1,17 @@
+WorkerScript.onMessage = function(msg) {
+    var view = new Uint8Array(msg.buffer)
+    var sum = 0
+    for (var i = 0; i < view.length; ++i)
+        sum += view[i]
+
+    var reply = {
+        length: msg.buffer.byteLength,
+        sum: sum,
+        viewLength: msg.view.length,
+        sameBuffer: msg.view.buffer === msg.buffer,
+        mapValue: msg.map.get("b")[1],
+        setHasTwo: msg.set.has("two"),
+        buffer: msg.buffer
+    }
+    WorkerScript.sendMessage(reply, [msg.buffer])
+}
@@ -0,0 +1,5 @@
+WorkerScript.onMessage = function(msg) {
+    WorkerScript.sendMessage({ waiting: true })
+    // Nobody ever notifies, only the engine going away ends the wait
+    Atomics.wait(msg.shared, 0, 0)
+}
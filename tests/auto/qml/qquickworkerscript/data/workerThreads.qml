@@ -0,0 +1,24 @@
+import QtQuick 2.12
+
+QtObject {
+    id: root
+
+    property int replies: 0
+
+    property WorkerScript first: WorkerScript {
+        source: "script.js"
+        workerThread: 0
+        onMessage: ++root.replies
+    }
+
+    property WorkerScript second: WorkerScript {
+        source: "script.js"
+        workerThread: 0
+        onMessage: ++root.replies
+    }
+
+    function sendAll(value) {
+        first.sendMessage(value)
+        second.sendMessage(value)
+    }
+}
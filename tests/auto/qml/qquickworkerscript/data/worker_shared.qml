@@ -0,0 +1,30 @@
+import QtQuick 2.0
+
+WorkerScript {
+    id: worker
+    source: "script_shared.js"
+
+    property var response
+    property var shared: new Int32Array(new SharedArrayBuffer(8))
+
+    signal done()
+
+    function start() {
+        worker.sendMessage({ shared: shared })
+    }
+
+    function wakeWorker() {
+        Atomics.store(shared, 0, 1)
+        return Atomics.notify(shared, 0)
+    }
+
+    function checkResponse() {
+        return (response.result === "ok" || response.result === "not-equal")
+                && response.value === 1 && Atomics.load(shared, 1) === 42
+    }
+
+    onMessage: {
+        worker.response = messageObject
+        worker.done()
+    }
+}
@@ -0,0 +1,35 @@
+import QtQuick 2.0
+
+WorkerScript {
+    id: worker
+    source: "script_transfer.js"
+
+    property var response
+    property int sentLength: -1
+
+    signal done()
+
+    function sendBuffers() {
+        var buffer = new ArrayBuffer(16)
+        var view = new Uint8Array(buffer)
+        for (var i = 0; i < view.length; ++i)
+            view[i] = i
+        var map = new Map([["a", 1], ["b", new Float64Array([1.5, 2.5])]])
+        var set = new Set([1, "two"])
+        worker.sendMessage({ buffer: buffer, view: view, map: map, set: set }, [buffer])
+        sentLength = buffer.byteLength
+    }
+
+    function checkResponse() {
+        return response.length === 16 && response.sum === 120 && response.viewLength === 16
+                && response.sameBuffer
+                && response.mapValue === 2.5 && response.setHasTwo
+                && response.buffer instanceof ArrayBuffer && response.buffer.byteLength === 16
+                && new Uint8Array(response.buffer)[15] === 15
+    }
+
+    onMessage: {
+        worker.response = messageObject
+        worker.done()
+    }
+}
@@ -0,0 +1,16 @@
+import QtQuick 2.0
+
+WorkerScript {
+    id: worker
+    source: "script_wait.js"
+
+    property var shared: new Int32Array(new SharedArrayBuffer(4))
+
+    signal done()
+
+    function start() {
+        worker.sendMessage({ shared: shared })
+    }
+
+    onMessage: worker.done()
+}
@@ -28,8 +28,10 @@
 #include <qtest.h>
 #include <QtCore/qdebug.h>
 #include <QtCore/qtimer.h>
+#include <QtCore/qelapsedtimer.h>
 #include <QtCore/qdir.h>
 #include <QtCore/qfileinfo.h>
+#include <QtCore/qregularexpression.h>
 #include <QtQml/qjsengine.h>
 
 #include <QtQml/qqmlcomponent.h>
@@ -51,6 +53,9 @@ private slots:
     void messaging_sendQObjectList();
     void messaging_sendJsObject();
     void messaging_sendExternalObject();
+    void messaging_transfer();
+    void messaging_sharedArrayBuffer();
+    void sharedArrayBuffer_waitOnShutdown();
     void script_with_pragma();
     void script_included();
     void scriptError_onLoad();
@@ -58,6 +63,7 @@ private slots:
     void script_function();
     void script_var();
     void stressDispose();
+    void workerThreads();
 
 private:
     void waitForEchoMessage(QQuickWorkerScript *worker) {
@@ -203,6 +209,66 @@ void tst_QQuickWorkerScript::messaging_sendExternalObject()
     delete obj;
 }
 
+void tst_QQuickWorkerScript::messaging_transfer()
+{
+    QQmlComponent component(&m_engine, testFileUrl("worker_transfer.qml"));
+    QScopedPointer<QQuickWorkerScript> worker(qobject_cast<QQuickWorkerScript*>(component.create()));
+    QVERIFY(worker != nullptr);
+
+    QVERIFY(QMetaObject::invokeMethod(worker.data(), "sendBuffers"));
+    // The transferred buffer is detached on the sending side
+    QCOMPARE(worker->property("sentLength").toInt(), 0);
+
+    waitForEchoMessage(worker.data());
+
+    QVariant result;
+    QVERIFY(QMetaObject::invokeMethod(worker.data(), "checkResponse", Q_RETURN_ARG(QVariant, result)));
+    QVERIFY(result.toBool());
+}
+
+void tst_QQuickWorkerScript::messaging_sharedArrayBuffer()
+{
+    QQmlComponent component(&m_engine, testFileUrl("worker_shared.qml"));
+    QScopedPointer<QQuickWorkerScript> worker(qobject_cast<QQuickWorkerScript*>(component.create()));
+    QVERIFY(worker != nullptr);
+
+    QVERIFY(QMetaObject::invokeMethod(worker.data(), "start"));
+
+    // Keep notifying until the worker was woken, or saw the store before it started waiting
+    QEventLoop loop;
+    QVERIFY(connect(worker.data(), SIGNAL(done()), &loop, SLOT(quit())));
+    QTimer timer;
+    connect(&timer, &QTimer::timeout, [&]() {
+        QMetaObject::invokeMethod(worker.data(), "wakeWorker");
+    });
+    timer.start(10);
+    QTimer::singleShot(10000, &loop, SLOT(quit()));
+    loop.exec();
+    timer.stop();
+
+    QVariant result;
+    QVERIFY(QMetaObject::invokeMethod(worker.data(), "checkResponse", Q_RETURN_ARG(QVariant, result)));
+    QVERIFY(result.toBool());
+}
+
+void tst_QQuickWorkerScript::sharedArrayBuffer_waitOnShutdown()
+{
+    // Destroying the engine must not hang on a worker that waits without a timeout
+    QScopedPointer<QQmlEngine> engine(new QQmlEngine);
+    QQmlComponent *component = new QQmlComponent(engine.data(), testFileUrl("worker_wait.qml"), engine.data());
+    QScopedPointer<QQuickWorkerScript> worker(qobject_cast<QQuickWorkerScript*>(component->create()));
+    QVERIFY(worker != nullptr);
+
+    QVERIFY(QMetaObject::invokeMethod(worker.data(), "start"));
+    waitForEchoMessage(worker.data());
+
+    QElapsedTimer timer;
+    timer.start();
+    worker.reset();
+    engine.reset();
+    QVERIFY(timer.elapsed() < 10000);
+}
+
 void tst_QQuickWorkerScript::script_with_pragma()
 {
     QVariant value(100);
@@ -329,6 +395,56 @@ void tst_QQuickWorkerScript::stressDispose()
     }
 }
 
+void tst_QQuickWorkerScript::workerThreads()
+{
+    QQmlEngine engine;
+    QQmlComponent component(&engine, testFileUrl("workerThreads.qml"));
+    QScopedPointer<QObject> root(component.create());
+    QVERIFY(root);
+
+    QQuickWorkerScript *first = root->property("first").value<QQuickWorkerScript *>();
+    QQuickWorkerScript *second = root->property("second").value<QQuickWorkerScript *>();
+    QVERIFY(first && second);
+
+    // Pinned workers share their thread
+    QCOMPARE(first->workerThread(), 0);
+    QCOMPARE(first->statistics().thread, 0);
+    QCOMPARE(second->statistics().thread, 0);
+
+    // Changing the thread of a running worker is refused
+    QTest::ignoreMessage(QtWarningMsg, QRegularExpression(".*Cannot change the worker thread.*"));
+    first->setWorkerThread(1);
+    QCOMPARE(first->workerThread(), 0);
+
+    // Without opting in, all workers share a single thread
+    QQuickWorkerScriptEngine *workerEngine = QQmlEnginePrivate::get(&engine)->getWorkerScriptEngine();
+    if (!qEnvironmentVariableIsSet("QML_WORKERSCRIPT_THREADS"))
+        QCOMPARE(workerEngine->maximumThreadCount(), 1);
+
+    // Other workers go to the least busy thread
+    workerEngine->setMaximumThreadCount(2);
+    QQmlComponent workerComponent(&engine, testFileUrl("worker.qml"));
+    QScopedPointer<QQuickWorkerScript> third(qobject_cast<QQuickWorkerScript *>(workerComponent.create()));
+    QVERIFY(third);
+    QCOMPARE(third->workerThread(), -1);
+    QCOMPARE(third->statistics().thread, 1);
+
+    for (int i = 0; i < 10; ++i)
+        QVERIFY(QMetaObject::invokeMethod(root.data(), "sendAll", Q_ARG(QVariant, i)));
+    QTRY_COMPARE(root->property("replies").toInt(), 20);
+
+    for (QQuickWorkerScript *worker : { first, second }) {
+        const QQuickWorkerScriptEngine::Statistics statistics = worker->statistics();
+        QCOMPARE(statistics.queueDepth, 0);
+        QCOMPARE(statistics.processed, 11); // the script and the ten messages
+        QVERIFY(statistics.maximumLatency <= statistics.totalLatency);
+    }
+
+    QVERIFY(QMetaObject::invokeMethod(third.data(), "testSend", Q_ARG(QVariant, QVariant(1))));
+    waitForEchoMessage(third.data());
+    QCOMPARE(third->statistics().processed, 2);
+}
+
 QTEST_MAIN(tst_QQuickWorkerScript)
 
 #include "tst_qquickworkerscript.moc"
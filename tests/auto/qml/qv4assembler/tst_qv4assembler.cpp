@@ -29,22 +29,37 @@
 #include <QtTest/QtTest>
 #include <QtCore/qprocess.h>
 #include <QtCore/qtemporaryfile.h>
+#include <QtQml/qjsengine.h>
 #include <private/qv4global_p.h>
+#include <private/qv4engine_p.h>
+#include <private/qv4functionobject_p.h>
+#include <private/qv4backgroundjit_p.h>
+#include <private/qjsvalue_p.h>
 
 class tst_QV4Assembler : public QObject
 {
     Q_OBJECT
 
 private slots:
+    void perfMapFile_data();
     void perfMapFile();
     void jitEnabled();
+    void backgroundCompilation();
 };
 
+void tst_QV4Assembler::perfMapFile_data()
+{
+    QTest::addColumn<bool>("jitOption");
+    QTest::newRow("environment") << false;
+    QTest::newRow("--jit") << true;
+}
+
 void tst_QV4Assembler::perfMapFile()
 {
 #if !defined(Q_OS_LINUX)
     QSKIP("perf map files are only generated on linux");
 #else
+    QFETCH(bool, jitOption);
     const QString qmljs = QLibraryInfo::location(QLibraryInfo::BinariesPath) + "/qmljs";
     QProcess process;
 
@@ -55,10 +70,18 @@ void tst_QV4Assembler::perfMapFile()
 
     QProcessEnvironment environment = QProcessEnvironment::systemEnvironment();
     environment.insert("QV4_PROFILE_WRITE_PERF_MAP", "1");
-    environment.insert("QV4_JIT_CALL_THRESHOLD", "0");
+    QStringList arguments({infile.fileName()});
+    if (jitOption) {
+        // --jit alone has to produce JIT code for functions which only run once.
+        environment.remove("QV4_JIT_CALL_THRESHOLD");
+        environment.remove("QV4_JIT_SYNCHRONOUS");
+        arguments.prepend("--jit");
+    } else {
+        environment.insert("QV4_JIT_CALL_THRESHOLD", "0");
+    }
 
     process.setProcessEnvironment(environment);
-    process.start(qmljs, QStringList({infile.fileName()}));
+    process.start(qmljs, arguments);
     QVERIFY(process.waitForStarted());
     const qint64 pid = process.processId();
     QVERIFY(pid != 0);
@@ -107,6 +130,35 @@ void tst_QV4Assembler::jitEnabled()
 #endif
 }
 
+void tst_QV4Assembler::backgroundCompilation()
+{
+#ifndef V4_ENABLE_JIT
+    QSKIP("The JIT is disabled");
+#else
+    qputenv("QV4_JIT_CALL_THRESHOLD", "1");
+    QJSEngine engine;
+    qunsetenv("QV4_JIT_CALL_THRESHOLD");
+    QV4::ExecutionEngine *v4 = engine.handle();
+    if (!v4->backgroundJIT)
+        QSKIP("Background compilation is not available");
+
+    QJSValue foo = engine.evaluate("(function foo(x) { return x * 2 })");
+    QV4::Scope scope(v4);
+    QV4::ScopedFunctionObject function(scope, *QJSValuePrivate::getValue(&foo));
+    QVERIFY(function);
+    QV4::Function *v4Function = function->function();
+
+    // The second call hands the function to the compiler thread and keeps interpreting.
+    QCOMPARE(foo.call({21}).toInt(), 42);
+    QCOMPARE(foo.call({21}).toInt(), 42);
+    QVERIFY(v4Function->jitQueued);
+
+    v4->backgroundJIT->finishPendingJobs();
+    QVERIFY(v4Function->jittedCode != nullptr);
+    QCOMPARE(foo.call({21}).toInt(), 42);
+#endif
+}
+
 QTEST_MAIN(tst_QV4Assembler)
 
 #include "tst_qv4assembler.moc"
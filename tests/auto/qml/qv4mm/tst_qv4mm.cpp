@@ -48,6 +48,9 @@ private slots:
     void multiWrappedQObjects();
     void accessParentOnDestruction();
     void clearICParent();
+    void incrementalGC();
+    void concurrentSweep();
+    void generationalGC();
 };
 
 void tst_qv4mm::gcStats()
@@ -148,6 +151,145 @@ void tst_qv4mm::clearICParent()
     QFAIL("Garbage collector was not triggered by large amount of InternalClasses");
 }
 
+void tst_qv4mm::incrementalGC()
+{
+    qputenv(QV4_MM_INCREMENTAL_GC, "100");
+    QV4::ExecutionEngine engine;
+    qunsetenv(QV4_MM_INCREMENTAL_GC);
+
+    QV4::MemoryManager *mm = engine.memoryManager;
+    QVERIFY(mm->incrementalGCEnabled());
+
+    QV4::Scope scope(engine.rootContext());
+    QV4::ScopedArrayObject array(scope, engine.newArrayObject());
+    for (uint i = 0; i < 1024; ++i) {
+        QV4::ScopedObject o(scope, engine.newObject());
+        array->push_back(o);
+    }
+
+    mm->startIncrementalGC();
+    QVERIFY(mm->incrementalGCInProgress());
+    QVERIFY(engine.writeBarrierActive);
+
+    // Objects created and stored while marking is in progress need to survive.
+    uint slices = 0;
+    uint i = 0;
+    while (!mm->markIncrementally(10)) {
+        QV4::Scope scope(&engine);
+        QV4::ScopedObject o(scope, engine.newObject());
+        QV4::ScopedString name(scope, engine.newString(QStringLiteral("value")));
+        QV4::ScopedValue v(scope, QV4::Value::fromInt32(i));
+        o->put(name, v);
+        array->put(i++ % 1024, o);
+        ++slices;
+    }
+
+    mm->finishIncrementalGC();
+    QVERIFY(!mm->incrementalGCInProgress());
+    QVERIFY(!engine.writeBarrierActive);
+    QVERIFY(mm->pauseStatistics.cycles >= 1);
+    QVERIFY(mm->pauseStatistics.pauses >= slices + 2);
+    QVERIFY(mm->pauseStatistics.maxPauseUsecs >= mm->pauseStatistics.lastPauseUsecs);
+
+    for (uint j = 0; j < 1024; ++j) {
+        QV4::ScopedObject o(scope, array->getIndexed(j));
+        QVERIFY(o);
+        QVERIFY(o->d()->inUse());
+    }
+
+    // A full GC finishes an ongoing incremental one
+    QVERIFY(!mm->collectIncrementally(100));
+    QVERIFY(mm->incrementalGCInProgress());
+    mm->runGC();
+    QVERIFY(!mm->incrementalGCInProgress());
+}
+
+void tst_qv4mm::concurrentSweep()
+{
+    qputenv(QV4_MM_CONCURRENT_SWEEP, "1");
+    QV4::ExecutionEngine engine;
+    qunsetenv(QV4_MM_CONCURRENT_SWEEP);
+
+    QV4::MemoryManager *mm = engine.memoryManager;
+    if (!mm->concurrentSweep)
+        QSKIP("Concurrent sweeping is not available");
+
+    QV4::Scope scope(engine.rootContext());
+    QV4::ScopedArrayObject array(scope, engine.newArrayObject());
+    for (int i = 0; i < 64 * 1024; ++i) {
+        QV4::Scope scope(&engine);
+        QV4::ScopedObject o(scope, engine.newObject());
+        if (i % 16 == 0)
+            array->push_back(o);
+    }
+
+    const size_t usedBefore = mm->getUsedMem();
+    mm->runGC();
+
+    // Allocating while the chunks are still being swept has to wait for them.
+    for (int i = 0; i < 1024; ++i) {
+        QV4::ScopedObject o(scope, engine.newObject());
+        array->push_back(o);
+    }
+
+    mm->finishSweep();
+    QVERIFY(!mm->blockAllocator.isSweeping());
+    QVERIFY(!mm->icAllocator.isSweeping());
+    QVERIFY(mm->getUsedMem() < usedBefore);
+
+    const uint length = array->getLength();
+    QCOMPARE(length, 4096u + 1024u);
+    for (uint i = 0; i < length; ++i) {
+        QV4::ScopedObject o(scope, array->getIndexed(i));
+        QVERIFY(o);
+        QVERIFY(o->d()->inUse());
+    }
+}
+
+void tst_qv4mm::generationalGC()
+{
+    qputenv(QV4_MM_GENERATIONAL_GC, "1");
+    QV4::ExecutionEngine engine;
+    qunsetenv(QV4_MM_GENERATIONAL_GC);
+
+    QV4::MemoryManager *mm = engine.memoryManager;
+    QVERIFY(mm->generationalGC);
+    QVERIFY(mm->writeBarrierRequired());
+
+    QV4::Scope scope(engine.rootContext());
+    QV4::ScopedObject old(scope, engine.newObject());
+    mm->runGC();
+    mm->finishSweep();
+    QVERIFY(old->d()->isMarked()); // promoted to the old generation
+
+    // Only reachable through the old object, which has to be in the remembered set
+    QV4::ScopedString name(scope, engine.newString(QStringLiteral("young")));
+    {
+        QV4::Scope scope(&engine);
+        QV4::ScopedObject young(scope, engine.newObject());
+        QV4::ScopedValue v(scope, QV4::Value::fromInt32(42));
+        young->put(name, v);
+        old->put(name, young);
+    }
+    for (int i = 0; i < 1024; ++i) {
+        QV4::Scope scope(&engine);
+        QV4::ScopedObject garbage(scope, engine.newObject());
+    }
+
+    const size_t usedBefore = mm->getUsedMem();
+    mm->runGC(QV4::MemoryManager::MinorGC);
+    mm->finishSweep();
+    QCOMPARE(mm->lastGCType, QV4::MemoryManager::MinorGC);
+    QCOMPARE(mm->pauseStatistics.minorCycles, 1u);
+    QVERIFY(mm->getUsedMem() < usedBefore);
+
+    QV4::ScopedObject young(scope, old->get(name));
+    QVERIFY(young);
+    QVERIFY(young->d()->isMarked());
+    QV4::ScopedValue value(scope, young->get(name));
+    QCOMPARE(value->toInt32(), 42);
+}
+
 QTEST_MAIN(tst_qv4mm)
 
 #include "tst_qv4mm.moc"
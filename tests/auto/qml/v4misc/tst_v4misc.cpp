@@ -29,6 +29,7 @@
 #include <qtest.h>
 #include <private/qv4instr_moth_p.h>
 #include <private/qv4script_p.h>
+#include <private/qv4engine_p.h>
 
 class tst_v4misc: public QObject
 {
@@ -45,6 +46,9 @@ private slots:
     void subClassing();
 
     void nestingDepth();
+
+    void polymorphicLookups_data();
+    void polymorphicLookups();
 };
 
 void tst_v4misc::tdzOptimizations_data()
@@ -197,6 +201,52 @@ void tst_v4misc::nestingDepth()
     }
 }
 
+void tst_v4misc::polymorphicLookups_data()
+{
+    QTest::addColumn<int>("shapes");
+    QTest::addColumn<bool>("megamorphic");
+
+    QTest::newRow("polymorphic") << 6 << false;
+    QTest::newRow("megamorphic") << 20 << true;
+}
+
+void tst_v4misc::polymorphicLookups()
+{
+    QFETCH(int, shapes);
+    QFETCH(bool, megamorphic);
+
+    QJSEngine engine;
+    QJSValue result = engine.evaluate(QString::fromLatin1(
+            "var objects = [];"
+            "for (var i = 0; i < %1; ++i) {"
+            "    var o = {};"
+            "    o['p' + i] = i;"
+            "    o.x = i;"
+            "    objects.push(o);"
+            "}"
+            "function get(o) { return o.x; }"
+            "function set(o, v) { o.x = v; }"
+            "var sum = 0;"
+            "for (var j = 0; j < 10; ++j) {"
+            "    for (var i = 0; i < objects.length; ++i) {"
+            "        set(objects[i], 2 * i);"
+            "        sum += get(objects[i]);"
+            "    }"
+            "}"
+            "sum;").arg(shapes));
+    QVERIFY(!result.isError());
+    QCOMPARE(result.toInt(), 10 * shapes * (shapes - 1));
+
+    const auto &statistics = engine.handle()->lookupStatistics;
+    QVERIFY(statistics.transitions > 0);
+    if (megamorphic) {
+        QVERIFY(statistics.megamorphicHits > 0);
+    } else {
+        QVERIFY(statistics.polymorphicHits > 0);
+        QCOMPARE(statistics.megamorphicHits, quint64(0));
+    }
+}
+
 QTEST_MAIN(tst_v4misc);
 
 #include "tst_v4misc.moc"
@@ -0,0 +1,85 @@
+/****************************************************************************
+**
+** Copyright (C) 2016 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+import QtQuick 2.12
+import QtTest 1.1
+
+Item {
+    id: root;
+    width: 200
+    height: 200
+
+    TestCase {
+        id: testCase
+        name: "animators-color"
+        when: Qt.colorEqual(box.color, "blue") && Qt.colorEqual(box.border.color, "lime")
+        function test_endresult() {
+            compare(box.colorChangeCounter, 1);
+            compare(box.borderColorChangeCounter, 1);
+            compare(box.color, "#0000ff");
+            compare(box.border.color, "#00ff00");
+            var image = grabImage(root);
+            compare(image.pixel(50, 50), Qt.rgba(0, 0, 1, 1));
+            compare(image.pixel(2, 50), Qt.rgba(0, 1, 0, 1));
+        }
+    }
+
+    Rectangle {
+        id: box
+        width: 100
+        height: 100
+        color: "red"
+        border.width: 5
+        border.color: "black"
+
+        property int colorChangeCounter: 0
+        property int borderColorChangeCounter: 0
+        onColorChanged: ++colorChangeCounter
+        Connections {
+            target: box.border
+            onColorChanged: ++box.borderColorChangeCounter
+        }
+
+        ColorAnimator {
+            id: colorAnimation
+            target: box
+            to: "blue"
+            duration: 100
+            running: true
+        }
+
+        BorderColorAnimator {
+            id: borderAnimation
+            target: box
+            from: "black"
+            to: "lime"
+            duration: 100
+            running: true
+        }
+    }
+}
@@ -28,6 +28,7 @@
 #include <QtTest/QtTest>
 #include <QtQml/qqmlengine.h>
 #include <QtQml/qqmlcomponent.h>
+#include <QtQml/qqmlproperty.h>
 #include <QtQuick/qquickview.h>
 #include <QtQml/private/qqmltimer_p.h>
 #include <QtQml/private/qqmllistmodel_p.h>
@@ -37,6 +38,7 @@
 #include <QtQuick/private/qquickitemanimation_p_p.h>
 #include <QtQuick/private/qquicktransition_p.h>
 #include <QtQuick/private/qquickanimation_p.h>
+#include <QtQuick/private/qquickanimation_p_p.h>
 #include <QtQuick/private/qquickanimatorjob_p.h>
 #include <QtQuick/private/qquickpathinterpolator_p.h>
 #include <QtQuick/private/qquickitem_p.h>
@@ -64,6 +66,10 @@ private slots:
     void simpleNumber();
     void simpleColor();
     void simpleRotation();
+#if defined(QT_BUILD_INTERNAL)
+    void typedInterpolation_data();
+    void typedInterpolation();
+#endif
     void simplePath();
     void simpleAnchor();
     void reparent();
@@ -224,6 +230,56 @@ void tst_qquickanimations::simpleColor()
     QCOMPARE(rect.color(), QColor::fromRgbF(0.498039, 0, 0.498039, 1));
 }
 
+#if defined(QT_BUILD_INTERNAL)
+void tst_qquickanimations::typedInterpolation_data()
+{
+    QTest::addColumn<QByteArray>("property");
+    QTest::addColumn<QVariant>("from");
+    QTest::addColumn<QVariant>("to");
+
+    QTest::newRow("real") << QByteArray("realValue") << QVariant(-3.5) << QVariant(100.25);
+    QTest::newRow("int") << QByteArray("intValue") << QVariant(7) << QVariant(-100);
+    QTest::newRow("color") << QByteArray("colorValue") << QVariant(QColor(10, 200, 30, 255)) << QVariant(QColor(250, 0, 130, 40));
+    QTest::newRow("point") << QByteArray("pointValue") << QVariant(QPointF(1, 2)) << QVariant(QPointF(-33, 50.5));
+    QTest::newRow("size") << QByteArray("sizeValue") << QVariant(QSizeF(1, 2)) << QVariant(QSizeF(33, 50.5));
+    QTest::newRow("rect") << QByteArray("rectValue") << QVariant(QRectF(0, 1, 10, 10)) << QVariant(QRectF(100, -50, 21, 40));
+}
+
+// The typed fast path of the updater has to produce the same values as the QVariant one
+void tst_qquickanimations::typedInterpolation()
+{
+    QFETCH(QByteArray, property);
+    QFETCH(QVariant, from);
+    QFETCH(QVariant, to);
+
+    QQmlEngine engine;
+    QQmlComponent component(&engine);
+    component.setData("import QtQuick 2.0\nQtObject { property real realValue; property int intValue; property color colorValue; "
+                      "property point pointValue; property size sizeValue; property rect rectValue }", QUrl());
+    QScopedPointer<QObject> typedObject(component.create());
+    QScopedPointer<QObject> variantObject(component.create());
+    QVERIFY(typedObject && variantObject);
+
+    QQuickAnimationPropertyUpdater typed;
+    QQuickAnimationPropertyUpdater variant;
+    typed.typedInterpolation = true;
+    typed.fromDefined = variant.fromDefined = true;
+    QQuickStateAction action;
+    action.fromValue = from;
+    action.toValue = to;
+    action.property = QQmlProperty(typedObject.data(), property);
+    typed.actions << action;
+    action.property = QQmlProperty(variantObject.data(), property);
+    variant.actions << action;
+
+    for (qreal progress : {0.0, 0.1, 0.25, 0.333, 0.5, 0.77, 0.999, 1.0}) {
+        typed.setValue(progress);
+        variant.setValue(progress);
+        QCOMPARE(typedObject->property(property), variantObject->property(property));
+    }
+}
+#endif
+
 void tst_qquickanimations::simpleRotation()
 {
     QQuickRectangle rect;
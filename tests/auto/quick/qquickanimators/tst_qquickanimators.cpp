@@ -30,21 +30,72 @@
 
 #include <QtQuick>
 #include <private/qquickanimator_p.h>
+#include <private/qquickrectangle_p.h>
 #include <private/qquickrepeater_p.h>
 #include <private/qquicktransition_p.h>
 
 #include <QtQml>
 
+// Paints a flat colored rectangle. The node is only set up when it is created,
+// so that any later change of the color on screen comes from the animator.
+class FlatColorItem : public QQuickItem
+{
+    Q_OBJECT
+    Q_PROPERTY(QColor color READ color WRITE setColor NOTIFY colorChanged)
+public:
+    FlatColorItem() { setFlag(ItemHasContents); }
+
+    QColor color() const { return m_color; }
+    void setColor(const QColor &color)
+    {
+        if (color == m_color)
+            return;
+        m_color = color;
+        emit colorChanged();
+    }
+
+    QSGNode *updatePaintNode(QSGNode *old, UpdatePaintNodeData *) override
+    {
+        if (old)
+            return old;
+
+        QSGGeometryNode *node = new QSGGeometryNode;
+        QSGGeometry *geometry = new QSGGeometry(QSGGeometry::defaultAttributes_Point2D(), 4);
+        QSGGeometry::updateRectGeometry(geometry, boundingRect());
+        node->setGeometry(geometry);
+        node->setFlag(QSGNode::OwnsGeometry);
+        QSGFlatColorMaterial *material = new QSGFlatColorMaterial;
+        material->setColor(m_color);
+        node->setMaterial(material);
+        node->setFlag(QSGNode::OwnsMaterial);
+        return node;
+    }
+
+signals:
+    void colorChanged();
+
+private:
+    QColor m_color;
+};
+
 class tst_Animators: public QObject
 {
     Q_OBJECT
 
 private slots:
+    void initTestCase();
     void testMultiWinAnimator_data();
     void testMultiWinAnimator();
     void testTransitions();
+    void testColorAnimators();
+    void testFlatColorAnimator();
 };
 
+void tst_Animators::initTestCase()
+{
+    qmlRegisterType<FlatColorItem>("Test", 1, 0, "FlatColorItem");
+}
+
 void tst_Animators::testMultiWinAnimator_data()
 {
     QTest::addColumn<int>("count");
@@ -119,6 +170,46 @@ void tst_Animators::testTransitions()
     QCOMPARE(child->scale(), qreal(1.0));
 }
 
+void tst_Animators::testColorAnimators()
+{
+    QQuickView view(QUrl::fromLocalFile("data/colorAnimator.qml"));
+    view.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&view));
+    QVERIFY(view.rootObject());
+
+    QQuickRectangle *box = view.rootObject()->property("box").value<QQuickRectangle *>();
+    QVERIFY(box);
+
+    // The final values are written back to the item once, when the animations finish
+    QTRY_COMPARE(box->color(), QColor(Qt::blue));
+    QTRY_COMPARE(box->border()->color(), QColor(Qt::green));
+    QCOMPARE(box->property("colorChangeCounter").toInt(), 1);
+    QCOMPARE(box->property("borderColorChangeCounter").toInt(), 1);
+
+    const qreal dpr = view.devicePixelRatio();
+    const QImage image = view.grabWindow();
+    QCOMPARE(image.pixel(QPoint(50, 50) * dpr), qRgb(0, 0, 255));
+    QCOMPARE(image.pixel(QPoint(2, 50) * dpr), qRgb(0, 255, 0));
+}
+
+void tst_Animators::testFlatColorAnimator()
+{
+    QQuickView view(QUrl::fromLocalFile("data/flatColorAnimator.qml"));
+    view.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&view));
+    QVERIFY(view.rootObject());
+
+    FlatColorItem *box = view.rootObject()->property("box").value<FlatColorItem *>();
+    QVERIFY(box);
+
+    QTRY_COMPARE(box->color(), QColor(Qt::blue));
+
+    // FlatColorItem never updates its material, so the color was set by the animator
+    const qreal dpr = view.devicePixelRatio();
+    const QImage image = view.grabWindow();
+    QCOMPARE(image.pixel(QPoint(50, 50) * dpr), qRgb(0, 0, 255));
+}
+
 #include "tst_qquickanimators.moc"
 
 QTEST_MAIN(tst_Animators)
@@ -0,0 +1,31 @@
+import QtQuick 2.12
+
+GridView {
+    id: grid
+    width: 240
+    height: 320
+    cellWidth: 80
+    cellHeight: 20
+    cacheBuffer: 0
+    reuseItems: true
+    model: 900
+
+    property int createdCount: 0
+    property int pooledCount: 0
+    property int reusedCount: 0
+
+    delegate: Rectangle {
+        objectName: "wrapper"
+        width: grid.cellWidth
+        height: grid.cellHeight
+        property int modelIndex: index
+        property bool wasReused: false
+
+        Component.onCompleted: grid.createdCount++
+        GridView.onPooled: grid.pooledCount++
+        GridView.onReused: {
+            wasReused = true
+            grid.reusedCount++
+        }
+    }
+}
@@ -215,6 +215,7 @@ private slots:
 
     void keyNavigationEnabled();
     void releaseItems();
+    void reuseItems();
 
 private:
     QList<int> toIntList(const QVariantList &list);
@@ -6804,6 +6805,59 @@ void tst_QQuickGridView::releaseItems()
     gridview->setModel(123);
 }
 
+void tst_QQuickGridView::reuseItems()
+{
+    QScopedPointer<QQuickView> window(createView());
+    window->setSource(testFileUrl("reuseItems.qml"));
+    window->show();
+    QVERIFY(QTest::qWaitForWindowExposed(window.data()));
+
+    QQuickGridView *gridview = qobject_cast<QQuickGridView *>(window->rootObject());
+    QVERIFY(gridview);
+    QVERIFY(gridview->reuseItems());
+    QQuickItemViewPrivate *gridviewPrivate = QQuickItemViewPrivate::get(gridview);
+
+    const int initialCreated = gridview->property("createdCount").toInt();
+    QVERIFY(initialCreated > 0);
+
+    // Scroll through most of the model. Rows leaving the top should be
+    // recycled for the rows entering at the bottom, rather than recreated.
+    for (qreal y = 0; y <= 5000; y += 50) {
+        gridview->setContentY(y);
+        QVERIFY(gridviewPrivate->model->poolSize() <= initialCreated);
+    }
+
+    QVERIFY(gridview->property("pooledCount").toInt() > 0);
+    QVERIFY(gridview->property("reusedCount").toInt() > 0);
+    QVERIFY(gridview->property("createdCount").toInt() < initialCreated * 2);
+
+    QQmlInstanceModel::PoolStatistics statistics = gridviewPrivate->model->poolStatistics();
+    QCOMPARE(statistics.pooled, gridview->property("pooledCount").toInt());
+    QCOMPARE(statistics.reused, gridview->property("reusedCount").toInt());
+    QVERIFY(statistics.misses >= initialCreated);
+    QCOMPARE(statistics.pooled, statistics.reused + statistics.drained + gridviewPrivate->model->poolSize());
+
+    // Recycled items must report the index they are currently shown for
+    QQuickItem *contentItem = gridview->contentItem();
+    bool sawReusedItem = false;
+    const auto delegates = findItems<QQuickItem>(contentItem, "wrapper");
+    for (QQuickItem *item : delegates) {
+        if (QQuickItemPrivate::get(item)->culled)
+            continue;
+        sawReusedItem |= item->property("wasReused").toBool();
+        const int index = item->property("modelIndex").toInt();
+        QCOMPARE(item->x(), qreal((index % 3) * 80));
+        QCOMPARE(item->y(), qreal((index / 3) * 20));
+    }
+    QVERIFY(sawReusedItem);
+
+    // Turning reuse off must drain the pool
+    const int drained = statistics.drained + gridviewPrivate->model->poolSize();
+    gridview->setReuseItems(false);
+    QCOMPARE(gridviewPrivate->model->poolSize(), 0);
+    QCOMPARE(gridviewPrivate->model->poolStatistics().drained, drained);
+}
+
 QTEST_MAIN(tst_QQuickGridView)
 
 #include "tst_qquickgridview.moc"
@@ -188,6 +188,7 @@ private slots:
     void contains();
 
     void childAt();
+    void hitTestBounds();
 
     void ignoreButtonPressNotInAcceptedMouseButtons();
 
@@ -2005,6 +2006,38 @@ void tst_qquickitem::contains()
     QCOMPARE(result.toBool(), contains);
 }
 
+void tst_qquickitem::hitTestBounds()
+{
+    QQuickItem parent;
+    parent.setSize(QSizeF(100, 100));
+    QQuickItem child(&parent);
+    child.setSize(QSizeF(10, 10));
+    QQuickItem grandChild(&child);
+    grandChild.setSize(QSizeF(10, 10));
+    QQuickItemPrivate *childPrivate = QQuickItemPrivate::get(&child);
+
+    // Bounds of the child and its descendants, in the coordinates of the parent
+    QVERIFY(childPrivate->subtreeMayContain(QPointF(5, 5)));
+    QVERIFY(!childPrivate->subtreeMayContain(QPointF(50, 50)));
+
+    // Follows geometry changes anywhere in the subtree
+    grandChild.setPosition(QPointF(45, 45));
+    QVERIFY(childPrivate->subtreeMayContain(QPointF(50, 50)));
+    child.setPosition(QPointF(-50, -50));
+    QVERIFY(!childPrivate->subtreeMayContain(QPointF(50, 50)));
+    QVERIFY(childPrivate->subtreeMayContain(QPointF(0, 0)));
+    child.setScale(2);
+    QVERIFY(childPrivate->subtreeMayContain(QPointF(-40, -40)));
+
+    // Children of clipping items are only hit inside of them
+    child.setClip(true);
+    QVERIFY(!childPrivate->subtreeMayContain(QPointF(0, 0)));
+
+    // Pointer handlers and masks may want points anywhere
+    child.setContainmentMask(&parent);
+    QVERIFY(childPrivate->subtreeMayContain(QPointF(500, 500)));
+}
+
 void tst_qquickitem::childAt()
 {
     QQuickView view;
@@ -0,0 +1,29 @@
+import QtQuick 2.12
+
+ListView {
+    id: list
+    width: 240
+    height: 320
+    cacheBuffer: 0
+    reuseItems: true
+    model: 300
+
+    property int createdCount: 0
+    property int pooledCount: 0
+    property int reusedCount: 0
+
+    delegate: Rectangle {
+        objectName: "wrapper"
+        width: list.width
+        height: 20
+        property int modelIndex: index
+        property bool wasReused: false
+
+        Component.onCompleted: list.createdCount++
+        ListView.onPooled: list.pooledCount++
+        ListView.onReused: {
+            wasReused = true
+            list.reusedCount++
+        }
+    }
+}
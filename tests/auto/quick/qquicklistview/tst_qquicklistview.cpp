@@ -275,6 +275,7 @@ private slots:
     void addOnCompleted();
     void setPositionOnLayout();
     void touchCancel();
+    void reuseItems();
 
 private:
     template <class T> void items(const QUrl &source);
@@ -8978,6 +8979,60 @@ void tst_QQuickListView::touchCancel() // QTBUG-74679
     QTRY_COMPARE(listview->contentY(), 500.0);
 }
 
+void tst_QQuickListView::reuseItems()
+{
+    QScopedPointer<QQuickView> window(createView());
+    window->setSource(testFileUrl("reuseItems.qml"));
+    window->show();
+    QVERIFY(QTest::qWaitForWindowExposed(window.data()));
+
+    QQuickListView *listview = qobject_cast<QQuickListView *>(window->rootObject());
+    QVERIFY(listview);
+    QVERIFY(listview->reuseItems());
+    QQuickItemViewPrivate *listviewPrivate = QQuickItemViewPrivate::get(listview);
+
+    const int initialCreated = listview->property("createdCount").toInt();
+    QVERIFY(initialCreated > 0);
+
+    // Scroll through most of the model. Items leaving the top should be
+    // recycled for the items entering at the bottom, rather than recreated.
+    for (qreal y = 0; y <= 5000; y += 50) {
+        listview->setContentY(y);
+        QVERIFY(listviewPrivate->model->poolSize() <= initialCreated);
+    }
+
+    QVERIFY(listview->property("pooledCount").toInt() > 0);
+    QVERIFY(listview->property("reusedCount").toInt() > 0);
+    QVERIFY(listview->property("createdCount").toInt() < initialCreated * 2);
+
+    // The pool accounts for every item that went through it
+    QQmlInstanceModel::PoolStatistics statistics = listviewPrivate->model->poolStatistics();
+    QCOMPARE(statistics.pooled, listview->property("pooledCount").toInt());
+    QCOMPARE(statistics.reused, listview->property("reusedCount").toInt());
+    QVERIFY(statistics.misses >= initialCreated);
+    QCOMPARE(statistics.pooled, statistics.reused + statistics.drained + listviewPrivate->model->poolSize());
+
+    // Recycled items must report the index they are currently shown for
+    QQuickItem *contentItem = listview->contentItem();
+    bool sawReusedItem = false;
+    const auto delegates = findItems<QQuickItem>(contentItem, "wrapper");
+    for (QQuickItem *item : delegates) {
+        if (QQuickItemPrivate::get(item)->culled)
+            continue;
+        sawReusedItem |= item->property("wasReused").toBool();
+        const int index = item->property("modelIndex").toInt();
+        QCOMPARE(item->y(), qreal(index * 20));
+    }
+    QVERIFY(sawReusedItem);
+
+    // Turning reuse off must drain the pool
+    const int drained = statistics.drained + listviewPrivate->model->poolSize();
+    listview->setReuseItems(false);
+    QCOMPARE(listviewPrivate->model->poolSize(), 0);
+    statistics = listviewPrivate->model->poolStatistics();
+    QCOMPARE(statistics.drained, drained);
+}
+
 QTEST_MAIN(tst_QQuickListView)
 
 #include "tst_qquicklistview.moc"
@@ -0,0 +1,34 @@
+import QtQuick 2.12
+
+PathView {
+    id: view
+    width: 240
+    height: 320
+    pathItemCount: 10
+    reuseItems: true
+    model: 100
+
+    property int createdCount: 0
+    property int pooledCount: 0
+    property int reusedCount: 0
+
+    path: Path {
+        startX: 120; startY: 0
+        PathLine { x: 120; y: 320 }
+    }
+
+    delegate: Rectangle {
+        objectName: "wrapper"
+        width: 100
+        height: 20
+        property int modelIndex: index
+        property bool wasReused: false
+
+        Component.onCompleted: view.createdCount++
+        PathView.onPooled: view.pooledCount++
+        PathView.onReused: {
+            wasReused = true
+            view.reusedCount++
+        }
+    }
+}
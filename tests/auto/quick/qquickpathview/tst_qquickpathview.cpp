@@ -34,6 +34,7 @@
 #include <QtQml/qqmlexpression.h>
 #include <QtQml/qqmlincubator.h>
 #include <QtQuick/private/qquickpathview_p.h>
+#include <QtQuick/private/qquickpathview_p_p.h>
 #include <QtQuick/private/qquickflickable_p.h>
 #include <QtQuick/private/qquickpath_p.h>
 #include <QtQuick/private/qquicktext_p.h>
@@ -148,6 +149,7 @@ private slots:
     void movementDirection();
     void removePath();
     void objectModelMove();
+    void reuseItems();
 };
 
 class TestObject : public QObject
@@ -2657,6 +2659,58 @@ void tst_QQuickPathView::objectModelMove()
     }
 }
 
+void tst_QQuickPathView::reuseItems()
+{
+    QScopedPointer<QQuickView> window(createView());
+    window->setSource(testFileUrl("reuseItems.qml"));
+    window->show();
+    QVERIFY(QTest::qWaitForWindowExposed(window.data()));
+
+    QQuickPathView *pathview = qobject_cast<QQuickPathView *>(window->rootObject());
+    QVERIFY(pathview);
+    QVERIFY(pathview->reuseItems());
+    QQuickPathViewPrivate *pathviewPrivate = static_cast<QQuickPathViewPrivate *>(QQuickItemPrivate::get(pathview));
+
+    const int initialCreated = pathview->property("createdCount").toInt();
+    QVERIFY(initialCreated > 0);
+
+    // Move through the whole model. Items leaving the path should be
+    // recycled for the items entering it, rather than recreated.
+    for (qreal offset = 0; offset <= 100; offset += 0.5) {
+        pathview->setOffset(offset);
+        QVERIFY(pathviewPrivate->model->poolSize() <= initialCreated);
+    }
+
+    QVERIFY(pathview->property("pooledCount").toInt() > 0);
+    QVERIFY(pathview->property("reusedCount").toInt() > 0);
+    QVERIFY(pathview->property("createdCount").toInt() < initialCreated * 2);
+
+    QQmlInstanceModel::PoolStatistics statistics = pathviewPrivate->model->poolStatistics();
+    QCOMPARE(statistics.pooled, pathview->property("pooledCount").toInt());
+    QCOMPARE(statistics.reused, pathview->property("reusedCount").toInt());
+    QVERIFY(statistics.misses >= initialCreated);
+    QCOMPARE(statistics.pooled, statistics.reused + statistics.drained + pathviewPrivate->model->poolSize());
+
+    // The items on the path, recycled or not, show distinct model indexes
+    bool sawReusedItem = false;
+    QSet<int> indexes;
+    const auto delegates = findItems<QQuickItem>(pathview, "wrapper");
+    for (QQuickItem *item : delegates) {
+        if (QQuickItemPrivate::get(item)->culled)
+            continue;
+        sawReusedItem |= item->property("wasReused").toBool();
+        indexes.insert(item->property("modelIndex").toInt());
+    }
+    QVERIFY(sawReusedItem);
+    QCOMPARE(indexes.count(), pathview->pathItemCount());
+
+    // Turning reuse off must drain the pool
+    const int drained = statistics.drained + pathviewPrivate->model->poolSize();
+    pathview->setReuseItems(false);
+    QCOMPARE(pathviewPrivate->model->poolSize(), 0);
+    QCOMPARE(pathviewPrivate->model->poolStatistics().drained, drained);
+}
+
 QTEST_MAIN(tst_QQuickPathView)
 
 #include "tst_qquickpathview.moc"
@@ -86,7 +86,8 @@ QUICKTESTS += \
     qquickscreen \
     touchmouse \
     scenegraph \
-    sharedimage
+    sharedimage \
+    softwarerenderer
 
 SUBDIRS += $$PUBLICTESTS
 
@@ -43,6 +43,7 @@
 
 #include <private/qsgcontext_p.h>
 #include <private/qsgrenderloop_p.h>
+#include <private/qsgadaptationlayer_p.h>
 
 #include "../../shared/util.h"
 #include "../shared/visualtestutil.h"
@@ -113,6 +114,7 @@ private slots:
 #endif
     void createTextureFromImage_data();
     void createTextureFromImage();
+    void distanceFieldDiskCache();
 
 private:
     bool m_brokenMipmapSupport;
@@ -559,6 +561,44 @@ void tst_SceneGraph::createTextureFromImage()
     QCOMPARE(texture->hasAlphaChannel(), expectedAlpha);
 }
 
+void tst_SceneGraph::distanceFieldDiskCache()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString fileName = dir.filePath(QStringLiteral("fields"));
+    const QByteArray key("key");
+
+    const QRawFont font = QRawFont::fromFont(QFont());
+    QVERIFY(font.isValid());
+    const QVector<quint32> glyphs = font.glyphIndexesForString(QStringLiteral("g"));
+    QCOMPARE(glyphs.size(), 1);
+    const glyph_t glyph = glyphs.first();
+    const QPainterPath path = font.pathForGlyph(glyph);
+    const QDistanceField field(path, glyph, false);
+    QVERIFY(!field.isNull());
+
+    {
+        QSGDistanceFieldDiskCache cache(fileName, key);
+        QVERIFY(!cache.contains(glyph));
+        cache.store(QVector<QDistanceField>() << field);
+        QVERIFY(cache.contains(glyph));
+    }
+
+    // A cache opened later finds the field, and restores it unchanged
+    QSGDistanceFieldDiskCache cache(fileName, key);
+    QVERIFY(cache.contains(glyph));
+    QDistanceField restored;
+    QVERIFY(cache.find(glyph, path, false, &restored));
+    QCOMPARE(restored.glyph(), field.glyph());
+    QCOMPARE(restored.width(), field.width());
+    QCOMPARE(restored.height(), field.height());
+    QVERIFY(memcmp(restored.constBits(), field.constBits(), size_t(field.width()) * field.height()) == 0);
+
+    // Files written for another key are ignored
+    QSGDistanceFieldDiskCache otherCache(fileName, QByteArray("other"));
+    QVERIFY(!otherCache.contains(glyph));
+}
+
 bool tst_SceneGraph::isRunningOnOpenGL()
 {
     bool retval = false;
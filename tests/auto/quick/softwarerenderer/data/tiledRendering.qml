@@ -0,0 +1,75 @@
+import QtQuick 2.12
+
+Rectangle {
+    id: root
+    width: 640
+    height: 480
+    color: "white"
+
+    property bool changed: false
+
+    Rectangle {
+        x: 10; y: 10
+        width: 200; height: 150
+        radius: 24
+        color: root.changed ? "orange" : "steelblue"
+        border.width: 5
+        border.color: "navy"
+    }
+
+    Rectangle {
+        x: 240; y: 20
+        width: 120; height: 300
+        radius: 60
+        gradient: Gradient {
+            GradientStop { position: 0; color: "yellow" }
+            GradientStop { position: 1; color: "green" }
+        }
+        border.width: 3
+        border.color: "black"
+    }
+
+    Rectangle {
+        x: 60; y: 200
+        width: 300; height: 200
+        rotation: root.changed ? 35 : 20
+        antialiasing: true
+        radius: 12
+        color: "#80ff0000"
+        border.width: 2
+        border.color: "darkred"
+    }
+
+    Image {
+        x: 400; y: 30
+        width: 200; height: 160
+        source: "image://pattern/checkers"
+        smooth: true
+    }
+
+    Image {
+        x: 420; y: 240
+        width: 160; height: 160
+        rotation: 45
+        source: "image://pattern/gradient"
+        smooth: true
+        antialiasing: true
+    }
+
+    Text {
+        x: 20; y: 420
+        width: 600
+        text: "Tiles painted on several threads must match a single painter"
+        font.pixelSize: 22
+        wrapMode: Text.WordWrap
+    }
+
+    Text {
+        x: 380; y: 200
+        rotation: -15
+        text: root.changed ? "Changed" : "Rotated"
+        font.pixelSize: 30
+        font.bold: true
+        color: "purple"
+    }
+}
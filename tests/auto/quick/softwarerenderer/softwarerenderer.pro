@@ -0,0 +1,11 @@
+CONFIG += testcase
+TARGET = tst_softwarerenderer
+macx:CONFIG -= app_bundle
+
+SOURCES += tst_softwarerenderer.cpp
+
+include (../../shared/util.pri)
+
+TESTDATA = data/*
+
+QT += core-private gui-private qml-private quick-private testlib
@@ -0,0 +1,146 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+#include <qtest.h>
+
+#include <QtGui/qimage.h>
+#include <QtGui/qpainter.h>
+#include <QtQml/qqmlengine.h>
+#include <QtQuick/qquickimageprovider.h>
+#include <QtQuick/qquickitem.h>
+#include <QtQuick/qquickview.h>
+#include <QtQuick/qsgrendererinterface.h>
+#include <private/qsgabstractsoftwarerenderer_p.h>
+
+#include "../../shared/util.h"
+
+class PatternImageProvider : public QQuickImageProvider
+{
+public:
+    PatternImageProvider() : QQuickImageProvider(QQuickImageProvider::Image) {}
+
+    QImage requestImage(const QString &id, QSize *size, const QSize &) override
+    {
+        QImage image(128, 128, QImage::Format_ARGB32_Premultiplied);
+        if (id == QLatin1String("checkers")) {
+            for (int y = 0; y < image.height(); ++y) {
+                for (int x = 0; x < image.width(); ++x)
+                    image.setPixel(x, y, ((x / 16) + (y / 16)) % 2 ? 0xff202020 : 0xffe0e0e0);
+            }
+        } else {
+            QPainter painter(&image);
+            QLinearGradient gradient(0, 0, image.width(), image.height());
+            gradient.setColorAt(0, Qt::cyan);
+            gradient.setColorAt(1, QColor(128, 0, 255, 128));
+            painter.setCompositionMode(QPainter::CompositionMode_Source);
+            painter.fillRect(image.rect(), gradient);
+        }
+        *size = image.size();
+        return image;
+    }
+};
+
+class tst_SoftwareRenderer : public QQmlDataTest
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void cleanup();
+
+    void tiledRendering_data();
+    void tiledRendering();
+
+private:
+    bool render(int threads, QImage *initial, QImage *updated);
+};
+
+void tst_SoftwareRenderer::initTestCase()
+{
+    QQmlDataTest::initTestCase();
+    QQuickWindow::setSceneGraphBackend(QSGRendererInterface::Software);
+}
+
+void tst_SoftwareRenderer::cleanup()
+{
+    qsg_software_set_render_threads(0);
+}
+
+/*
+    Renders the test scene with the given number of render threads, once in full, and once
+    more after changing a few items, which updates a region larger than the minimum size
+    for tiled rendering.
+*/
+bool tst_SoftwareRenderer::render(int threads, QImage *initial, QImage *updated)
+{
+    qsg_software_set_render_threads(threads);
+
+    QQuickView view;
+    view.engine()->addImageProvider(QLatin1String("pattern"), new PatternImageProvider);
+    view.setSource(testFileUrl("tiledRendering.qml"));
+    view.setResizeMode(QQuickView::SizeViewToRootObject);
+    view.show();
+    if (!QTest::qWaitForWindowExposed(&view) || !view.rootObject())
+        return false;
+    if (view.rendererInterface()->graphicsApi() != QSGRendererInterface::Software)
+        return false;
+
+    *initial = view.grabWindow();
+    view.rootObject()->setProperty("changed", true);
+    *updated = view.grabWindow();
+    return !initial->isNull() && !updated->isNull();
+}
+
+void tst_SoftwareRenderer::tiledRendering_data()
+{
+    QTest::addColumn<int>("threads");
+
+    QTest::newRow("2 threads") << 2;
+    QTest::newRow("4 threads") << 4;
+    QTest::newRow("7 threads") << 7;
+}
+
+void tst_SoftwareRenderer::tiledRendering()
+{
+    QFETCH(int, threads);
+
+    // A single thread paints with one painter, which is the reference
+    QImage expectedInitial;
+    QImage expectedUpdated;
+    QVERIFY(render(1, &expectedInitial, &expectedUpdated));
+    QVERIFY(expectedInitial != expectedUpdated);
+
+    QImage initial;
+    QImage updated;
+    QVERIFY(render(threads, &initial, &updated));
+    QCOMPARE(initial, expectedInitial);
+    QCOMPARE(updated, expectedUpdated);
+}
+
+QTEST_MAIN(tst_SoftwareRenderer)
+
+#include "tst_softwarerenderer.moc"
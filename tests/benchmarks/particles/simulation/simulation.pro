@@ -0,0 +1,9 @@
+CONFIG += benchmark
+TEMPLATE = app
+TARGET = tst_simulation
+SOURCES += tst_simulation.cpp
+macx:CONFIG -= app_bundle
+
+DEFINES += SRCDIR=\\\"$$PWD\\\"
+
+QT += quickparticles-private testlib
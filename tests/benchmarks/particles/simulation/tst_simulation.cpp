@@ -0,0 +1,88 @@
+/****************************************************************************
+**
+** Copyright (C) 2016 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <qtest.h>
+#include <QtTest/QtTest>
+#include <QThread>
+#include "../../../auto/particles/shared/particlestestsshared.h"
+#include <private/qquickparticlesystem_p.h>
+
+class tst_simulation : public QObject
+{
+    Q_OBJECT
+public:
+    tst_simulation();
+
+private slots:
+    void test_threads();
+    void test_threads_data();
+};
+
+tst_simulation::tst_simulation()
+{
+}
+
+inline QUrl TEST_FILE(const QString &filename)
+{
+    return QUrl::fromLocalFile(QLatin1String(SRCDIR) + QLatin1String("/data/") + filename);
+}
+
+void tst_simulation::test_threads_data()
+{
+    QTest::addColumn<int> ("threads");
+    for (int threads = 1; threads < QThread::idealThreadCount(); threads *= 2)
+        QTest::newRow(qPrintable(QString::fromLatin1("%1 threads").arg(threads))) << threads;
+    QTest::newRow("one per core") << QThread::idealThreadCount();
+}
+
+void tst_simulation::test_threads()
+{
+    QFETCH(int, threads);
+    QQuickView* view = createView(TEST_FILE("gravity.qml"));
+    QQuickParticleSystem* system = view->rootObject()->findChild<QQuickParticleSystem*>("system");
+    //Pretend we're running, but we manually advance the simulation
+    system->m_running = true;
+    system->m_animation = 0;
+    system->simulationThreads = threads;
+    system->reset();
+
+    int curTime = 1;
+    system->updateCurrentTime(curTime);//Fixed point and get init out of the way - including emission
+
+    QBENCHMARK {
+        curTime += 16;
+        system->updateCurrentTime(curTime);
+    }
+
+    QVERIFY(extremelyFuzzyCompare(system->groupData[0]->size(), 50000, 10));
+    delete view;
+}
+
+QTEST_MAIN(tst_simulation);
+
+#include "tst_simulation.moc"
@@ -32,6 +32,8 @@
 #include <private/qqmlmetatype_p.h>
 #include <private/qquickanimation_p_p.h>
 #include <QQmlContext>
+#include <QQmlProperty>
+#include <QColor>
 
 class tst_animation : public QObject
 {
@@ -45,6 +47,8 @@ private slots:
 #if defined(QT_BUILD_INTERNAL)
     void bulkValueAnimator();
     void propertyUpdater();
+    void propertyUpdaterSetValue_data();
+    void propertyUpdaterSetValue();
 #endif
 
     void animationtree_qml();
@@ -94,6 +98,59 @@ void tst_animation::propertyUpdater()
         delete updater;
     }
 }
+
+void tst_animation::propertyUpdaterSetValue_data()
+{
+    QTest::addColumn<QString>("property");
+    QTest::addColumn<QVariant>("from");
+    QTest::addColumn<QVariant>("to");
+    QTest::addColumn<bool>("typed");
+
+    for (bool typed : {false, true}) {
+        const char *suffix = typed ? " typed" : " variant";
+        QTest::newRow(QByteArray(QByteArray("real") + suffix)) << "realValue" << QVariant(0.) << QVariant(100.) << typed;
+        QTest::newRow(QByteArray(QByteArray("int") + suffix)) << "intValue" << QVariant(0) << QVariant(100) << typed;
+        QTest::newRow(QByteArray(QByteArray("color") + suffix)) << "colorValue" << QVariant(QColor(Qt::red)) << QVariant(QColor(Qt::blue)) << typed;
+        QTest::newRow(QByteArray(QByteArray("point") + suffix)) << "pointValue" << QVariant(QPointF(0, 0)) << QVariant(QPointF(100, 50)) << typed;
+        QTest::newRow(QByteArray(QByteArray("rect") + suffix)) << "rectValue" << QVariant(QRectF(0, 0, 10, 10)) << QVariant(QRectF(100, 50, 20, 40)) << typed;
+    }
+}
+
+// Ticks an updater driving the same property on 2000 objects, like as many running animations
+void tst_animation::propertyUpdaterSetValue()
+{
+    QFETCH(QString, property);
+    QFETCH(QVariant, from);
+    QFETCH(QVariant, to);
+    QFETCH(bool, typed);
+
+    QQmlComponent component(&engine);
+    component.setData("import QtQuick 2.0\nItem { property real realValue; property int intValue; property color colorValue; property point pointValue; property rect rectValue }", QUrl());
+
+    QObjectList objects;
+    QQuickAnimationPropertyUpdater updater;
+    updater.typedInterpolation = typed;
+    updater.fromDefined = true;
+    for (int i = 0; i < 2000; ++i) {
+        QObject *obj = component.create();
+        QVERIFY(obj);
+        objects << obj;
+
+        QQuickStateAction action;
+        action.property = QQmlProperty(obj, property);
+        action.fromValue = from;
+        action.toValue = to;
+        updater.actions << action;
+    }
+
+    QBENCHMARK {
+        for (int step = 0; step < 10; ++step)
+            updater.setValue(step / 10.);
+    }
+
+    QCOMPARE(objects.first()->property(property.toLatin1()).userType(), from.userType());
+    qDeleteAll(objects);
+}
 #endif // QT_BUILD_INTERNAL
 
 void tst_animation::animationtree_qml()
@@ -8,6 +8,8 @@ SUBDIRS += \
            qqmlchangeset \
            qqmlcomponent \
            qqmlmetaproperty \
+           qqmlmetatype \
+           animation \
            librarymetrics_performance \
            script \
            js \
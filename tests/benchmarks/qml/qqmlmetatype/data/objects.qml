@@ -0,0 +1,15 @@
+import QtQml 2.0
+
+QtObject {
+    id: root
+    property int count: 0
+
+    property list<QtObject> objects: [
+        Timer { interval: 10; running: root.count > 0 },
+        Timer { interval: 20; repeat: true },
+        QtObject { property string name: "first"; property int value: root.count * 2 },
+        QtObject { property string name: "second"; property var values: [1, 2, 3] },
+        Binding { target: root; property: "count"; value: 1 },
+        Connections { target: root; onCountChanged: {} }
+    ]
+}
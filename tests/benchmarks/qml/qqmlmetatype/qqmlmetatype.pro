@@ -0,0 +1,10 @@
+CONFIG += benchmark
+TEMPLATE = app
+TARGET = tst_qqmlmetatype
+QT += qml-private testlib
+macx:CONFIG -= app_bundle
+
+SOURCES += tst_qqmlmetatype.cpp
+
+# Define SRCDIR equal to test's source directory
+DEFINES += SRCDIR=\\\"$$PWD\\\"
@@ -0,0 +1,143 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <qtest.h>
+#include <QQmlEngine>
+#include <QQmlComponent>
+#include <QThread>
+#include <QVector>
+#include <private/qqmlmetatype_p.h>
+#include <private/qhashedstring_p.h>
+
+#include <functional>
+
+// Measures the type lookups which component creation does, from several threads at once
+class tst_qqmlmetatype : public QObject
+{
+    Q_OBJECT
+
+public:
+    tst_qqmlmetatype();
+
+private slots:
+    void lookup_data();
+    void lookup();
+    void concurrentEngines_data();
+    void concurrentEngines();
+
+private:
+    void runOnThreads(int threadCount, const std::function<void()> &function);
+};
+
+class FunctionThread : public QThread
+{
+public:
+    FunctionThread(const std::function<void()> &function) : m_function(function) {}
+
+protected:
+    void run() override { m_function(); }
+
+private:
+    std::function<void()> m_function;
+};
+
+tst_qqmlmetatype::tst_qqmlmetatype()
+{
+}
+
+void tst_qqmlmetatype::runOnThreads(int threadCount, const std::function<void()> &function)
+{
+    QVector<FunctionThread *> threads;
+    for (int i = 0; i < threadCount; ++i) {
+        threads.append(new FunctionThread(function));
+        threads.last()->start();
+    }
+    for (FunctionThread *thread : qAsConst(threads)) {
+        thread->wait();
+        delete thread;
+    }
+}
+
+void tst_qqmlmetatype::lookup_data()
+{
+    QTest::addColumn<int>("threadCount");
+
+    QTest::newRow("1 thread") << 1;
+    QTest::newRow("2 threads") << 2;
+    QTest::newRow("4 threads") << 4;
+    QTest::newRow("8 threads") << 8;
+}
+
+void tst_qqmlmetatype::lookup()
+{
+    QFETCH(int, threadCount);
+
+    // Registers the QtQml types
+    QQmlEngine engine;
+
+    const QHashedStringRef module(QStringLiteral("QtQml"));
+    const QHashedStringRef timer(QStringLiteral("Timer"));
+    const QHashedStringRef qtObject(QStringLiteral("QtObject"));
+    QVERIFY(QQmlMetaType::qmlType(timer, module, 2, 0).isValid());
+
+    QBENCHMARK {
+        runOnThreads(threadCount, [&]() {
+            for (int i = 0; i < 10000; ++i) {
+                QQmlMetaType::qmlType(timer, module, 2, 0);
+                QQmlMetaType::qmlType(qtObject, module, 2, 0);
+                QQmlMetaType::qmlType(&QObject::staticMetaObject);
+                QQmlMetaType::isQObject(QMetaType::QString);
+                QQmlMetaType::typeCategory(QMetaType::QVariantList);
+            }
+        });
+    }
+}
+
+void tst_qqmlmetatype::concurrentEngines_data()
+{
+    lookup_data();
+}
+
+void tst_qqmlmetatype::concurrentEngines()
+{
+    QFETCH(int, threadCount);
+
+    const QUrl url = QUrl::fromLocalFile(SRCDIR "/data/objects.qml");
+
+    QBENCHMARK {
+        runOnThreads(threadCount, [&]() {
+            QQmlEngine engine;
+            QQmlComponent component(&engine, url);
+            for (int i = 0; i < 20; ++i)
+                delete component.create();
+        });
+    }
+}
+
+QTEST_MAIN(tst_qqmlmetatype)
+#include "tst_qqmlmetatype.moc"
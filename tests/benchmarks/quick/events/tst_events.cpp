@@ -50,6 +50,8 @@ private slots:
     void mouseMove();
     void touchToMousePressRelease();
     void touchToMousePressMove();
+    void manyItemsPressRelease();
+    void manyItemsHoverMove();
 
 public slots:
     void initTestCase() {
@@ -139,5 +141,41 @@ void tst_events::touchToMousePressMove()
     QCOMPARE(mouseArea->pressed(), false);
 }
 
+void tst_events::manyItemsPressRelease()
+{
+    TestView manyItemsWindow;
+    manyItemsWindow.setSource(testFileUrl("manyitems.qml"));
+    manyItemsWindow.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&manyItemsWindow));
+    QQuickMouseArea *mouseArea = manyItemsWindow.rootObject()->findChild<QQuickMouseArea *>("mouseArea");
+    QCOMPARE(mouseArea->pressed(), false);
+
+    QBENCHMARK {
+        QMouseEvent pressEvent(QEvent::MouseButtonPress, QPoint(390, 390), Qt::LeftButton, Qt::LeftButton, 0);
+        manyItemsWindow.handleEvent(&pressEvent);
+        QCOMPARE(mouseArea->pressed(), true);
+        QMouseEvent releaseEvent(QEvent::MouseButtonRelease, QPoint(390, 390), Qt::LeftButton, Qt::LeftButton, 0);
+        manyItemsWindow.handleEvent(&releaseEvent);
+    }
+    QCOMPARE(mouseArea->pressed(), false);
+}
+
+void tst_events::manyItemsHoverMove()
+{
+    TestView manyItemsWindow;
+    manyItemsWindow.setSource(testFileUrl("manyitems.qml"));
+    manyItemsWindow.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&manyItemsWindow));
+    QQuickMouseArea *mouseArea = manyItemsWindow.rootObject()->findChild<QQuickMouseArea *>("mouseArea");
+
+    QMouseEvent moveEvent1(QEvent::MouseMove, QPoint(390, 390), Qt::NoButton, Qt::NoButton, 0);
+    QMouseEvent moveEvent2(QEvent::MouseMove, QPoint(391, 390), Qt::NoButton, Qt::NoButton, 0);
+    QBENCHMARK {
+        manyItemsWindow.handleEvent(&moveEvent1);
+        manyItemsWindow.handleEvent(&moveEvent2);
+    }
+    QVERIFY(mouseArea->hovered());
+}
+
 QTEST_MAIN(tst_events)
 #include "tst_events.moc"
@@ -31,6 +31,7 @@
 #include <QCommandLineParser>
 #include <QFile>
 #include <QFileInfo>
+#include <QUrl>
 #include <QDateTime>
 #include <QHashFunctions>
 #include <QSaveFile>
@@ -38,6 +39,7 @@
 #include <QScopeGuard>
 
 #include <private/qqmlirbuilder_p.h>
+#include <private/qv4compilationunitbundle_p.h>
 #include <private/qqmljsparser_p.h>
 #include <private/qqmljslexer_p.h>
 
@@ -172,19 +174,25 @@ static bool compileQmlFile(const QString &inputFileName, SaveFunction saveFuncti
     QmlIR::Document irDocument(/*debugMode*/false);
 
     QString sourceCode;
+    quint64 sourceHash = 0;
     {
         QFile f(inputFileName);
         if (!f.open(QIODevice::ReadOnly)) {
             error->message = QLatin1String("Error opening ") + inputFileName + QLatin1Char(':') + f.errorString();
             return false;
         }
-        sourceCode = QString::fromUtf8(f.readAll());
+        const QByteArray sourceData = f.readAll();
         if (f.error() != QFileDevice::NoError) {
             error->message = QLatin1String("Error reading from ") + inputFileName + QLatin1Char(':') + f.errorString();
             return false;
         }
+        sourceCode = QString::fromUtf8(sourceData);
+        sourceHash = QV4::CompiledData::computeSourceHash(sourceData.constData(), sourceData.size());
     }
 
+    // Lets the unit be validated by content when it is used as a disk cache.
+    irDocument.jsModule.sourceHash = sourceHash;
+
     {
         QmlIR::IRBuilder irBuilder(illegalNames);
         if (!irBuilder.generateFromQml(sourceCode, inputFileName, &irDocument)) {
@@ -240,17 +248,20 @@ static bool compileJSFile(const QString &inputFileName, const QString &inputFile
     QQmlRefPointer<QV4::CompiledData::CompilationUnit> unit;
 
     QString sourceCode;
+    quint64 sourceHash = 0;
     {
         QFile f(inputFileName);
         if (!f.open(QIODevice::ReadOnly)) {
             error->message = QLatin1String("Error opening ") + inputFileName + QLatin1Char(':') + f.errorString();
             return false;
         }
-        sourceCode = QString::fromUtf8(f.readAll());
+        const QByteArray sourceData = f.readAll();
         if (f.error() != QFileDevice::NoError) {
             error->message = QLatin1String("Error reading from ") + inputFileName + QLatin1Char(':') + f.errorString();
             return false;
         }
+        sourceCode = QString::fromUtf8(sourceData);
+        sourceHash = QV4::CompiledData::computeSourceHash(sourceData.constData(), sourceData.size());
     }
 
     const bool isModule = inputFileName.endsWith(QLatin1String(".mjs"));
@@ -258,12 +269,13 @@ static bool compileJSFile(const QString &inputFileName, const QString &inputFile
         QList<QQmlJS::DiagnosticMessage> diagnostics;
         // Precompiled files are relocatable and the final location will be set when loading.
         QString url;
-        unit = QV4::ExecutionEngine::compileModule(/*debugMode*/false, url, sourceCode, QDateTime(), &diagnostics);
+        unit = QV4::ExecutionEngine::compileModule(/*debugMode*/false, url, sourceCode, QDateTime(), &diagnostics, sourceHash);
         error->appendDiagnostics(inputFileName, diagnostics);
         if (!unit)
             return false;
     } else {
         QmlIR::Document irDocument(/*debugMode*/false);
+        irDocument.jsModule.sourceHash = sourceHash;
 
         QQmlJS::Engine *engine = &irDocument.jsParserEngine;
         QmlIR::ScriptDirectivesCollector directivesCollector(&irDocument);
@@ -401,6 +413,45 @@ static bool saveUnitAsCpp(const QString &inputFileName, const QString &outputFil
     return true;
 }
 
+// Mirrors QQmlFile::urlToLocalFileOrQrc(), which is what the bundle is keyed by at run-time.
+static QString sourcePathForUnit(const QString &sourceUrl)
+{
+    const QUrl url(sourceUrl);
+    if (url.scheme().compare(QLatin1String("qrc"), Qt::CaseInsensitive) == 0)
+        return QLatin1Char(':') + url.path();
+    if (url.isLocalFile())
+        return url.toLocalFile();
+    return QFileInfo(sourceUrl).absoluteFilePath();
+}
+
+static bool writeBundle(const QStringList &cacheFiles, const QString &outputFileName, QString *errorString)
+{
+    QVector<QV4::CompilationUnitBundle::Entry> entries;
+    entries.reserve(cacheFiles.size());
+    for (const QString &cacheFile : cacheFiles) {
+        QFile f(cacheFile);
+        if (!f.open(QIODevice::ReadOnly)) {
+            *errorString = QLatin1String("Error opening ") + cacheFile + QLatin1Char(':') + f.errorString();
+            return false;
+        }
+
+        QV4::CompilationUnitBundle::Entry entry;
+        entry.unitData = f.readAll();
+        const auto *unit = reinterpret_cast<const QV4::CompiledData::Unit *>(entry.unitData.constData());
+        if (size_t(entry.unitData.size()) < sizeof(QV4::CompiledData::Unit)
+                || strncmp(unit->magic, QV4::CompiledData::magic_str, sizeof(unit->magic)) != 0
+                || unit->unitSize != quint32(entry.unitData.size())
+                || unit->sourceFileIndex >= unit->stringTableSize) {
+            *errorString = cacheFile + QLatin1String(" is not a QML cache file");
+            return false;
+        }
+        entry.sourcePath = sourcePathForUnit(unit->stringAtInternal(unit->sourceFileIndex));
+        entries.append(entry);
+    }
+
+    return QV4::CompilationUnitBundle::write(outputFileName, entries, errorString);
+}
+
 int main(int argc, char **argv)
 {
     // Produce reliably the same output for the same input by disabling QHash's random seeding.
@@ -423,6 +474,9 @@ int main(int argc, char **argv)
     QCommandLineOption resourcePathOption(QStringLiteral("resource-path"), QCoreApplication::translate("main", "Qt resource file path corresponding to the file being compiled"), QCoreApplication::translate("main", "resource-path"));
     parser.addOption(resourcePathOption);
 
+    QCommandLineOption bundleOption(QStringLiteral("bundle"), QCoreApplication::translate("main", "Combine the given cache files into a single cache bundle"));
+    parser.addOption(bundleOption);
+
     QCommandLineOption outputFileOption(QStringLiteral("o"), QCoreApplication::translate("main", "Output file name"), QCoreApplication::translate("main", "file name"));
     parser.addOption(outputFileOption);
 
@@ -436,14 +490,17 @@ int main(int argc, char **argv)
     enum Output {
         GenerateCpp,
         GenerateCacheFile,
-        GenerateLoader
+        GenerateLoader,
+        GenerateBundle
     } target = GenerateCacheFile;
 
     QString outputFileName;
     if (parser.isSet(outputFileOption))
         outputFileName = parser.value(outputFileOption);
 
-    if (outputFileName.endsWith(QLatin1String(".cpp"))) {
+    if (parser.isSet(bundleOption)) {
+        target = GenerateBundle;
+    } else if (outputFileName.endsWith(QLatin1String(".cpp"))) {
         target = GenerateCpp;
         if (outputFileName.endsWith(QLatin1String("qmlcache_loader.cpp")))
             target = GenerateLoader;
@@ -452,11 +509,25 @@ int main(int argc, char **argv)
     const QStringList sources = parser.positionalArguments();
     if (sources.isEmpty()){
         parser.showHelp();
-    } else if (sources.count() > 1 && target != GenerateLoader) {
+    } else if (sources.count() > 1 && target != GenerateLoader && target != GenerateBundle) {
         fprintf(stderr, "%s\n", qPrintable(QStringLiteral("Too many input files specified: '") + sources.join(QStringLiteral("' '")) + QLatin1Char('\'')));
         return EXIT_FAILURE;
     }
 
+    if (target == GenerateBundle) {
+        if (outputFileName.isEmpty()) {
+            fprintf(stderr, "--%s requires an output file name.\n", qPrintable(bundleOption.names().first()));
+            return EXIT_FAILURE;
+        }
+
+        Error error;
+        if (!writeBundle(sources, outputFileName, &error.message)) {
+            error.augment(QLatin1String("Error generating cache bundle: ")).print();
+            return EXIT_FAILURE;
+        }
+        return EXIT_SUCCESS;
+    }
+
     const QString inputFile = sources.first();
     if (outputFileName.isEmpty())
         outputFileName = inputFile + QLatin1Char('c');
@@ -84,6 +84,7 @@ int main(int argc, char *argv[])
     if (!args.isEmpty()) {
         if (args.constFirst() == QLatin1String("--jit")) {
             qputenv("QV4_JIT_CALL_THRESHOLD", QByteArray("0"));
+            qputenv("QV4_JIT_SYNCHRONOUS", QByteArray("1"));
             args.removeFirst();
         }
         if (args.constFirst() == QLatin1String("--interpret")) {